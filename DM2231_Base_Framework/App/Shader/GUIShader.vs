@@ -1,13 +0,0 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-
-out vec2 TexCoord;
-
-uniform mat4 transform;
-
-void main()
-{
-	gl_Position = transform * vec4(aPos, 1.0);
-	TexCoord = aTexCoord;
-}
\ No newline at end of file
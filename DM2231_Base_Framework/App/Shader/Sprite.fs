@@ -2,11 +2,12 @@
 out vec4 FragColor;
 
 in vec2 TexCoord;
+in vec4 ourColor;
 
 // texture samplers
 uniform sampler2D texture1;
 
 void main()
 {
-	FragColor = texture(texture1, TexCoord);
+	FragColor = texture(texture1, TexCoord) * ourColor;
 }
\ No newline at end of file
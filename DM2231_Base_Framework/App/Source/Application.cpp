@@ -20,6 +20,9 @@
 
 #include "GameControl\Settings.h"
 
+// Include Profiler
+#include "System\Profiler.h"
+
 // Inputs
 #include "Inputs\KeyboardController.h"
 #include "Inputs\MouseController.h"
@@ -66,7 +69,7 @@ void repos_callback(GLFWwindow* window, int xpos, int ypos)
 	CSettings::GetInstance()->iWindowPosX = xpos;
 	CSettings::GetInstance()->iWindowPosY = ypos;
 	// Update the glViewPort
-	glViewport(0, 0, CSettings::GetInstance()->iWindowWidth, CSettings::GetInstance()->iWindowHeight);
+	GL()->Viewport(0, 0, CSettings::GetInstance()->iWindowWidth, CSettings::GetInstance()->iWindowHeight);
 }
 
 /**
@@ -81,7 +84,7 @@ void resize_callback(GLFWwindow* window, int width, int height)
 	CSettings::GetInstance()->iWindowWidth = width;
 	CSettings::GetInstance()->iWindowHeight = height;
 	// Update the glViewPort
-	glViewport(0, 0, width, height);
+	GL()->Viewport(0, 0, width, height);
 }
 
 /**
@@ -168,6 +171,12 @@ bool Application::Init(void)
 	//This function makes the context of the specified window current on the calling thread. 
 	glfwMakeContextCurrent(cSettings->pWindow);
 
+	// Let the buffer swap wait for the vertical blank if it is enabled, and tell the frame pacer how often the monitor refreshes
+	glfwSwapInterval(cSettings->bUseVSync ? 1 : 0);
+	const GLFWvidmode* pVideoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	cFramePacer.Init(cSettings->dFrameTime, cSettings->dSpinWindow);
+	cFramePacer.SetVSync(cSettings->bUseVSync, (pVideoMode && (pVideoMode->refreshRate > 0)) ? 1.0 / pVideoMode->refreshRate : 0.0);
+
 	//Sets the callback functions for GLFW
 	//Set the window position callback function
 	glfwSetWindowPosCallback(cSettings->pWindow, repos_callback);
@@ -205,6 +214,10 @@ bool Application::Init(void)
 		return false;
 	}
 
+	// Initialise the CProfiler instance before the scene, so that the loading of the assets can be profiled too
+	CProfiler::GetInstance()->Init();
+	CProfiler::GetInstance()->SetEnabled(cSettings->bEnableProfiler);
+
 	// Initialise the cScene3D instance
 	cScene3D = CScene3D::GetInstance();
 	if (cScene3D->Init() == false)
@@ -227,15 +240,43 @@ void Application::Run(void)
 {
 	// Start timer to calculate how long it takes to render this frame
 	cStopWatch.StartTimer();
+	// Start the frame schedule from now
+	cFramePacer.Start();
 
 	double dElapsedTime = 0.0;
+	dAccumulator = 0.0;
+
+	// When the update is pipelined, the next frame is simulated on the simulation thread while this frame is rendered.
+	// The first frame is simulated before the loop, so that there is a render state to draw.
+	const bool bPipelined = cSettings->bPipelinedUpdate;
+	cScene3D->SetPipelined(bPipelined);
+	if (bPipelined)
+	{
+		bSimulationQueued = false;
+		bStopping = false;
+		thrSimulation = std::thread(&Application::SimulationThread, this);
+		Simulate(dElapsedTime);
+	}
 
-	// Render loop
+	// Render loop. The input is only read here while the simulation is not running.
 	while (!glfwWindowShouldClose(cSettings->pWindow)
 		&& (!CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE)))
 	{
-		// Call the cScene3D's Update method
-		cScene3D->Update(dElapsedTime);
+		// Mark the start of this frame in the profiler
+		CProfiler::GetInstance()->BeginFrame();
+
+		if (bPipelined)
+		{
+			// Draw the frame which was simulated last, while the simulation thread simulates the next one
+			cScene3D->Sync();
+			StartSimulation(dElapsedTime);
+		}
+		else
+		{
+			// Simulate this frame, then draw it
+			Simulate(dElapsedTime);
+			cScene3D->Sync();
+		}
 
 		// Call the cScene3D's Pre-Render method
 		cScene3D->PreRender();
@@ -248,7 +289,14 @@ void Application::Run(void)
 
 		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
 		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(cSettings->pWindow);
+		{
+			PROFILE_SCOPE("SwapBuffers");
+			glfwSwapBuffers(cSettings->pWindow);
+		}
+
+		// The input devices are updated by the events below, which the simulation must not be reading
+		if (bPipelined)
+			WaitForSimulation();
 
 		// Poll events
 		glfwPollEvents();
@@ -259,11 +307,105 @@ void Application::Run(void)
 		//// Perform Post Update Input Devices
 		//PostUpdateInputDevices();
 
+		// Frame rate limiter. Sleeps, then spins, until the next frame is due on a steady schedule.
+		{
+			PROFILE_SCOPE("Wait");
+			cFramePacer.Wait();
+		}
+
+		// Collect the zones of this frame from all the threads
+		CProfiler::GetInstance()->EndFrame();
+
+		// Count the whole of this frame, after the profiler has collected it, so that a hitch can be matched to the zones which caused it
 		dElapsedTime = cStopWatch.GetElapsedTime();
 		cFPSCounter->Update(dElapsedTime);
+	}
+
+	// Stop and join the simulation thread
+	if (bPipelined)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtxSimulation);
+			bStopping = true;
+		}
+		cvSimulationQueued.notify_one();
+		thrSimulation.join();
+	}
+}
+
+/**
+ @brief Simulate a frame: the input and the game events, then as many fixed steps as the time of the last frame allows.
+		The positions are rendered between the last two steps by the time which is left over, so the render state is captured last.
+ @param dElapsedTime A const double variable which contains the time of the last frame, in seconds
+ */
+void Application::Simulate(const double dElapsedTime)
+{
+	// Call the cScene3D's Update method, which handles the input and the game events of this frame
+	cScene3D->Update(dElapsedTime);
+
+	// Step the simulation at a fixed rate
+	dAccumulator += (dElapsedTime < cSettings->dMaxFrameTime) ? dElapsedTime : cSettings->dMaxFrameTime;
+	while (dAccumulator >= cSettings->dFixedTimeStep)
+	{
+		cScene3D->FixedUpdate(cSettings->dFixedTimeStep);
+		dAccumulator -= cSettings->dFixedTimeStep;
+	}
+	cScene3D->SetInterpolation((float)(dAccumulator / cSettings->dFixedTimeStep));
 
-		// Frame rate limiter. Limits each frame to a specified time in ms.   
-		cStopWatch.WaitUntil(cSettings->frameTime);
+	// Copy what the rendering needs, so that the scene can be changed again while it is drawn
+	cScene3D->CaptureRenderState();
+}
+
+/**
+ @brief Start simulating a frame on the simulation thread
+ @param dElapsedTime A const double variable which contains the time of the last frame, in seconds
+ */
+void Application::StartSimulation(const double dElapsedTime)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxSimulation);
+		dSimulationTime = dElapsedTime;
+		bSimulationQueued = true;
+	}
+	cvSimulationQueued.notify_one();
+}
+
+/**
+ @brief Wait until the simulation thread has finished the frame which was started last
+ */
+void Application::WaitForSimulation(void)
+{
+	PROFILE_SCOPE("Wait for Simulation");
+
+	std::unique_lock<std::mutex> lock(mtxSimulation);
+	cvSimulationDone.wait(lock, [this] { return !bSimulationQueued; });
+}
+
+/**
+ @brief Simulate the frames which are queued by StartSimulation, until the thread is stopped
+ */
+void Application::SimulationThread(void)
+{
+	CProfiler::GetInstance()->SetThreadName("Simulation");
+
+	while (true)
+	{
+		double dElapsedTime = 0.0;
+		{
+			std::unique_lock<std::mutex> lock(mtxSimulation);
+			cvSimulationQueued.wait(lock, [this] { return bStopping || bSimulationQueued; });
+			if (bStopping)
+				return;
+			dElapsedTime = dSimulationTime;
+		}
+
+		Simulate(dElapsedTime);
+
+		{
+			std::lock_guard<std::mutex> lock(mtxSimulation);
+			bSimulationQueued = false;
+		}
+		cvSimulationDone.notify_one();
 	}
 }
 
@@ -289,6 +431,9 @@ void Application::Destroy(void)
 		cScene3D = NULL;
 	}
 
+	// Destroy the CProfiler instance
+	CProfiler::GetInstance()->Destroy();
+
 	//Close OpenGL window and terminate GLFW
 	glfwDestroyWindow(cSettings->pWindow);
 	//Finalize and clean up GLFW
@@ -326,6 +471,10 @@ CSoundController* Application::getSoundEngine()
  */
 Application::Application(void)
 	: cFPSCounter(NULL)
+	, dAccumulator(0.0)
+	, bSimulationQueued(false)
+	, bStopping(false)
+	, dSimulationTime(0.0)
 {
 }
 
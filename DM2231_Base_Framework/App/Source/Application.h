@@ -9,12 +9,18 @@
 #include "DesignPatterns\SingletonTemplate.h"
 
 #include "TimeControl\StopWatch.h"
+// Frame Pacer
+#include "TimeControl\FramePacer.h"
 
 // FPS Counter
 #include "TimeControl\FPSCounter.h"
 
 #include "Scene3D/Scene3D.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 struct GLFWwindow;
 
 class CSettings;
@@ -41,6 +47,8 @@ public:
 protected:
 	// Declare timer for calculating time per frame
 	CStopWatch cStopWatch;
+	// Declare the frame pacer which limits the frame rate
+	CFramePacer cFramePacer;
 
 	// The handler to the CSettings instance
 	CSettings* cSettings;
@@ -53,6 +61,19 @@ protected:
 
 	CSoundController* soundengine;
 
+	// The time which has passed but has not been simulated yet
+	double dAccumulator;
+
+	// The thread which simulates the next frame while this frame is rendered, when CSettings::bPipelinedUpdate is true
+	std::thread thrSimulation;
+	bool bSimulationQueued;
+	bool bStopping;
+	// The elapsed time which the queued frame is simulated by
+	double dSimulationTime;
+	std::mutex mtxSimulation;
+	std::condition_variable cvSimulationQueued;
+	std::condition_variable cvSimulationDone;
+
 	// Constructor
 	Application(void);
 
@@ -62,4 +83,13 @@ protected:
 	// Update input devices
 	void UpdateInputDevices(void);
 	void PostUpdateInputDevices(void);
+
+	// Simulate a frame, then capture the render state for it
+	void Simulate(const double dElapsedTime);
+	// Start simulating a frame on the simulation thread
+	void StartSimulation(const double dElapsedTime);
+	// Wait until the simulation thread has finished the frame
+	void WaitForSimulation(void);
+	// Simulate the frames which are queued, until the thread is stopped
+	void SimulationThread(void);
 };
@@ -25,17 +25,18 @@ CCSVWriter::~CCSVWriter()
 }
 
 /**
-@brief Write to a CSV file which contains column names
-@param filename A string containing the name of the input file
-@param vector<pair<string, vector<int>>> A vector containing pairs of string and vector which represents the tile map
-@return A vector<vector<int>> variable
+@brief Write to a CSV file which contains column names. The first row holds the names of the columns,
+		and each following row holds the next value of each column. A column which is shorter than the others is left empty.
+@param filename A string containing the name of the output file
+@param vector<pair<string, vector<int>>> A vector containing pairs of a column name and the values of that column
+@return true if the file was written, else false
 */
 bool CCSVWriter::write_csv_with_columnname(string filename, vector<pair<string, vector<int>>> vData)
 {
-	// The result of this CSV reading attempt
+	// The result of this CSV writing attempt
 	bool bResult = false;
 
-	// Create an input filestream
+	// Create an output filestream
 	ofstream myFile(filename, ios::out | ios::trunc);
 
 	// Make sure the file is open
@@ -44,15 +45,27 @@ bool CCSVWriter::write_csv_with_columnname(string filename, vector<pair<string,
 	// Write all data including the column names
 	if (myFile.good())
 	{
-		vector<pair<string, vector<int>>>::iterator iterRow;
-		for (iterRow = vData.begin(); iterRow != vData.end(); iterRow++)
+		// Write the column names, and find the longest column
+		size_t uNumOfRows = 0;
+		for (size_t iColumn = 0; iColumn < vData.size(); iColumn++)
+		{
+			if (iColumn > 0)
+				myFile << ",";
+			myFile << vData[iColumn].first;
+			if (vData[iColumn].second.size() > uNumOfRows)
+				uNumOfRows = vData[iColumn].second.size();
+		}
+		myFile << endl;
+
+		// Write the values row by row
+		for (size_t iRow = 0; iRow < uNumOfRows; iRow++)
 		{
-			vector<int>::iterator iterColumn;
-			for (iterColumn = iterRow->second.begin(); iterColumn != iterRow->second.end(); iterColumn++)
+			for (size_t iColumn = 0; iColumn < vData.size(); iColumn++)
 			{
-				myFile << *iterColumn;
-				if (iterColumn != iterRow->second.end())
+				if (iColumn > 0)
 					myFile << ",";
+				if (iRow < vData[iColumn].second.size())
+					myFile << vData[iColumn].second[iRow];
 			}
 			myFile << endl;
 		}
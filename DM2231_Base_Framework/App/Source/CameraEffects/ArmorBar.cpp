@@ -1,5 +1,7 @@
 #include "ArmorBar.h"
-#include "GL\glew.h"
+
+// Include SpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 #include <iostream>
 using namespace std;
@@ -16,10 +18,6 @@ CArmorBar::CArmorBar(void)
  */
 CArmorBar::~CArmorBar(void)
 {
-	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
 	cShader = NULL;
 }
@@ -30,13 +28,6 @@ CArmorBar::~CArmorBar(void)
  */
 bool CArmorBar::Init(glm::vec3 pos, glm::vec4 color)
 {
-	// Check if the shader is ready
-	if (!cShader)
-	{
-		cout << "CProgressBar::Init(): The shader is not available for this class instance." << endl;
-		return false;
-	}
-
 	// Call the parent's Init()
 	CEntity3D::Init();
 
@@ -50,33 +41,6 @@ bool CArmorBar::Init(glm::vec3 pos, glm::vec4 color)
 	vec3Position = pos;
 	vec4Colour = color;
 
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	float vertices[] = {
-		// positions		// texture coords
-		-fWidth,  fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		-fWidth, -fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		 fWidth, -fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		 fWidth, -fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		 fWidth,  fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		-fWidth,  fHeight, 0.0f, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-	};
-
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-
-	glBindVertexArray(VAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// texture coord attribute
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
 	return true;
 }
 
@@ -127,70 +91,25 @@ void CArmorBar::Update(const double dElapsedTime)
  */
 void CArmorBar::PreRender(void)
 {
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// The sprite batch sets up blending when it is flushed
 }
 
 /**
- @brief Render Render this instance
- @param cShader A Shader* variable which contains the Shader to use in this class instance
+ @brief Render Add this instance to the sprite batch
  */
 void CArmorBar::Render(void)
 {
-	// If the shader is in this class, then do not render
-	if (!cShader)
-	{
-		cout << "CProgressBar::Render(): The shader is not available for this class instance." << endl;
-		return;
-	}
-
-	// Activate shader
-	cShader->use();
-
-	unsigned int transformLoc;
-	// get matrix's uniform location and set matrix
-	transformLoc = glGetUniformLocation(cShader->ID, "transform");
-	// Reset the transform
-	transform = glm::mat4(1.0f);
-	// Translate to the position to render. Note that the centrepoint of the progressbar will be at this position
-	// So we need to offset to the right by the vec3Scale.x * fWidth
-	transform = glm::translate(transform, glm::vec3(vec3Position.x + vec3Scale.x * fWidth, vec3Position.y, vec3Position.z));
-	// Scale the size of the progressbar by vec3Scale. 
-	// Note that .y and .z should be 1.0f if you are not scaling them at all
-	transform = glm::scale(transform, vec3Scale);
-
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	// Render the quad
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-
-	// Reset to default
-	glBindVertexArray(0);
-
-	// get matrix's uniform location and set matrix
-	transformLoc = glGetUniformLocation(cShader->ID, "transform");
-	// Reset the transform
-	transform = glm::mat4(1.0f);
-	// Translate to the position to render. Note that the centrepoint of the progressbar will be at this position
-	// So we need to offset to the right by the vec3Scale.x * fWidth
-	transform = glm::translate(transform, glm::vec3(vec3Position.x + fWidth, vec3Position.y, vec3Position.z));
-
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	// Render the quad
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_LINE_LOOP, 0, 6);
-
-	// Reset to default
-	glBindVertexArray(0);
-
+	// The centrepoint of the bar is at vec3RenderPosition.x + vec3RenderScale.x * fWidth, so the bar starts at vec3RenderPosition.x
+	// and shrinks towards it. The outline is not scaled, so it shows the full length of the bar.
+	// The bars have always been drawn opaque, so the alpha of the colour is not used.
+	// The position and the scale are from the render state, as the scale is changed by the simulation.
+	CSpriteBatch* cSpriteBatch = CSpriteBatch::GetInstance();
+	cSpriteBatch->AddQuad(	glm::vec2(vec3RenderPosition.x, vec3RenderPosition.y - vec3RenderScale.y * fHeight),
+							glm::vec2(vec3RenderPosition.x + vec3RenderScale.x * fWidth * 2.0f, vec3RenderPosition.y + vec3RenderScale.y * fHeight),
+							glm::vec4(glm::vec3(vec4Colour), 1.0f));
+	cSpriteBatch->AddRectangle(	glm::vec2(vec3RenderPosition.x, vec3RenderPosition.y - fHeight),
+								glm::vec2(vec3RenderPosition.x + fWidth * 2.0f, vec3RenderPosition.y + fHeight),
+								glm::vec4(glm::vec3(vec4Colour), 1.0f));
 }
 
 /**
@@ -198,8 +117,6 @@ void CArmorBar::Render(void)
  */
 void CArmorBar::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 bool CArmorBar::GetArmorBarState()
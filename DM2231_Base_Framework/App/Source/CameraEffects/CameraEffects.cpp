@@ -1,5 +1,7 @@
 #include "CameraEffects.h"
-#include "GL\glew.h"
+
+// Include SpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 #include <iostream>
 using namespace std;
@@ -18,10 +20,6 @@ CCameraEffects::CCameraEffects(void)
  */
 CCameraEffects::~CCameraEffects(void)
 {
-	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
 	cShader = NULL;
 }
@@ -32,13 +30,6 @@ CCameraEffects::~CCameraEffects(void)
  */
 bool CCameraEffects::Init(void)
 {
-	// Check if the shader is ready
-	if (!cShader)
-	{
-		cout << "CCameraEffects::Init(): The shader is not available for this class instance." << endl;
-		return false;
-	}
-
 	// Call the parent's Init()
 	CEntity3D::Init();
 
@@ -47,44 +38,10 @@ bool CCameraEffects::Init(void)
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	float vertices[] = {
-		// positions			// texture coords
-		-1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-		-1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-		1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-
-		1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-		1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-		-1.0f, 1.0f, 0.0f, 0.0f, 1.0f
-	};
-
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-
-	glBindVertexArray(VAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// texture coord attribute
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
-	if ((VAO == 0) || (VBO == 0))
-	{
-		std::cout << "Unable to initialise CameraEffect" << std::endl;
-		return false;
-	}
-
-	// load and create a texture 
-	iTextureID = LoadTexture("Image/GUI/CameraEffects_Blood.tga");
-	if (iTextureID == 0)
+	// The blood screen is drawn from the GUI atlas
+	if (!CTextureAtlas::GetInstance()->HasRegion("CameraEffects_Blood"))
 	{
-		cout << "Unable to load Image/GUI/CameraEffects_Blood.tga" << endl;
+		cout << "CCameraEffects::Init(): Image/GUI/CameraEffects_Blood.tga is not in the GUI atlas" << endl;
 		return false;
 	}
 
@@ -167,53 +124,29 @@ void CCameraEffects::Update(const double dElapsedTime)
  */
 void CCameraEffects::PreRender(void)
 {
-	if (!bStatus_BloodScreen)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	// The sprite batch sets up blending when it is flushed
+}
 
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+/**
+ @brief Check if the BloodScreen is drawn
+ @return bStatus_BloodScreen value
+ */
+bool CCameraEffects::IsVisible(void) const
+{
+	return bStatus_BloodScreen;
 }
 
 /**
- @brief Render Render this instance
- @param cShader A Shader* variable which contains the Shader to use in this class instance
+ @brief Render Add this instance to the sprite batch
  */
 void CCameraEffects::Render(void)
 {
-	// If the shader is in this class, then do not render
-	if (!cShader)
-	{
-		cout << "CCameraEffects::Render(): The shader is not available for this class instance." << endl;
-		return;
-	}
-
-	// Activate shader
-	cShader->use();
-
-	if (!bStatus_BloodScreen)
+	// The status of the BloodScreen is checked by IsVisible when the render state is captured
+	if (!bRenderVisible)
 		return;
 
-	unsigned int transformLoc;
-	// get matrix's uniform location and set matrix
-	transformLoc = glGetUniformLocation(cShader->ID, "transform");
-
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the quad
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-
-	// Reset to default
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	// The blood screen covers the whole screen
+	CSpriteBatch::GetInstance()->AddSprite("CameraEffects_Blood", glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, 1.0f));
 }
 
 /**
@@ -221,9 +154,4 @@ void CCameraEffects::Render(void)
  */
 void CCameraEffects::PostRender(void)
 {
-	if (!bStatus_BloodScreen)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
 }
@@ -32,6 +32,8 @@ public:
 	virtual bool SetTimer_BloodScreen(const float fCountdownTimer_BloodScreen = 2.0f);
 	// Get Countdown Timer for BloodScreen
 	virtual float GetTimer_BloodScreen(void) const;
+	// Check if the BloodScreen is drawn
+	virtual bool IsVisible(void) const;
 
 	// Update this class instance
 	virtual void Update(const double dElapsedTime);
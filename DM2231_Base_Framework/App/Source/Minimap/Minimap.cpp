@@ -5,6 +5,9 @@
  */
 #include "Minimap.h"
 
+// Include SpriteBatch
+#include "RenderControl\SpriteBatch.h"
+
 #include <iostream>
 using namespace std;
 
@@ -21,13 +24,9 @@ CMinimap::CMinimap(void)
 CMinimap::~CMinimap(void)
 {
 	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &FBO);
-	glDeleteBuffers(1, &uiTextureColorBuffer);
-	glDeleteBuffers(1, &RBO);
-	glDeleteVertexArrays(1, &VAO_BORDER);
-	glDeleteBuffers(1, &VBO_BORDER);
+	glDeleteFramebuffers(1, &FBO);
+	glDeleteTextures(1, &uiTextureColorBuffer);
+	glDeleteRenderbuffers(1, &RBO);
 }
 
 /**
@@ -36,51 +35,18 @@ CMinimap::~CMinimap(void)
  */
 bool CMinimap::Init(void)
 {
-	// Check if the shader is ready
-	if (!cShader)
-	{
-		cout << "CMinimap::Init(): The shader is not available for this class instance." << endl;
-		return false;
-	}
-
 	// Call the parent's Init()
 	CEntity3D::Init();
 
 	// Set the type
 	SetType(CEntity3D::TYPE::OTHERS);
 
-	// Set screenTexture to 0 in the shader program
-	cShader->setInt("screenTexture", 0);
-
-	float vertices[] = 
-	{
-		// positions	// texCoords
-		0.5f, 1.0f,		0.0f, 1.0f,
-		0.5f, 0.5f,		0.0f, 0.0f,
-		1.0f, 0.5f,		1.0f, 0.0f,
-
-		0.5f, 1.0f,		0.0f, 1.0f,
-		1.0f, 0.5f,		1.0f, 0.0f,
-		1.0f, 1.0f,		1.0f, 1.0f
-	};
-
-	// Set up the rendering environment
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-
 	// Framebuffer configuration
 	glGenFramebuffers(1, &FBO);
-	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	GL()->BindFramebuffer(GL_FRAMEBUFFER, FBO);
 	// create a color attachment texture
 	glGenTextures(1, &uiTextureColorBuffer);
-	glBindTexture(GL_TEXTURE_2D, uiTextureColorBuffer);
+	GL()->BindTexture(GL_TEXTURE_2D, uiTextureColorBuffer);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, cSettings->iWindowWidth, cSettings->iWindowHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -94,29 +60,7 @@ bool CMinimap::Init(void)
 	// now that we actually created the FBO and added all attachments we want to check if it is actually complete now
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << endl;
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-	// Setup the border
-	float vertices_border[] =
-	{
-		// positions	// texCoords
-		0.5f, 1.0f,		0.0f, 1.0f,
-		0.5f, 0.5f,		0.0f, 0.0f,
-		1.0f, 0.5f,		1.0f, 0.0f,
-		1.0f, 1.0f,		1.0f, 1.0f
-	};
-
-	// Set up the rendering environment
-	glGenVertexArrays(1, &VAO_BORDER);
-	glGenBuffers(1, &VBO_BORDER);
-	glBindVertexArray(VAO_BORDER);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO_BORDER);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices_border), &vertices_border, GL_STATIC_DRAW);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-
+	GL()->BindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	return true;
 }
@@ -154,7 +98,7 @@ void CMinimap::SetProjection(glm::mat4 projection)
 void CMinimap::Activate(void)
 {
 	// Start rendering the framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	GL()->BindFramebuffer(GL_FRAMEBUFFER, FBO);
 }
 
 /**
@@ -163,7 +107,7 @@ void CMinimap::Activate(void)
 void CMinimap::Deactivate(void)
 {
 	// Stop rendering the framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GL()->BindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 /**
@@ -179,41 +123,20 @@ void CMinimap::Update(const double dElapsedTime)
 void CMinimap::PreRender(void)
 {
 	// Clear the framebuffer's content and display a pale green background
-	glClearColor(0.0f, 0.5f, 0.0f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	GL()->ClearColor(0.0f, 0.5f, 0.0f, 1.0f);
+	GL()->Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 /**
- @brief Render Render this instance
- @param cShader A Shader* variable which contains the Shader to use in this class instance
+ @brief Render Add the minimap and its border to the sprite batch
  */
 void CMinimap::Render(void)
 {
-	// If the shader is in this class, then do not render
-	if (!cShader)
-	{
-		cout << "CMinimap::Render(): The shader is not available for this class instance." << endl;
-		return;
-	}
-
-	// Activate shader
-	cShader->use();
-
-	// Render the texture for the minimap
-	glBindVertexArray(VAO);
-	// Use the color attachment texture as the texture of the quad plane
-	glBindTexture(GL_TEXTURE_2D, uiTextureColorBuffer);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	// Reset to default
-	glBindTexture(GL_TEXTURE_2D, 0);
-	glBindVertexArray(0);
-
+	CSpriteBatch* cSpriteBatch = CSpriteBatch::GetInstance();
+	// Use the color attachment texture as the texture of the quad in the top right corner
+	cSpriteBatch->AddTexturedQuad(uiTextureColorBuffer, glm::vec2(0.5f, 0.5f), glm::vec2(1.0f, 1.0f));
 	// Render the border
-	glBindVertexArray(VAO_BORDER);
-	glDrawArrays(GL_LINE_LOOP, 0, 4);
-	// Reset to default
-	glBindVertexArray(0);
-
+	cSpriteBatch->AddRectangle(glm::vec2(0.5f, 0.5f), glm::vec2(1.0f, 1.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
 }
 
 /**
@@ -23,7 +23,6 @@ public:
 	unsigned int FBO;
 	unsigned int uiTextureColorBuffer;
 	unsigned int RBO;
-	unsigned int VAO_BORDER, VBO_BORDER;
 
 	// Initialise this class instance
 	bool Init(void);
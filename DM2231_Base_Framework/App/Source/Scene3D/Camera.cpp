@@ -89,6 +89,27 @@ glm::mat4 CCamera::GetViewMatrix(void) const
 	return glm::lookAt(vec3Position, vec3Position + vec3Front, vec3Up);
 }
 
+/**
+ @brief Returns the view matrix for another position and Euler Angles, without changing this camera.
+		The vectors are calculated in the same way as UpdateCameraVectors(), but the pitch is not constrained.
+ @param vec3Position A const glm::vec3 variable which contains the position of the view
+ @param fYaw A const float variable which contains the yaw of the view
+ @param fPitch A const float variable which contains the pitch of the view
+ @return A glm::mat4 variable which contains the view matrix
+ */
+glm::mat4 CCamera::GetViewMatrix(const glm::vec3 vec3Position, const float fYaw, const float fPitch) const
+{
+	glm::vec3 front;
+	front.x = cos(glm::radians(fYaw)) * cos(glm::radians(fPitch));
+	front.y = sin(glm::radians(fPitch));
+	front.z = sin(glm::radians(fYaw)) * cos(glm::radians(fPitch));
+	front = glm::normalize(front);
+	glm::vec3 right = glm::normalize(glm::cross(front, vec3WorldUp));
+	glm::vec3 up = glm::normalize(glm::cross(right, front));
+
+	return glm::lookAt(vec3Position, vec3Position + front, up);
+}
+
 /**
 @brief Returns the Perspective Matrix
 @return A glm::mat4 variable which contains the Perspective matrix
@@ -51,6 +51,8 @@ public:
 
     // Returns the view matrix calculated using Euler Angles and the LookAt Matrix
 	glm::mat4 GetViewMatrix(void) const;
+	// Returns the view matrix for another position and Euler Angles, without changing this camera
+	glm::mat4 GetViewMatrix(const glm::vec3 vec3Position, const float fYaw, const float fPitch) const;
 	// Returns the Perspective Matrix
 	glm::mat4 GetPerspectiveMatrix(void) const;
 
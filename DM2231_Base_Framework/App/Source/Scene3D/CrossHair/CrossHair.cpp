@@ -1,5 +1,7 @@
 #include "CrossHair.h"
-#include "GL\glew.h"
+
+// Include SpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 #include <iostream>
 using namespace std;
@@ -17,10 +19,6 @@ CCrossHair::CCrossHair(void)
  */
 CCrossHair::~CCrossHair(void)
 {
-	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
 	cShader = NULL;
 }
@@ -31,13 +29,6 @@ CCrossHair::~CCrossHair(void)
  */
 bool CCrossHair::Init(void)
 {
-	// Check if the shader is ready
-	if (!cShader)
-	{
-		cout << "CCrossHair::Init(): The shader is not available for this class instance." << endl;
-		return false;
-	}
-
 	// Call the parent's Init()
 	CEntity3D::Init();
 
@@ -46,53 +37,16 @@ bool CCrossHair::Init(void)
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 
-	float fAspectRatio = (float)cSettings->iWindowWidth / (float)cSettings->iWindowHeight;
-
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	float vertices[] = {
-		// positions			// texture coords
-		-1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-		-1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-		1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-
-		1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-		1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-		-1.0f, 1.0f, 0.0f, 0.0f, 1.0f
-	};
-
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-
-	glBindVertexArray(VAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// texture coord attribute
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
-	if ((VAO == 0) || (VBO == 0))
+	// The crosshairs are drawn from the GUI atlas
+	CTextureAtlas* cTextureAtlas = CTextureAtlas::GetInstance();
+	if (!cTextureAtlas->HasRegion("CrossHair_Pistol"))
 	{
-		std::cout << "Unable to initialise CameraEffect" << std::endl;
+		cout << "CCrossHair::Init(): Image/GUI/CrossHair_Pistol.tga is not in the GUI atlas" << endl;
 		return false;
 	}
-
-	// load and create a texture 
-	iTextureID = LoadTexture("Image/pistol.tga");
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene3D_CrossHair.tga" << endl;
-		return false;
-	}	
-
-	RifleID = LoadTexture("Image/ogcrosshair.tga");
-	if (RifleID == 0)
+	if (!cTextureAtlas->HasRegion("CrossHair_Rifle"))
 	{
-		cout << "bruh no texture" << endl;
+		cout << "CCrossHair::Init(): Image/GUI/CrossHair_Rifle.tga is not in the GUI atlas" << endl;
 		return false;
 	}
 
@@ -153,61 +107,27 @@ void CCrossHair::Update(const double dElapsedTime)
  */
 void CCrossHair::PreRender(void)
 {
-	if (!bActive)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// The sprite batch sets up blending when it is flushed
 }
 
 /**
- @brief Render Render this instance
- @param cShader A Shader* variable which contains the Shader to use in this class instance
+ @brief Render Add this instance to the sprite batch
+ @param info A CWeaponInfo* variable which contains the weapon which the player is holding
  */
 void CCrossHair::Render(CWeaponInfo* info)
 {
 	if (!bActive)
 		return;
 
-	// If the shader is in this class, then do not render
-	if (!cShader)
-	{
-		cout << "CCrossHair::Render(): The shader is not available for this class instance." << endl;
-		return;
-	}
-
-	// Activate shader
-	cShader->use();
-
-	unsigned int transformLoc;
-	// get matrix's uniform location and set matrix
-	transformLoc = glGetUniformLocation(cShader->ID, "transform");
-
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
+	// The crosshair images cover the whole screen
 	if (info->type == CWeaponInfo::WeaponType::PISTOL)
 	{
-		// Get the texture to be rendered
-		glBindTexture(GL_TEXTURE_2D, iTextureID);
+		CSpriteBatch::GetInstance()->AddSprite("CrossHair_Pistol", glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, 1.0f));
 	}
 	else if (info->type == CWeaponInfo::WeaponType::RIFLE)
 	{
-		// Get the texture to be rendered
-		glBindTexture(GL_TEXTURE_2D, RifleID);
+		CSpriteBatch::GetInstance()->AddSprite("CrossHair_Rifle", glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, 1.0f));
 	}
-
-	// Render the quad
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-
-	// Reset to default
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 /**
@@ -215,9 +135,4 @@ void CCrossHair::Render(CWeaponInfo* info)
  */
 void CCrossHair::PostRender(void)
 {
-	if (!bActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
 }
@@ -5,8 +5,8 @@
  */
 #include "EnemyBoss3D.h"
 
-// Allowing loading of LoadOBJ.h
-#include "System/LoadOBJ.h"
+// Include MeshManager
+#include "System/MeshManager.h"
 
 #include <iostream>
 using namespace std;
@@ -84,10 +84,6 @@ CEnemyBoss3D::~CEnemyBoss3D(void)
 		// We set it to NULL only since it was declared somewhere else
 		cCamera = NULL;
 	}
-
-	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
 }
 
 /**
@@ -112,40 +108,15 @@ bool CEnemyBoss3D::Init(void)
 	// Initialise the cPlayer3D
 	cPlayer3D = CPlayer3D::GetInstance();
 
-	std::vector<glm::vec3> vertices;
-	std:: vector <glm::vec2> uvs;
-	std::vector<glm::vec3> normals;
-
 	vec3Scale = glm::vec3(0.125, 0.125, 0.125);
 	vec3ColliderScale = glm::vec3(1.5, 4, 1.5);
 
-	std::string file_path = "OBJ//boss2.obj";
-	bool success = LoadOBJ(file_path.c_str(), vertices, uvs, normals);
-	if (!success)
-		return NULL;
-	std::vector <Vertex> vertex_buffer_data;
-	std::vector <GLuint> index_buffer_data;
-	IndexVBO(vertices, uvs, normals, index_buffer_data, vertex_buffer_data);
-
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &IBO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint),&index_buffer_data[0], GL_STATIC_DRAW);
-	index_buffer_size = index_buffer_data.size();
-
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec3)));
+	// Load the mesh, which is shared with the other instances using the same OBJ file
+	if (LoadMesh("OBJ//boss2.obj") == false)
+	{
+		cout << "CEnemyBoss3D::Init(): Unable to load OBJ//boss2.obj" << endl;
+		return false;
+	}
 
 	// load and create a texture 
 	iTextureID = LoadTexture("Image/boss2.tga");
@@ -315,7 +286,7 @@ void CEnemyBoss3D::ActivateCollider(Shader* cLineShader)
 void CEnemyBoss3D::PreRender(void)
 {
 	// Draw this as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /**
@@ -335,14 +306,14 @@ void CEnemyBoss3D::Render(void)
 	cShader->use();
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	GL()->ActiveTexture(GL_TEXTURE0);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
 
 	// create transformations
 	model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	//model = glm::rotate(model, (float)glfwGetTime()/10.0f, glm::vec3(0.0f, 0.0f, 1.0f));
-	model = glm::translate(model, vec3Position);
-	model = glm::scale(model, vec3Scale);
+	model = glm::translate(model, GetRenderPosition());
+	model = glm::scale(model, vec3RenderScale);
 
 	// note: currently we set the projection matrix each frame, but since the projection 
 	// matrix rarely changes it's often best practice to set it outside the main loop only once.
@@ -350,27 +321,14 @@ void CEnemyBoss3D::Render(void)
 	cShader->setMat4("view", view);
 	cShader->setMat4("model", model);
 
-	// render boxes
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glDrawElements(GL_TRIANGLES, index_buffer_size, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glDrawElements(GL_TRIANGLES, index_buffer_size, GL_UNSIGNED_INT, 0);
-
-	glDisableVertexAttribArray(1);
-	glDisableVertexAttribArray(0);
+	// render the shared mesh
+	CMeshManager::GetInstance()->Draw(cMesh);
 
 	// Render the CCollider if needed
 	if ((cCollider) && (cCollider->bIsDisplayed))
 	{
 		model = glm::mat4(1.0f);
-		model = glm::translate(model, vec3Position);
+		model = glm::translate(model, GetRenderPosition());
 		model = glm::scale(model, vec3ColliderScale);
 
 		cCollider->model = model;
@@ -385,7 +343,7 @@ void CEnemyBoss3D::Render(void)
 */
 void CEnemyBoss3D::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
 
 int CEnemyBoss3D::get_enemyHealth()
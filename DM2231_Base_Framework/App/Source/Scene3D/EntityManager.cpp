@@ -2,6 +2,9 @@
 
 #include "../Application.h"
 
+// Include Profiler
+#include "System\Profiler.h"
+
 #include <iostream>
 using namespace std;
 
@@ -12,6 +15,7 @@ CEntityManager::CEntityManager(void)
 	: model(glm::mat4(1.0f))
 	, view(glm::mat4(1.0f))
 	, projection(glm::mat4(1.0f))
+	, cOcclusionCuller(NULL)
 	, enemy_deathCount(0)
 {
 }
@@ -29,6 +33,7 @@ CEntityManager::~CEntityManager(void)
 		delete *it;
 		it = lEntity3D.erase(it);
 	}
+	DeleteRemoved();
 }
 
 /**
@@ -39,11 +44,12 @@ bool CEntityManager::Init(void)
 	//enemyHealth = 8;
 	enemy_deathCount = 0;
 
+	// The sound controller is initialised by CScene3D, so that the audio engine is only created once
 	cSoundController = CSoundController::GetInstance();
-	cSoundController->Init();
 	//cSoundController->LoadSound("../Sounds/damage.ogg", 1);
 
 	lEntity3D.clear();
+	mEmitters.clear();
 	return true;
 }
 
@@ -79,7 +85,13 @@ void CEntityManager::SetProjection(glm::mat4 projection)
 */
 void CEntityManager::Add(CEntity3D* cEntity3D)
 {
+	// Start the interpolation at where the CEntity3D is added, so that it is not drawn moving in from elsewhere
+	cEntity3D->StoreStateForInterpolation();
 	lEntity3D.push_back(cEntity3D);
+
+	// The NPCs and projectiles carry a sound emitter, which the sound controller moves with them every frame
+	if ((cEntity3D->GetType() == CEntity3D::TYPE::NPC) || (cEntity3D->GetType() == CEntity3D::TYPE::PROJECTILE))
+		mEmitters[cEntity3D] = cSoundController->AddEmitter(cEntity3D);
 }
 
 /**
@@ -93,8 +105,11 @@ bool CEntityManager::Erase(CEntity3D* cEntity3D)
 	// Delete the entity if found
 	if (findIter != lEntity3D.end())
 	{
-		// Delete the CEntity3D
-		delete *findIter;
+		// Stop the sound emitters from following the CEntity3D
+		cSoundController->RemoveEmitters(*findIter);
+		mEmitters.erase(*findIter);
+		// Delete the CEntity3D once the rendering no longer uses it
+		vRemoved.push_back(*findIter);
 		// Go to the next iteration after erasing from the list
 		findIter = lEntity3D.erase(findIter);
 		return true;
@@ -126,7 +141,7 @@ bool CEntityManager::CollisionCheck(CEntity3D* cEntity3D)
 				cout << "** Collision between Player and NPC ***" << endl;
 				bResult = true;
 				
-				//cSoundController->PlaySoundByID(1);
+				//cSoundController->PlaySoundByID(SOUND_DAMAGE);
 
 				static_cast<CHealthBar*>(cHealthBar)->SetHealthBarState(true);
 				static_cast<CArmorBar*>(cArmorBar)->SetArmorBarState(true);
@@ -148,7 +163,7 @@ bool CEntityManager::CollisionCheck(CEntity3D* cEntity3D)
 				// Rollback the cEntity3D's position
 				cEntity3D->RollbackPosition();
 
-				//cSoundController->PlaySoundByID(2);
+				//cSoundController->PlaySoundByID(SOUND_WALLBUMP);
 
 				cout << "** Collision between Player and Structure ***" << endl;
 				bResult = true;
@@ -165,6 +180,8 @@ bool CEntityManager::CollisionCheck(CEntity3D* cEntity3D)
  */
 void CEntityManager::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("CEntityManager::Update");
+
 	std::list<CEntity3D*>::iterator it, end;
 	std::list<CEntity3D*>::iterator it_other;
 
@@ -175,6 +192,9 @@ void CEntityManager::Update(const double dElapsedTime)
 		(*it)->Update(dElapsedTime);
 	}
 
+	// The collision checks are timed as a zone of their own, until the end of the update
+	PROFILE_SCOPE("CEntityManager::Collisions");
+
 	// Check for collisions among them
 	end = lEntity3D.end();
 	for (it = lEntity3D.begin(); it != end; ++it)
@@ -203,6 +223,7 @@ void CEntityManager::Update(const double dElapsedTime)
 
 					(*it_other)->SetToDelete(true);
 					cout << "** Collision between NPC and Projectile ***" << endl;
+					PlaySoundAtEntity(SOUND_DAMAGE, *it);
 
 					static_cast<CEnemy3D*>(*it)->set_enemyHealth(static_cast<CEnemy3D*>(*it)->get_enemyHealth() - 1);
 				}
@@ -222,6 +243,7 @@ void CEntityManager::Update(const double dElapsedTime)
 					}
 
 					cout << "** Collision between NPC and Projectile ***" << endl;
+					PlaySoundAtEntity(SOUND_DAMAGE, *it_other);
 
 					static_cast<CEnemy3D*>(*it)->set_enemyHealth(static_cast<CEnemy3D*>(*it)->get_enemyHealth() - 1);
 				}
@@ -231,6 +253,7 @@ void CEntityManager::Update(const double dElapsedTime)
 					(*it)->SetToDelete(true);
 					(*it_other)->SetToDelete(true);
 					cout << "** Collision between 2 Projectiles ***" << endl;
+					PlaySoundAtEntity(SOUND_WALLBUMP, *it);
 				}
 				else if (((*it)->GetType() == CEntity3D::TYPE::NPC) &&
 					((*it_other)->GetType() == CEntity3D::TYPE::NPC))
@@ -258,6 +281,19 @@ void CEntityManager::Update(const double dElapsedTime)
 	}
 }
 
+/**
+ @brief Play a 3D sound at the sound emitter of a CEntity3D, so that the sound moves with it.
+		Nothing is played if the CEntity3D has no emitter.
+ @param ID A const int variable which contains the ID of the sound
+ @param cEntity3D A const CEntity3D* variable which contains the CEntity3D
+ */
+void CEntityManager::PlaySoundAtEntity(const int ID, const CEntity3D* cEntity3D)
+{
+	std::map<const CEntity3D*, int>::iterator it = mEmitters.find(cEntity3D);
+	if (it != mEmitters.end())
+		cSoundController->PlaySoundAtEmitter(ID, it->second);
+}
+
 /**
  @brief CleanUp all CEntity3Ds which are marked for deletion
  */
@@ -270,8 +306,11 @@ void CEntityManager::CleanUp(void)
 	{
 		if ((*it)->IsToDelete())
 		{
-			// Delete the CEntity3D
-			delete *it;
+			// Stop the sound emitters from following the CEntity3D
+			cSoundController->RemoveEmitters(*it);
+			mEmitters.erase(*it);
+			// Delete the CEntity3D once the rendering no longer uses it
+			vRemoved.push_back(*it);
 			// Go to the next iteration after erasing from the list
 			it = lEntity3D.erase(it);
 		}
@@ -284,21 +323,96 @@ void CEntityManager::CleanUp(void)
 }
 
 /**
- @brief Render this class instance
+ @brief Store the positions of all CEntity3Ds before a simulation step, which the rendering interpolates from
  */
-void CEntityManager::Render(void)
+void CEntityManager::StoreStateForInterpolation(void)
 {
-	// Render all entities
 	std::list<CEntity3D*>::iterator it, end;
 	end = lEntity3D.end();
 	for (it = lEntity3D.begin(); it != end; ++it)
+		(*it)->StoreStateForInterpolation();
+}
+
+/**
+ @brief Copy the render state of all CEntity3Ds, at the end of a simulation update
+ @param vEntities A std::vector<CRenderState::EntityState>& variable which the render states are copied into
+ */
+void CEntityManager::CaptureRenderState(std::vector<CRenderState::EntityState>& vEntities)
+{
+	vEntities.resize(lEntity3D.size());
+	std::list<CEntity3D*>::iterator it, end;
+	end = lEntity3D.end();
+	unsigned int i = 0;
+	for (it = lEntity3D.begin(); it != end; ++it, ++i)
+		vEntities[i].Capture(*it);
+}
+
+/**
+ @brief Delete the CEntity3Ds which were removed. The render state which is drawn may still hold them until the next one is published,
+		so this is called after the render states are swapped.
+ */
+void CEntityManager::DeleteRemoved(void)
+{
+	for (unsigned int i = 0; i < vRemoved.size(); i++)
+		delete vRemoved[i];
+	vRemoved.clear();
+}
+
+/**
+ @brief Render the CEntity3Ds in a render state. Their render states have been set from it already,
+		so the culling uses the bounds at the interpolated positions which they are drawn at.
+ @param vEntities A const std::vector<CRenderState::EntityState>& variable which contains the render states
+ */
+void CEntityManager::Render(const std::vector<CRenderState::EntityState>& vEntities)
+{
+	PROFILE_SCOPE("CEntityManager::Render");
+
+	glm::vec3 vec3BoundsMin, vec3BoundsMax;
+
+	// Draw the structures into the occlusion culler's depth buffer, so that the entities behind them can be skipped
+	bool bOcclusionCulling = (cOcclusionCuller) && (cOcclusionCuller->IsEnabled());
+	if (bOcclusionCulling)
 	{
-		(*it)->SetView(view);
-		(*it)->SetProjection(projection);
-		(*it)->PreRender();
-		(*it)->Render();
-		(*it)->PostRender();
+		cOcclusionCuller->Begin(projection * view);
+		for (unsigned int i = 0; i < vEntities.size(); i++)
+		{
+			if ((vEntities[i].eType != CEntity3D::TYPE::STRUCTURE) || (!vEntities[i].bVisible))
+				continue;
+			vEntities[i].pEntity->GetRenderBounds(vec3BoundsMin, vec3BoundsMax);
+			cOcclusionCuller->AddOccluder(vec3BoundsMin, vec3BoundsMax);
+		}
 	}
+
+	// Render all entities
+	for (unsigned int i = 0; i < vEntities.size(); i++)
+	{
+		const CRenderState::EntityState& sEntity = vEntities[i];
+		if (!sEntity.bVisible)
+			continue;
+
+		// The structures are the occluders, so they are not tested against themselves
+		if ((bOcclusionCulling) && (sEntity.eType != CEntity3D::TYPE::STRUCTURE))
+		{
+			sEntity.pEntity->GetRenderBounds(vec3BoundsMin, vec3BoundsMax);
+			if (cOcclusionCuller->IsVisible(vec3BoundsMin, vec3BoundsMax) == false)
+				continue;
+		}
+
+		sEntity.pEntity->SetView(view);
+		sEntity.pEntity->SetProjection(projection);
+		sEntity.pEntity->PreRender();
+		sEntity.pEntity->Render();
+		sEntity.pEntity->PostRender();
+	}
+}
+
+/**
+ @brief Set the occlusion culler which hides the entities behind the structures
+ @param cOcclusionCuller A COcclusionCuller* variable which contains the occlusion culler, or NULL to draw every entity
+ */
+void CEntityManager::SetOcclusionCuller(COcclusionCuller* cOcclusionCuller)
+{
+	this->cOcclusionCuller = cOcclusionCuller;
 }
 
 int CEntityManager::get_enemy_deathCount()
@@ -6,6 +6,9 @@
 // Include Entity3D
 #include <Primitives/Entity3D.h>
 
+// Include OcclusionCuller
+#include <RenderControl/OcclusionCuller.h>
+
 // Include GLM
 #include <includes/glm.hpp>
 #include <includes/gtc/matrix_transform.hpp>
@@ -13,6 +16,8 @@
 
 // Include list
 #include <list>
+#include <map>
+#include <vector>
 
 #include "Enemy3D.h"
 #include "EnemyBoss3D.h"
@@ -21,6 +26,9 @@
 
 #include "../SoundController/SoundController.h"
 
+// Include RenderState
+#include "RenderState.h"
+
 class CEntityManager : public CSingletonTemplate<CEntityManager>
 {
 	friend class CSingletonTemplate<CEntityManager>;
@@ -49,9 +57,19 @@ public:
 
 	// CleanUp all CEntity3Ds which are marked for deletion
 	virtual void CleanUp(void);
+	// Delete the CEntity3Ds which were removed, once the rendering no longer uses them
+	virtual void DeleteRemoved(void);
+
+	// Store the positions of all CEntity3Ds before a simulation step, which the rendering interpolates from
+	virtual void StoreStateForInterpolation(void);
+	// Copy the render state of all CEntity3Ds
+	virtual void CaptureRenderState(std::vector<CRenderState::EntityState>& vEntities);
 
-	// Render this class instance
-	virtual void Render(void);
+	// Render the CEntity3Ds in a render state
+	virtual void Render(const std::vector<CRenderState::EntityState>& vEntities);
+
+	// Set the occlusion culler which hides the entities behind the structures, or NULL to draw every entity
+	virtual void SetOcclusionCuller(COcclusionCuller* cOcclusionCuller);
 
 	int get_enemy_deathCount();
 	void set_enemy_deathCount(int x);
@@ -68,6 +86,10 @@ protected:
 
 	// List of CEntity3D
 	std::list<CEntity3D*> lEntity3D;
+	// The sound emitters of the NPCs and projectiles, so that their sounds move with them
+	std::map<const CEntity3D*, int> mEmitters;
+	// The CEntity3Ds which were removed from lEntity3D, but may still be in the render state which is drawn
+	std::vector<CEntity3D*> vRemoved;
 
 	//CEnemy3D* cEnemy3D;
 
@@ -78,8 +100,14 @@ protected:
 
 	CSoundController* cSoundController;
 
+	// Handler to the occlusion culler
+	COcclusionCuller* cOcclusionCuller;
+
 	int enemy_deathCount;
 
+	// Play a 3D sound at the sound emitter of a CEntity3D
+	void PlaySoundAtEntity(const int ID, const CEntity3D* cEntity3D);
+
 	// Default Constructor
 	CEntityManager(void);
 	// Destructor
@@ -9,8 +9,8 @@
 #include <includes\gtc\matrix_transform.hpp>
 
 #include <iostream>
-// Include ImageLoader
-#include "System\ImageLoader.h"
+// Include TextureManager
+#include "System\TextureManager.h"
 
 // Constructor
 CGroundMap::CGroundMap(void)
@@ -39,6 +39,18 @@ CGroundMap::~CGroundMap(void)
 		}
 	}
 
+	// Release the textures which were acquired from the CTextureManager. The ground tiles only borrow them.
+	if (iTextureID_01 != 0)
+	{
+		CTextureManager::GetInstance()->Release(iTextureID_01);
+		iTextureID_01 = 0;
+	}
+	if (iTextureID_02 != 0)
+	{
+		CTextureManager::GetInstance()->Release(iTextureID_02);
+		iTextureID_02 = 0;
+	}
+
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
 	cShader = NULL;
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
@@ -204,7 +216,7 @@ bool CGroundMap::ReCalculate(void)
 void CGroundMap::PreRender(void)
 {
 	// draw skybox as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /**
@@ -242,7 +254,7 @@ void CGroundMap::Render(void)
 void CGroundMap::PostRender(void)
 {
 	// Set depth function back to default
-	glDepthFunc(GL_LESS);
+	GL()->DepthFunc(GL_LESS);
 }
 
 /**
@@ -270,52 +282,14 @@ glm::vec3 CGroundMap::GetExactPosition(glm::vec3 vec3Position)
 }
 
 /**
-@brief Load a texture
+@brief Load a texture through the CTextureManager, so the tiles which use the same file share one OpenGL texture.
+	   The texture is released in the destructor.
 @param filename A const char* variable which contains the file name of the texture
+@param iTextureID A GLuint& variable which returns the texture ID
 @return An bool value where true means it is successfully loaded, otherwise false
 */
-bool CGroundMap::LoadTexture(const char* filename, GLuint& iTextureID_01)
+bool CGroundMap::LoadTexture(const char* filename, GLuint& iTextureID)
 {
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-
-	// The texture ID
-	//GLuint iNewTextureID;
-
-	// Generate a texture ID
-	glGenTextures(1, &iTextureID_01);
-	// Set this texture ID to be a GL_TEXTURE_2D
-	glBindTexture(GL_TEXTURE_2D, iTextureID_01);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	// Get the image loader singleton instance
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-
-	// Load the image from the file
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
-	{
-		// Check if it has alpha channel (nrChannels == 4) or none (nrChannels == 3)
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		return false;
-	}
-
-	// Free up the memory of the file data read in
-	free(data);
-
-	return true;
+	iTextureID = CTextureManager::GetInstance()->Acquire(filename);
+	return (iTextureID != 0);
 }
@@ -25,6 +25,9 @@ CGroundTile::CGroundTile(void)
  */
 CGroundTile::~CGroundTile(void)
 {
+	// The texture is shared from the CGroundMap, which holds the reference from the CTextureManager.
+	// The tiles are copied into the map's vectors, so they must not release it in CEntity3D's destructor.
+	iTextureID = 0;
 }
 
 /**
@@ -62,10 +65,10 @@ bool CGroundTile::Init(void)
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 
-	glBindVertexArray(VAO);
+	GL()->BindVertexArray(VAO);
 
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
 	// position attribute
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
@@ -145,7 +148,7 @@ void CGroundTile::Update(const double dElapsedTime)
 void CGroundTile::PreRender(void)
 {
 	// Draw ground tile as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /**
@@ -165,8 +168,8 @@ void CGroundTile::Render(void)
 	cShader->use();
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	GL()->ActiveTexture(GL_TEXTURE0);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
 
 	// create transformations
 	model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
@@ -181,8 +184,8 @@ void CGroundTile::Render(void)
 	cShader->setMat4("model", model);
 
 	// render container
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
+	GL()->BindVertexArray(VAO);
+	GL()->DrawArrays(GL_TRIANGLES, 0, 6);
 }
 
 /**
@@ -190,7 +193,7 @@ void CGroundTile::Render(void)
  */
 void CGroundTile::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
 
 /**
@@ -19,12 +19,13 @@ CPlayer3D::CPlayer3D(void)
 	, fPitch(0.0f)
 	, fMouseSensitivity(0.1f)
 	, cCamera(NULL)
+	, fRenderYaw(-90.0f)
 	, cGroundMap(NULL)
 	, cPrimaryWeapon(NULL)
 	, cSecondaryWeapon(NULL)
 	, iCurrentWeapon(0)
 	, fCameraSwayAngle(0.0f)
-	, fCameraSwayDeltaAngle(0.15f)
+	, fCameraSwayDeltaAngle(9.0f)
 	, bCameraSwayDirection(false)	// false = left, true = right
 	, bCameraSwayActive(true)
 {
@@ -53,12 +54,13 @@ CPlayer3D::CPlayer3D(	const glm::vec3 vec3Position,
 	, fPitch(fPitch)
 	, fMouseSensitivity(0.1f)
 	, cCamera(NULL)
+	, fRenderYaw(fYaw)
 	, cGroundMap(NULL)
 	, cPrimaryWeapon(NULL)
 	, cSecondaryWeapon(NULL)
 	, iCurrentWeapon(0)
 	, fCameraSwayAngle(0.0f)
-	, fCameraSwayDeltaAngle(0.5f)
+	, fCameraSwayDeltaAngle(30.0f)
 	, bCameraSwayDirection(false)	// false = left, true = right
 	, bCameraSwayActive(true)
 {
@@ -172,10 +174,10 @@ bool CPlayer3D::Init(void)
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 
-	glBindVertexArray(VAO);
+	GL()->BindVertexArray(VAO);
 
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
 	// position attribute
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
@@ -423,7 +425,7 @@ void CPlayer3D::Update(const double dElapsedTime)
 
 		if (bCameraSwayDirection == false)	// Sway to left
 		{
-			fCameraSwayAngle -= fCameraSwayDeltaAngle;
+			fCameraSwayAngle -= fCameraSwayDeltaAngle * (float)dElapsedTime;
 			if (fCameraSwayAngle < fCameraSwayAngle_LeftLimit)
 			{
 				fCameraSwayAngle = fCameraSwayAngle_LeftLimit;
@@ -432,7 +434,7 @@ void CPlayer3D::Update(const double dElapsedTime)
 		}
 		else if (bCameraSwayDirection == true)	// Sway to right
 		{
-			fCameraSwayAngle += fCameraSwayDeltaAngle;
+			fCameraSwayAngle += fCameraSwayDeltaAngle * (float)dElapsedTime;
 			if (fCameraSwayAngle > fCameraSwayAngle_RightLimit)
 			{
 				fCameraSwayAngle = fCameraSwayAngle_RightLimit;
@@ -450,7 +452,25 @@ void CPlayer3D::Update(const double dElapsedTime)
 void CPlayer3D::PreRender(void)
 {
 	// Draw ground tile as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+}
+
+/**
+ @brief Check if the player is drawn. It is not drawn when the camera is attached to it.
+ @return true if the player is drawn, else false
+ */
+bool CPlayer3D::IsVisible(void) const
+{
+	return (cCamera == NULL) && (CEntity3D::IsVisible());
+}
+
+/**
+ @brief Set the yaw to render at, from the render state which the simulation published
+ @param fRenderYaw A const float variable which contains the yaw, in degrees
+ */
+void CPlayer3D::SetRenderYaw(const float fRenderYaw)
+{
+	this->fRenderYaw = fRenderYaw;
 }
 
 /**
@@ -458,8 +478,8 @@ void CPlayer3D::PreRender(void)
  */
 void CPlayer3D::Render(void)
 {
-	// Don't render the player if the camera is attached to it
-	if (cCamera)
+	// Don't render the player if the camera is attached to it, which IsVisible checked when the render state was captured
+	if (!bRenderVisible)
 		return;
 
 	// If the shader is in this class, then do not render
@@ -473,14 +493,14 @@ void CPlayer3D::Render(void)
 	cShader->use();
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	GL()->ActiveTexture(GL_TEXTURE0);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
 
 	// create transformations
 	model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	model = glm::translate(model, glm::vec3(vec3Position.x, vec3Position.y, vec3Position.z));
-	model = glm::scale(model, vec3Scale);
-	model = glm::rotate(model, glm::radians(fYaw), glm::vec3(0.0f, 1.0f, 0.0f));
+	model = glm::translate(model, GetRenderPosition());
+	model = glm::scale(model, vec3RenderScale);
+	model = glm::rotate(model, glm::radians(fRenderYaw), glm::vec3(0.0f, 1.0f, 0.0f));
 
 	// note: currently we set the projection matrix each frame, but since the projection 
 	// matrix rarely changes it's often best practice to set it outside the main loop only once.
@@ -489,8 +509,8 @@ void CPlayer3D::Render(void)
 	cShader->setMat4("model", model);
 
 	// render boxes
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 36);
+	GL()->BindVertexArray(VAO);
+	GL()->DrawArrays(GL_TRIANGLES, 0, 36);
 
 	// Render the CCollider if needed
 	if ((cCollider) && (cCollider->bIsDisplayed))
@@ -508,7 +528,7 @@ void CPlayer3D::Render(void)
  */
 void CPlayer3D::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
 
 /**
@@ -587,8 +607,8 @@ void CPlayer3D::UpdateJumpFall(const double dElapsedTime)
 	}
 	else if (cPhysics3D.GetStatus() == CPhysics3D::STATUS::FALL)
 	{
-		// Update the elapsed time to the physics engine
-		cPhysics3D.AddElapsedTime(0.1f);
+		// Update the elapsed time to the physics engine, sped up so that the fall is as quick as it was tuned to be
+		cPhysics3D.AddElapsedTime((float)dElapsedTime * fFallTimeScale);
 		// Call the physics engine update method to calculate the final velocity and displacement
 		cPhysics3D.Update();
 		// Get the displacement from the physics engine and update the player position
@@ -105,9 +105,16 @@ public:
 	// PostRender
 	virtual void PostRender(void);
 
+	// Check if the player is drawn. It is not drawn when the camera is attached to it.
+	virtual bool IsVisible(void) const;
+	// Set the yaw to render at, from the render state
+	void SetRenderYaw(const float fRenderYaw);
+
 protected:
 	// The handle to the CCamera class instance
 	CCamera* cCamera;
+	// The yaw which the rendering uses
+	float fRenderYaw;
 
 	// The handle to the CGroundMap class instance
 	CGroundMap* cGroundMap;
@@ -119,6 +126,7 @@ protected:
 
 	// Player/Camera Sway
 	float fCameraSwayAngle; 
+	// The speed of the sway, in degrees per second
 	float fCameraSwayDeltaAngle; 
 	// The limits for left and right sway 
 	const float fCameraSwayAngle_LeftLimit = -2.0f, fCameraSwayAngle_RightLimit = 2.0f;
@@ -128,6 +136,8 @@ protected:
 
 	// Physics
 	CPhysics3D cPhysics3D;
+	// How much faster than real time the physics runs when falling. The fall was tuned at 0.1 s of physics time per frame at 60 fps.
+	const float fFallTimeScale = 6.0f;
 
 	// Default Constructor
 	CPlayer3D(void);
@@ -0,0 +1,79 @@
+#include "RenderState.h"
+
+/**
+ @brief Copy the state of an entity, at the end of a simulation update
+ @param pEntity A CEntity3D* variable which contains the entity
+ */
+void CRenderState::EntityState::Capture(CEntity3D* pEntity)
+{
+	this->pEntity = pEntity;
+	eType = pEntity->GetType();
+	vec3StatePosition = pEntity->GetStatePosition();
+	vec3Position = pEntity->GetPosition();
+	vec3Scale = pEntity->GetScale();
+	bVisible = pEntity->IsVisible();
+}
+
+/**
+ @brief Set the render state of the entity, before it is drawn
+ @param fInterpolation A const float variable which contains how far the rendering is from the last simulation step to the current one
+ */
+void CRenderState::EntityState::Apply(const float fInterpolation) const
+{
+	pEntity->SetRenderState(glm::mix(vec3StatePosition, vec3Position, fInterpolation), vec3Scale, bVisible);
+}
+
+/**
+ @brief Constructor
+ */
+CRenderState::CRenderState(void)
+	: iReadFrame(0)
+{
+	for (int i = 0; i < 2; i++)
+	{
+		asFrames[i].fInterpolation = 1.0f;
+		asFrames[i].vec3CameraStatePosition = glm::vec3(0.0f);
+		asFrames[i].vec3CameraPosition = glm::vec3(0.0f);
+		asFrames[i].fCameraYaw = 0.0f;
+		asFrames[i].fCameraPitch = 0.0f;
+		asFrames[i].fCameraZoom = 45.0f;
+		asFrames[i].fPlayerYaw = 0.0f;
+		asFrames[i].pWeapon = NULL;
+		asFrames[i].iMagRound = 0;
+		asFrames[i].iMaxMagRound = 0;
+	}
+}
+
+/**
+ @brief Destructor
+ */
+CRenderState::~CRenderState(void)
+{
+}
+
+/**
+ @brief Get the frame which the simulation captures into
+ @return A Frame& of the write buffer
+ */
+CRenderState::Frame& CRenderState::GetWriteFrame(void)
+{
+	return asFrames[1 - iReadFrame];
+}
+
+/**
+ @brief Get the frame which the rendering draws
+ @return A const Frame& of the read buffer
+ */
+const CRenderState::Frame& CRenderState::GetReadFrame(void) const
+{
+	return asFrames[iReadFrame];
+}
+
+/**
+ @brief Swap the frames, so that the frame which was captured last is drawn. Neither the simulation nor the rendering
+		may be using the frames when this is called.
+ */
+void CRenderState::Publish(void)
+{
+	iReadFrame = 1 - iReadFrame;
+}
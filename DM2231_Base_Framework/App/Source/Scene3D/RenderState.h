@@ -0,0 +1,82 @@
+#pragma once
+
+// Include Entity3D
+#include <Primitives/Entity3D.h>
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+
+class CWeaponInfo;
+
+// A double-buffered copy of what the rendering needs from the simulation: the transforms and the visibility of the entities,
+// the camera and the values which the HUD shows. The simulation captures a frame into the write buffer at the end of each update,
+// while the rendering draws the read buffer, so that the two can run on different threads at the same time.
+// The buffers are swapped by Publish, which is only called when neither of them is in use.
+class CRenderState
+{
+public:
+	// The render state of an entity
+	struct EntityState
+	{
+		CEntity3D* pEntity;
+		CEntity3D::TYPE eType;
+		// The position at the last simulation step and the current one, which are interpolated between
+		glm::vec3 vec3StatePosition;
+		glm::vec3 vec3Position;
+		glm::vec3 vec3Scale;
+		bool bVisible;
+
+		// Copy the state of an entity. This is called by the simulation.
+		void Capture(CEntity3D* pEntity);
+		// Set the render state of the entity, interpolated by fInterpolation. This is called by the rendering.
+		void Apply(const float fInterpolation) const;
+	};
+
+	// Everything which is drawn in a frame
+	struct Frame
+	{
+		// How far the rendering is from the last simulation step to the current one, from 0 to 1
+		float fInterpolation;
+
+		// The camera
+		glm::vec3 vec3CameraStatePosition;
+		glm::vec3 vec3CameraPosition;
+		float fCameraYaw;
+		float fCameraPitch;
+		float fCameraZoom;
+
+		// The player
+		EntityState sPlayer;
+		float fPlayerYaw;
+
+		// The entities of the CEntityManager
+		std::vector<EntityState> vEntities;
+
+		// The HUD
+		EntityState sHealthBar;
+		EntityState sArmorBar;
+		EntityState sCameraEffects;
+		CWeaponInfo* pWeapon;
+		int iMagRound;
+		int iMaxMagRound;
+	};
+
+	// Constructor
+	CRenderState(void);
+	// Destructor
+	~CRenderState(void);
+
+	// Get the frame which the simulation captures into
+	Frame& GetWriteFrame(void);
+	// Get the frame which the rendering draws
+	const Frame& GetReadFrame(void) const;
+	// Swap the frames, so that the frame which was captured last is drawn
+	void Publish(void);
+
+protected:
+	// The two frames, and the index of the one which is drawn
+	Frame asFrames[2];
+	int iReadFrame;
+};
@@ -20,6 +20,21 @@ using namespace std;
 #include "Structure3D_2.h"
 #include "WeaponInfo/Rifle.h"
 
+// Include LoadOBJ
+#include "System\LoadOBJ.h"
+// Include MeshOptimizer
+#include "System\MeshOptimizer.h"
+
+// Include CSVWriter
+#include "..\CSVWriter\CSVWriter.h"
+
+/**
+ Boolean macro to benchmark the mesh import when the scene starts. The OBJ parser is timed against
+ the line-by-line parser which it replaced, and the ACMR of every model is reported.
+	0=Off, 1=On
+ */
+#define _BENCHMARK_MESH_IMPORT 0
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -28,14 +43,24 @@ CScene3D::CScene3D(void)
 	, cShader(NULL)
 	, cSimpleShader(NULL)
 	, cTextRenderer(NULL)
-	, cGUIShader(NULL)
-	, cGUISimpleShader(NULL)
-	, cRenderToTextureShader(NULL)
+	, cStreamBuffer(NULL)
+	, cShaderCache(NULL)
+	, cDebugDraw(NULL)
+	, cRenderGraph(NULL)
+	, cTextureAtlas(NULL)
+	, cSpriteBatch(NULL)
+	, cOcclusionCuller(NULL)
+	, cGLDispatch(NULL)
+	, cGLRecordingBackend(NULL)
+	, cSpriteShader(NULL)
 	, cKeyboardController(NULL)
 	, cMouseController(NULL)
 	, cJoystickController(NULL)
 	, cFPSCounter(NULL)
 	, cSoundController(NULL)
+	, cTextureManager(NULL)
+	, cMeshManager(NULL)
+	, cAssetLoader(NULL)
 	, cEntityManager(NULL)
 	, cPlayer3D(NULL)
 	, cCamera(NULL)
@@ -50,6 +75,10 @@ CScene3D::CScene3D(void)
 	, printLoseScreen(false)
 	, printWinScreen(false)
 	, bossDED(false)
+	, vec3CameraStatePosition(0.0f)
+	, fInterpolation(1.0f)
+	, bShowProfiler(false)
+	, bPipelined(false)
 {
 }
 
@@ -156,20 +185,56 @@ CScene3D::~CScene3D(void)
 		cTextRenderer = NULL;
 	}
 
-	if (cRenderToTextureShader)
+	if (cRenderGraph)
+	{
+		cRenderGraph->Destroy();
+		cRenderGraph = NULL;
+	}
+
+	if (cOcclusionCuller)
+	{
+		cOcclusionCuller->Destroy();
+		cOcclusionCuller = NULL;
+	}
+
+	// Switch back to the driver backend before the recording backend is deleted
+	if (cGLDispatch)
+		cGLDispatch->SetBackend(NULL);
+	if (cGLRecordingBackend)
+	{
+		delete cGLRecordingBackend;
+		cGLRecordingBackend = NULL;
+	}
+
+	if (cDebugDraw)
+	{
+		cDebugDraw->Destroy();
+		cDebugDraw = NULL;
+	}
+
+	if (cSpriteBatch)
+	{
+		cSpriteBatch->Destroy();
+		cSpriteBatch = NULL;
+	}
+
+	if (cTextureAtlas)
 	{
-		delete cRenderToTextureShader;
-		cRenderToTextureShader = NULL;
+		cTextureAtlas->Destroy();
+		cTextureAtlas = NULL;
 	}
-	if (cGUISimpleShader)
+
+	// Destroy the cStreamBuffer after the text, line and sprite batches which draw from it
+	if (cStreamBuffer)
 	{
-		delete cGUISimpleShader;
-		cGUISimpleShader = NULL;
+		cStreamBuffer->Destroy();
+		cStreamBuffer = NULL;
 	}
-	if (cGUIShader)
+
+	if (cSpriteShader)
 	{
-		delete cGUIShader;
-		cGUIShader = NULL;
+		delete cSpriteShader;
+		cSpriteShader = NULL;
 	}
 	if (groundShader)
 	{
@@ -199,11 +264,46 @@ CScene3D::~CScene3D(void)
 		cShader = NULL;
 	}
 
+	// Destroy the cShaderCache after the shaders which were loaded through it
+	if (cShaderCache)
+	{
+		cShaderCache->Destroy();
+		cShaderCache = NULL;
+	}
+
+	// Destroy the cGLDispatch after everything which renders through it
+	if (cGLDispatch)
+	{
+		cGLDispatch->Destroy();
+		cGLDispatch = NULL;
+	}
+
 	if (cWeaponInfo)
 	{
 		cWeaponInfo = NULL;
 	}
 
+	// Destroy the cAssetLoader before the caches which it loads into
+	if (cAssetLoader)
+	{
+		cAssetLoader->Destroy();
+		cAssetLoader = NULL;
+	}
+
+	// Destroy the cMeshManager after all the entities have released their meshes
+	if (cMeshManager)
+	{
+		cMeshManager->Destroy();
+		cMeshManager = NULL;
+	}
+
+	// Destroy the cTextureManager after all the entities have released their textures
+	if (cTextureManager)
+	{
+		cTextureManager->Destroy();
+		cTextureManager = NULL;
+	}
+
 	// We won't delete this since it was created elsewhere
 	cSettings = NULL;
 }
@@ -218,9 +318,42 @@ bool CScene3D::Init(void)
 
 	srand(time(NULL));
 
+	// The per-frame OpenGL calls are made through the cGLDispatch. The recording backend counts the calls
+	// of each frame and passes them on to the driver, and is only used when it is switched on.
+	cGLDispatch = CGLDispatch::GetInstance();
+	cGLRecordingBackend = new CGLRecordingBackend(cGLDispatch->GetDriverBackend());
+
 	// configure global opengl state
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_CULL_FACE);
+	GL()->Enable(GL_DEPTH_TEST);
+	GL()->Enable(GL_CULL_FACE);
+
+	// Initialise the texture cache, so entities which use the same image share one texture
+	cTextureManager = CTextureManager::GetInstance();
+	cTextureManager->Init();
+
+	// Initialise the mesh registry, so entities which use the same OBJ file share one set of buffers
+	cMeshManager = CMeshManager::GetInstance();
+	cMeshManager->Init();
+
+	// Start decoding the textures and meshes of the entities on the worker threads, while the shaders are compiled below.
+	// Only the uploads are left for the main thread, and the entities then find their assets in the caches.
+	cAssetLoader = CAssetLoader::GetInstance();
+	cAssetLoader->Init();
+	cAssetLoader->RequestMesh("OBJ//boss2.obj");
+	cAssetLoader->RequestMesh("OBJ//enemy2.obj");
+	cAssetLoader->RequestMesh("OBJ/box2.obj");
+	cAssetLoader->RequestMesh("OBJ/pillar.obj");
+	cAssetLoader->RequestTexture("Image/boss2.tga");
+	cAssetLoader->RequestTexture("Image/enemy2.tga");
+	cAssetLoader->RequestTexture("Image/Scene3D_Player.tga");
+	cAssetLoader->RequestTexture("Image/structure.tga");
+	cAssetLoader->RequestTexture("Image/structure2.tga");
+	cAssetLoader->RequestTexture("Image/pillar.tga");
+
+	// Initialise the program binary cache, so that the shaders are only compiled when their sources or the driver change
+	cAssetLoader->BeginPhase("shaders");
+	cShaderCache = CShaderCache::GetInstance();
+	cShaderCache->Init();
 
 	// Setup the shaders
 	cShader = new Shader("Shader//Scene3D.vs", "Shader//Scene3D.fs");
@@ -233,11 +366,45 @@ bool CScene3D::Init(void)
 	// Setup the shaders
 	groundShader = new Shader("Shader//Ground.vs", "Shader//Ground.fs");
 	// Setup the shaders
-	cGUIShader = new Shader("Shader//GUIShader.vs", "Shader//GUIShader.fs");
-	// Setup the shaders
-	cGUISimpleShader = new Shader("Shader//GUISimpleShader.vs", "Shader//GUISimpleShader.fs");
-	// Setup the shaders
-	cRenderToTextureShader = new Shader("Shader//RenderToTexture.vs", "Shader//RenderToTexture.fs");
+	cSpriteShader = new Shader("Shader//Sprite.vs", "Shader//Sprite.fs");
+
+	// Save the binaries of the shaders which were compiled from source, for the next run
+	cShaderCache->Save();
+	cAssetLoader->EndPhase();
+	cShaderCache->PrintStats();
+
+	// Upload the assets as the worker threads finish decoding them
+	if (cAssetLoader->Finish() == false)
+	{
+		cout << "Failed to load the assets" << endl;
+		return false;
+	}
+	cAssetLoader->PrintTimeline();
+#if _BENCHMARK_MESH_IMPORT
+	// Time the OBJ parsers on the two largest models
+	BenchmarkLoadOBJ("OBJ//ball.obj", 10);
+	BenchmarkLoadOBJ("OBJ//boss2.obj", 10);
+	// Report the ACMR of every model before and after it is optimised
+	const char* cModels[] = { "OBJ//ball.obj", "OBJ//boss.obj", "OBJ//boss2.obj", "OBJ//box2.obj",
+							  "OBJ//enemy.obj", "OBJ//enemy2.obj", "OBJ//man.obj", "OBJ//pillar.obj" };
+	for (int i = 0; i < sizeof(cModels) / sizeof(cModels[0]); i++)
+		ReportMeshOptimisation(cModels[i]);
+#endif
+	// The boss assets were loaded by the cAssetLoader above and are kept in the caches,
+	// so that spawning the bosses during the game does not load any files
+
+	// Initialise the streaming vertex buffer, which the text, line and sprite batches write into every frame
+	cStreamBuffer = CStreamBuffer::GetInstance();
+	if (cStreamBuffer->Init() == false)
+	{
+		cout << "Failed to initialise the CStreamBuffer" << endl;
+		return false;
+	}
+
+	// Initialise the line batch which draws the colliders
+	cDebugDraw = CDebugDraw::GetInstance();
+	cDebugDraw->SetShader(cSimpleShader);
+	cDebugDraw->Init();
 
 	// Configure the camera
 	cCamera = CCamera::GetInstance();
@@ -261,25 +428,48 @@ bool CScene3D::Init(void)
 	cSoundController = CSoundController::GetInstance();
 	cSoundController->Init();
 
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\damage.ogg"), 1, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\wallbump.ogg"), 2, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\pistolshot.ogg"), 3, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\rifle.ogg"), 4, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\losesound.ogg"), 5, true, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\winsound.ogg"), 6, true, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\bossmusic.ogg"), 7, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\pistolreload.ogg"), 8, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\riflereload.ogg"), 9, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\damage.ogg"), SOUND_DAMAGE, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\wallbump.ogg"), SOUND_WALLBUMP, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\pistolshot.ogg"), SOUND_PISTOL_SHOT, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\rifle.ogg"), SOUND_RIFLE_SHOT, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\losesound.ogg"), SOUND_LOSE, true, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\winsound.ogg"), SOUND_WIN, true, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\bossmusic.ogg"), SOUND_BOSS_MUSIC, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\pistolreload.ogg"), SOUND_PISTOL_RELOAD, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\riflereload.ogg"), SOUND_RIFLE_RELOAD, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), SOUND_DUD, true);
+
+	// Set the priorities of the sounds, and how many of each can play at once. The music is never stolen by the gunfire.
+	cSoundController->SetSoundPriority(SOUND_LOSE, 10, 1);
+	cSoundController->SetSoundPriority(SOUND_WIN, 10, 1);
+	cSoundController->SetSoundPriority(SOUND_BOSS_MUSIC, 10, 1);
+	cSoundController->SetSoundPriority(SOUND_DAMAGE, 5, 2);
+	cSoundController->SetSoundPriority(SOUND_PISTOL_RELOAD, 4, 1);
+	cSoundController->SetSoundPriority(SOUND_RIFLE_RELOAD, 4, 1);
+	cSoundController->SetSoundPriority(SOUND_PISTOL_SHOT, 2, 3);
+	cSoundController->SetSoundPriority(SOUND_RIFLE_SHOT, 2, 4);
+	cSoundController->SetSoundPriority(SOUND_WALLBUMP, 1, 2);
 
 	// Initialise the EntityManager
 	cEntityManager = CEntityManager::GetInstance();
 	cEntityManager->Init();
 
+	// Initialise the occlusion culler, so that the entities which are hidden behind the walls and pillars are not drawn
+	cOcclusionCuller = COcclusionCuller::GetInstance();
+	if (cOcclusionCuller->Init() == false)
+	{
+		cout << "Failed to initialise the COcclusionCuller" << endl;
+		return false;
+	}
+	cEntityManager->SetOcclusionCuller(cOcclusionCuller);
+
 	// Initialise the cPlayer3D
 	cPlayer3D = CPlayer3D::GetInstance();
 	cPlayer3D->SetShader(cShader);
 	cPlayer3D->Init();
 	cPlayer3D->AttachCamera(cCamera);
+	cPlayer3D->StoreStateForInterpolation();
+	vec3CameraStatePosition = cCamera->vec3Position;
 	//cPlayer3D->SetScale(glm::vec3(0.5f));
 	cPlayer3D->ActivateCollider(cSimpleShader);
 	// Assign a cPistol to the cPlayer3D
@@ -436,48 +626,71 @@ bool CScene3D::Init(void)
 		return false;
 	}
 
+	// Pack the images in the GUI folder into one texture, so that the HUD can be drawn with a single texture
+	cTextureAtlas = CTextureAtlas::GetInstance();
+	cTextureAtlas->Init();
+	if ((cTextureAtlas->AddFolder("Image/GUI") == false) ||
+		(cTextureAtlas->Build() == false))
+	{
+		cout << "Failed to build the GUI atlas" << endl;
+		return false;
+	}
+
+	// Initialise the sprite batch which draws the HUD
+	cSpriteBatch = CSpriteBatch::GetInstance();
+	cSpriteBatch->SetShader(cSpriteShader);
+	cSpriteBatch->SetAtlas(cTextureAtlas);
+	cSpriteBatch->Init();
+
 	// Load the CameraEffects
 	cCameraEffects = CCameraEffects::GetInstance();
-	// Set a shader to this class instance of CameraEffects
-	cCameraEffects->SetShader(cGUIShader);
 	cCameraEffects->Init();
 
 	// Load the ProgressBar
 	cHealthBar = new CHealthBar();
-	// Set a shader to this class instance of CameraEffects
-	cHealthBar->SetShader(cGUISimpleShader);
 	cHealthBar->Init(glm::vec3(- 1.0f + 0.0333f, -1.0f + 0.0333f * 58, 0.0f), glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
 
 	cEntityManager->SetHealthBar(cHealthBar);
 
 	// Load the ProgressBar
 	cArmorBar = new CArmorBar();
-	// Set a shader to this class instance of CameraEffects
-	cArmorBar->SetShader(cGUISimpleShader);
 	cArmorBar->Init(glm::vec3(-1.0f + 0.0333f, -1.1f + 0.0333f * 58, 0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 0.5f));
 
 	cEntityManager->SetArmorBar(cArmorBar);
 
 	// Load the Minimap
 	cMinimap = CMinimap::GetInstance();
-	// Set a shader to this class instance of Minimap
-	cMinimap->SetShader(cRenderToTextureShader);
 	cMinimap->Init();
 
 	// Load the cCrossHair
 	cCrossHair = CCrossHair::GetInstance();
-	// Set a shader to this class instance of CameraEffects
-	cCrossHair->SetShader(cGUIShader);
 	cCrossHair->Init();
 
+	// Declare the render passes. The minimap pass is skipped when its overlay is switched off.
+	cRenderGraph = CRenderGraph::GetInstance();
+	cRenderGraph->Init();
+	cRenderGraph->AddTarget("minimap", cMinimap->FBO);
+	cRenderGraph->AddPass("Minimap", "minimap", std::vector<std::string>(), [this]() { RenderMinimapPass(); });
+	cRenderGraph->AddPass("Main", CRenderGraph::BACKBUFFER, std::vector<std::string>(), [this]() { RenderMainPass(); });
+	cRenderGraph->AddPass("HUD", CRenderGraph::BACKBUFFER, std::vector<std::string>(), [this]() { RenderHUDPass(); });
+	cRenderGraph->AddPass("MinimapOverlay", CRenderGraph::BACKBUFFER, std::vector<std::string>(1, "minimap"), [this]() { RenderMinimapOverlayPass(); });
+
+	// Print the texture cache, GUI atlas, mesh registry and sound statistics
+	cTextureManager->PrintStats();
+	cTextureAtlas->PrintStats();
+	cMeshManager->PrintStats();
+	cSoundController->PrintStats();
+
 	return true;
 }
 
 /**
-@brief Update Update this instance
+@brief Update Update this instance once per frame. The input and the game events are handled here; the simulation is stepped in FixedUpdate.
 */
 void CScene3D::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("CScene3D::Update");
+
 	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_0))
 	{
 		if (cPlayer3D->IsCameraAttached())
@@ -491,63 +704,96 @@ void CScene3D::Update(const double dElapsedTime)
 	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_9))
 	{
 		// Toggle the crosshair on or off
-		if (cCrossHair->GetStatus() == false)
-			cCrossHair->SetStatus(true);
-		else
-			cCrossHair->SetStatus(false);
+		RunOnMainThread([this]() {
+			if (cCrossHair->GetStatus() == false)
+				cCrossHair->SetStatus(true);
+			else
+				cCrossHair->SetStatus(false);
+		});
 		
 		// Reset the key so that it will not repeat until the key is released and pressed again
 		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_9);
 	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_8))
+	{
+		// Print the timings of the render passes in the last frames, then toggle the minimap on or off.
+		// When it is off, the minimap is not rendered at all.
+		RunOnMainThread([this]() {
+			cRenderGraph->PrintTimings();
+			cRenderGraph->SetPassEnabled("MinimapOverlay", !cRenderGraph->IsPassEnabled("MinimapOverlay"));
+		});
 
-	if (printLoseScreen == true || printWinScreen == true)
+		// Reset the key so that it will not repeat until the key is released and pressed again
+		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_8);
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_7))
 	{
-		cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), 1, true);
-		cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), 2, true);
-		cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), 3, true);
-		cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), 4, true);
-		cSoundController->LoadSound(FileSystem::getPath("Sounds\\dud.ogg"), 7, true);
+		// Print what the occlusion culler did in the last frame, then toggle it on or off
+		RunOnMainThread([this]() {
+			cOcclusionCuller->PrintStats();
+			cOcclusionCuller->SetEnabled(!cOcclusionCuller->IsEnabled());
+		});
+
+		// Reset the key so that it will not repeat until the key is released and pressed again
+		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_7);
 	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_6))
+	{
+		// Toggle the recording of the OpenGL calls on or off. The counts of the last frame are printed when it is switched off.
+		RunOnMainThread([this]() {
+			if (cGLDispatch->GetBackend() == cGLRecordingBackend)
+			{
+				cGLRecordingBackend->PrintStats();
+				cGLDispatch->SetBackend(NULL);
+			}
+			else
+				cGLDispatch->SetBackend(cGLRecordingBackend);
+		});
 
-	// Store the current position, if rollback is needed.
-	cPlayer3D->StorePositionForRollback();
+		// Reset the key so that it will not repeat until the key is released and pressed again
+		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_6);
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_5))
+	{
+		// Toggle the profiler and its summary on or off
+		RunOnMainThread([this]() {
+			bShowProfiler = !CProfiler::GetInstance()->IsEnabled();
+			CProfiler::GetInstance()->SetEnabled(bShowProfiler);
+		});
+
+		// Reset the key so that it will not repeat until the key is released and pressed again
+		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_5);
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_4))
+	{
+		// Save the zones which the profiler has collected, to be opened in chrome://tracing, and the frame times of the last frames
+		RunOnMainThread([this]() {
+			CProfiler::GetInstance()->ExportChromeTrace("profile.json");
+			SaveFrameStats();
+		});
+
+		// Reset the key so that it will not repeat until the key is released and pressed again
+		CKeyboardController::GetInstance()->ResetKey(GLFW_KEY_4);
+	}
+
+	// Silence the gameplay sounds on the win or lose screen, by binding them to dud.ogg which was loaded in Init
+	if (printLoseScreen == true || printWinScreen == true)
+	{
+		cSoundController->BindSound(SOUND_DAMAGE, SOUND_DUD);
+		cSoundController->BindSound(SOUND_WALLBUMP, SOUND_DUD);
+		cSoundController->BindSound(SOUND_PISTOL_SHOT, SOUND_DUD);
+		cSoundController->BindSound(SOUND_RIFLE_SHOT, SOUND_DUD);
+		cSoundController->BindSound(SOUND_BOSS_MUSIC, SOUND_DUD);
+	}
 
 	// Update the joystick
 	cJoystickController->Update(cJoystickController->GetJoystickID());
 
-	// Get keyboard updates for player3D
-	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_W))
-		|| (cJoystickController->IsJoystickActivated(CJoystickController::FORWARD)))
-		cPlayer3D->ProcessMovement(CPlayer3D::FORWARD, (float)dElapsedTime);
-	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_S))
-		|| (cJoystickController->IsJoystickActivated(CJoystickController::BACKWARD)))
-		cPlayer3D->ProcessMovement(CPlayer3D::BACKWARD, (float)dElapsedTime);
-	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_A))
-		|| (cJoystickController->IsJoystickActivated(CJoystickController::LEFT)))
-		cPlayer3D->ProcessMovement(CPlayer3D::LEFT, (float)dElapsedTime);
-	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_D))
-		|| (cJoystickController->IsJoystickActivated(CJoystickController::RIGHT)))
-		cPlayer3D->ProcessMovement(CPlayer3D::RIGHT, (float)dElapsedTime);
-	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_W) && CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_LEFT_SHIFT))
-		|| (cJoystickController->IsJoystickActivated(CJoystickController::FORWARD)))
-		cPlayer3D->ProcessMovement(CPlayer3D::SPRINT, (float)dElapsedTime);
+	// Get keyboard updates for jumping
 	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_SPACE))
 		|| (cJoystickController->IsButtonDown(0))) // Button 0 is the A button on the GamePad
 		cPlayer3D->SetToJump();
 
-	// Get keyboard updates for camera
-	if (!cPlayer3D->IsCameraAttached())
-	{
-		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_I))
-			cCamera->ProcessKeyboard(CCamera::FORWARD, (float)dElapsedTime);
-		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_K))
-			cCamera->ProcessKeyboard(CCamera::BACKWARD, (float)dElapsedTime);
-		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_J))
-			cCamera->ProcessKeyboard(CCamera::LEFT, (float)dElapsedTime);
-		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_L))
-			cCamera->ProcessKeyboard(CCamera::RIGHT, (float)dElapsedTime);
-	}
-
 	if (cPlayer3D->IsCameraAttached())
 	{
 		// Get mouse updates
@@ -573,11 +819,11 @@ void CScene3D::Update(const double dElapsedTime)
 	{
 		if (cWeaponInfo->type == CWeaponInfo::WeaponType::PISTOL)
 		{
-			//cSoundController->PlaySoundByID(8);
+			//cSoundController->PlaySoundByID(SOUND_PISTOL_RELOAD);
 		}
 		else
 		{
-			//cSoundController->PlaySoundByID(9);
+			//cSoundController->PlaySoundByID(SOUND_RIFLE_RELOAD);
 		}
 
 		cPlayer3D->GetWeapon()->Reload();
@@ -587,27 +833,30 @@ void CScene3D::Update(const double dElapsedTime)
 	if ((cMouseController->IsButtonReleased(CMouseController::BUTTON_TYPE::LMB))
 		|| (cJoystickController->IsButtonDown(2))) // Button 2 is the X button on the GamePad
 	{
-		// Try to create a projectile using the primary weapon, 0
-		CProjectile* cProjectile = cPlayer3D->DischargeWeapon();
-		if (cWeaponInfo->type == CWeaponInfo::WeaponType::PISTOL)
-		{
-			if (cWeaponInfo->GetMagRound() > 0)
+		// The projectile creates its OpenGL objects, so it is created on the main thread
+		RunOnMainThread([this]() {
+			// Try to create a projectile using the primary weapon, 0
+			CProjectile* cProjectile = cPlayer3D->DischargeWeapon();
+			if (cWeaponInfo->type == CWeaponInfo::WeaponType::PISTOL)
 			{
-				cCamera->fPitch = 90;
-				cCamera->fYaw = 90;
-				//cSoundController->PlaySoundByID(3);
+				if (cWeaponInfo->GetMagRound() > 0)
+				{
+					cCamera->fPitch = 90;
+					cCamera->fYaw = 90;
+					//cSoundController->PlaySoundByID(SOUND_PISTOL_SHOT);
+				}
 			}
-		}
-		else
-		{
-			if (cWeaponInfo->GetMagRound() > 0)
+			else
 			{
-				//cSoundController->PlaySoundByID(4);
+				if (cWeaponInfo->GetMagRound() > 0)
+				{
+					//cSoundController->PlaySoundByID(SOUND_RIFLE_SHOT);
+				}
 			}
-		}
-		// If the projectile was successfully created then add to the EntityManager
-		if (cProjectile)
-			cEntityManager->Add(cProjectile);
+			// If the projectile was successfully created then add to the EntityManager
+			if (cProjectile)
+				cEntityManager->Add(cProjectile);
+		});
 	}
 	else if (cMouseController->IsButtonDown(CMouseController::BUTTON_TYPE::RMB))
 	{
@@ -626,27 +875,30 @@ void CScene3D::Update(const double dElapsedTime)
 
 	if (renderBoss == true)
 	{
-		//cSoundController->PlaySoundByID(7);
-		//cSoundController->VolumeDecrease(7);
+		//cSoundController->PlaySoundByID(SOUND_BOSS_MUSIC);
+		//cSoundController->VolumeDecrease(SOUND_BOSS_MUSIC);
 
-		CEnemyBoss3D* cEnemyBoss3D = new CEnemyBoss3D(glm::vec3(4.f, 40.f, -4.f));
+		// The bosses and the rifle load their models and create their OpenGL objects, so they are created on the main thread
+		RunOnMainThread([this]() {
+			CEnemyBoss3D* cEnemyBoss3D = new CEnemyBoss3D(glm::vec3(4.f, 40.f, -4.f));
 
-		cEnemyBoss3D->SetShader(cShader);
-		cEnemyBoss3D->Init();
-		cEnemyBoss3D->ActivateCollider(cSimpleShader);
-		cEntityManager->Add(cEnemyBoss3D);
+			cEnemyBoss3D->SetShader(cShader);
+			cEnemyBoss3D->Init();
+			cEnemyBoss3D->ActivateCollider(cSimpleShader);
+			cEntityManager->Add(cEnemyBoss3D);
 
-		CEnemyBoss3D* cEnemyBoss3D_2 = new CEnemyBoss3D(glm::vec3(-4.f, 40.f, 4.f));
+			CEnemyBoss3D* cEnemyBoss3D_2 = new CEnemyBoss3D(glm::vec3(-4.f, 40.f, 4.f));
 
-		cEnemyBoss3D_2->SetShader(cShader);
-		cEnemyBoss3D_2->Init();
-		cEnemyBoss3D_2->ActivateCollider(cSimpleShader);
-		cEntityManager->Add(cEnemyBoss3D_2);
+			cEnemyBoss3D_2->SetShader(cShader);
+			cEnemyBoss3D_2->Init();
+			cEnemyBoss3D_2->ActivateCollider(cSimpleShader);
+			cEntityManager->Add(cEnemyBoss3D_2);
 
-		CRifle* cRifle = new CRifle();
-		cRifle->Init();
-		cRifle->SetShader(cSimpleShader);
-		cPlayer3D->SetWeapon(1, cRifle);
+			CRifle* cRifle = new CRifle();
+			cRifle->Init();
+			cRifle->SetShader(cSimpleShader);
+			cPlayer3D->SetWeapon(1, cRifle);
+		});
 
 		cEntityManager->set_enemy_deathCount(0);
 		renderBoss = false;
@@ -656,21 +908,86 @@ void CScene3D::Update(const double dElapsedTime)
 	// WIN LOSE CONDITIONS
 	if (cEntityManager->get_enemy_deathCount() > 1 && bossDED == true && printWinScreen == false)
 	{
-		//cSoundController->PlaySoundByID(6);
+		//cSoundController->PlaySoundByID(SOUND_WIN);
 		printWinScreen = true;
 	}
 
 	if (static_cast<CHealthBar*>(cHealthBar)->GetHealthBarLength() <= 0 && printLoseScreen == false)
 	{
-		//cSoundController->PlaySoundByID(5);
+		//cSoundController->PlaySoundByID(SOUND_LOSE);
 		printLoseScreen = true;
 	}
 
 	// Post Update the mouse controller
 	cMouseController->PostUpdate();
 
+	// Update camera effects
+	cCameraEffects->Update(dElapsedTime);
+
+	// Update progress bar
+
+	if (static_cast<CArmorBar*>(cArmorBar)->GetArmorBarLength() >= 0)
+		cArmorBar->Update(dElapsedTime);
+	else
+		cHealthBar->Update(dElapsedTime);
+
+	cWeaponInfo = cPlayer3D->GetWeapon();
+
+	// Move the listener to the camera, then sync it and the sound emitters with the audio backend in one batch for this frame
+	cSoundController->SetListenerPosition(cCamera->vec3Position.x, cCamera->vec3Position.y, cCamera->vec3Position.z);
+	cSoundController->SetListenerDirection(cCamera->vec3Front.x, cCamera->vec3Front.y, cCamera->vec3Front.z);
+	cSoundController->Update(dElapsedTime);
+}
+
+/**
+ @brief Step the simulation by a fixed time step. The movement, the entities, the collisions and the player are updated here,
+		so that the gameplay runs at the same speed at any frame rate.
+ @param dTimeStep A const double variable which contains the fixed time step, in seconds
+ */
+void CScene3D::FixedUpdate(const double dTimeStep)
+{
+	PROFILE_SCOPE("CScene3D::FixedUpdate");
+
+	// Store the positions before this step, which the rendering interpolates from
+	cPlayer3D->StoreStateForInterpolation();
+	cEntityManager->StoreStateForInterpolation();
+	vec3CameraStatePosition = cCamera->vec3Position;
+
+	// Store the current position, if rollback is needed.
+	cPlayer3D->StorePositionForRollback();
+
+	// Get keyboard updates for player3D
+	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_W))
+		|| (cJoystickController->IsJoystickActivated(CJoystickController::FORWARD)))
+		cPlayer3D->ProcessMovement(CPlayer3D::FORWARD, (float)dTimeStep);
+	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_S))
+		|| (cJoystickController->IsJoystickActivated(CJoystickController::BACKWARD)))
+		cPlayer3D->ProcessMovement(CPlayer3D::BACKWARD, (float)dTimeStep);
+	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_A))
+		|| (cJoystickController->IsJoystickActivated(CJoystickController::LEFT)))
+		cPlayer3D->ProcessMovement(CPlayer3D::LEFT, (float)dTimeStep);
+	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_D))
+		|| (cJoystickController->IsJoystickActivated(CJoystickController::RIGHT)))
+		cPlayer3D->ProcessMovement(CPlayer3D::RIGHT, (float)dTimeStep);
+	if ((CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_W) && CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_LEFT_SHIFT))
+		|| (cJoystickController->IsJoystickActivated(CJoystickController::FORWARD)))
+		cPlayer3D->ProcessMovement(CPlayer3D::SPRINT, (float)dTimeStep);
+
+	// Get keyboard updates for camera
+	if (!cPlayer3D->IsCameraAttached())
+	{
+		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_I))
+			cCamera->ProcessKeyboard(CCamera::FORWARD, (float)dTimeStep);
+		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_K))
+			cCamera->ProcessKeyboard(CCamera::BACKWARD, (float)dTimeStep);
+		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_J))
+			cCamera->ProcessKeyboard(CCamera::LEFT, (float)dTimeStep);
+		if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_L))
+			cCamera->ProcessKeyboard(CCamera::RIGHT, (float)dTimeStep);
+	}
+
 	// Update the Entities
-	cEntityManager->Update(dElapsedTime);
+	cEntityManager->Update(dTimeStep);
 
 	// Check for Player3D colliding with Entities
 	if (cEntityManager->CollisionCheck(cPlayer3D) == true)
@@ -682,19 +999,111 @@ void CScene3D::Update(const double dElapsedTime)
 	cEntityManager->CleanUp();
 
 	// Update the player3D
-	cPlayer3D->Update(dElapsedTime);
+	cPlayer3D->Update(dTimeStep);
+}
 
-	// Update camera effects
-	cCameraEffects->Update(dElapsedTime);
+/**
+ @brief Set how far the rendering is from the last simulation step to the current one, so that the positions are interpolated
+ @param fInterpolation A const float variable which contains the fraction of a step which is left over, from 0 to 1
+ */
+void CScene3D::SetInterpolation(const float fInterpolation)
+{
+	this->fInterpolation = fInterpolation;
+}
 
-	// Update progress bar
+/**
+ @brief Copy what the rendering needs into the write frame of the render state, at the end of the simulation of a frame.
+		The rendering only draws what is in the render state, so the simulation can change the scene while the last frame is drawn.
+ */
+void CScene3D::CaptureRenderState(void)
+{
+	PROFILE_SCOPE("CScene3D::CaptureRenderState");
+
+	CRenderState::Frame& sFrame = cRenderState.GetWriteFrame();
+	sFrame.fInterpolation = fInterpolation;
+
+	// The camera
+	sFrame.vec3CameraStatePosition = vec3CameraStatePosition;
+	sFrame.vec3CameraPosition = cCamera->vec3Position;
+	sFrame.fCameraYaw = cCamera->fYaw;
+	sFrame.fCameraPitch = cCamera->fPitch;
+	sFrame.fCameraZoom = cCamera->fZoom;
+
+	// The player and the entities
+	sFrame.sPlayer.Capture(cPlayer3D);
+	sFrame.fPlayerYaw = cPlayer3D->fYaw;
+	cEntityManager->CaptureRenderState(sFrame.vEntities);
+
+	// The HUD
+	sFrame.sHealthBar.Capture(cHealthBar);
+	sFrame.sArmorBar.Capture(cArmorBar);
+	sFrame.sCameraEffects.Capture(cCameraEffects);
+	sFrame.pWeapon = cPlayer3D->GetWeapon();
+	if (sFrame.pWeapon)
+	{
+		sFrame.iMagRound = sFrame.pWeapon->GetMagRound();
+		sFrame.iMaxMagRound = sFrame.pWeapon->GetMaxMagRound();
+	}
+}
 
-	if (static_cast<CArmorBar*>(cArmorBar)->GetArmorBarLength() >= 0)
-		cArmorBar->Update(dElapsedTime);
+/**
+ @brief Set if the simulation runs on another thread while the last frame is rendered.
+		When it does, the tasks which need the OpenGL context are queued until the next Sync.
+ @param bPipelined A const bool variable which is true if the simulation runs on another thread
+ */
+void CScene3D::SetPipelined(const bool bPipelined)
+{
+	this->bPipelined = bPipelined;
+}
+
+/**
+ @brief Run a task on the main thread, which owns the OpenGL context. It is run at once if the simulation is on the main thread,
+		else it is queued until the next Sync.
+ @param fnTask A const std::function<void(void)>& variable which contains the task
+ */
+void CScene3D::RunOnMainThread(const std::function<void(void)>& fnTask)
+{
+	if (bPipelined)
+		vMainThreadTasks.push_back(fnTask);
 	else
-		cHealthBar->Update(dElapsedTime);
+		fnTask();
+}
 
-	cWeaponInfo = cPlayer3D->GetWeapon();
+/**
+ @brief Publish the render state which was captured last, so that it is drawn, then run the tasks which were queued for the main thread
+		and delete the entities which are no longer in either render state. It must be called on the main thread while the simulation is not running.
+ */
+void CScene3D::Sync(void)
+{
+	PROFILE_SCOPE("CScene3D::Sync");
+
+	cRenderState.Publish();
+
+	for (unsigned int i = 0; i < vMainThreadTasks.size(); i++)
+		vMainThreadTasks[i]();
+	vMainThreadTasks.clear();
+
+	// The entities which were removed before the last capture are not in the frame which is drawn now
+	cEntityManager->DeleteRemoved();
+}
+
+/**
+ @brief Set the render state which was published on the player, the entities and the HUD, before they are drawn.
+		The positions are interpolated between the last simulation step and the current one.
+ */
+void CScene3D::ApplyRenderState(void)
+{
+	const CRenderState::Frame& sFrame = cRenderState.GetReadFrame();
+
+	sFrame.sPlayer.Apply(sFrame.fInterpolation);
+	cPlayer3D->SetRenderYaw(sFrame.fPlayerYaw);
+	for (unsigned int i = 0; i < sFrame.vEntities.size(); i++)
+		sFrame.vEntities[i].Apply(sFrame.fInterpolation);
+
+	// The HUD is not moved by the simulation steps, so it is not interpolated
+	sFrame.sHealthBar.Apply(1.0f);
+	sFrame.sArmorBar.Apply(1.0f);
+	sFrame.sCameraEffects.Apply(1.0f);
 }
 
 /**
@@ -702,53 +1111,54 @@ void CScene3D::Update(const double dElapsedTime)
  */
 void CScene3D::PreRender(void)
 {
+	// Start counting the OpenGL calls of this frame
+	GL()->BeginFrame();
+
 	// Reset the OpenGL rendering environment
 	glLoadIdentity();
 
 	// Clear the screen and buffer
-	glClearColor(0.0f, 0.1f, 0.5f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	GL()->ClearColor(0.0f, 0.1f, 0.5f, 1.0f);
+	GL()->Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 /**
- @brief Render Render this instance
+ @brief Render Render this instance through the render graph
  */
 void CScene3D::Render(void)
 {
-	// Part 1: Render for the minimap by binding to framebuffer and render to color texture
-	//         But the camera is move to top-view of the scene
-
-	// Backup some key settings for the camera and player
-	glm::vec3 storePlayerPosition = cPlayer3D->GetPosition();
-	float storeCameraYaw = cCamera->fYaw;
-	float storeCameraPitch = cCamera->fPitch;
-	glm::vec3 storeCameraPosition = cCamera->vec3Position;
-	// Adjust camera yaw and pitch so that it is looking from a top-view of the terrain
-	cCamera->fYaw += 180.0f;
-	cCamera->fPitch = -90.0f;
-	// We store the player's position into the camera as we want the minimap to focus on the player
-	cCamera->vec3Position = glm::vec3(storePlayerPosition.x, 10.0f, storePlayerPosition.z);
-	// Recalculate all the camera vectors. 
-	// We disable pitch constrains for this specific case as we want the camera to look straight down
-	cCamera->ProcessMouseMovement(0, 0, false);
-	// Generate the view and projection
-	glm::mat4 playerView = cCamera->GetViewMatrix();
+	PROFILE_SCOPE("CScene3D::Render");
+
+	// Only the render state is drawn, and not the state which the simulation is changing
+	ApplyRenderState();
+
+	// The dynamic vertices of this frame go into the next segment of the streaming vertex buffer
+	cStreamBuffer->BeginFrame();
+	cRenderGraph->Execute();
+	cStreamBuffer->EndFrame();
+}
+
+/**
+ @brief Render the scene from a top-view above the player into the minimap's framebuffer
+ */
+void CScene3D::RenderMinimapPass(void)
+{
+	const CRenderState::Frame& sFrame = cRenderState.GetReadFrame();
+
+	// Look straight down from above the player. The view is built from the camera's yaw
+	// without changing the camera, so the main pass is not affected.
+	glm::vec3 vec3PlayerPosition = cPlayer3D->GetRenderPosition();
+	glm::mat4 playerView = cCamera->GetViewMatrix(	glm::vec3(vec3PlayerPosition.x, 10.0f, vec3PlayerPosition.z),
+													sFrame.fCameraYaw + 180.0f,
+													-90.0f);
 	glm::mat4 playerProjection = glm::perspective(	glm::radians(45.0f),
 													(float)cSettings->iWindowWidth / (float)cSettings->iWindowHeight,
 													0.1f, 1000.0f);
 
-	// Set the camera parameters back to the previous values
-	cCamera->fYaw = storeCameraYaw;
-	cCamera->fPitch = storeCameraPitch;
-	cCamera->vec3Position = storeCameraPosition;
-	cCamera->ProcessMouseMovement(0, 0, true); // call this to make sure it updates its camera vectors, note that we disable pitch constrains for this specific case (otherwise we can't reverse camera's pitch values)
-
-	// Activate the minimap system
-	cMinimap->Activate();
 	// Setup the rendering environment
 	cMinimap->PreRender();
 
-	glEnable(GL_DEPTH_TEST); // enable depth testing (is disabled for rendering screen-space quad)
+	GL()->Enable(GL_DEPTH_TEST); // enable depth testing (is disabled for rendering screen-space quad)
 
 	// Render the Ground for the minimap
 	cGroundMap->SetView(playerView);
@@ -760,7 +1170,7 @@ void CScene3D::Render(void)
 	// Render the entities for the minimap
 	cEntityManager->SetView(playerView);
 	cEntityManager->SetProjection(playerProjection);
-	cEntityManager->Render();
+	cEntityManager->Render(sFrame.vEntities);
 
 	// Render the player for the minimap
 	cPlayer3D->SetView(playerView);
@@ -769,17 +1179,28 @@ void CScene3D::Render(void)
 	cPlayer3D->Render();
 	cPlayer3D->PostRender();
 
-	// Deactivate the cMinimap so that we can render as per normal
-	cMinimap->Deactivate();
+	// Render the colliders for the minimap
+	cDebugDraw->Flush(playerView, playerProjection);
+}
 
-	// Part 2: Render the entire scene as per normal
-	// Get the camera view and projection
-	glm::mat4 view = CCamera::GetInstance()->GetViewMatrix();;
-	glm::mat4 projection = glm::perspective(	glm::radians(CCamera::GetInstance()->fZoom),
+/**
+ @brief Render the entire scene as per normal
+ */
+void CScene3D::RenderMainPass(void)
+{
+	const CRenderState::Frame& sFrame = cRenderState.GetReadFrame();
+
+	// Get the camera view and projection. The view is built from the camera's Euler angles,
+	// so that the camera sway which the player applies to them is seen. The position is interpolated between the simulation steps.
+	glm::mat4 view = cCamera->GetViewMatrix(glm::mix(sFrame.vec3CameraStatePosition, sFrame.vec3CameraPosition, sFrame.fInterpolation),
+											sFrame.fCameraYaw,
+											glm::clamp(sFrame.fCameraPitch, -89.0f, 89.0f));
+	glm::mat4 projection = glm::perspective(	glm::radians(sFrame.fCameraZoom),
 												(float)cSettings->iWindowWidth / (float)cSettings->iWindowHeight,
 												0.1f, 1000.0f);
-	glClearColor(0.0f, 0.0f, 0.5f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	GL()->Enable(GL_DEPTH_TEST);
+	GL()->ClearColor(0.0f, 0.0f, 0.5f, 1.0f);
+	GL()->Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	// Render the SkyBox
 	cSkyBox->SetView(view);
@@ -798,7 +1219,7 @@ void CScene3D::Render(void)
 	// Render the entities
 	cEntityManager->SetView(view);
 	cEntityManager->SetProjection(projection);
-	cEntityManager->Render();
+	cEntityManager->Render(sFrame.vEntities);
 
 	// Render the player
 	cPlayer3D->SetView(view);
@@ -807,27 +1228,25 @@ void CScene3D::Render(void)
 	cPlayer3D->Render();
 	cPlayer3D->PostRender();
 
-	// now draw the mirror quad with screen texture
-	// --------------------------------------------
-	glDisable(GL_DEPTH_TEST); // disable depth test so screen-space quad isn't discarded due to depth test.
+	// Render the colliders
+	cDebugDraw->Flush(view, projection);
+}
 
-	cCameraEffects->PreRender();
-	cCameraEffects->Render();
-	cCameraEffects->PostRender();
+/**
+ @brief Render the GUI elements and text over the scene
+ */
+void CScene3D::RenderHUDPass(void)
+{
+	const CRenderState::Frame& sFrame = cRenderState.GetReadFrame();
+
+	GL()->Disable(GL_DEPTH_TEST); // disable depth test so screen-space quad isn't discarded due to depth test.
 
-	cHealthBar->PreRender();
+	// Add the HUD elements to the sprite batch, then draw them together
+	cCameraEffects->Render();
 	cHealthBar->Render();
-	cHealthBar->PostRender();
-	
-	cArmorBar->PreRender();
 	cArmorBar->Render();
-	cArmorBar->PostRender();
-
-	cCrossHair->PreRender();
-	cCrossHair->Render(cPlayer3D->GetWeapon());
-	cCrossHair->PostRender();
-
-	cMinimap->Render();
+	cCrossHair->Render(sFrame.pWeapon);
+	cSpriteBatch->Flush();
 
 	// Call the cTextRenderer's PreRender()
 	cTextRenderer->PreRender();
@@ -838,10 +1257,10 @@ void CScene3D::Render(void)
 	// Render FPS info
 	//	cTextRenderer->Render(cFPSCounter->GetFrameRateString(), 10.0f, 580.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
 	// Render Camera Position
-	cTextRenderer->Render(glm::to_string(cPlayer3D->GetPosition()), 10.0f, 30.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
+	cTextRenderer->Render(glm::to_string(sFrame.sPlayer.vec3Position), 10.0f, 30.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
 	// Render Camera Position
-	cTextRenderer->Render(glm::to_string(cCamera->vec3Position), 10.0f, 10.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
-	if (cWeaponInfo->type == CWeaponInfo::WeaponType::PISTOL)
+	cTextRenderer->Render(glm::to_string(sFrame.vec3CameraPosition), 10.0f, 10.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
+	if (sFrame.pWeapon->type == CWeaponInfo::WeaponType::PISTOL)
 	{
 		cTextRenderer->Render("PISTOL", 70, 535, 1, glm::vec3(0, 0, 0));
 	}
@@ -849,12 +1268,105 @@ void CScene3D::Render(void)
 	{
 		cTextRenderer->Render("RIFLE", 70, 535, 1, glm::vec3(0, 0, 0));
 	}
-	cTextRenderer->Render(std::to_string(cWeaponInfo->GetMagRound()) + "/" + std::to_string(cWeaponInfo->GetMaxMagRound()), 100, 500, 1, glm::vec3(0, 0, 0));
+	cTextRenderer->Render(std::to_string(sFrame.iMagRound) + "/" + std::to_string(sFrame.iMaxMagRound), 100, 500, 1, glm::vec3(0, 0, 0));
+
+	if (bShowProfiler)
+		RenderProfilerSummary();
 
 	// Call the cTextRenderer's PostRender()
 	cTextRenderer->PostRender();
+}
+
+/**
+ @brief Draw the summary of the profiler with the cTextRenderer, one line per zone, from the top left of the window.
+		The zones are indented by their depth, and the GPU times of the render passes follow the CPU times.
+ */
+void CScene3D::RenderProfilerSummary(void)
+{
+	const float fScale = 0.35f;
+	const float fLineHeight = 14.0f;
+	float fY = (float)cSettings->iWindowHeight - 20.0f;
+	char acLine[128];
+
+	snprintf(acLine, sizeof(acLine), "Frame %.2f ms", CProfiler::GetInstance()->GetFrameTime());
+	cTextRenderer->Render(acLine, 10.0f, fY, fScale, glm::vec3(1.0f, 1.0f, 0.0f));
+	fY -= fLineHeight;
+	snprintf(acLine, sizeof(acLine), "p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms  hitches %u",
+		cFPSCounter->GetPercentile50(), cFPSCounter->GetPercentile95(), cFPSCounter->GetPercentile99(),
+		cFPSCounter->GetMaxFrameTime(), cFPSCounter->GetNumOfHitches());
+	cTextRenderer->Render(acLine, 10.0f, fY, fScale, glm::vec3(1.0f, 1.0f, 0.0f));
+	fY -= fLineHeight;
+
+	const std::vector<CProfiler::SummaryLine>& vSummary = CProfiler::GetInstance()->GetSummary();
+	for (unsigned int i = 0; i < vSummary.size(); i++)
+	{
+		snprintf(acLine, sizeof(acLine), "%s%*s%s %.2f ms",
+			vSummary[i].bGPU ? "GPU " : "", vSummary[i].iDepth * 2, "", vSummary[i].pName, vSummary[i].dTime);
+		cTextRenderer->Render(acLine, 10.0f, fY, fScale,
+			vSummary[i].bGPU ? glm::vec3(0.5f, 1.0f, 0.5f) : glm::vec3(1.0f, 1.0f, 1.0f));
+		fY -= fLineHeight;
+	}
+}
+
+/**
+ @brief Save the frame times of the last frames to frametimes.csv, with the frame number, the time in microseconds and if it was a hitch,
+		and the histogram of the last frames to frametime_histogram.csv
+ @return true if both files were saved, else false
+ */
+bool CScene3D::SaveFrameStats(void)
+{
+	std::vector<double> vFrameTimes;
+	std::vector<bool> vHitches;
+	cFPSCounter->GetFrameTimes(vFrameTimes, vHitches);
+
+	// The frame numbers count up to the last frame
+	unsigned int uFirst = cFPSCounter->GetNumOfFrames() - (unsigned int)vFrameTimes.size();
+	vector<pair<string, vector<int>>> vSeries(3);
+	vSeries[0].first = "frame";
+	vSeries[1].first = "frame_time_us";
+	vSeries[2].first = "hitch";
+	for (unsigned int i = 0; i < vFrameTimes.size(); i++)
+	{
+		vSeries[0].second.push_back(uFirst + i);
+		vSeries[1].second.push_back((int)(vFrameTimes[i] * 1000.0));
+		vSeries[2].second.push_back(vHitches[i] ? 1 : 0);
+	}
 
-	return;
+	const std::vector<int>& vHistogram = cFPSCounter->GetHistogram();
+	vector<pair<string, vector<int>>> vBins(2);
+	vBins[0].first = "frame_time_ms";
+	vBins[1].first = "frames";
+	for (unsigned int i = 0; i < vHistogram.size(); i++)
+	{
+		vBins[0].second.push_back(i * CFPSCounter::HISTOGRAM_BIN_WIDTH);
+		vBins[1].second.push_back(vHistogram[i]);
+	}
+
+	CCSVWriter cCSVWriter;
+	try
+	{
+		if ((cCSVWriter.write_csv_with_columnname("frametimes.csv", vSeries) == false) ||
+			(cCSVWriter.write_csv_with_columnname("frametime_histogram.csv", vBins) == false))
+			return false;
+	}
+	catch (runtime_error e)
+	{
+		cout << "CScene3D::SaveFrameStats(): " << e.what() << endl;
+		return false;
+	}
+	cout << "CScene3D::SaveFrameStats(): Saved " << vFrameTimes.size() << " frame times to frametimes.csv" << endl;
+	return true;
+}
+
+/**
+ @brief Render the minimap's texture over the scene
+ */
+void CScene3D::RenderMinimapOverlayPass(void)
+{
+	GL()->Disable(GL_DEPTH_TEST);
+
+	cMinimap->Render();
+	cSpriteBatch->Flush();
 }
 
 /**
@@ -862,4 +1374,6 @@ void CScene3D::Render(void)
  */
 void CScene3D::PostRender(void)
 {
+	// Stop counting the OpenGL calls of this frame
+	GL()->EndFrame();
 }
\ No newline at end of file
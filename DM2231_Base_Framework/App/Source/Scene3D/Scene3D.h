@@ -10,6 +10,8 @@
 
 // Include shader
 #include "RenderControl\shader.h"
+// Include ShaderCache
+#include "RenderControl\ShaderCache.h"
 
 // Include GLM
 #include <includes/glm.hpp>
@@ -18,6 +20,22 @@
 
 // Include TextRenderer
 #include "RenderControl\TextRenderer.h"
+// Include StreamBuffer
+#include "RenderControl\StreamBuffer.h"
+// Include DebugDraw
+#include "RenderControl\DebugDraw.h"
+// Include RenderGraph
+#include "RenderControl\RenderGraph.h"
+// Include TextureAtlas
+#include "RenderControl\TextureAtlas.h"
+// Include SpriteBatch
+#include "RenderControl\SpriteBatch.h"
+// Include OcclusionCuller
+#include "RenderControl\OcclusionCuller.h"
+// Include GLDispatch
+#include "RenderControl\GLDispatch.h"
+// Include GLRecordingBackend
+#include "RenderControl\GLRecordingBackend.h"
 
 // Include Keyboard controller
 #include "Inputs\KeyboardController.h"
@@ -29,11 +47,22 @@
 // FPS Counter
 #include "TimeControl\FPSCounter.h"
 
+// Include TextureManager
+#include "System\TextureManager.h"
+// Include MeshManager
+#include "System\MeshManager.h"
+// Include AssetLoader
+#include "System\AssetLoader.h"
+// Include Profiler
+#include "System\Profiler.h"
+
 // Include SoundController
 #include "..\SoundController\SoundController.h"
 
 // Include EntityManager
 #include "EntityManager.h"
+// Include RenderState
+#include "RenderState.h"
 
 // Include Player3D
 #include "Player3D.h"
@@ -63,6 +92,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <functional>
+#include <vector>
 
 class CSettings;
 
@@ -73,8 +104,20 @@ public:
 	// Init
 	bool Init(void);
 
-	// Update
+	// Update the input and the game events, once per frame
 	void Update(const double dElapsedTime);
+	// Step the simulation by a fixed time step
+	void FixedUpdate(const double dTimeStep);
+	// Set how far the rendering is from the last simulation step to the current one
+	void SetInterpolation(const float fInterpolation);
+	// Copy what the rendering needs into the render state, at the end of the simulation of a frame
+	void CaptureRenderState(void);
+
+	// Set if the simulation runs on another thread while the last frame is rendered
+	void SetPipelined(const bool bPipelined);
+	// Publish the render state which was captured last, and run the tasks which were queued for the main thread.
+	// This is called on the main thread when the simulation is not running.
+	void Sync(void);
 
 	// PreRender
 	void PreRender(void);
@@ -95,12 +138,8 @@ public:
 	Shader* skyBoxShader;
 	// Handler to the groundShader Shader Program instance
 	Shader* groundShader;
-	// Handler to the GUIShader Shader Program instance
-	Shader* cGUIShader;
-	// Handler to the GUISimpleShader Shader Program instance
-	Shader* cGUISimpleShader;
-	// Handler to the RenderToTexture Shader Program instance
-	Shader* cRenderToTextureShader;
+	// Handler to the Sprite Shader Program instance
+	Shader* cSpriteShader;
 
 protected:
 	// The handler to the CSettings
@@ -109,6 +148,32 @@ protected:
 	// The handler containing the instance of the CTextRenderer
 	CTextRenderer* cTextRenderer;
 
+	// The handler containing the instance of the CStreamBuffer
+	CStreamBuffer* cStreamBuffer;
+
+	// The handler containing the instance of the CShaderCache
+	CShaderCache* cShaderCache;
+
+	// The handler containing the instance of the CDebugDraw
+	CDebugDraw* cDebugDraw;
+
+	// The handler containing the instance of the CRenderGraph
+	CRenderGraph* cRenderGraph;
+
+	// The handler containing the instance of the GUI CTextureAtlas
+	CTextureAtlas* cTextureAtlas;
+
+	// The handler containing the instance of the CSpriteBatch
+	CSpriteBatch* cSpriteBatch;
+
+	// The handler containing the instance of the COcclusionCuller
+	COcclusionCuller* cOcclusionCuller;
+
+	// The handler containing the instance of the CGLDispatch
+	CGLDispatch* cGLDispatch;
+	// The backend which counts the OpenGL calls of each frame, when it is switched on
+	CGLRecordingBackend* cGLRecordingBackend;
+
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
 
@@ -127,6 +192,13 @@ protected:
 	// Handler to the CSoundController
 	CSoundController* cSoundController;
 
+	// Handler to the CTextureManager
+	CTextureManager* cTextureManager;
+	// Handler to the CMeshManager
+	CMeshManager* cMeshManager;
+	// Handler to the CAssetLoader
+	CAssetLoader* cAssetLoader;
+
 	// Handler to the EntityManager class
 	CEntityManager* cEntityManager;
 
@@ -161,6 +233,35 @@ protected:
 	bool printLoseScreen;
 	bool printWinScreen;
 
+	// The camera position before the last simulation step, and how far the rendering is from it to the current position
+	glm::vec3 vec3CameraStatePosition;
+	float fInterpolation;
+
+	// Flag to indicate if the summary of the profiler is drawn over the scene
+	bool bShowProfiler;
+
+	// The state which the rendering draws, which the simulation captures at the end of each frame
+	CRenderState cRenderState;
+	// Flag to indicate if the simulation runs on another thread while the last frame is rendered
+	bool bPipelined;
+	// The tasks which the simulation queued for the main thread, such as creating OpenGL objects
+	std::vector<std::function<void(void)>> vMainThreadTasks;
+
+	// Run a task on the main thread, at once if the simulation is on the main thread, else at the next Sync
+	void RunOnMainThread(const std::function<void(void)>& fnTask);
+	// Set the render state which was published on the entities, before they are drawn
+	void ApplyRenderState(void);
+
+	// Render passes, which are run by the cRenderGraph
+	void RenderMinimapPass(void);
+	void RenderMainPass(void);
+	void RenderHUDPass(void);
+	void RenderMinimapOverlayPass(void);
+	// Draw the summary of the profiler with the cTextRenderer
+	void RenderProfilerSummary(void);
+	// Save the frame times and the histogram of the last frames as CSV files
+	bool SaveFrameStats(void);
+
 	// Constructor
 	CScene3D(void);
 	// Destructor
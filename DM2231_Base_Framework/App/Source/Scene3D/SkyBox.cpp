@@ -106,9 +106,9 @@ bool CSkyBox::Init(void)
 	// skybox VAO and VBO
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
+	GL()->BindVertexArray(VAO);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 
@@ -166,7 +166,7 @@ void CSkyBox::Update(const double dElapsedTime)
 void CSkyBox::PreRender(void)
 {
 	// draw skybox as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /**
@@ -189,11 +189,11 @@ void CSkyBox::Render(void)
 	cShader->setMat4("projection", projection);
 
 	// skybox cube
-	glBindVertexArray(VAO);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, iTextureID);
-	glDrawArrays(GL_TRIANGLES, 0, 36);
-	glBindVertexArray(0);
+	GL()->BindVertexArray(VAO);
+	GL()->ActiveTexture(GL_TEXTURE0);
+	GL()->BindTexture(GL_TEXTURE_CUBE_MAP, iTextureID);
+	GL()->DrawArrays(GL_TRIANGLES, 0, 36);
+	GL()->BindVertexArray(0);
 }
 
 /**
@@ -201,7 +201,7 @@ void CSkyBox::Render(void)
  */
 void CSkyBox::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
 
 // Load SkyBox textures
@@ -218,7 +218,7 @@ GLuint CSkyBox::LoadSkyBoxTextures(void)
 {
 	unsigned int textureID;
 	glGenTextures(1, &textureID);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+	GL()->BindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
 	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
 	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 5);
@@ -226,10 +226,25 @@ GLuint CSkyBox::LoadSkyBoxTextures(void)
 	// Get the image loader
 	CImageLoader* cImageLoader = CImageLoader::GetInstance();
 
-	// Load each of the textures as a single texture ID
+	// Load each of the textures as a single texture ID.
+	// The DXT compressed copy of each face is used if there is an up-to-date one.
+	// The skybox is not mipmapped, so the faces are compressed without a mipmap chain.
 	int width, height, nrChannels;
 	for (unsigned int i = 0; i < skyboxTexture.size(); i++)
 	{
+		if (cImageLoader->IsCompressionSupported())
+		{
+			int iNumOfLevels = 0;
+			size_t uBytes = 0;
+			if ((cImageLoader->LoadCompressed(skyboxTexture[i].c_str(), GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, false, iNumOfLevels, uBytes))
+				|| ((cImageLoader->Compress(skyboxTexture[i].c_str(), false, false))
+					&& (cImageLoader->LoadCompressed(skyboxTexture[i].c_str(), GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, false, iNumOfLevels, uBytes))))
+			{
+				std::cout << skyboxTexture[i] << " successfully loaded (compressed). " << std::endl;
+				continue;
+			}
+		}
+
 		unsigned char *data = cImageLoader->Load(skyboxTexture[i].c_str(), width, height, nrChannels, false);
 		if (data)
 		{
@@ -249,6 +264,8 @@ GLuint CSkyBox::LoadSkyBoxTextures(void)
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	// There is only one level in each face
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
 
 	//// Generate mipmaps
 	//glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
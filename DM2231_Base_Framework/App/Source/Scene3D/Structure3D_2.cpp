@@ -4,7 +4,7 @@
  Date: Apr 2020
  */
 #include "Structure3D_2.h"
-#include "System/LoadOBJ.h"
+#include "System/MeshManager.h"
 #include <iostream>
 using namespace std;
 
@@ -45,10 +45,6 @@ CStructure2_3D::~CStructure2_3D(void)
 		// We set it to NULL only since it was declared somewhere else
 		cGroundMap = NULL;
 	}
-
-	// Delete the rendering objects in the graphics card
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
 }
 
 /**
@@ -70,31 +66,15 @@ bool CStructure2_3D::Init(void)
 	// Set the type
 	SetType(CEntity3D::TYPE::STRUCTURE);
 
-	std::vector<glm::vec3> vertices;
-    std::vector <glm::vec2> uvs;
-	std::vector<glm::vec3> normals;
-
 	vec3Scale = glm::vec3(1, 1, 1);
 	vec3ColliderScale = glm::vec3(1, 1, 1);
 
-	std::string file_path = "OBJ/pillar.obj";
-	bool success = LoadOBJ(file_path.c_str(), vertices, uvs, normals);
-	if (!success)
-		return NULL;
-	std::vector <Vertex> vertex_buffer_data;
-	std::vector <GLuint> index_buffer_data;
-	IndexVBO(vertices, uvs, normals, index_buffer_data, vertex_buffer_data);
-
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &IBO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
-	index_buffer_size = index_buffer_data.size();
+	// Load the mesh, which is shared with the other instances using the same OBJ file
+	if (LoadMesh("OBJ/pillar.obj") == false)
+	{
+		cout << "CStructure2_3D::Init(): Unable to load OBJ/pillar.obj" << endl;
+		return false;
+	}
 
 	// load and create a texture 
 	iTextureID = LoadTexture("Image/pillar.tga");
@@ -165,7 +145,7 @@ void CStructure2_3D::ActivateCollider(Shader* cLineShader)
 void CStructure2_3D::PreRender(void)
 {
 	// Draw this as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /**
@@ -185,8 +165,8 @@ void CStructure2_3D::Render(void)
 	cShader->use();
 
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	GL()->ActiveTexture(GL_TEXTURE0);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
 
 	//int angle = 90;
 
@@ -194,7 +174,7 @@ void CStructure2_3D::Render(void)
 	model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	//model = glm::rotate(model, glm::radians(90.f), glm::vec3(0.0f, 1.0f, 0.0f));
 	model = glm::translate(model, vec3Position);
-	model = glm::scale(model, vec3Scale);
+	model = glm::scale(model, vec3RenderScale);
 
 	// note: currently we set the projection matrix each frame, but since the projection 
 	// matrix rarely changes it's often best practice to set it outside the main loop only once.
@@ -202,23 +182,8 @@ void CStructure2_3D::Render(void)
 	cShader->setMat4("view", view);
 	cShader->setMat4("model", model);
 
-	//// render boxes
-	//glBindVertexArray(VAO);
-	//glDrawArrays(GL_TRIANGLES, 0, 36);
-	glBindVertexArray(VAO);
-	//glDrawArrays(GL_TRIANGLES, 0, 36);
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glDrawElements(GL_TRIANGLES, index_buffer_size, GL_UNSIGNED_INT, 0);
-
-	glDisableVertexAttribArray(1);
-	glDisableVertexAttribArray(0);
+	// render the shared mesh
+	CMeshManager::GetInstance()->Draw(cMesh);
 	// Render the CCollider if needed
 	if ((cCollider) && (cCollider->bIsDisplayed))
 	{
@@ -234,5 +199,5 @@ void CStructure2_3D::Render(void)
 */
 void CStructure2_3D::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
@@ -109,10 +109,10 @@ bool CProjectile::Init(	glm::vec3 vec3Position,
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 
-	glBindVertexArray(VAO);
+	GL()->BindVertexArray(VAO);
 
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
 	// position attribute
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -249,6 +249,15 @@ double CProjectile::GetLifetime(void) const
 	return dLifetime;
 }
 
+/**
+ @brief Check if this projectile is drawn. It is only drawn while it is active and its lifetime has not run out.
+ @return true if this projectile is drawn, else false
+ */
+bool CProjectile::IsVisible(void) const
+{
+	return (bStatus) && (dLifetime >= 0.0f) && (CEntity3D::IsVisible());
+}
+
 /** 
  @brief Get the speed of the projectile
  @return A const float variable which contains the speed of the projectile
@@ -294,7 +303,7 @@ void CProjectile::Update(const double dElapsedTime)
 void CProjectile::PreRender(void)
 {
 	// Draw this as last
-	glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+	GL()->DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
 }
 
 /** 
@@ -302,10 +311,8 @@ void CProjectile::PreRender(void)
  */
 void CProjectile::Render(void)
 {
-	if (bStatus == false)
-		return;
-
-	if (dLifetime < 0.0f)
+	// The status and the lifetime are checked by IsVisible when the render state is captured
+	if (bRenderVisible == false)
 		return;
 
 	// If the shader is in this class, then do not render
@@ -323,8 +330,8 @@ void CProjectile::Render(void)
 	// create transformations
 	model = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	//model = glm::rotate(model, (float)glfwGetTime()/10.0f, glm::vec3(0.0f, 0.0f, 1.0f));
-	model = glm::translate(model, vec3Position);
-	model = glm::scale(model, vec3Scale);
+	model = glm::translate(model, GetRenderPosition());
+	model = glm::scale(model, vec3RenderScale);
 
 	// note: currently we set the projection matrix each frame, but since the projection matrix 
 	// rarely changes it's often best practice to set it outside the main loop only once.
@@ -333,8 +340,8 @@ void CProjectile::Render(void)
 	cShader->setMat4("model", model);
 
 	// render boxes
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 36);
+	GL()->BindVertexArray(VAO);
+	GL()->DrawArrays(GL_TRIANGLES, 0, 36);
 
 	// Render the CCollider if needed
 	if ((cCollider) && (cCollider->bIsDisplayed))
@@ -351,5 +358,5 @@ void CProjectile::Render(void)
 */
 void CProjectile::PostRender(void)
 {
-	glDepthFunc(GL_LESS); // set depth function back to default
+	GL()->DepthFunc(GL_LESS); // set depth function back to default
 }
\ No newline at end of file
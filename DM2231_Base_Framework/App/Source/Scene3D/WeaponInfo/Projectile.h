@@ -52,6 +52,8 @@ public:
 	float GetSpeed(void) const;
 	// Get the source of the projectile
 	CEntity3D* GetSource(void) const;
+	// Check if this projectile is drawn
+	virtual bool IsVisible(void) const;
 
 	// Update the status of this projectile
 	virtual void Update(const double dElapsedTime);
@@ -0,0 +1,54 @@
+#pragma once
+
+// Include IrrKlang for vec3df
+#include <includes/irrKlang.h>
+using namespace irrklang;
+
+#include <cstddef>
+
+// The audio engine which the CSoundController plays its sounds through.
+// Sound files are loaded as sources, and each playing sound is a voice; both are referred to by handles,
+// which are -1 when there is no source or voice.
+class CAudioBackend
+{
+public:
+	// Constructor
+	CAudioBackend(void) {}
+	// Destructor
+	virtual ~CAudioBackend(void) {}
+
+	// Create the audio engine
+	virtual bool Init(void) = 0;
+	// Get the name of this backend
+	virtual const char* GetName(void) const = 0;
+
+	// Load a sound file as a source. A streamed source is read from the disk while it plays, instead of being decoded into memory.
+	virtual int LoadSource(const char* filename, const bool bStreamed, const bool bPreload) = 0;
+	// Get and set the volume which the voices of a source start at
+	virtual float GetSourceVolume(const int iSource) = 0;
+	virtual void SetSourceVolume(const int iSource, const float fVolume) = 0;
+
+	// Start a voice of a source. 2D voices ignore the position.
+	virtual int Play(const int iSource, const bool bLooped, const bool b3D, const vec3df& vec3dfPosition) = 0;
+	// Stop a voice. The handle stays valid until it is released.
+	virtual void Stop(const int iVoice) = 0;
+	// Check if a voice has finished playing
+	virtual bool IsFinished(const int iVoice) = 0;
+	// Release a voice which is no longer needed. Its handle can be reused for another voice.
+	virtual void Release(const int iVoice) = 0;
+	// Get the volume, position and minimum distance of a voice, to work out how loud it is at the listener
+	virtual float GetVolume(const int iVoice) = 0;
+	virtual vec3df GetPosition(const int iVoice) = 0;
+	virtual float GetMinDistance(const int iVoice) = 0;
+	// Move a 3D voice
+	virtual void SetPosition(const int iVoice, const vec3df& vec3dfPosition) = 0;
+
+	// Set the position and view direction of the listener of the 3D voices
+	virtual void SetListener(const vec3df& vec3dfPosition, const vec3df& vec3dfDirection) = 0;
+	// Get and set the master volume
+	virtual float GetMasterVolume(void) = 0;
+	virtual void SetMasterVolume(const float fVolume) = 0;
+
+	// Advance the engine by the time since the last frame
+	virtual void Update(const double dElapsedTime) = 0;
+};
@@ -0,0 +1,376 @@
+#include "AudioMixerBackend.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ @param iSampleRate A const int variable which contains the sample rate of the mix buffer
+ */
+CAudioMixerBackend::CAudioMixerBackend(const int iSampleRate)
+	: iSampleRate(iSampleRate)
+	, fMasterVolume(1.0f)
+	, vec3dfListenerPos(vec3df(0, 0, 0))
+	, vec3dfListenerDir(vec3df(0, 0, 1))
+	, dFrameRemainder(0.0)
+{
+	memset(&sStats, 0, sizeof(sStats));
+}
+
+/**
+ @brief Destructor
+ */
+CAudioMixerBackend::~CAudioMixerBackend(void)
+{
+	vVoices.clear();
+	vFreeVoices.clear();
+	vSources.clear();
+}
+
+/**
+ @brief Initialise the mixer. There is no device to open, so it cannot fail.
+ @return true
+ */
+bool CAudioMixerBackend::Init(void)
+{
+	return true;
+}
+
+/**
+ @brief Get the name of this backend
+ */
+const char* CAudioMixerBackend::GetName(void) const
+{
+	return "offline mixer";
+}
+
+/**
+ @brief Load a sound file as a source. A 16-bit PCM WAV file which is not streamed is read into memory;
+		any other file is given silent samples in its place.
+ @param filename A const char* variable which contains the name of the file
+ @param bStreamed A const bool variable which is true if the file is streamed, so only a second of it is held in memory
+ @param bPreload A const bool variable which is not used, as the samples are always read now
+ @return The handle of the source, or -1 if the file could not be read
+ */
+int CAudioMixerBackend::LoadSource(const char* filename, const bool bStreamed, const bool /*bPreload*/)
+{
+	Source sSource;
+	if (ReadSoundFileInfo(filename, sSource.sInfo) == false)
+		return -1;
+	if ((sSource.sInfo.iNumOfChannels <= 0) || (sSource.sInfo.iSampleRate <= 0))
+		return -1;
+	sSource.fVolume = 1.0f;
+
+	if ((bStreamed == false) && ReadWavSamples(filename, sSource.vSamples))
+	{
+		sSource.uNumOfBufferFrames = sSource.vSamples.size() / sSource.sInfo.iNumOfChannels;
+	}
+	else
+	{
+		sSource.uNumOfBufferFrames = sSource.sInfo.uNumOfFrames;
+		if (bStreamed && (sSource.uNumOfBufferFrames > (unsigned long long)sSource.sInfo.iSampleRate))
+			sSource.uNumOfBufferFrames = sSource.sInfo.iSampleRate;
+		sSource.vSamples.assign((size_t)(sSource.uNumOfBufferFrames * sSource.sInfo.iNumOfChannels), 0);
+	}
+
+	vSources.push_back(sSource);
+	return (int)vSources.size() - 1;
+}
+
+/**
+ @brief Get the volume which the voices of a source start at
+ */
+float CAudioMixerBackend::GetSourceVolume(const int iSource)
+{
+	Source* pSource = GetSource(iSource);
+	return pSource ? pSource->fVolume : 0.0f;
+}
+
+/**
+ @brief Set the volume which the voices of a source start at
+ */
+void CAudioMixerBackend::SetSourceVolume(const int iSource, const float fVolume)
+{
+	Source* pSource = GetSource(iSource);
+	if (pSource)
+		pSource->fVolume = fVolume;
+}
+
+/**
+ @brief Start a voice of a source
+ @param iSource A const int variable which contains the handle of the source
+ @param bLooped A const bool variable which is true if the voice loops
+ @param b3D A const bool variable which is true if the voice is played at a position
+ @param vec3dfPosition A const vec3df& variable which contains the position of a 3D voice
+ @return The handle of the voice, or -1 if it could not be played
+ */
+int CAudioMixerBackend::Play(const int iSource, const bool bLooped, const bool b3D, const vec3df& vec3dfPosition)
+{
+	Source* pSource = GetSource(iSource);
+	if ((pSource == NULL) || (pSource->uNumOfBufferFrames == 0))
+		return -1;
+
+	Voice sVoice;
+	sVoice.bInUse = true;
+	sVoice.bFinished = false;
+	sVoice.iSource = iSource;
+	sVoice.bLooped = bLooped;
+	sVoice.b3D = b3D;
+	sVoice.vec3dfPosition = vec3dfPosition;
+	sVoice.fVolume = pSource->fVolume;
+	sVoice.fMinDistance = 1.0f;
+	sVoice.dFrame = 0.0;
+	sStats.uNumOfPlays++;
+
+	if (vFreeVoices.empty())
+	{
+		vVoices.push_back(sVoice);
+		return (int)vVoices.size() - 1;
+	}
+	int iVoice = vFreeVoices.back();
+	vFreeVoices.pop_back();
+	vVoices[iVoice] = sVoice;
+	return iVoice;
+}
+
+/**
+ @brief Stop a voice
+ */
+void CAudioMixerBackend::Stop(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	if (pVoice)
+		pVoice->bFinished = true;
+}
+
+/**
+ @brief Check if a voice has finished playing
+ */
+bool CAudioMixerBackend::IsFinished(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	return pVoice ? pVoice->bFinished : true;
+}
+
+/**
+ @brief Release a voice which is no longer needed
+ */
+void CAudioMixerBackend::Release(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	if (pVoice == NULL)
+		return;
+
+	pVoice->bInUse = false;
+	vFreeVoices.push_back(iVoice);
+}
+
+/**
+ @brief Get the volume of a voice
+ */
+float CAudioMixerBackend::GetVolume(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	return pVoice ? pVoice->fVolume : 0.0f;
+}
+
+/**
+ @brief Get the position of a voice
+ */
+vec3df CAudioMixerBackend::GetPosition(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	return pVoice ? pVoice->vec3dfPosition : vec3df(0.0f, 0.0f, 0.0f);
+}
+
+/**
+ @brief Get the distance from a voice within which it plays at its full volume
+ */
+float CAudioMixerBackend::GetMinDistance(const int iVoice)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	return pVoice ? pVoice->fMinDistance : 1.0f;
+}
+
+/**
+ @brief Move a 3D voice
+ */
+void CAudioMixerBackend::SetPosition(const int iVoice, const vec3df& vec3dfPosition)
+{
+	Voice* pVoice = GetVoice(iVoice);
+	if (pVoice)
+		pVoice->vec3dfPosition = vec3dfPosition;
+}
+
+/**
+ @brief Set the position and view direction of the listener of the 3D voices
+ */
+void CAudioMixerBackend::SetListener(const vec3df& vec3dfPosition, const vec3df& vec3dfDirection)
+{
+	vec3dfListenerPos = vec3dfPosition;
+	vec3dfListenerDir = vec3dfDirection;
+}
+
+/**
+ @brief Get the master volume
+ */
+float CAudioMixerBackend::GetMasterVolume(void)
+{
+	return fMasterVolume;
+}
+
+/**
+ @brief Set the master volume
+ */
+void CAudioMixerBackend::SetMasterVolume(const float fVolume)
+{
+	fMasterVolume = fVolume;
+}
+
+/**
+ @brief Mix the frames which are due in the time since the last frame into the mix buffer
+ @param dElapsedTime A const double variable which contains the time since the last frame, in seconds
+ */
+void CAudioMixerBackend::Update(const double dElapsedTime)
+{
+	// Carry the part of a frame which is left over, so that no time is lost to rounding
+	double dNumOfFrames = dElapsedTime * iSampleRate + dFrameRemainder;
+	unsigned int uNumOfFrames = (unsigned int)dNumOfFrames;
+	dFrameRemainder = dNumOfFrames - uNumOfFrames;
+
+	chrono::high_resolution_clock::time_point tStart = chrono::high_resolution_clock::now();
+
+	vMixBuffer.assign(uNumOfFrames * 2, 0.0f);
+	int iNumOfVoices = 0;
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if ((vVoices[i].bInUse == false) || vVoices[i].bFinished)
+			continue;
+		MixVoice(vVoices[i], uNumOfFrames);
+		iNumOfVoices++;
+	}
+
+	sStats.uNumOfFrames += uNumOfFrames;
+	if (iNumOfVoices > sStats.iPeakVoices)
+		sStats.iPeakVoices = iNumOfVoices;
+	sStats.dMixTime += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - tStart).count();
+}
+
+/**
+ @brief Get the interleaved stereo samples which were mixed in the last Update
+ */
+const std::vector<float>& CAudioMixerBackend::GetMixBuffer(void) const
+{
+	return vMixBuffer;
+}
+
+/**
+ @brief Get the statistics about the mixing
+ */
+const CAudioMixerBackend::MixStats& CAudioMixerBackend::GetStats(void) const
+{
+	return sStats;
+}
+
+/**
+ @brief Print the statistics about the mixing to the console
+ */
+void CAudioMixerBackend::PrintStats(void) const
+{
+	double dMixedTime = (double)sStats.uNumOfFrames / iSampleRate;
+	cout << "CAudioMixerBackend: " << dMixedTime << " s mixed at " << iSampleRate << " Hz, "
+		<< sStats.uNumOfPlays << " voices played, " << sStats.iPeakVoices << " at once, "
+		<< sStats.uNumOfVoiceFrames << " voice frames in " << sStats.dMixTime << " ms";
+	if (sStats.uNumOfVoiceFrames > 0)
+		cout << " (" << sStats.dMixTime * 1000000.0 / sStats.uNumOfVoiceFrames << " ns per voice frame)";
+	cout << endl;
+}
+
+/**
+ @brief Get a source by its handle
+ @return The source, or NULL if the handle is not valid
+ */
+CAudioMixerBackend::Source* CAudioMixerBackend::GetSource(const int iSource)
+{
+	if ((iSource < 0) || (iSource >= (int)vSources.size()))
+		return NULL;
+	return &vSources[iSource];
+}
+
+/**
+ @brief Get a voice by its handle
+ @return The voice, or NULL if the handle is not valid or was released
+ */
+CAudioMixerBackend::Voice* CAudioMixerBackend::GetVoice(const int iVoice)
+{
+	if ((iVoice < 0) || (iVoice >= (int)vVoices.size()) || (vVoices[iVoice].bInUse == false))
+		return NULL;
+	return &vVoices[iVoice];
+}
+
+/**
+ @brief Mix a voice into the mix buffer. The source is resampled to the mix rate by taking the nearest sample,
+		3D voices fade with the distance beyond their minimum distance and are panned by the side they are on,
+		and the voice finishes at the end of the source unless it is looped.
+ @param sVoice A Voice& variable which contains the voice
+ @param uNumOfFrames A const unsigned int variable which contains the number of frames to mix
+ */
+void CAudioMixerBackend::MixVoice(Voice& sVoice, const unsigned int uNumOfFrames)
+{
+	const Source& sSource = vSources[sVoice.iSource];
+	const int iNumOfChannels = sSource.sInfo.iNumOfChannels;
+	const double dFramesPerFrame = (double)sSource.sInfo.iSampleRate / iSampleRate;
+	const double dNumOfFrames = (double)sSource.sInfo.uNumOfFrames;
+
+	float fGain = fMasterVolume * sVoice.fVolume / 32768.0f;
+	float fLeftGain = fGain;
+	float fRightGain = fGain;
+	if (sVoice.b3D)
+	{
+		vec3df vec3dfOffset = sVoice.vec3dfPosition - vec3dfListenerPos;
+		float fDistance = (float)vec3dfOffset.getLength();
+		if (fDistance > sVoice.fMinDistance)
+			fGain *= sVoice.fMinDistance / fDistance;
+
+		// Pan by how far the voice is to the right of the view direction
+		float fPan = 0.0f;
+		vec3df vec3dfRight = vec3df(0.0f, 1.0f, 0.0f).crossProduct(vec3dfListenerDir);
+		if ((fDistance > 0.0f) && (vec3dfRight.getLength() > 0.0f))
+			fPan = (float)(vec3dfOffset.dotProduct(vec3dfRight.normalize()) / fDistance);
+		fLeftGain = fGain * (fPan > 0.0f ? 1.0f - fPan : 1.0f);
+		fRightGain = fGain * (fPan < 0.0f ? 1.0f + fPan : 1.0f);
+	}
+
+	float* pOut = vMixBuffer.empty() ? NULL : &vMixBuffer[0];
+	const short* pSamples = &sSource.vSamples[0];
+	unsigned int uFrame = 0;
+	for (; uFrame < uNumOfFrames; uFrame++)
+	{
+		if (sVoice.dFrame >= dNumOfFrames)
+		{
+			if (sVoice.bLooped == false)
+			{
+				sVoice.bFinished = true;
+				break;
+			}
+			sVoice.dFrame -= dNumOfFrames;
+		}
+
+		// A streamed source only holds the start of the file, so the frames wrap around it
+		unsigned long long uSourceFrame = (unsigned long long)sVoice.dFrame;
+		if (uSourceFrame >= sSource.uNumOfBufferFrames)
+			uSourceFrame %= sSource.uNumOfBufferFrames;
+
+		const short* pFrame = pSamples + uSourceFrame * iNumOfChannels;
+		float fLeft = pFrame[0];
+		float fRight = (iNumOfChannels > 1) ? pFrame[1] : fLeft;
+		pOut[uFrame * 2] += fLeft * fLeftGain;
+		pOut[uFrame * 2 + 1] += fRight * fRightGain;
+
+		sVoice.dFrame += dFramesPerFrame;
+	}
+	sStats.uNumOfVoiceFrames += uFrame;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+// Include AudioBackend
+#include "AudioBackend.h"
+// Include SoundFile; it reads the format and samples of a sound file
+#include "SoundFile.h"
+
+#include <vector>
+
+// Mixes the voices into a stereo buffer in memory instead of playing them on a sound device.
+// It needs no audio hardware, so it runs headless, and the mixing is timed so that audio-heavy scenes can be benchmarked.
+// 16-bit PCM WAV files are mixed from their samples. The other formats are not decoded here, so they are mixed as
+// silence of the same length, format and memory use, which keeps the timing and the voice lifetimes realistic.
+class CAudioMixerBackend : public CAudioBackend
+{
+public:
+	// Statistics about the mixing
+	struct MixStats
+	{
+		// The number of frames which were mixed
+		unsigned long long uNumOfFrames;
+		// The number of frames which were mixed for each voice, summed over the voices
+		unsigned long long uNumOfVoiceFrames;
+		// The number of voices which were played
+		unsigned int uNumOfPlays;
+		// The most voices which were mixed at once
+		int iPeakVoices;
+		// The time spent mixing, in milliseconds
+		double dMixTime;
+	};
+
+	// Constructor
+	CAudioMixerBackend(const int iSampleRate = 44100);
+	// Destructor
+	virtual ~CAudioMixerBackend(void);
+
+	virtual bool Init(void);
+	virtual const char* GetName(void) const;
+
+	virtual int LoadSource(const char* filename, const bool bStreamed, const bool bPreload);
+	virtual float GetSourceVolume(const int iSource);
+	virtual void SetSourceVolume(const int iSource, const float fVolume);
+
+	virtual int Play(const int iSource, const bool bLooped, const bool b3D, const vec3df& vec3dfPosition);
+	virtual void Stop(const int iVoice);
+	virtual bool IsFinished(const int iVoice);
+	virtual void Release(const int iVoice);
+	virtual float GetVolume(const int iVoice);
+	virtual vec3df GetPosition(const int iVoice);
+	virtual float GetMinDistance(const int iVoice);
+	virtual void SetPosition(const int iVoice, const vec3df& vec3dfPosition);
+
+	virtual void SetListener(const vec3df& vec3dfPosition, const vec3df& vec3dfDirection);
+	virtual float GetMasterVolume(void);
+	virtual void SetMasterVolume(const float fVolume);
+
+	// Mix the frames which are due in the time since the last frame
+	virtual void Update(const double dElapsedTime);
+
+	// Get the interleaved stereo samples which were mixed in the last Update
+	const std::vector<float>& GetMixBuffer(void) const;
+	// Get the statistics about the mixing
+	const MixStats& GetStats(void) const;
+	// Print the statistics about the mixing to the console
+	void PrintStats(void) const;
+
+protected:
+	// A sound file which was loaded
+	struct Source
+	{
+		SoundFileInfo sInfo;
+		// The interleaved samples. A streamed source only holds one second of them, which is looped over.
+		std::vector<short> vSamples;
+		// The number of frames in vSamples
+		unsigned long long uNumOfBufferFrames;
+		float fVolume;
+	};
+
+	// A sound which is playing
+	struct Voice
+	{
+		bool bInUse;
+		bool bFinished;
+		int iSource;
+		bool bLooped;
+		bool b3D;
+		vec3df vec3dfPosition;
+		float fVolume;
+		float fMinDistance;
+		// The frame of the source which is played next. It is fractional as the source may have another sample rate.
+		double dFrame;
+	};
+
+	// The sample rate of the mix buffer
+	int iSampleRate;
+	// The master volume
+	float fMasterVolume;
+
+	// The sources and voices, indexed by their handles, and the handles of the voices which were released
+	std::vector<Source> vSources;
+	std::vector<Voice> vVoices;
+	std::vector<int> vFreeVoices;
+
+	// The listener of the 3D voices
+	vec3df vec3dfListenerPos;
+	vec3df vec3dfListenerDir;
+
+	// The interleaved stereo samples which were mixed in the last Update
+	std::vector<float> vMixBuffer;
+	// The part of a frame which was not mixed in the last Update
+	double dFrameRemainder;
+
+	// Statistics
+	MixStats sStats;
+
+	// Get a source or a voice by its handle, or NULL
+	Source* GetSource(const int iSource);
+	Voice* GetVoice(const int iVoice);
+	// Mix a voice into the mix buffer
+	void MixVoice(Voice& sVoice, const unsigned int uNumOfFrames);
+};
@@ -0,0 +1,263 @@
+#include "IrrKlangBackend.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CIrrKlangBackend::CIrrKlangBackend(void)
+	: cSoundEngine(NULL)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CIrrKlangBackend::~CIrrKlangBackend(void)
+{
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if (vVoices[i] != NULL)
+		{
+			vVoices[i]->stop();
+			vVoices[i]->drop();
+		}
+	}
+	vVoices.clear();
+	vFreeVoices.clear();
+	vSources.clear();
+
+	// Clear the sound engine, which also deletes the ISoundSources which it owns
+	if (cSoundEngine)
+	{
+		cSoundEngine->drop();
+		cSoundEngine = NULL;
+	}
+}
+
+/**
+ @brief Create the irrKlang sound engine
+ @return true if the sound engine was created, else false
+ */
+bool CIrrKlangBackend::Init(void)
+{
+	if (cSoundEngine != NULL)
+		return true;
+
+	// Initialise the sound engine with default parameters
+	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
+	if (cSoundEngine == NULL)
+	{
+		cout << "Unable to initialise the IrrKlang sound engine" << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Get the name of this backend
+ */
+const char* CIrrKlangBackend::GetName(void) const
+{
+	return "irrKlang";
+}
+
+/**
+ @brief Load a sound file as a source
+ @param filename A const char* variable which contains the name of the file
+ @param bStreamed A const bool variable which is true if the file is streamed from the disk, else it is decoded into memory
+ @param bPreload A const bool variable which is true if the file is decoded now, instead of when it is first played
+ @return The handle of the source, or -1 if the file could not be loaded
+ */
+int CIrrKlangBackend::LoadSource(const char* filename, const bool bStreamed, const bool bPreload)
+{
+	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename,
+																	bStreamed ? E_STREAM_MODE::ESM_STREAMING : E_STREAM_MODE::ESM_NO_STREAMING,
+																	bPreload);
+	if (pSoundSource == NULL)
+		return -1;
+
+	// Force the decoded sounds not to have any streaming, however large they are
+	if (bStreamed == false)
+		pSoundSource->setForcedStreamingThreshold(-1);
+
+	vSources.push_back(pSoundSource);
+	return (int)vSources.size() - 1;
+}
+
+/**
+ @brief Get the volume which the voices of a source start at
+ */
+float CIrrKlangBackend::GetSourceVolume(const int iSource)
+{
+	ISoundSource* pSoundSource = GetSource(iSource);
+	return pSoundSource ? pSoundSource->getDefaultVolume() : 0.0f;
+}
+
+/**
+ @brief Set the volume which the voices of a source start at
+ */
+void CIrrKlangBackend::SetSourceVolume(const int iSource, const float fVolume)
+{
+	ISoundSource* pSoundSource = GetSource(iSource);
+	if (pSoundSource)
+		pSoundSource->setDefaultVolume(fVolume);
+}
+
+/**
+ @brief Start a voice of a source
+ @param iSource A const int variable which contains the handle of the source
+ @param bLooped A const bool variable which is true if the voice loops
+ @param b3D A const bool variable which is true if the voice is played at a position
+ @param vec3dfPosition A const vec3df& variable which contains the position of a 3D voice
+ @return The handle of the voice, or -1 if it could not be played
+ */
+int CIrrKlangBackend::Play(const int iSource, const bool bLooped, const bool b3D, const vec3df& vec3dfPosition)
+{
+	ISoundSource* pSoundSource = GetSource(iSource);
+	if (pSoundSource == NULL)
+		return -1;
+
+	// The voices are tracked, so that they can be stopped and queried
+	ISound* pSound = NULL;
+	if (b3D)
+		pSound = cSoundEngine->play3D(pSoundSource, vec3dfPosition, bLooped, false, true);
+	else
+		pSound = cSoundEngine->play2D(pSoundSource, bLooped, false, true);
+	if (pSound == NULL)
+		return -1;
+
+	if (vFreeVoices.empty())
+	{
+		vVoices.push_back(pSound);
+		return (int)vVoices.size() - 1;
+	}
+	int iVoice = vFreeVoices.back();
+	vFreeVoices.pop_back();
+	vVoices[iVoice] = pSound;
+	return iVoice;
+}
+
+/**
+ @brief Stop a voice
+ */
+void CIrrKlangBackend::Stop(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	if (pSound)
+		pSound->stop();
+}
+
+/**
+ @brief Check if a voice has finished playing
+ */
+bool CIrrKlangBackend::IsFinished(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	return pSound ? pSound->isFinished() : true;
+}
+
+/**
+ @brief Release a voice which is no longer needed
+ */
+void CIrrKlangBackend::Release(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	if (pSound == NULL)
+		return;
+
+	pSound->drop();
+	vVoices[iVoice] = NULL;
+	vFreeVoices.push_back(iVoice);
+}
+
+/**
+ @brief Get the volume of a voice
+ */
+float CIrrKlangBackend::GetVolume(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	return pSound ? pSound->getVolume() : 0.0f;
+}
+
+/**
+ @brief Get the position of a voice
+ */
+vec3df CIrrKlangBackend::GetPosition(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	return pSound ? pSound->getPosition() : vec3df(0.0f, 0.0f, 0.0f);
+}
+
+/**
+ @brief Get the distance from a voice within which it plays at its full volume
+ */
+float CIrrKlangBackend::GetMinDistance(const int iVoice)
+{
+	ISound* pSound = GetVoice(iVoice);
+	return pSound ? pSound->getMinDistance() : 1.0f;
+}
+
+/**
+ @brief Move a 3D voice
+ */
+void CIrrKlangBackend::SetPosition(const int iVoice, const vec3df& vec3dfPosition)
+{
+	ISound* pSound = GetVoice(iVoice);
+	if (pSound)
+		pSound->setPosition(vec3dfPosition);
+}
+
+/**
+ @brief Set the position and view direction of the listener of the 3D voices
+ */
+void CIrrKlangBackend::SetListener(const vec3df& vec3dfPosition, const vec3df& vec3dfDirection)
+{
+	cSoundEngine->setListenerPosition(vec3dfPosition, vec3dfDirection);
+}
+
+/**
+ @brief Get the master volume
+ */
+float CIrrKlangBackend::GetMasterVolume(void)
+{
+	return cSoundEngine->getSoundVolume();
+}
+
+/**
+ @brief Set the master volume
+ */
+void CIrrKlangBackend::SetMasterVolume(const float fVolume)
+{
+	cSoundEngine->setSoundVolume(fVolume);
+}
+
+/**
+ @brief Advance the engine. irrKlang mixes on its own thread, so there is nothing to do here.
+ */
+void CIrrKlangBackend::Update(const double /*dElapsedTime*/)
+{
+}
+
+/**
+ @brief Get a source by its handle
+ @return The source, or NULL if the handle is not valid
+ */
+ISoundSource* CIrrKlangBackend::GetSource(const int iSource) const
+{
+	if ((iSource < 0) || (iSource >= (int)vSources.size()))
+		return NULL;
+	return vSources[iSource];
+}
+
+/**
+ @brief Get a voice by its handle
+ @return The voice, or NULL if the handle is not valid
+ */
+ISound* CIrrKlangBackend::GetVoice(const int iVoice) const
+{
+	if ((iVoice < 0) || (iVoice >= (int)vVoices.size()))
+		return NULL;
+	return vVoices[iVoice];
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Include AudioBackend
+#include "AudioBackend.h"
+#pragma comment(lib, "irrKlang.lib") // link with irrKlang.dll
+
+#include <vector>
+
+// Plays the sounds through the irrKlang sound engine
+class CIrrKlangBackend : public CAudioBackend
+{
+public:
+	// Constructor
+	CIrrKlangBackend(void);
+	// Destructor
+	virtual ~CIrrKlangBackend(void);
+
+	virtual bool Init(void);
+	virtual const char* GetName(void) const;
+
+	virtual int LoadSource(const char* filename, const bool bStreamed, const bool bPreload);
+	virtual float GetSourceVolume(const int iSource);
+	virtual void SetSourceVolume(const int iSource, const float fVolume);
+
+	virtual int Play(const int iSource, const bool bLooped, const bool b3D, const vec3df& vec3dfPosition);
+	virtual void Stop(const int iVoice);
+	virtual bool IsFinished(const int iVoice);
+	virtual void Release(const int iVoice);
+	virtual float GetVolume(const int iVoice);
+	virtual vec3df GetPosition(const int iVoice);
+	virtual float GetMinDistance(const int iVoice);
+	virtual void SetPosition(const int iVoice, const vec3df& vec3dfPosition);
+
+	virtual void SetListener(const vec3df& vec3dfPosition, const vec3df& vec3dfDirection);
+	virtual float GetMasterVolume(void);
+	virtual void SetMasterVolume(const float fVolume);
+
+	virtual void Update(const double dElapsedTime);
+
+protected:
+	// The handler to the irrklang Sound Engine
+	ISoundEngine* cSoundEngine;
+
+	// The sources, indexed by their handles. They are owned by the sound engine.
+	std::vector<ISoundSource*> vSources;
+	// The voices, indexed by their handles, and the handles which were released
+	std::vector<ISound*> vVoices;
+	std::vector<int> vFreeVoices;
+
+	// Get a source or a voice by its handle, or NULL
+	ISoundSource* GetSource(const int iSource) const;
+	ISound* GetVoice(const int iVoice) const;
+};
@@ -1,5 +1,17 @@
 #include "SoundController.h"
 
+// Include the audio backends
+#ifdef _WIN32
+#include "IrrKlangBackend.h"
+#else
+#include "AudioMixerBackend.h"
+#endif
+
+// Include filesystem
+#include "System\filesystem.h"
+// Include Entity3D; the emitters follow them
+#include <Primitives/Entity3D.h>
+
 #include <iostream>
 using namespace std;
 
@@ -7,9 +19,12 @@ using namespace std;
  @brief Constructor
  */
 CSoundController::CSoundController(void)
-	: cSoundEngine(NULL)
+	: cAudioBackend(NULL)
 	, vec3dfListenerPos(vec3df(0, 0, 0))
 	, vec3dfListenerDir(vec3df(0, 0, 1))
+	, vSounds(NUM_SOUND_ID, (CSoundInfo*)NULL)
+	, fStreamingThreshold(5.0f)
+	, uNumOfCulled(0)
 {
 }
 
@@ -18,50 +33,90 @@ CSoundController::CSoundController(void)
  */
 CSoundController::~CSoundController(void)
 {
-	// Iterate through the entityMap
-	for (std::map<int, CSoundInfo*>::iterator it = soundMap.begin(); it != soundMap.end(); ++it)
+	// Iterate through the sounds
+	for (unsigned int i = 0; i < vSounds.size(); i++)
 	{
-		// If the value/second was not deleted elsewhere, then delete it here
-		if (it->second != NULL)
+		// If the sound was not deleted elsewhere, then delete it here
+		if (vSounds[i] != NULL)
 		{
-			delete it->second;
-			it->second = NULL;
+			delete vSounds[i];
+			vSounds[i] = NULL;
 		}
 	}
 
-	// Remove all elements in entityMap
-	soundMap.clear();
+	// Stop the voices before the audio backend is deleted
+	cVoiceManager.StopAll();
+
+	// Remove all the sounds and emitters
+	vSounds.clear();
+	vEmitters.clear();
+	vFreeEmitters.clear();
+	mapSoundSources.clear();
 
-	// Since we have already dropped the ISoundSource, then we cannot delete the cSoundEngine
-	//// Clear the sound engine
-	//if (cSoundEngine)
-	//{
-	//	cSoundEngine->drop();
-	//	cSoundEngine = NULL;
-	//}
+	// Delete the audio backend, which also deletes the sound sources which it owns
+	if (cAudioBackend)
+	{
+		delete cAudioBackend;
+		cAudioBackend = NULL;
+	}
 }
 
 /**
- @brief Initialise this class instance
+ @brief Initialise this class instance. The audio engine is only created once; calling this again does nothing.
+ @param cAudioBackend A CAudioBackend* variable which contains the audio backend to play the sounds through,
+		or NULL to use irrKlang on Windows and the offline mixer elsewhere. This class instance deletes it.
  @return A bool value. true is this class instance was initialised, else false
  */
-bool CSoundController::Init(void)
+bool CSoundController::Init(CAudioBackend* cAudioBackend)
 {
-	// Initialise the sound engine with default parameters
-	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
-	if (cSoundEngine == NULL)
+	if (this->cAudioBackend != NULL)
+	{
+		if ((cAudioBackend != NULL) && (cAudioBackend != this->cAudioBackend))
+		{
+			cout << "CSoundController::Init(): The audio backend is already initialised as "
+				<< this->cAudioBackend->GetName() << endl;
+			delete cAudioBackend;
+		}
+		return true;
+	}
+
+	if (cAudioBackend == NULL)
+	{
+#ifdef _WIN32
+		cAudioBackend = new CIrrKlangBackend();
+#else
+		cAudioBackend = new CAudioMixerBackend();
+#endif
+	}
+	if (cAudioBackend->Init() == false)
 	{
-		cout << "Unable to initialise the IrrKlang sound engine" << endl;
+		cout << "CSoundController::Init(): Unable to initialise the " << cAudioBackend->GetName() << " audio backend" << endl;
+		delete cAudioBackend;
 		return false;
 	}
+	this->cAudioBackend = cAudioBackend;
+
+	// Cap the number of sounds which play at once, so that the cost of mixing stays bounded in heavy combat
+	cVoiceManager.Init(cAudioBackend, 16);
 	return true;
 }
 
 /**
- @brief Load a sound
+ @brief Get the audio backend
+ @return The audio backend, or NULL if this class instance was not initialised
+ */
+CAudioBackend* CSoundController::GetAudioBackend(void) const
+{
+	return cAudioBackend;
+}
+
+/**
+ @brief Load a sound. Each file is only read once; loading it again for another ID, or for the same ID,
+		shares the sound source which was read the first time. Sounds which are longer than the streaming threshold,
+		such as the music, are streamed from the disk; the others are decoded into memory.
  @param filename A string variable storing the name of the file to read from
  @param ID A const int variable which will be the ID of the iSoundSource in the map
- @param bPreload A const bool variable which indicates if this iSoundSource will be pre-loaded into memory now.
+ @param bPreload A const bool variable which indicates if this iSoundSource will be pre-loaded into memory now. Streamed sounds are not preloaded.
  @param bIsLooped A const bool variable which indicates if this iSoundSource will have loop playback.
  @param eSoundType A SOUNDTYPE enum variable which states the type of sound
  @param vec3dfSoundPos A vec3df variable which contains the 3D position of the sound
@@ -74,40 +129,66 @@ bool CSoundController::LoadSound(	string filename,
 									CSoundInfo::SOUNDTYPE eSoundType,
 									vec3df vec3dfSoundPos)
 {
-	// Load the sound from the file
-	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
-																	E_STREAM_MODE::ESM_NO_STREAMING, 
-																	bPreload);
+	// Trivial Rejection : The IDs index the sounds, so they cannot be negative
+	if (ID < 0)
+	{
+		cout << "Unable to load sound " << filename.c_str() << " as #" << ID << endl;
+		return false;
+	}
 
+	// Get the sound source of the file
+	int iSource = GetSoundSource(filename, bPreload);
 
-	// Trivial Rejection : Invalid pointer provided
-	if (pSoundSource == nullptr)
+	// Trivial Rejection : The file could not be read
+	if (iSource < 0)
 	{
 		cout << "Unable to load sound " << filename.c_str() << endl;
 		return false;
 	}
 
-	// Force the sound source not to have any streaming
-	pSoundSource->setForcedStreamingThreshold(-1);
-
-	// Clean up first if there is an existing Entity with the same name
-	RemoveSound(ID);
+	// Make room for the ID
+	if ((unsigned int)ID >= vSounds.size())
+		vSounds.resize(ID + 1, (CSoundInfo*)NULL);
 
-	// Add the entity now
-	CSoundInfo* cSoundInfo = new CSoundInfo();
+	// Reuse the existing sound with the same ID, else add the sound now
+	CSoundInfo* cSoundInfo = vSounds[ID];
+	if (cSoundInfo == NULL)
+	{
+		cSoundInfo = new CSoundInfo();
+		vSounds[ID] = cSoundInfo;
+	}
 	if (eSoundType == CSoundInfo::SOUNDTYPE::_2D)
-		cSoundInfo->Init(ID, pSoundSource, bIsLooped);
+		cSoundInfo->Init(ID, iSource, bIsLooped);
 	else
-		cSoundInfo->Init(ID, pSoundSource, bIsLooped, eSoundType, vec3dfSoundPos);
+		cSoundInfo->Init(ID, iSource, bIsLooped, eSoundType, vec3dfSoundPos);
 
-	// Set to soundMap
-	soundMap[ID] = cSoundInfo;
+	return true;
+}
+
+/**
+ @brief Bind a sound ID to the file of another sound, which is already loaded. No file is read,
+		and the sound keeps its own loop status, type and position.
+ @param ID A const int variable which contains the ID of the sound to bind
+ @param iSourceID A const int variable which contains the ID of the sound whose file is to be played instead
+ @return true if the sound was bound, else false
+ */
+bool CSoundController::BindSound(const int ID, const int iSourceID)
+{
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	CSoundInfo* pSourceInfo = GetSound(iSourceID);
+	if ((pSoundInfo == nullptr) || (pSourceInfo == nullptr))
+		return false;
+
+	// The sound is already bound to this file
+	if (pSoundInfo->GetSound() == pSourceInfo->GetSound())
+		return true;
 
+	pSoundInfo->Init(ID, pSourceInfo->GetSound(), pSoundInfo->GetLoopStatus(), pSoundInfo->GetSoundType(), pSoundInfo->GetPosition());
 	return true;
 }
 
 /**
- @brief Play a sound by its ID
+ @brief Play a sound by its ID. The sound is not played if all the voices are in use by sounds with higher priorities.
  @param ID A const int variable which will be the ID of the iSoundSource in the map
  */
 void CSoundController::PlaySoundByID(const int ID)
@@ -119,17 +200,195 @@ void CSoundController::PlaySoundByID(const int ID)
 		return;
 	}
 
-	if (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_2D)
+	// Make room for the voice, stealing another if needed
+	if (cVoiceManager.Acquire(ID, pSoundInfo->GetPriority(), pSoundInfo->GetMaxInstances(), vec3dfListenerPos) == false)
+		return;
+
+	// The voices are tracked, so that they can be stopped when they are stolen.
+	// The listener is synced with the audio backend once per frame, in Update.
+	bool bIs3D = (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_3D);
+	int iVoice = cAudioBackend->Play(	pSoundInfo->GetSound(),
+										pSoundInfo->GetLoopStatus(),
+										bIs3D,
+										pSoundInfo->GetPosition());
+	cVoiceManager.Add(iVoice, ID, pSoundInfo->GetPriority(), bIs3D);
+}
+
+/**
+ @brief Add an emitter which carries 3D sounds at the position of an entity. The entity must outlive the emitter,
+		so remove the emitter, or call RemoveEmitters, before the entity is deleted.
+ @param pEntity A const CEntity3D* variable which contains the entity to follow
+ @param fMaxDistance A const float variable which contains the distance from the listener beyond which the emitter is culled.
+		irrKlang fades the sounds by fMinDistance / fDistance, so the default of 100 is where they drop to 1% of their volume.
+ @return The handle of the emitter, or -1 if there is no entity
+ */
+int CSoundController::AddEmitter(const CEntity3D* pEntity, const float fMaxDistance)
+{
+	if (pEntity == NULL)
+		return -1;
+
+	SoundEmitter sEmitter;
+	sEmitter.pEntity = pEntity;
+	sEmitter.fMaxDistance = fMaxDistance;
+
+	glm::vec3 vec3Position = pEntity->GetPosition();
+	vec3df vec3dfPosition(vec3Position.x, vec3Position.y, vec3Position.z);
+	bool bAudible = (vec3dfPosition.getDistanceFrom(vec3dfListenerPos) <= fMaxDistance);
+
+	if (vFreeEmitters.empty())
 	{
-		cSoundEngine->play2D(	pSoundInfo->GetSound(), 
-								pSoundInfo->GetLoopStatus());
+		vEmitters.push_back(sEmitter);
+		vEmitterPositions.push_back(vec3dfPosition);
+		vEmitterAudible.push_back(bAudible);
+		return (int)vEmitters.size() - 1;
 	}
-	else if (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_3D)
+	int iEmitter = vFreeEmitters.back();
+	vFreeEmitters.pop_back();
+	vEmitters[iEmitter] = sEmitter;
+	vEmitterPositions[iEmitter] = vec3dfPosition;
+	vEmitterAudible[iEmitter] = bAudible;
+	return iEmitter;
+}
+
+/**
+ @brief Remove an emitter. Its voices are not stopped; they finish where the emitter was last.
+ @param iEmitter A const int variable which contains the handle of the emitter
+ */
+void CSoundController::RemoveEmitter(const int iEmitter)
+{
+	if ((iEmitter < 0) || (iEmitter >= (int)vEmitters.size()) || (vEmitters[iEmitter].pEntity == NULL))
+		return;
+
+	cVoiceManager.DetachEmitter(iEmitter);
+	vEmitters[iEmitter].pEntity = NULL;
+	vEmitterAudible[iEmitter] = false;
+	vFreeEmitters.push_back(iEmitter);
+}
+
+/**
+ @brief Remove the emitters which are attached to an entity, before the entity is deleted
+ @param pEntity A const CEntity3D* variable which contains the entity
+ */
+void CSoundController::RemoveEmitters(const CEntity3D* pEntity)
+{
+	if (pEntity == NULL)
+		return;
+
+	for (unsigned int i = 0; i < vEmitters.size(); i++)
 	{
-		cSoundEngine->setListenerPosition(vec3dfListenerPos, vec3dfListenerDir);
-		cSoundEngine->play3D(	pSoundInfo->GetSound(), 
-								pSoundInfo->GetPosition(), 
-								pSoundInfo->GetLoopStatus());
+		if (vEmitters[i].pEntity == pEntity)
+			RemoveEmitter(i);
+	}
+}
+
+/**
+ @brief Play a 3D sound at an emitter, so that the sound moves with its entity. The sound is not sent to the audio backend
+		if the emitter is out of range of the listener, or if all the voices are in use by sounds with higher priorities.
+ @param ID A const int variable which contains the ID of the sound
+ @param iEmitter A const int variable which contains the handle of the emitter
+ */
+void CSoundController::PlaySoundAtEmitter(const int ID, const int iEmitter)
+{
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if ((!pSoundInfo) || (iEmitter < 0) || (iEmitter >= (int)vEmitters.size()) || (vEmitters[iEmitter].pEntity == NULL))
+	{
+		cout << "Sound #" << ID << " is not playable at emitter #" << iEmitter << "." << endl;
+		return;
+	}
+
+	// Use the position of the entity now, as it may have moved since the last sync
+	glm::vec3 vec3Position = vEmitters[iEmitter].pEntity->GetPosition();
+	vec3df vec3dfPosition(vec3Position.x, vec3Position.y, vec3Position.z);
+	if (vec3dfPosition.getDistanceFrom(vec3dfListenerPos) > vEmitters[iEmitter].fMaxDistance)
+	{
+		uNumOfCulled++;
+		return;
+	}
+
+	// Make room for the voice, stealing another if needed
+	if (cVoiceManager.Acquire(ID, pSoundInfo->GetPriority(), pSoundInfo->GetMaxInstances(), vec3dfListenerPos) == false)
+		return;
+
+	int iVoice = cAudioBackend->Play(pSoundInfo->GetSound(), pSoundInfo->GetLoopStatus(), true, vec3dfPosition);
+	cVoiceManager.Add(iVoice, ID, pSoundInfo->GetPriority(), true, iEmitter);
+}
+
+/**
+ @brief Set the priority of a sound, and the maximum number of voices which can play it at once.
+		When the voices run out, the voices with the lowest priorities are stolen first.
+ @param ID A const int variable which contains the ID of the sound
+ @param iPriority A const int variable which contains the priority
+ @param iMaxInstances A const int variable which contains the maximum number of voices, or 0 if there is no limit
+ @return true if the sound was found, else false
+ */
+bool CSoundController::SetSoundPriority(const int ID, const int iPriority, const int iMaxInstances)
+{
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (!pSoundInfo)
+		return false;
+
+	pSoundInfo->SetPriority(iPriority, iMaxInstances);
+	return true;
+}
+
+/**
+ @brief Set the maximum number of voices which can play at once. The voices which are playing are stopped.
+ @param iMaxVoices A const int variable which contains the maximum number of voices
+ @return true if the maximum was set, else false
+ */
+bool CSoundController::SetMaxVoices(const int iMaxVoices)
+{
+	return cVoiceManager.Init(cAudioBackend, iMaxVoices);
+}
+
+/**
+ @brief Sync the listener and the emitters with the audio backend, advance it, which mixes the voices if it is the offline mixer,
+		and release the voices which have finished playing. Call it once per frame, after the entities and the listener have moved.
+ @param dElapsedTime A const double variable which contains the time since the last frame
+ */
+void CSoundController::Update(const double dElapsedTime)
+{
+	SyncEmitters();
+	cAudioBackend->Update(dElapsedTime);
+	cVoiceManager.Update();
+}
+
+/**
+ @brief Set the length above which the sounds are streamed from the disk instead of being decoded into memory.
+		It applies to the files which are loaded after this call.
+ @param fStreamingThreshold A const float variable which contains the length, in seconds
+ */
+void CSoundController::SetStreamingThreshold(const float fStreamingThreshold)
+{
+	this->fStreamingThreshold = fStreamingThreshold;
+}
+
+/**
+ @brief Get the memory used by the decoded sounds
+ @return The number of bytes of decoded samples
+ */
+size_t CSoundController::GetBytesResident(void) const
+{
+	size_t uBytesResident = 0;
+	for (std::map<string, SoundSource>::const_iterator it = mapSoundSources.begin(); it != mapSoundSources.end(); ++it)
+		uBytesResident += it->second.uBytes;
+	return uBytesResident;
+}
+
+/**
+ @brief Print the number of sounds and voices, and the memory used by each sound file, to the console
+ */
+void CSoundController::PrintStats(void) const
+{
+	cout << "CSoundController (" << cAudioBackend->GetName() << "): " << GetNumOfSounds() << " sounds from " << mapSoundSources.size() << " files, "
+		<< GetBytesResident() / 1024 << " KB decoded, "
+		<< cVoiceManager.GetNumOfVoices() << "/" << cVoiceManager.GetMaxVoices() << " voices, "
+		<< cVoiceManager.GetNumOfStolen() << " stolen, " << cVoiceManager.GetNumOfRejected() << " rejected, "
+		<< vEmitters.size() - vFreeEmitters.size() << " emitters, " << uNumOfCulled << " culled" << endl;
+	for (std::map<string, SoundSource>::const_iterator it = mapSoundSources.begin(); it != mapSoundSources.end(); ++it)
+	{
+		cout << "\t" << it->first << ": " << it->second.fDuration << " s, "
+			<< (it->second.bStreamed ? "streamed" : "decoded") << ", " << it->second.uBytes / 1024 << " KB" << endl;
 	}
 }
 
@@ -140,14 +399,14 @@ void CSoundController::PlaySoundByID(const int ID)
 bool CSoundController::MasterVolumeIncrease(void)
 {
 	// Get the current volume
-	float fCurrentVolume = cSoundEngine->getSoundVolume();
+	float fCurrentVolume = cAudioBackend->GetMasterVolume();
 
 	// Check if the maximum volume has been reached
 	if (fCurrentVolume == 1.0f)
 		return false;
 
 	// Increase the volume by 10%
-	cSoundEngine->setSoundVolume(fCurrentVolume + 0.1f);
+	cAudioBackend->SetMasterVolume(fCurrentVolume + 0.1f);
 
 	return true;
 }
@@ -159,75 +418,77 @@ bool CSoundController::MasterVolumeIncrease(void)
 bool CSoundController::MasterVolumeDecrease(void)
 {
 	// Get the current volume
-	float fCurrentVolume = cSoundEngine->getSoundVolume();
+	float fCurrentVolume = cAudioBackend->GetMasterVolume();
 
 	// Check if the minimum volume has been reached
 	if (fCurrentVolume == 0.0f)
 		return false;
 
 	// Decrease the volume by 10%
-	cSoundEngine->setSoundVolume(fCurrentVolume - 0.1f);
+	cAudioBackend->SetMasterVolume(fCurrentVolume - 0.1f);
 
 	return true;
 }
 
 
 /**
- @brief Increase volume of a ISoundSource
+ @brief Increase volume of a sound source
  @param ID A const int variable which contains the ID of the iSoundSource in the map
  @return true if successfully decreased volume, else false
  */
 bool CSoundController::VolumeIncrease(const int ID)
 {
-	// Get the ISoundSource
-	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
-	if (pISoundSource != nullptr)
+	// Get the sound source
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
 	{
 		return false;
 	}
+	int iSource = pSoundInfo->GetSound();
 
 	// Get the current volume
-	float fCurrentVolume = pISoundSource->getDefaultVolume();
+	float fCurrentVolume = cAudioBackend->GetSourceVolume(iSource);
 
 	// Check if the maximum volume has been reached
 	if (fCurrentVolume >= 1.0f)
 	{
-		pISoundSource->setDefaultVolume(1.0f);
+		cAudioBackend->SetSourceVolume(iSource, 1.0f);
 		return false;
 	}
 
 	// Increase the volume by 10%
-	pISoundSource->setDefaultVolume(fCurrentVolume + 0.1f);
+	cAudioBackend->SetSourceVolume(iSource, fCurrentVolume + 0.1f);
 
 	return true;
 }
 
 /**
- @brief Decrease volume of a ISoundSource
+ @brief Decrease volume of a sound source
  @param ID A const int variable which contains the ID of the iSoundSource in the map
  @return true if successfully decreased volume, else false
  */
 bool CSoundController::VolumeDecrease(const int ID)
 {
-	// Get the ISoundSource
-	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
-	if (pISoundSource != nullptr)
+	// Get the sound source
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
 	{
 		return false;
 	}
+	int iSource = pSoundInfo->GetSound();
 
 	// Get the current volume
-	float fCurrentVolume = pISoundSource->getDefaultVolume();
+	float fCurrentVolume = cAudioBackend->GetSourceVolume(iSource);
 
 	// Check if the minimum volume has been reached
 	if (fCurrentVolume <= 0.0f)
 	{
-		pISoundSource->setDefaultVolume(0.0f);
+		cAudioBackend->SetSourceVolume(iSource, 0.0f);
 		return false;
 	}
 
 	// Decrease the volume by 10%
-	pISoundSource->setDefaultVolume(fCurrentVolume - 0.1f);
+	cAudioBackend->SetSourceVolume(iSource, fCurrentVolume - 0.1f);
 
 	return true;
 }
@@ -262,8 +523,8 @@ void CSoundController::SetListenerDirection(const float x, const float y, const
  */
 CSoundInfo* CSoundController::GetSound(const int ID)
 {
-	if (soundMap.count(ID) != 0)
-		return soundMap[ID];
+	if ((ID >= 0) && ((unsigned int)ID < vSounds.size()))
+		return vSounds[ID];
 
 	return nullptr;
 }
@@ -279,7 +540,7 @@ bool CSoundController::RemoveSound(const int ID)
 	if (pSoundInfo != nullptr)
 	{
 		delete pSoundInfo;
-		soundMap.erase(ID);
+		vSounds[ID] = NULL;
 		return true;
 	}
 	return false;
@@ -291,5 +552,71 @@ bool CSoundController::RemoveSound(const int ID)
 */
 int CSoundController::GetNumOfSounds(void) const
 {
-	return soundMap.size();
-}
\ No newline at end of file
+	int iNumOfSounds = 0;
+	for (unsigned int i = 0; i < vSounds.size(); i++)
+	{
+		if (vSounds[i] != NULL)
+			iNumOfSounds++;
+	}
+	return iNumOfSounds;
+}
+
+/**
+ @brief Get the sound source of a file. The file is only read the first time; after that, its sound source is returned.
+		The length of the file is read from its headers to decide if it is streamed or decoded into memory.
+ @param filename A const string& variable storing the name of the file to read from
+ @param bPreload A const bool variable which indicates if the file will be decoded into memory now
+ @return The handle of the sound source, or -1 if the file could not be read
+ */
+int CSoundController::GetSoundSource(const string& filename, const bool bPreload)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+	std::map<string, SoundSource>::iterator it = mapSoundSources.find(strPath);
+	if (it != mapSoundSources.end())
+		return it->second.iSource;
+
+	SoundSource sSource;
+	sSource.bStreamed = false;
+	sSource.fDuration = 0.0f;
+	sSource.uBytes = 0;
+
+	// Stream the long sounds. A file whose length cannot be read is decoded into memory, as all sounds were before.
+	SoundFileInfo sFileInfo;
+	if (ReadSoundFileInfo(filename.c_str(), sFileInfo))
+	{
+		sSource.fDuration = sFileInfo.fDuration;
+		sSource.bStreamed = (sFileInfo.fDuration > fStreamingThreshold);
+		sSource.uBytes = sSource.bStreamed ? 0 : sFileInfo.uDecodedBytes;
+	}
+
+	// Load the sound from the file
+	sSource.iSource = cAudioBackend->LoadSource(filename.c_str(), sSource.bStreamed, bPreload && !sSource.bStreamed);
+	if (sSource.iSource < 0)
+		return -1;
+
+	mapSoundSources[strPath] = sSource;
+	return sSource.iSource;
+}
+
+/**
+ @brief Sync the listener and the positions of the emitters with the audio backend, in one batch. The positions of all the
+		emitters are read from their entities first, then the emitters beyond their maximum distance from the listener are culled,
+		and only the voices of the others are moved in the audio backend.
+ */
+void CSoundController::SyncEmitters(void)
+{
+	cAudioBackend->SetListener(vec3dfListenerPos, vec3dfListenerDir);
+
+	for (unsigned int i = 0; i < vEmitters.size(); i++)
+	{
+		const CEntity3D* pEntity = vEmitters[i].pEntity;
+		if (pEntity == NULL)
+			continue;
+
+		glm::vec3 vec3Position = pEntity->GetPosition();
+		vEmitterPositions[i].set(vec3Position.x, vec3Position.y, vec3Position.z);
+		vEmitterAudible[i] = (vEmitterPositions[i].getDistanceFrom(vec3dfListenerPos) <= vEmitters[i].fMaxDistance);
+	}
+
+	cVoiceManager.MoveVoices(vEmitterPositions, vEmitterAudible);
+}
@@ -17,19 +17,50 @@ using namespace irrklang;
 #include <string>
 // Include map storage
 #include <map>
+// Include vector storage
+#include <vector>
 using namespace std;
 
 // Include SoundInfo class; it stores the sound and other information
 #include "SoundInfo.h"
+// Include VoiceManager class; it caps the number of sounds which play at once
+#include "VoiceManager.h"
+// Include SoundFile; it reads the length of a sound file
+#include "SoundFile.h"
+// Include AudioBackend; it plays the sounds
+#include "AudioBackend.h"
+
+// The entities which the sound emitters are attached to
+class CEntity3D;
+
+// The IDs of the sounds in the game. They index the sounds directly, so keep them small and dense.
+enum SOUND_ID
+{
+	SOUND_NONE = 0,
+	SOUND_DAMAGE,
+	SOUND_WALLBUMP,
+	SOUND_PISTOL_SHOT,
+	SOUND_RIFLE_SHOT,
+	SOUND_LOSE,
+	SOUND_WIN,
+	SOUND_BOSS_MUSIC,
+	SOUND_PISTOL_RELOAD,
+	SOUND_RIFLE_RELOAD,
+	SOUND_DUD,
+	NUM_SOUND_ID
+};
 
 class CSoundController : public CSingletonTemplate<CSoundController>
 {
 	friend CSingletonTemplate<CSoundController>;
 public:
-	// Initialise this class instance
-	bool Init(void);
+	// Initialise this class instance with an audio backend, which this class instance then owns.
+	// If none is given, irrKlang is used on Windows and the offline mixer elsewhere.
+	bool Init(CAudioBackend* cAudioBackend = NULL);
+	// Get the audio backend
+	CAudioBackend* GetAudioBackend(void) const;
 
-	// Load a sound
+	// Load a sound. Short sounds are decoded into memory, and long sounds are streamed from the disk.
 	bool LoadSound(	string filename, 
 					const int ID,
 					const bool bPreload = true,
@@ -37,17 +68,43 @@ public:
 					CSoundInfo::SOUNDTYPE eSoundType = CSoundInfo::SOUNDTYPE::_2D,
 					vec3df vec3dfSoundPos = vec3df(0.0f, 0.0f, 0.0f));
 
+	// Bind a sound ID to the file of another sound, which is already loaded
+	bool BindSound(const int ID, const int iSourceID);
+
 	// Play a sound by its ID
 	void PlaySoundByID(const int ID);
 
+	// Add an emitter which carries 3D sounds at the position of an entity. It is culled beyond fMaxDistance from the listener.
+	int AddEmitter(const CEntity3D* pEntity, const float fMaxDistance = 100.0f);
+	// Remove an emitter. Its voices finish where it was last.
+	void RemoveEmitter(const int iEmitter);
+	// Remove the emitters which are attached to an entity, before the entity is deleted
+	void RemoveEmitters(const CEntity3D* pEntity);
+	// Play a 3D sound at an emitter, so that the sound moves with its entity
+	void PlaySoundAtEmitter(const int ID, const int iEmitter);
+
+	// Set the priority of a sound, and the maximum number of voices which can play it at once
+	bool SetSoundPriority(const int ID, const int iPriority, const int iMaxInstances);
+	// Set the maximum number of voices which can play at once
+	bool SetMaxVoices(const int iMaxVoices);
+	// Sync the listener and the emitters with the audio backend, advance it and release the voices which have finished playing
+	void Update(const double dElapsedTime);
+	// Set the length, in seconds, above which the sounds are streamed from the disk instead of being decoded into memory
+	void SetStreamingThreshold(const float fStreamingThreshold);
+	// Get the memory used by the decoded sounds
+	size_t GetBytesResident(void) const;
+
+	// Print the number of sounds and voices, and the memory used by each sound file, to the console
+	void PrintStats(void) const;
+
 	// Increase Master volume
 	bool MasterVolumeIncrease(void);
 	// Decrease Master volume
 	bool MasterVolumeDecrease(void);
 
-	// Increase volume of a ISoundSource
+	// Increase volume of a sound source
 	bool VolumeIncrease(const int ID);
-	// Decrease volume of a ISoundSource
+	// Decrease volume of a sound source
 	bool VolumeDecrease(const int ID);
 
 	// For 3D sounds only
@@ -70,11 +127,55 @@ protected:
 	// Get the number of sounds in this map
 	int GetNumOfSounds(void) const;
 
-	// The handler to the irrklang Sound Engine
-	ISoundEngine* cSoundEngine;
-
-	// The map of all the entity created
-	std::map<int, CSoundInfo*> soundMap;
+	// Get the handle of the sound source of a file, reading the file only if it was not read before
+	int GetSoundSource(const string& filename, const bool bPreload);
+
+	// A sound file which was read
+	struct SoundSource
+	{
+		// The handle of the source in the CAudioBackend
+		int iSource;
+		// true if the file is streamed from the disk, else it is decoded into memory
+		bool bStreamed;
+		// The length of the sound, in seconds, or 0 if it could not be read
+		float fDuration;
+		// The memory used by the decoded samples. Streamed sounds only use a small buffer for each voice.
+		size_t uBytes;
+	};
+
+	// Sync the listener and the positions of the emitters with the audio backend, in one batch
+	void SyncEmitters(void);
+
+	// An emitter of 3D sounds, which follows an entity
+	struct SoundEmitter
+	{
+		// The entity which carries the emitter, or NULL if the emitter was removed
+		const CEntity3D* pEntity;
+		// The distance from the listener beyond which the emitter is inaudible, so it is culled
+		float fMaxDistance;
+	};
+
+	// The audio engine which plays the sounds
+	CAudioBackend* cAudioBackend;
+
+	// The voices which are playing
+	CVoiceManager cVoiceManager;
+
+	// The sounds, indexed by their IDs. An ID which has no sound holds NULL.
+	std::vector<CSoundInfo*> vSounds;
+	// The sound sources which were read, by their canonical file paths. They are shared by all the sounds which use the same file.
+	std::map<string, SoundSource> mapSoundSources;
+	// The length, in seconds, above which the sounds are streamed
+	float fStreamingThreshold;
+
+	// The emitters, indexed by their handles, and the handles which were removed
+	std::vector<SoundEmitter> vEmitters;
+	std::vector<int> vFreeEmitters;
+	// The positions of the emitters, and whether they are within range of the listener, as of the last sync
+	std::vector<vec3df> vEmitterPositions;
+	std::vector<bool> vEmitterAudible;
+	// The number of sounds which were not played at an emitter as it was out of range
+	unsigned int uNumOfCulled;
 
 	// For 3D sound only: Listener position
 	vec3df vec3dfListenerPos;
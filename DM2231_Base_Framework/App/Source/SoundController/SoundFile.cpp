@@ -0,0 +1,170 @@
+#include "SoundFile.h"
+
+#include <fstream>
+#include <vector>
+#include <cstring>
+using namespace std;
+
+// An Ogg page is never longer than this, so the last page of a file starts within this many bytes of its end
+static const size_t OGG_MAX_PAGE_SIZE = 65307;
+
+/**
+ @brief Read a little-endian integer
+ */
+static unsigned long long ReadLE(const unsigned char* pData, const int iNumOfBytes)
+{
+	unsigned long long uValue = 0;
+	for (int i = iNumOfBytes - 1; i >= 0; i--)
+		uValue = (uValue << 8) | pData[i];
+	return uValue;
+}
+
+/**
+ @brief Read the format and length of an Ogg Vorbis file. The format is in the identification header
+		at the start of the file, and the length is the granule position of the last page.
+ @param file An ifstream& variable which contains the open file
+ @param uFileSize A const size_t variable which contains the size of the file
+ @param sInfo A SoundFileInfo& variable which returns the format and length
+ @return true if the file was read, else false
+ */
+static bool ReadOggInfo(ifstream& file, const size_t uFileSize, SoundFileInfo& sInfo)
+{
+	// The identification header is in the first page: "\x01vorbis", the version, then the channels and the sample rate
+	vector<unsigned char> vHead(uFileSize < 4096 ? uFileSize : 4096);
+	file.seekg(0);
+	file.read((char*)&vHead[0], vHead.size());
+	const unsigned char* pHeader = NULL;
+	for (size_t i = 0; i + 16 <= vHead.size(); i++)
+	{
+		if ((vHead[i] == 1) && (memcmp(&vHead[i + 1], "vorbis", 6) == 0))
+		{
+			pHeader = &vHead[i];
+			break;
+		}
+	}
+	if (pHeader == NULL)
+		return false;
+	sInfo.iNumOfChannels = pHeader[11];
+	sInfo.iSampleRate = (int)ReadLE(pHeader + 12, 4);
+
+	// The granule position of the last page is the number of samples in each channel
+	size_t uTailSize = (uFileSize < OGG_MAX_PAGE_SIZE) ? uFileSize : OGG_MAX_PAGE_SIZE;
+	vector<unsigned char> vTail(uTailSize);
+	file.seekg(uFileSize - uTailSize);
+	file.read((char*)&vTail[0], uTailSize);
+	for (size_t i = uTailSize >= 14 ? uTailSize - 14 : 0; i-- > 0;)
+	{
+		if (memcmp(&vTail[i], "OggS", 4) == 0)
+		{
+			sInfo.uNumOfFrames = ReadLE(&vTail[i + 6], 8);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ @brief Read the format and length of a WAV file from its fmt and data chunks, leaving the file at the start of the samples
+ @param file An ifstream& variable which contains the open file
+ @param sInfo A SoundFileInfo& variable which returns the format and length
+ @param iBitsPerSample An int& variable which returns the size of each sample, in bits
+ @return true if the file was read, else false
+ */
+static bool ReadWavInfo(ifstream& file, SoundFileInfo& sInfo, int& iBitsPerSample)
+{
+	unsigned char cChunk[8];
+	int iBytesPerFrame = 0;
+	file.seekg(12);
+	while (file.read((char*)cChunk, 8))
+	{
+		unsigned long long uChunkSize = ReadLE(cChunk + 4, 4);
+		if (memcmp(cChunk, "fmt ", 4) == 0)
+		{
+			unsigned char cFormat[16];
+			if (!file.read((char*)cFormat, 16))
+				return false;
+			sInfo.iNumOfChannels = (int)ReadLE(cFormat + 2, 2);
+			sInfo.iSampleRate = (int)ReadLE(cFormat + 4, 4);
+			iBytesPerFrame = (int)ReadLE(cFormat + 12, 2);
+			iBitsPerSample = (int)ReadLE(cFormat + 14, 2);
+			file.seekg(uChunkSize - 16 + (uChunkSize & 1), ios::cur);
+		}
+		else if (memcmp(cChunk, "data", 4) == 0)
+		{
+			if (iBytesPerFrame <= 0)
+				return false;
+			sInfo.uNumOfFrames = uChunkSize / iBytesPerFrame;
+			return true;
+		}
+		else
+			file.seekg(uChunkSize + (uChunkSize & 1), ios::cur);
+	}
+	return false;
+}
+
+/**
+ @brief Read the format and length of an Ogg Vorbis or WAV file, without decoding it
+ @param filename A const char* variable which contains the name of the file
+ @param sInfo A SoundFileInfo& variable which returns the format and length
+ @return true if the file was read, else false
+ */
+bool ReadSoundFileInfo(const char* filename, SoundFileInfo& sInfo)
+{
+	memset(&sInfo, 0, sizeof(sInfo));
+
+	ifstream file(filename, ios::binary);
+	if (!file.is_open())
+		return false;
+	file.seekg(0, ios::end);
+	size_t uFileSize = (size_t)file.tellg();
+	if (uFileSize < 16)
+		return false;
+
+	char cMagic[4];
+	file.seekg(0);
+	file.read(cMagic, 4);
+
+	bool bRead = false;
+	if (memcmp(cMagic, "OggS", 4) == 0)
+		bRead = ReadOggInfo(file, uFileSize, sInfo);
+	else if (memcmp(cMagic, "RIFF", 4) == 0)
+	{
+		int iBitsPerSample = 0;
+		bRead = ReadWavInfo(file, sInfo, iBitsPerSample);
+	}
+	if ((bRead == false) || (sInfo.iNumOfChannels <= 0) || (sInfo.iSampleRate <= 0))
+		return false;
+
+	sInfo.fDuration = (float)((double)sInfo.uNumOfFrames / sInfo.iSampleRate);
+	sInfo.uDecodedBytes = (size_t)(sInfo.uNumOfFrames * sInfo.iNumOfChannels * 2);
+	return true;
+}
+
+/**
+ @brief Read the interleaved samples of a 16-bit PCM WAV file
+ @param filename A const char* variable which contains the name of the file
+ @param vSamples A std::vector<short>& variable which returns the samples
+ @return true if the file was read, else false
+ */
+bool ReadWavSamples(const char* filename, std::vector<short>& vSamples)
+{
+	ifstream file(filename, ios::binary);
+	if (!file.is_open())
+		return false;
+
+	char cMagic[4];
+	if (!file.read(cMagic, 4) || (memcmp(cMagic, "RIFF", 4) != 0))
+		return false;
+
+	SoundFileInfo sInfo;
+	memset(&sInfo, 0, sizeof(sInfo));
+	int iBitsPerSample = 0;
+	if ((ReadWavInfo(file, sInfo, iBitsPerSample) == false) || (iBitsPerSample != 16) || (sInfo.iNumOfChannels <= 0))
+		return false;
+
+	vSamples.resize((size_t)(sInfo.uNumOfFrames * sInfo.iNumOfChannels));
+	if (vSamples.empty())
+		return true;
+	// The samples are little-endian, like the machines which this runs on
+	return (bool)file.read((char*)&vSamples[0], vSamples.size() * sizeof(short));
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// The format and length of a sound file, read from its headers without decoding it
+struct SoundFileInfo
+{
+	int iNumOfChannels;
+	int iSampleRate;
+	// The number of samples in each channel
+	unsigned long long uNumOfFrames;
+	// The length of the sound, in seconds
+	float fDuration;
+	// The memory which the sound takes when it is decoded into 16-bit samples
+	size_t uDecodedBytes;
+};
+
+// Read the format and length of an Ogg Vorbis or WAV file
+bool ReadSoundFileInfo(const char* filename, SoundFileInfo& sInfo);
+
+// Read the interleaved samples of a 16-bit PCM WAV file
+bool ReadWavSamples(const char* filename, std::vector<short>& vSamples);
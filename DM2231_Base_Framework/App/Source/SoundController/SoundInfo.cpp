@@ -8,9 +8,11 @@ using namespace std;
  */
 CSoundInfo::CSoundInfo(void)
 	: ID(-1)
-	, pSoundSource(NULL)
+	, iSource(-1)
 	, bIsLooped(false)
 	, eSoundType(_2D)
+	, iPriority(0)
+	, iMaxInstances(0)
 	, vec3dfSoundPos(vec3df(0.0, 0.0, 0.0))
 {
 }
@@ -20,31 +22,27 @@ CSoundInfo::CSoundInfo(void)
  */
 CSoundInfo::~CSoundInfo(void)
 {
-	// Clear the memory before destroying this class instance
-	if (pSoundSource != NULL)
-	{
-		pSoundSource->drop();
-		pSoundSource = NULL;
-	}
+	// The sound source is owned by the CAudioBackend, and may be shared with other sounds, so it is not released here
+	iSource = -1;
 }
 
 /**
  @brief Initialise this class instance
  @param ID A const int variable which will be the ID of the iSoundSource in the map
- @param pSoundSource A ISoundSource* variable which contains the iSoundSource
+ @param iSource A const int variable which contains the handle of the sound source in the CAudioBackend
  @param bIsLooped A const bool variable which indicates if this iSoundSource will have loop playback.
  @param eSoundType A SOUNDTYPE enum variable which states the type of sound
  @param vec3dfSoundPos A vec3df variable which contains the 3D position of the sound
  @return A bool value. true is this class instance was initialised, else false
  */
 bool CSoundInfo::Init(	const int ID,
-						ISoundSource* pSoundSource,
+						const int iSource,
 						const bool bIsLooped,
 						SOUNDTYPE eSoundType,
 						vec3df vec3dfSoundPos)
 {
 	this->ID = ID;
-	this->pSoundSource = pSoundSource;
+	this->iSource = iSource;
 	this->bIsLooped = bIsLooped;
 	this->eSoundType = eSoundType;
 	this->vec3dfSoundPos = vec3dfSoundPos;
@@ -53,12 +51,12 @@ bool CSoundInfo::Init(	const int ID,
 }
 
 /**
- @brief Get an sound from this class
- @return The iSoundSource stored in this class instance
+ @brief Get the handle of the sound source in the CAudioBackend
+ @return The handle of the sound source stored in this class instance
  */
-ISoundSource* CSoundInfo::GetSound(void) const
+int CSoundInfo::GetSound(void) const
 {
-	return pSoundSource;
+	return iSource;
 }
 
 /**
@@ -80,47 +78,32 @@ CSoundInfo::SOUNDTYPE CSoundInfo::GetSoundType(void) const
 }
 
 /**
- @brief Increase volume of a ISoundSource
- @return true if successfully decreased volume, else false
+ @brief Set the priority, and the maximum number of voices which can play this sound at once
+ @param iPriority A const int variable which contains the priority
+ @param iMaxInstances A const int variable which contains the maximum number of voices, or 0 if there is no limit
  */
-bool CSoundInfo::VolumeIncrease(void)
+void CSoundInfo::SetPriority(const int iPriority, const int iMaxInstances)
 {
-	// Get the current volume
-	float fCurrentVolume = pSoundSource->getDefaultVolume();
-
-	// Check if the maximum volume has been reached
-	if (fCurrentVolume >= 1.0f)
-	{
-		pSoundSource->setDefaultVolume(1.0f);
-		return false;
-	}
-
-	// Increase the volume by 10%
-	pSoundSource->setDefaultVolume(fCurrentVolume + 0.1f);
-
-	return true;
+	this->iPriority = iPriority;
+	this->iMaxInstances = iMaxInstances;
 }
 
 /**
- @brief Decrease volume of a ISoundSource
- @return true if successfully decreased volume, else false
+ @brief Get the priority
+ @return iPriority value
  */
-bool CSoundInfo::VolumeDecrease(void)
+int CSoundInfo::GetPriority(void) const
 {
-	// Get the current volume
-	float fCurrentVolume = pSoundSource->getDefaultVolume();
-
-	// Check if the minimum volume has been reached
-	if (fCurrentVolume <= 0.0f)
-	{
-		pSoundSource->setDefaultVolume(0.0f);
-		return false;
-	}
-
-	// Decrease the volume by 10%
-	pSoundSource->setDefaultVolume(fCurrentVolume - 0.1f);
+	return iPriority;
+}
 
-	return true;
+/**
+ @brief Get the maximum number of voices which can play this sound at once
+ @return iMaxInstances value
+ */
+int CSoundInfo::GetMaxInstances(void) const
+{
+	return iMaxInstances;
 }
 
 // For 3D sounds only
@@ -28,13 +28,13 @@ public:
 
 	// Initialise this class instance
 	bool Init(	const int ID, 
-				ISoundSource* pSoundSource, 
+				const int iSource, 
 				const bool bIsLooped = false, 
 				SOUNDTYPE eSoundType = _2D,
 				vec3df vec3dfSoundPos = vec3df(0.0f, 0.0f, 0.0f));
 
-	// Get an sound from this map
-	ISoundSource* GetSound(void) const;
+	// Get the handle of the sound source in the CAudioBackend
+	int GetSound(void) const;
 
 	// Get loop status
 	bool GetLoopStatus(void) const;
@@ -42,10 +42,12 @@ public:
 	// Get sound type
 	SOUNDTYPE GetSoundType(void) const;
 
-	// Increase volume of a ISoundSource
-	bool VolumeIncrease(void);
-	// Decrease volume of a ISoundSource
-	bool VolumeDecrease(void);
+	// Set the priority, and the maximum number of voices which can play this sound at once
+	void SetPriority(const int iPriority, const int iMaxInstances);
+	// Get the priority
+	int GetPriority(void) const;
+	// Get the maximum number of voices which can play this sound at once, or 0 if there is no limit
+	int GetMaxInstances(void) const;
 
 	// For 3D sounds only
 	// Set position
@@ -58,8 +60,8 @@ protected:
 	// ID for this sound
 	int ID;
 
-	// The handler to the irrklang Sound Engine
-	ISoundSource* pSoundSource;
+	// The handle of the sound source in the CAudioBackend. It may be shared with other sounds.
+	int iSource;
 
 	// Indicate if this sound will be looped during playback
 	bool bIsLooped;
@@ -67,6 +69,11 @@ protected:
 	// Sound type
 	SOUNDTYPE eSoundType;
 
+	// The priority of the voices of this sound; voices with higher priorities are kept when voices must be stolen
+	int iPriority;
+	// The maximum number of voices which can play this sound at once, or 0 if there is no limit
+	int iMaxInstances;
+
 	// For 3D sound only: Sound position
 	vec3df vec3dfSoundPos;
 };
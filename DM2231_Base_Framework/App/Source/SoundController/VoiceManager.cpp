@@ -0,0 +1,298 @@
+#include "VoiceManager.h"
+
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CVoiceManager::CVoiceManager(void)
+	: cAudioBackend(NULL)
+	, iMaxVoices(16)
+	, uNextSequence(0)
+	, uNumOfStolen(0)
+	, uNumOfRejected(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CVoiceManager::~CVoiceManager(void)
+{
+	StopAll();
+}
+
+/**
+ @brief Initialise this class instance
+ @param cAudioBackend A CAudioBackend* variable which contains the audio engine which plays the voices
+ @param iMaxVoices A const int variable which contains the maximum number of voices which can play at once
+ @return A bool value. true is this class instance was initialised, else false
+ */
+bool CVoiceManager::Init(CAudioBackend* cAudioBackend, const int iMaxVoices)
+{
+	if (cAudioBackend == NULL)
+	{
+		cout << "CVoiceManager::Init(): There is no audio backend" << endl;
+		return false;
+	}
+	if (iMaxVoices <= 0)
+	{
+		cout << "CVoiceManager::Init(): The maximum number of voices must be more than 0" << endl;
+		return false;
+	}
+
+	StopAll();
+	this->cAudioBackend = cAudioBackend;
+	this->iMaxVoices = iMaxVoices;
+	uNumOfStolen = 0;
+	uNumOfRejected = 0;
+	vVoices.reserve(iMaxVoices);
+	return true;
+}
+
+/**
+ @brief Make room for a new voice of a sound. If the sound has iMaxInstances voices already, its quietest or oldest voice
+		is stopped. If all the voices are in use, the voice with the lowest priority, then the quietest, then the oldest
+		is stopped, but only if its priority is not higher than that of the new voice.
+ @param ID A const int variable which contains the ID of the sound
+ @param iPriority A const int variable which contains the priority of the sound. Higher priorities are kept over lower ones.
+ @param iMaxInstances A const int variable which contains the maximum number of voices of this sound
+ @param vec3dfListenerPos A const vec3df& variable which contains the position of the listener, to work out how loud the 3D voices are
+ @return true if the sound can be played, else false
+ */
+bool CVoiceManager::Acquire(const int ID,
+							const int iPriority,
+							const int iMaxInstances,
+							const vec3df& vec3dfListenerPos)
+{
+	Update();
+
+	// Replace a voice of the same sound if it has too many
+	int iNumOfInstances = 0;
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if (vVoices[i].ID == ID)
+			iNumOfInstances++;
+	}
+	if ((iMaxInstances > 0) && (iNumOfInstances >= iMaxInstances))
+	{
+		Stop(FindVictim(ID, iPriority, vec3dfListenerPos));
+		uNumOfStolen++;
+		return true;
+	}
+
+	if ((int)vVoices.size() < iMaxVoices)
+		return true;
+
+	// Steal a voice which is not more important than the new one
+	int iVictim = FindVictim(-1, iPriority, vec3dfListenerPos);
+	if (iVictim < 0)
+	{
+		uNumOfRejected++;
+		return false;
+	}
+	Stop(iVictim);
+	uNumOfStolen++;
+	return true;
+}
+
+/**
+ @brief Keep track of a voice which was started after Acquire returned true
+ @param iVoice A const int variable which contains the handle of the voice in the CAudioBackend
+ @param ID A const int variable which contains the ID of the sound
+ @param iPriority A const int variable which contains the priority of the sound
+ @param bIs3D A const bool variable which is true if the voice was played in 3D
+ @param iEmitter A const int variable which contains the emitter which carries the voice, or -1 if it does not move
+ */
+void CVoiceManager::Add(const int iVoice, const int ID, const int iPriority, const bool bIs3D, const int iEmitter)
+{
+	if (iVoice < 0)
+		return;
+
+	Voice sVoice;
+	sVoice.iVoice = iVoice;
+	sVoice.ID = ID;
+	sVoice.iPriority = iPriority;
+	sVoice.bIs3D = bIs3D;
+	sVoice.iEmitter = iEmitter;
+	sVoice.uSequence = uNextSequence++;
+	vVoices.push_back(sVoice);
+}
+
+/**
+ @brief Release the voices which have finished playing
+ */
+void CVoiceManager::Update(void)
+{
+	if (cAudioBackend == NULL)
+		return;
+
+	unsigned int uNumOfPlaying = 0;
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if (cAudioBackend->IsFinished(vVoices[i].iVoice))
+		{
+			cAudioBackend->Release(vVoices[i].iVoice);
+			continue;
+		}
+		vVoices[uNumOfPlaying++] = vVoices[i];
+	}
+	vVoices.resize(uNumOfPlaying);
+}
+
+/**
+ @brief Move the voices which are attached to emitters to the positions of their emitters, in one pass over the voices.
+		The voices of the emitters which are culled are not moved, so that nothing is sent to the audio backend for them.
+ @param vEmitterPositions A const std::vector<vec3df>& variable which contains the positions of the emitters, indexed by their handles
+ @param vEmitterAudible A const std::vector<bool>& variable which is true for the emitters which are not culled
+ */
+void CVoiceManager::MoveVoices(const std::vector<vec3df>& vEmitterPositions, const std::vector<bool>& vEmitterAudible)
+{
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		int iEmitter = vVoices[i].iEmitter;
+		if ((iEmitter < 0) || (iEmitter >= (int)vEmitterPositions.size()) || (vEmitterAudible[iEmitter] == false))
+			continue;
+		cAudioBackend->SetPosition(vVoices[i].iVoice, vEmitterPositions[iEmitter]);
+	}
+}
+
+/**
+ @brief Stop moving the voices of an emitter, so that they finish where the emitter was last
+ @param iEmitter A const int variable which contains the handle of the emitter
+ */
+void CVoiceManager::DetachEmitter(const int iEmitter)
+{
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if (vVoices[i].iEmitter == iEmitter)
+			vVoices[i].iEmitter = -1;
+	}
+}
+
+/**
+ @brief Stop all the voices
+ */
+void CVoiceManager::StopAll(void)
+{
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		cAudioBackend->Stop(vVoices[i].iVoice);
+		cAudioBackend->Release(vVoices[i].iVoice);
+	}
+	vVoices.clear();
+}
+
+/**
+ @brief Get the maximum number of voices
+ */
+int CVoiceManager::GetMaxVoices(void) const
+{
+	return iMaxVoices;
+}
+
+/**
+ @brief Get the number of voices which are playing
+ */
+int CVoiceManager::GetNumOfVoices(void) const
+{
+	return (int)vVoices.size();
+}
+
+/**
+ @brief Get the number of voices which were stopped to make room for another
+ */
+unsigned int CVoiceManager::GetNumOfStolen(void) const
+{
+	return uNumOfStolen;
+}
+
+/**
+ @brief Get the number of sounds which were not played as there was no room for them
+ */
+unsigned int CVoiceManager::GetNumOfRejected(void) const
+{
+	return uNumOfRejected;
+}
+
+/**
+ @brief Get how loud a voice is at the listener. 3D voices fade with the distance beyond their minimum distance.
+ @param sVoice A const Voice& variable which contains the voice
+ @param vec3dfListenerPos A const vec3df& variable which contains the position of the listener
+ @return The volume of the voice at the listener
+ */
+float CVoiceManager::GetLoudness(const Voice& sVoice, const vec3df& vec3dfListenerPos) const
+{
+	float fVolume = cAudioBackend->GetVolume(sVoice.iVoice);
+	if (sVoice.bIs3D == false)
+		return fVolume;
+
+	float fDistance = (float)cAudioBackend->GetPosition(sVoice.iVoice).getDistanceFrom(vec3dfListenerPos);
+	float fMinDistance = cAudioBackend->GetMinDistance(sVoice.iVoice);
+	if (fDistance > fMinDistance)
+		fVolume *= fMinDistance / fDistance;
+	return fVolume;
+}
+
+/**
+ @brief Find the voice to steal: the one with the lowest priority, then the quietest, then the oldest
+ @param ID A const int variable which contains the ID of the sound to steal from, or -1 to steal from any sound
+ @param iPriority A const int variable which contains the highest priority which can be stolen from.
+		It is not checked when stealing from one sound.
+ @param vec3dfListenerPos A const vec3df& variable which contains the position of the listener
+ @return The index of the voice, or -1 if no voice can be stolen
+ */
+int CVoiceManager::FindVictim(const int ID, const int iPriority, const vec3df& vec3dfListenerPos) const
+{
+	int iVictim = -1;
+	float fVictimLoudness = 0.0f;
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		const Voice& sVoice = vVoices[i];
+		if (ID >= 0)
+		{
+			if (sVoice.ID != ID)
+				continue;
+		}
+		else if (sVoice.iPriority > iPriority)
+			continue;
+
+		float fLoudness = GetLoudness(sVoice, vec3dfListenerPos);
+		if (iVictim >= 0)
+		{
+			const Voice& sVictim = vVoices[iVictim];
+			if (sVoice.iPriority != sVictim.iPriority)
+			{
+				if (sVoice.iPriority > sVictim.iPriority)
+					continue;
+			}
+			// Voices within 1% of each other's volume are taken to be as loud, so the older one is stolen
+			else if (fabs(fLoudness - fVictimLoudness) > 0.01f)
+			{
+				if (fLoudness > fVictimLoudness)
+					continue;
+			}
+			else if (sVoice.uSequence > sVictim.uSequence)
+				continue;
+		}
+		iVictim = (int)i;
+		fVictimLoudness = fLoudness;
+	}
+	return iVictim;
+}
+
+/**
+ @brief Stop a voice and stop tracking it
+ @param iIndex A const int variable which contains the index of the voice
+ */
+void CVoiceManager::Stop(const int iIndex)
+{
+	if ((iIndex < 0) || (iIndex >= (int)vVoices.size()))
+		return;
+
+	cAudioBackend->Stop(vVoices[iIndex].iVoice);
+	cAudioBackend->Release(vVoices[iIndex].iVoice);
+	vVoices.erase(vVoices.begin() + iIndex);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Include AudioBackend
+#include "AudioBackend.h"
+
+// Include vector storage
+#include <vector>
+
+// Keeps track of the sounds which are playing, so that the number of them can be capped.
+// When a sound is started over the cap, the voice with the lowest priority is stolen from, then the quietest, then the oldest.
+class CVoiceManager
+{
+public:
+	// Constructor
+	CVoiceManager(void);
+
+	// Destructor
+	virtual ~CVoiceManager(void);
+
+	// Initialise this class instance
+	bool Init(CAudioBackend* cAudioBackend, const int iMaxVoices);
+
+	// Make room for a new voice of a sound, stopping another voice if needed
+	bool Acquire(	const int ID,
+					const int iPriority,
+					const int iMaxInstances,
+					const vec3df& vec3dfListenerPos);
+	// Keep track of a voice which was started after Acquire returned true
+	void Add(const int iVoice, const int ID, const int iPriority, const bool bIs3D, const int iEmitter = -1);
+
+	// Move the voices which are attached to emitters to the positions of their emitters, skipping the emitters which are culled
+	void MoveVoices(const std::vector<vec3df>& vEmitterPositions, const std::vector<bool>& vEmitterAudible);
+	// Stop moving the voices of an emitter, so that they finish where the emitter was last
+	void DetachEmitter(const int iEmitter);
+
+	// Drop the voices which have finished playing
+	void Update(void);
+	// Stop all the voices
+	void StopAll(void);
+
+	// Get the maximum number of voices
+	int GetMaxVoices(void) const;
+	// Get the number of voices which are playing
+	int GetNumOfVoices(void) const;
+	// Get the number of voices which were stopped to make room for another
+	unsigned int GetNumOfStolen(void) const;
+	// Get the number of sounds which were not played as there was no room for them
+	unsigned int GetNumOfRejected(void) const;
+
+protected:
+	// A sound which is playing
+	struct Voice
+	{
+		// The handle of the voice in the CAudioBackend
+		int iVoice;
+		// The ID of the sound in the CSoundController
+		int ID;
+		int iPriority;
+		bool bIs3D;
+		// The emitter in the CSoundController which carries this voice, or -1 if it does not move
+		int iEmitter;
+		// The order in which the voices were started
+		unsigned int uSequence;
+	};
+
+	// The audio engine which plays the voices
+	CAudioBackend* cAudioBackend;
+	// The voices which are playing
+	std::vector<Voice> vVoices;
+	// The maximum number of voices
+	int iMaxVoices;
+	// The sequence number of the next voice
+	unsigned int uNextSequence;
+
+	// Statistics
+	unsigned int uNumOfStolen;
+	unsigned int uNumOfRejected;
+
+	// Get how loud a voice is at the listener
+	float GetLoudness(const Voice& sVoice, const vec3df& vec3dfListenerPos) const;
+	// Find the voice to steal among those with an ID, or among all of them if ID is negative, up to a priority
+	int FindVictim(const int ID, const int iPriority, const vec3df& vec3dfListenerPos) const;
+	// Stop a voice and stop tracking it
+	void Stop(const int iIndex);
+};
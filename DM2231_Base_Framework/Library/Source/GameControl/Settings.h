@@ -48,7 +48,13 @@ public:
 
 	// Frame Rate Information
 	const unsigned char FPS = 60; // FPS of this game
-	const unsigned int frameTime = 1000 / FPS; // time for each frame
+	const double dFrameTime = 1.0 / FPS; // time for each frame, in seconds
+	bool bUseVSync = false; // let the buffer swap wait for the vertical blank, instead of only pacing the frames on the CPU
+	double dSpinWindow = 0.002; // the last part of each frame, in seconds, which is spun on instead of slept through
+	const double dFixedTimeStep = 1.0 / 120.0; // time for each simulation step, in seconds, which does not depend on the frame rate
+	const double dMaxFrameTime = 0.25; // the longest frame which is simulated in full, so that a stall does not need many steps to catch up
+	bool bEnableProfiler = false; // time the zones of each frame from the start, so that the loading of the assets is profiled too
+	bool bPipelinedUpdate = false; // simulate the next frame on another thread while this frame is rendered, at the cost of a frame of latency
 
 	// Input control
 	//const bool bActivateMouseInput
@@ -1,6 +1,7 @@
 #include "Collider.h"
 
-#include <GLFW/glfw3.h>
+// Include DebugDraw
+#include "../RenderControl/DebugDraw.h"
 
 /**
  @brief Default Constructor
@@ -11,6 +12,7 @@ CCollider::CCollider(void)
 	, vec4Colour(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f))
 	, bIsDisplayed(true)
 	, fLineWidth(3.0)
+	, cLineShader(NULL)
 {
 }
 
@@ -22,72 +24,11 @@ CCollider::~CCollider(void)
 }
 
 /**
- @brief Initialise this class instance
+ @brief Initialise this class instance.
+		The box is drawn through the CDebugDraw line batch, so no OpenGL objects are created here.
  */
 bool CCollider::Init(void)
 {
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	float vertices[] = {
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		vec3BottomLeft.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3BottomLeft.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-
-		vec3BottomLeft.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3TopRight.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3TopRight.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
-		vec3BottomLeft.x, vec3TopRight.y, vec3BottomLeft.z, vec4Colour.x, vec4Colour.y, vec4Colour.z
-	};
-
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-
-	glBindVertexArray(VAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// texture coord attribute
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
-	glLineWidth(fLineWidth);
-
 	return true;
 }
 
@@ -108,23 +49,14 @@ void CCollider::PreRender(void)
 }
 
 /**
- @brief Render
+ @brief Render Add this box to the CDebugDraw line batch, which is drawn when the batch is flushed
  */
 void CCollider::Render(void)
 {
 	if (!bIsDisplayed)
 		return;
 
-	// activate shader
-	cLineShader->use();
-
-	cLineShader->setMat4("model", model);
-	cLineShader->setMat4("view", view);
-	cLineShader->setMat4("projection", projection);
-
-	// render box
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_LINE_LOOP, 0, 36);
+	CDebugDraw::GetInstance()->AddBox(model, vec3BottomLeft, vec3TopRight, vec4Colour);
 }
 
 /**
@@ -49,6 +49,5 @@ public:
 
 protected:
 	Shader* cLineShader;
-	unsigned int VAO, VBO;
 };
 
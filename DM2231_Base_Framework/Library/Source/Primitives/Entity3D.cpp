@@ -5,8 +5,10 @@
  */
 #include "Entity3D.h"
 
-// Include ImageLoader
-#include "..\System\ImageLoader.h"
+// Include TextureManager
+#include "..\System\TextureManager.h"
+// Include MeshManager
+#include "..\System\MeshManager.h"
 
 /**
 @brief Default Constructor
@@ -17,6 +19,9 @@ CEntity3D::CEntity3D()
 	, cShader(NULL)
 	, VAO(0)
 	, VBO(0)
+	, IBO(0)
+	, index_buffer_size(0)
+	, cMesh(NULL)
 	, iTextureID(0)
 	, model(glm::mat4(1.0f))
 	, view(glm::mat4(1.0f))
@@ -25,6 +30,10 @@ CEntity3D::CEntity3D()
 	, vec3Position(0.0f)
 	, vec3Front(glm::vec3(0.0f, 0.0f, -1.0f))
 	, vec3PreviousPosition(0.0f)
+	, vec3StatePosition(0.0f)
+	, vec3RenderPosition(0.0f)
+	, vec3RenderScale(1.0f)
+	, bRenderVisible(true)
 	, vec3Scale(1.0f)
 	, fRotationAngle(0.0f)
 	, vec3RotationAxis(1.0f)
@@ -47,6 +56,25 @@ CEntity3D::~CEntity3D(void)
 		cCollider = NULL;
 	}
 
+	// Release the mesh which was acquired from the CMeshManager
+	if (cMesh)
+	{
+		CMeshManager::GetInstance()->Release(cMesh);
+		cMesh = NULL;
+	}
+
+	// Release the textures which were acquired from the CTextureManager
+	if (iTextureID != 0)
+	{
+		CTextureManager::GetInstance()->Release(iTextureID);
+		iTextureID = 0;
+	}
+	if (RifleID != 0)
+	{
+		CTextureManager::GetInstance()->Release(RifleID);
+		RifleID = 0;
+	}
+
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
 	cShader = NULL;
 	// We set this to NULL, since it was created elsewhere so we don't delete it here
@@ -155,6 +183,38 @@ const float CEntity3D::GetMovementSpeed(void) const
 	return fMovementSpeed;
 }
 
+/**
+ @brief Get the world space bounding box of this instance where it is drawn, which is used for culling.
+		The bounds of the shared mesh are scaled and moved to the render position, in the same way as
+		the model matrix in Render. Entities without a mesh use a unit cube scaled by the render scale and the collider.
+ @param vec3Min A glm::vec3& variable which returns the minimum corner
+ @param vec3Max A glm::vec3& variable which returns the maximum corner
+ */
+void CEntity3D::GetRenderBounds(glm::vec3& vec3Min, glm::vec3& vec3Max) const
+{
+	if (cMesh)
+	{
+		glm::vec3 vec3A = cMesh->vec3Min * vec3RenderScale;
+		glm::vec3 vec3B = cMesh->vec3Max * vec3RenderScale;
+		for (int i = 0; i < 3; i++)
+		{
+			vec3Min[i] = vec3RenderPosition[i] + ((vec3A[i] < vec3B[i]) ? vec3A[i] : vec3B[i]);
+			vec3Max[i] = vec3RenderPosition[i] + ((vec3A[i] < vec3B[i]) ? vec3B[i] : vec3A[i]);
+		}
+		return;
+	}
+
+	glm::vec3 vec3HalfSize = glm::abs(vec3RenderScale) * 0.5f;
+	glm::vec3 vec3ColliderHalfSize = glm::abs(vec3ColliderScale) * 0.5f;
+	for (int i = 0; i < 3; i++)
+	{
+		if (vec3ColliderHalfSize[i] > vec3HalfSize[i])
+			vec3HalfSize[i] = vec3ColliderHalfSize[i];
+	}
+	vec3Min = vec3RenderPosition - vec3HalfSize;
+	vec3Max = vec3RenderPosition + vec3HalfSize;
+}
+
 // These methods are for marking this CEntity3D for deletion
 /**
  @brief Mark this CEntity3D for deletion
@@ -239,47 +299,87 @@ void CEntity3D::RollbackPosition(void)
 }
 
 /**
-@brief Load a texture, assign it a code and store it in MapOfTextureIDs.
+ @brief Store the position of the last simulation step, before the next step moves this instance
+ */
+void CEntity3D::StoreStateForInterpolation(void)
+{
+	vec3StatePosition = vec3Position;
+}
+
+/**
+ @brief Get the position at the last simulation step, which the rendering interpolates from
+ @return vec3StatePosition value
+ */
+const glm::vec3 CEntity3D::GetStatePosition(void) const
+{
+	return vec3StatePosition;
+}
+
+/**
+ @brief Check if this instance is drawn. An instance which is marked for deletion is not drawn.
+ @return true if this instance is drawn, else false
+ */
+bool CEntity3D::IsVisible(void) const
+{
+	return !bToDelete;
+}
+
+/**
+ @brief Set the state which the rendering uses. It is called on the main thread from the render state which the simulation published,
+		so that the rendering does not read the state which the simulation is changing.
+ @param vec3Position A const glm::vec3& variable which contains the position to render at
+ @param vec3Scale A const glm::vec3& variable which contains the scale to render at
+ @param bVisible A const bool variable which is true if this instance is drawn
+ */
+void CEntity3D::SetRenderState(const glm::vec3& vec3Position, const glm::vec3& vec3Scale, const bool bVisible)
+{
+	vec3RenderPosition = vec3Position;
+	vec3RenderScale = vec3Scale;
+	bRenderVisible = bVisible;
+}
+
+/**
+ @brief Get the position to render at, which is between the last simulation step and the current one,
+		so that the movement looks smooth when the frames and the simulation steps do not line up
+ @return vec3RenderPosition value
+ */
+const glm::vec3 CEntity3D::GetRenderPosition(void) const
+{
+	return vec3RenderPosition;
+}
+
+/**
+@brief Load a texture through the CTextureManager, so instances which use the same file share one OpenGL texture.
+	   The texture is released in the destructor.
 @param filename A const char* variable which contains the file name of the texture
-@return true if the initialisation is successful, else false
+@return The OpenGL texture ID, or 0 if the texture could not be loaded
 */
 int CEntity3D::LoadTexture(const char* filename)
 {
-	// Texture ID
-	GLuint iTextureID = 0;
-
-	// Variables used in loading the texture
-	int width, height, nrChannels;
-
-	// texture 1
-	// ---------
-	glGenTextures(1, &iTextureID);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-	// set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	// set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	CImageLoader* cImageLoader = CImageLoader::GetInstance();
-	unsigned char *data = cImageLoader->Load(filename, width, height, nrChannels, true);
-	if (data)
-	{
-		if (nrChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		else if (nrChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	return CTextureManager::GetInstance()->Acquire(filename);
+}
 
-		// Generate mipmaps
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		return 0;
-	}
-	// Free up the memory of the file data read in
-	free(data);
+/**
+@brief Load a mesh through the CMeshManager, so instances which use the same OBJ file share one set of buffers.
+	   The mesh is released in the destructor.
+@param filename A const char* variable which contains the file name of the OBJ file
+@return true if the mesh is loaded, else false
+*/
+bool CEntity3D::LoadMesh(const char* filename)
+{
+	const Mesh* cNewMesh = CMeshManager::GetInstance()->Acquire(filename);
+	if (cNewMesh == NULL)
+		return false;
 
-	return iTextureID;
+	// Release the previous mesh, if any
+	if (cMesh)
+		CMeshManager::GetInstance()->Release(cMesh);
+
+	cMesh = cNewMesh;
+	VAO = cMesh->VAO;
+	VBO = cMesh->VBO;
+	IBO = cMesh->IBO;
+	index_buffer_size = cMesh->iIndexCount;
+
+	return true;
 }
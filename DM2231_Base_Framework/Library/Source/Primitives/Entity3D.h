@@ -16,6 +16,9 @@
 // Include Settings
 #include "..\GameControl\Settings.h"
 
+// A mesh which is shared through the CMeshManager
+struct Mesh;
+
 class CEntity3D
 {
 public:
@@ -74,6 +77,8 @@ public:
 	virtual const glm::vec3 GetRotationAxis(void) const;
 	virtual const glm::vec4 GetColour(void) const;
 	virtual const float GetMovementSpeed(void) const;
+	// Get the world space bounding box of this instance where it is drawn, which is used for culling
+	virtual void GetRenderBounds(glm::vec3& vec3Min, glm::vec3& vec3Max) const;
 
 	// These methods are for marking this CEntity3D for deletion
 	virtual void SetToDelete(const bool bToDelete);
@@ -92,6 +97,18 @@ public:
 	// Rollback the position to the previous position
 	virtual void RollbackPosition(void);
 
+	// Store the position of the last simulation step, which the rendering interpolates from
+	virtual void StoreStateForInterpolation(void);
+	// Get the position at the last simulation step
+	virtual const glm::vec3 GetStatePosition(void) const;
+	// Check if this instance is drawn. It is checked by the simulation when the render state is captured.
+	virtual bool IsVisible(void) const;
+
+	// Set the state which the rendering uses, from the render state which was published by the simulation
+	virtual void SetRenderState(const glm::vec3& vec3Position, const glm::vec3& vec3Scale, const bool bVisible);
+	// Get the position to render at, between the last simulation step and the current one
+	virtual const glm::vec3 GetRenderPosition(void) const;
+
 	// Update this class instance
 	virtual void Update(const double dElapsedTime) = 0;
 
@@ -112,6 +129,8 @@ protected:
 	// OpenGL objects
 	GLuint VAO, VBO, IBO;
 	GLuint index_buffer_size;
+	// The mesh which is shared with other instances, if this entity uses one
+	const Mesh* cMesh;
 	// The texture ID in OpenGL
 	GLuint iTextureID;
 	GLuint RifleID;
@@ -128,6 +147,13 @@ protected:
 	glm::vec3 vec3Position;
 	// Previous Position
 	glm::vec3 vec3PreviousPosition;
+	// The position at the last simulation step
+	glm::vec3 vec3StatePosition;
+	// The state which the rendering uses. Only the main thread reads and writes it, so that the simulation can move
+	// this instance on another thread while it is drawn.
+	glm::vec3 vec3RenderPosition;
+	glm::vec3 vec3RenderScale;
+	bool bRenderVisible;
 	// Direction
 	glm::vec3 vec3Front;
 	// Scale
@@ -154,4 +180,6 @@ protected:
 
 	// Load Ground textures
 	virtual int LoadTexture(const char* filename);
+	// Load a shared mesh from an OBJ file
+	virtual bool LoadMesh(const char* filename);
 };
@@ -0,0 +1,175 @@
+#include "DebugDraw.h"
+
+// Include StreamBuffer
+#include "StreamBuffer.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CDebugDraw::CDebugDraw(void)
+	: fLineWidth(3.0f)
+	, cLineShader(NULL)
+	, VAO(0)
+	, uNumOfLinesDrawn(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CDebugDraw::~CDebugDraw(void)
+{
+	// Delete the rendering objects in the graphics card
+	if (VAO != 0)
+	{
+		GL()->DeleteVertexArrays(1, &VAO);
+	}
+
+	// We set this to NULL, since it was created elsewhere so we don't delete it here
+	cLineShader = NULL;
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CDebugDraw::Init(void)
+{
+	if (VAO != 0)
+		return true;
+
+	// The vertices are written into the streaming vertex buffer each frame
+	GLuint uiStreamVBO = CStreamBuffer::GetInstance()->GetVBO();
+	if (uiStreamVBO == 0)
+	{
+		cout << "CDebugDraw::Init(): Initialise the CStreamBuffer before initialising this class instance." << endl;
+		return false;
+	}
+
+	GL()->GenVertexArrays(1, &VAO);
+
+	GL()->BindVertexArray(VAO);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, uiStreamVBO);
+
+	// position attribute
+	GL()->VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	GL()->EnableVertexAttribArray(0);
+	// colour attribute
+	GL()->VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	GL()->EnableVertexAttribArray(1);
+
+	GL()->BindVertexArray(0);
+
+	return true;
+}
+
+/**
+ @brief Set a shader to this class instance
+ @param cLineShader A Shader* variable which stores a shader which renders lines
+ */
+void CDebugDraw::SetShader(Shader* cLineShader)
+{
+	this->cLineShader = cLineShader;
+}
+
+/**
+ @brief Add a line to the batch
+ @param vec3Start A const glm::vec3& variable which contains the start of the line in world space
+ @param vec3End A const glm::vec3& variable which contains the end of the line in world space
+ @param vec4Colour A const glm::vec4& variable which contains the colour of the line
+ */
+void CDebugDraw::AddLine(const glm::vec3& vec3Start, const glm::vec3& vec3End, const glm::vec4& vec4Colour)
+{
+	const float afVertices[] = {
+		vec3Start.x, vec3Start.y, vec3Start.z, vec4Colour.x, vec4Colour.y, vec4Colour.z,
+		vec3End.x, vec3End.y, vec3End.z, vec4Colour.x, vec4Colour.y, vec4Colour.z
+	};
+	vVertices.insert(vVertices.end(), afVertices, afVertices + 12);
+}
+
+/**
+ @brief Add the 12 edges of a box to the batch. The corners are transformed into world space here,
+		so boxes with different model matrices can share one draw call.
+ @param model A const glm::mat4& variable which contains the model matrix of the box
+ @param vec3BottomLeft A const glm::vec3& variable which contains the bottom left corner in model space
+ @param vec3TopRight A const glm::vec3& variable which contains the top right corner in model space
+ @param vec4Colour A const glm::vec4& variable which contains the colour of the box
+ */
+void CDebugDraw::AddBox(const glm::mat4& model,
+						const glm::vec3& vec3BottomLeft,
+						const glm::vec3& vec3TopRight,
+						const glm::vec4& vec4Colour)
+{
+	// The 8 corners, where bit 0 selects x, bit 1 selects y and bit 2 selects z
+	glm::vec3 avec3Corners[8];
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 vec4Corner(	(i & 1) ? vec3TopRight.x : vec3BottomLeft.x,
+								(i & 2) ? vec3TopRight.y : vec3BottomLeft.y,
+								(i & 4) ? vec3TopRight.z : vec3BottomLeft.z,
+								1.0f);
+		avec3Corners[i] = glm::vec3(model * vec4Corner);
+	}
+
+	// The 12 edges join corners which differ by one bit
+	static const int aiEdges[12][2] = {
+		{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+		{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+		{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+	};
+	for (int i = 0; i < 12; i++)
+	{
+		AddLine(avec3Corners[aiEdges[i][0]], avec3Corners[aiEdges[i][1]], vec4Colour);
+	}
+}
+
+/**
+ @brief Draw all the lines in the batch with one draw call, then empty the batch
+ @param view A const glm::mat4& variable which contains the view matrix
+ @param projection A const glm::mat4& variable which contains the projection matrix
+ */
+void CDebugDraw::Flush(const glm::mat4& view, const glm::mat4& projection)
+{
+	uNumOfLinesDrawn = (unsigned int)(vVertices.size() / 12);
+	if (vVertices.size() == 0)
+		return;
+
+	if ((VAO == 0) || (cLineShader == NULL))
+	{
+		cout << "CDebugDraw::Flush(): This class instance is not initialised." << endl;
+		vVertices.clear();
+		return;
+	}
+
+	cLineShader->use();
+	cLineShader->setMat4("model", glm::mat4(1.0f));
+	cLineShader->setMat4("view", view);
+	cLineShader->setMat4("projection", projection);
+
+	// Copy the batch into this frame's part of the streaming vertex buffer
+	GLint iFirst = CStreamBuffer::GetInstance()->Allocate(&vVertices[0], vVertices.size() * sizeof(float), 6 * sizeof(float));
+	if (iFirst < 0)
+	{
+		vVertices.clear();
+		return;
+	}
+
+	GL()->LineWidth(fLineWidth);
+
+	GL()->BindVertexArray(VAO);
+	GL()->DrawArrays(GL_LINES, iFirst, (GLsizei)(vVertices.size() / 6));
+	GL()->BindVertexArray(0);
+
+	vVertices.clear();
+}
+
+/**
+ @brief Get the number of lines which were drawn by the last Flush
+ */
+unsigned int CDebugDraw::GetNumOfLinesDrawn(void) const
+{
+	return uNumOfLinesDrawn;
+}
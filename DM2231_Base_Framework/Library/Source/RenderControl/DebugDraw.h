@@ -0,0 +1,62 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include shader
+#include "shader.h"
+
+#include <vector>
+
+class CDebugDraw : public CSingletonTemplate<CDebugDraw>
+{
+	friend CSingletonTemplate<CDebugDraw>;
+public:
+	// Init
+	bool Init(void);
+
+	// Set a shader to this class instance
+	void SetShader(Shader* cLineShader);
+
+	// Add a line to the batch
+	void AddLine(const glm::vec3& vec3Start, const glm::vec3& vec3End, const glm::vec4& vec4Colour);
+	// Add the 12 edges of a box to the batch
+	void AddBox(const glm::mat4& model,
+				const glm::vec3& vec3BottomLeft,
+				const glm::vec3& vec3TopRight,
+				const glm::vec4& vec4Colour);
+
+	// Draw all the lines in the batch with one draw call, then empty the batch
+	void Flush(const glm::mat4& view, const glm::mat4& projection);
+
+	// Get the number of lines which were drawn by the last Flush
+	unsigned int GetNumOfLinesDrawn(void) const;
+
+	// Line width
+	float fLineWidth;
+
+protected:
+	// Handler to the line shader
+	Shader* cLineShader;
+
+	// The VAO, which reads from the streaming vertex buffer
+	GLuint VAO;
+
+	// The vertices in the batch, each with a position and a colour
+	std::vector<float> vVertices;
+
+	// The number of lines which were drawn by the last Flush
+	unsigned int uNumOfLinesDrawn;
+
+	// Constructor
+	CDebugDraw(void);
+
+	// Destructor
+	virtual ~CDebugDraw(void);
+};
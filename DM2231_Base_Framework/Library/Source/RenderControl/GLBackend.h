@@ -0,0 +1,72 @@
+#pragma once
+
+// Include GLEW
+#include <GL/glew.h>
+
+// The OpenGL calls which the rendering code makes every frame, and the calls which create the buffers,
+// vertex arrays and fences which they use.
+// The calls have the same names and parameters as in OpenGL, without the gl prefix.
+class CGLBackend
+{
+public:
+	// Destructor
+	virtual ~CGLBackend(void) {}
+
+	// Mark the start and end of a frame
+	virtual void BeginFrame(void) {}
+	virtual void EndFrame(void) {}
+
+	// Fixed function state
+	virtual void Enable(GLenum eCap) = 0;
+	virtual void Disable(GLenum eCap) = 0;
+	virtual void DepthFunc(GLenum eFunc) = 0;
+	virtual void BlendFunc(GLenum eSrcFactor, GLenum eDstFactor) = 0;
+	virtual void LineWidth(GLfloat fWidth) = 0;
+	virtual void Viewport(GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight) = 0;
+	virtual void ClearColor(GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha) = 0;
+	virtual void Clear(GLbitfield uMask) = 0;
+
+	// Bindings
+	virtual void UseProgram(GLuint uProgram) = 0;
+	virtual void BindVertexArray(GLuint uArray) = 0;
+	virtual void BindBuffer(GLenum eTarget, GLuint uBuffer) = 0;
+	virtual void ActiveTexture(GLenum eTexture) = 0;
+	virtual void BindTexture(GLenum eTarget, GLuint uTexture) = 0;
+	virtual void BindFramebuffer(GLenum eTarget, GLuint uFramebuffer) = 0;
+
+	// Uniforms
+	virtual GLint GetUniformLocation(GLuint uProgram, const GLchar* pName) = 0;
+	virtual void Uniform1i(GLint iLocation, GLint iV0) = 0;
+	virtual void Uniform1f(GLint iLocation, GLfloat fV0) = 0;
+	virtual void Uniform2f(GLint iLocation, GLfloat fV0, GLfloat fV1) = 0;
+	virtual void Uniform3f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2) = 0;
+	virtual void Uniform4f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2, GLfloat fV3) = 0;
+	virtual void Uniform2fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue) = 0;
+	virtual void Uniform3fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue) = 0;
+	virtual void Uniform4fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue) = 0;
+	virtual void UniformMatrix2fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue) = 0;
+	virtual void UniformMatrix3fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue) = 0;
+	virtual void UniformMatrix4fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue) = 0;
+
+	// Buffer uploads
+	virtual void BufferData(GLenum eTarget, GLsizeiptr iSize, const void* pData, GLenum eUsage) = 0;
+	virtual void* MapBufferRange(GLenum eTarget, GLintptr iOffset, GLsizeiptr iLength, GLbitfield uAccess) = 0;
+	virtual GLboolean UnmapBuffer(GLenum eTarget) = 0;
+
+	// Buffers and vertex arrays
+	virtual void GenBuffers(GLsizei iCount, GLuint* pBuffers) = 0;
+	virtual void DeleteBuffers(GLsizei iCount, const GLuint* pBuffers) = 0;
+	virtual void GenVertexArrays(GLsizei iCount, GLuint* pArrays) = 0;
+	virtual void DeleteVertexArrays(GLsizei iCount, const GLuint* pArrays) = 0;
+	virtual void VertexAttribPointer(GLuint uIndex, GLint iSize, GLenum eType, GLboolean bNormalized, GLsizei iStride, const void* pPointer) = 0;
+	virtual void EnableVertexAttribArray(GLuint uIndex) = 0;
+
+	// Fences
+	virtual GLsync FenceSync(GLenum eCondition, GLbitfield uFlags) = 0;
+	virtual GLenum ClientWaitSync(GLsync sSync, GLbitfield uFlags, GLuint64 uTimeout) = 0;
+	virtual void DeleteSync(GLsync sSync) = 0;
+
+	// Draws
+	virtual void DrawArrays(GLenum eMode, GLint iFirst, GLsizei iCount) = 0;
+	virtual void DrawElements(GLenum eMode, GLsizei iCount, GLenum eType, const void* pIndices) = 0;
+};
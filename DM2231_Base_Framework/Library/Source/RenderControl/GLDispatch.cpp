@@ -0,0 +1,40 @@
+#include "GLDispatch.h"
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CGLDispatch::CGLDispatch(void)
+{
+	// Use the driver until another backend is set
+	cBackend = &cDriverBackend;
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CGLDispatch::~CGLDispatch(void)
+{
+	// We set this to NULL, since it was created elsewhere so we don't delete it here
+	cBackend = NULL;
+}
+
+/**
+ @brief Set the backend to make the per-frame OpenGL calls through
+ @param cBackend A CGLBackend* variable which contains the backend, or NULL to use the driver backend
+ */
+void CGLDispatch::SetBackend(CGLBackend* cBackend)
+{
+	if (cBackend == NULL)
+		this->cBackend = &cDriverBackend;
+	else
+		this->cBackend = cBackend;
+}
+
+/**
+ @brief Get the backend which passes the calls to the driver
+ @return The driver backend
+ */
+CGLBackend* CGLDispatch::GetDriverBackend(void)
+{
+	return &cDriverBackend;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLDriverBackend
+#include "GLDriverBackend.h"
+
+// Holds the backend which the per-frame OpenGL calls are made through.
+// The driver backend is used unless another backend is set, e.g. a CGLRecordingBackend.
+class CGLDispatch : public CSingletonTemplate<CGLDispatch>
+{
+	friend CSingletonTemplate<CGLDispatch>;
+public:
+	// Set the backend to make the calls through. Set NULL to use the driver again.
+	void SetBackend(CGLBackend* cBackend);
+	// Get the backend to make the calls through
+	CGLBackend* GetBackend(void) const
+	{
+		return cBackend;
+	}
+	// Get the backend which passes the calls to the driver
+	CGLBackend* GetDriverBackend(void);
+
+protected:
+	// The backend which passes the calls to the driver
+	CGLDriverBackend cDriverBackend;
+	// The backend which the calls are made through
+	CGLBackend* cBackend;
+
+	// Constructor
+	CGLDispatch(void);
+	// Destructor
+	virtual ~CGLDispatch(void);
+};
+
+// Get the backend which the per-frame OpenGL calls are made through, e.g. GL()->DrawArrays(...)
+inline CGLBackend* GL(void)
+{
+	return CGLDispatch::GetInstance()->GetBackend();
+}
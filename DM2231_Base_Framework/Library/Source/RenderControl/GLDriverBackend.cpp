@@ -0,0 +1,217 @@
+#include "GLDriverBackend.h"
+
+/**
+ @brief Constructor
+ */
+CGLDriverBackend::CGLDriverBackend(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CGLDriverBackend::~CGLDriverBackend(void)
+{
+}
+
+// Each of the calls below is passed straight to the OpenGL function with the same name
+
+void CGLDriverBackend::Enable(GLenum eCap)
+{
+	glEnable(eCap);
+}
+
+void CGLDriverBackend::Disable(GLenum eCap)
+{
+	glDisable(eCap);
+}
+
+void CGLDriverBackend::DepthFunc(GLenum eFunc)
+{
+	glDepthFunc(eFunc);
+}
+
+void CGLDriverBackend::BlendFunc(GLenum eSrcFactor, GLenum eDstFactor)
+{
+	glBlendFunc(eSrcFactor, eDstFactor);
+}
+
+void CGLDriverBackend::LineWidth(GLfloat fWidth)
+{
+	glLineWidth(fWidth);
+}
+
+void CGLDriverBackend::Viewport(GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight)
+{
+	glViewport(iX, iY, iWidth, iHeight);
+}
+
+void CGLDriverBackend::ClearColor(GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha)
+{
+	glClearColor(fRed, fGreen, fBlue, fAlpha);
+}
+
+void CGLDriverBackend::Clear(GLbitfield uMask)
+{
+	glClear(uMask);
+}
+
+void CGLDriverBackend::UseProgram(GLuint uProgram)
+{
+	glUseProgram(uProgram);
+}
+
+void CGLDriverBackend::BindVertexArray(GLuint uArray)
+{
+	glBindVertexArray(uArray);
+}
+
+void CGLDriverBackend::BindBuffer(GLenum eTarget, GLuint uBuffer)
+{
+	glBindBuffer(eTarget, uBuffer);
+}
+
+void CGLDriverBackend::ActiveTexture(GLenum eTexture)
+{
+	glActiveTexture(eTexture);
+}
+
+void CGLDriverBackend::BindTexture(GLenum eTarget, GLuint uTexture)
+{
+	glBindTexture(eTarget, uTexture);
+}
+
+void CGLDriverBackend::BindFramebuffer(GLenum eTarget, GLuint uFramebuffer)
+{
+	glBindFramebuffer(eTarget, uFramebuffer);
+}
+
+GLint CGLDriverBackend::GetUniformLocation(GLuint uProgram, const GLchar* pName)
+{
+	return glGetUniformLocation(uProgram, pName);
+}
+
+void CGLDriverBackend::Uniform1i(GLint iLocation, GLint iV0)
+{
+	glUniform1i(iLocation, iV0);
+}
+
+void CGLDriverBackend::Uniform1f(GLint iLocation, GLfloat fV0)
+{
+	glUniform1f(iLocation, fV0);
+}
+
+void CGLDriverBackend::Uniform2f(GLint iLocation, GLfloat fV0, GLfloat fV1)
+{
+	glUniform2f(iLocation, fV0, fV1);
+}
+
+void CGLDriverBackend::Uniform3f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2)
+{
+	glUniform3f(iLocation, fV0, fV1, fV2);
+}
+
+void CGLDriverBackend::Uniform4f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2, GLfloat fV3)
+{
+	glUniform4f(iLocation, fV0, fV1, fV2, fV3);
+}
+
+void CGLDriverBackend::Uniform2fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	glUniform2fv(iLocation, iCount, pValue);
+}
+
+void CGLDriverBackend::Uniform3fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	glUniform3fv(iLocation, iCount, pValue);
+}
+
+void CGLDriverBackend::Uniform4fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	glUniform4fv(iLocation, iCount, pValue);
+}
+
+void CGLDriverBackend::UniformMatrix2fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	glUniformMatrix2fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLDriverBackend::UniformMatrix3fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	glUniformMatrix3fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLDriverBackend::UniformMatrix4fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	glUniformMatrix4fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLDriverBackend::BufferData(GLenum eTarget, GLsizeiptr iSize, const void* pData, GLenum eUsage)
+{
+	glBufferData(eTarget, iSize, pData, eUsage);
+}
+
+void* CGLDriverBackend::MapBufferRange(GLenum eTarget, GLintptr iOffset, GLsizeiptr iLength, GLbitfield uAccess)
+{
+	return glMapBufferRange(eTarget, iOffset, iLength, uAccess);
+}
+
+GLboolean CGLDriverBackend::UnmapBuffer(GLenum eTarget)
+{
+	return glUnmapBuffer(eTarget);
+}
+
+void CGLDriverBackend::GenBuffers(GLsizei iCount, GLuint* pBuffers)
+{
+	glGenBuffers(iCount, pBuffers);
+}
+
+void CGLDriverBackend::DeleteBuffers(GLsizei iCount, const GLuint* pBuffers)
+{
+	glDeleteBuffers(iCount, pBuffers);
+}
+
+void CGLDriverBackend::GenVertexArrays(GLsizei iCount, GLuint* pArrays)
+{
+	glGenVertexArrays(iCount, pArrays);
+}
+
+void CGLDriverBackend::DeleteVertexArrays(GLsizei iCount, const GLuint* pArrays)
+{
+	glDeleteVertexArrays(iCount, pArrays);
+}
+
+void CGLDriverBackend::VertexAttribPointer(GLuint uIndex, GLint iSize, GLenum eType, GLboolean bNormalized, GLsizei iStride, const void* pPointer)
+{
+	glVertexAttribPointer(uIndex, iSize, eType, bNormalized, iStride, pPointer);
+}
+
+void CGLDriverBackend::EnableVertexAttribArray(GLuint uIndex)
+{
+	glEnableVertexAttribArray(uIndex);
+}
+
+GLsync CGLDriverBackend::FenceSync(GLenum eCondition, GLbitfield uFlags)
+{
+	return glFenceSync(eCondition, uFlags);
+}
+
+GLenum CGLDriverBackend::ClientWaitSync(GLsync sSync, GLbitfield uFlags, GLuint64 uTimeout)
+{
+	return glClientWaitSync(sSync, uFlags, uTimeout);
+}
+
+void CGLDriverBackend::DeleteSync(GLsync sSync)
+{
+	glDeleteSync(sSync);
+}
+
+void CGLDriverBackend::DrawArrays(GLenum eMode, GLint iFirst, GLsizei iCount)
+{
+	glDrawArrays(eMode, iFirst, iCount);
+}
+
+void CGLDriverBackend::DrawElements(GLenum eMode, GLsizei iCount, GLenum eType, const void* pIndices)
+{
+	glDrawElements(eMode, iCount, eType, pIndices);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Include GLBackend
+#include "GLBackend.h"
+
+// Passes every call straight to the OpenGL driver
+class CGLDriverBackend : public CGLBackend
+{
+public:
+	// Constructor
+	CGLDriverBackend(void);
+	// Destructor
+	virtual ~CGLDriverBackend(void);
+
+	// Fixed function state
+	virtual void Enable(GLenum eCap);
+	virtual void Disable(GLenum eCap);
+	virtual void DepthFunc(GLenum eFunc);
+	virtual void BlendFunc(GLenum eSrcFactor, GLenum eDstFactor);
+	virtual void LineWidth(GLfloat fWidth);
+	virtual void Viewport(GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight);
+	virtual void ClearColor(GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha);
+	virtual void Clear(GLbitfield uMask);
+
+	// Bindings
+	virtual void UseProgram(GLuint uProgram);
+	virtual void BindVertexArray(GLuint uArray);
+	virtual void BindBuffer(GLenum eTarget, GLuint uBuffer);
+	virtual void ActiveTexture(GLenum eTexture);
+	virtual void BindTexture(GLenum eTarget, GLuint uTexture);
+	virtual void BindFramebuffer(GLenum eTarget, GLuint uFramebuffer);
+
+	// Uniforms
+	virtual GLint GetUniformLocation(GLuint uProgram, const GLchar* pName);
+	virtual void Uniform1i(GLint iLocation, GLint iV0);
+	virtual void Uniform1f(GLint iLocation, GLfloat fV0);
+	virtual void Uniform2f(GLint iLocation, GLfloat fV0, GLfloat fV1);
+	virtual void Uniform3f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2);
+	virtual void Uniform4f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2, GLfloat fV3);
+	virtual void Uniform2fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void Uniform3fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void Uniform4fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void UniformMatrix2fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+	virtual void UniformMatrix3fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+	virtual void UniformMatrix4fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+
+	// Buffer uploads
+	virtual void BufferData(GLenum eTarget, GLsizeiptr iSize, const void* pData, GLenum eUsage);
+	virtual void* MapBufferRange(GLenum eTarget, GLintptr iOffset, GLsizeiptr iLength, GLbitfield uAccess);
+	virtual GLboolean UnmapBuffer(GLenum eTarget);
+
+	// Buffers and vertex arrays
+	virtual void GenBuffers(GLsizei iCount, GLuint* pBuffers);
+	virtual void DeleteBuffers(GLsizei iCount, const GLuint* pBuffers);
+	virtual void GenVertexArrays(GLsizei iCount, GLuint* pArrays);
+	virtual void DeleteVertexArrays(GLsizei iCount, const GLuint* pArrays);
+	virtual void VertexAttribPointer(GLuint uIndex, GLint iSize, GLenum eType, GLboolean bNormalized, GLsizei iStride, const void* pPointer);
+	virtual void EnableVertexAttribArray(GLuint uIndex);
+
+	// Fences
+	virtual GLsync FenceSync(GLenum eCondition, GLbitfield uFlags);
+	virtual GLenum ClientWaitSync(GLsync sSync, GLbitfield uFlags, GLuint64 uTimeout);
+	virtual void DeleteSync(GLsync sSync);
+
+	// Draws
+	virtual void DrawArrays(GLenum eMode, GLint iFirst, GLsizei iCount);
+	virtual void DrawElements(GLenum eMode, GLsizei iCount, GLenum eType, const void* pIndices);
+};
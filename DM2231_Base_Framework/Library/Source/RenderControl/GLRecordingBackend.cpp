@@ -0,0 +1,527 @@
+#include "GLRecordingBackend.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// The positions of the fixed function state in vFixedState
+static const unsigned int FIXED_DEPTH_FUNC = 0;
+static const unsigned int FIXED_BLEND_FUNC = 1;
+static const unsigned int FIXED_LINE_WIDTH = 3;
+static const unsigned int FIXED_VIEWPORT = 4;
+static const unsigned int FIXED_CLEAR_COLOR = 8;
+static const unsigned int FIXED_SIZE = 12;
+
+/**
+ @brief Constructor
+ @param cForward A CGLBackend* variable which contains the backend to pass the calls on to, or NULL to make no OpenGL calls
+ */
+CGLRecordingBackend::CGLRecordingBackend(CGLBackend* cForward)
+	: cForward(cForward)
+	, uNumOfFrames(0)
+	, bCallLogEnabled(false)
+	, eActiveTexture(GL_TEXTURE0)
+	, uLastName(0)
+{
+	memset(&sFrameStats, 0, sizeof(FrameStats));
+	memset(&sLastFrameStats, 0, sizeof(FrameStats));
+	// Nothing is known about the state yet, so the first call to set each value is counted as a change
+	vFixedState.assign(FIXED_SIZE, -1.0f);
+}
+
+/**
+ @brief Destructor
+ */
+CGLRecordingBackend::~CGLRecordingBackend(void)
+{
+	// We set this to NULL, since it was created elsewhere so we don't delete it here
+	cForward = NULL;
+}
+
+/**
+ @brief Start a frame. The counters and the call log are cleared, but the state is kept,
+		so that a call which sets the state to what the last frame left it at is still redundant.
+ */
+void CGLRecordingBackend::BeginFrame(void)
+{
+	memset(&sFrameStats, 0, sizeof(FrameStats));
+	vCallLog.clear();
+	if (cForward)
+		cForward->BeginFrame();
+}
+
+/**
+ @brief End a frame, and keep its counters
+ */
+void CGLRecordingBackend::EndFrame(void)
+{
+	sLastFrameStats = sFrameStats;
+	uNumOfFrames++;
+	if (cForward)
+		cForward->EndFrame();
+}
+
+/**
+ @brief Keep a text log of every call in the current frame
+ @param bCallLogEnabled A const bool variable which is true to keep the log
+ */
+void CGLRecordingBackend::SetCallLogEnabled(const bool bCallLogEnabled)
+{
+	this->bCallLogEnabled = bCallLogEnabled;
+	if (!bCallLogEnabled)
+		vCallLog.clear();
+}
+
+/**
+ @brief Get the text log of the calls in the current frame, or of the last frame after EndFrame
+ */
+const std::vector<std::string>& CGLRecordingBackend::GetCallLog(void) const
+{
+	return vCallLog;
+}
+
+/**
+ @brief Get the counters of the current frame
+ */
+const CGLRecordingBackend::FrameStats& CGLRecordingBackend::GetFrameStats(void) const
+{
+	return sFrameStats;
+}
+
+/**
+ @brief Get the counters of the last frame which was ended
+ */
+const CGLRecordingBackend::FrameStats& CGLRecordingBackend::GetLastFrameStats(void) const
+{
+	return sLastFrameStats;
+}
+
+/**
+ @brief Get the number of frames which were ended
+ */
+unsigned int CGLRecordingBackend::GetNumOfFrames(void) const
+{
+	return uNumOfFrames;
+}
+
+/**
+ @brief Print the counters of the last frame to the console
+ */
+void CGLRecordingBackend::PrintStats(void) const
+{
+	cout << "CGLRecordingBackend: frame " << uNumOfFrames << ", "
+		<< sLastFrameStats.uNumOfCalls << " calls, "
+		<< sLastFrameStats.uNumOfDrawCalls << " draws, "
+		<< sLastFrameStats.uNumOfVertices << " vertices, "
+		<< sLastFrameStats.uNumOfStateChanges << " state changes ("
+		<< sLastFrameStats.uNumOfRedundantStateChanges << " redundant), "
+		<< sLastFrameStats.uNumOfUniforms << " uniforms, "
+		<< sLastFrameStats.uBytesUploaded << " bytes uploaded" << endl;
+}
+
+void CGLRecordingBackend::Enable(GLenum eCap)
+{
+	Record("Enable", to_string(eCap));
+	RecordState(StateKey(STATE_CAPABILITY, eCap), GL_TRUE);
+	if (cForward)
+		cForward->Enable(eCap);
+}
+
+void CGLRecordingBackend::Disable(GLenum eCap)
+{
+	Record("Disable", to_string(eCap));
+	RecordState(StateKey(STATE_CAPABILITY, eCap), GL_FALSE);
+	if (cForward)
+		cForward->Disable(eCap);
+}
+
+void CGLRecordingBackend::DepthFunc(GLenum eFunc)
+{
+	Record("DepthFunc", to_string(eFunc));
+	GLfloat afValues[] = { (GLfloat)eFunc };
+	RecordFixedState(FIXED_DEPTH_FUNC, afValues, 1);
+	if (cForward)
+		cForward->DepthFunc(eFunc);
+}
+
+void CGLRecordingBackend::BlendFunc(GLenum eSrcFactor, GLenum eDstFactor)
+{
+	Record("BlendFunc", to_string(eSrcFactor) + ", " + to_string(eDstFactor));
+	GLfloat afValues[] = { (GLfloat)eSrcFactor, (GLfloat)eDstFactor };
+	RecordFixedState(FIXED_BLEND_FUNC, afValues, 2);
+	if (cForward)
+		cForward->BlendFunc(eSrcFactor, eDstFactor);
+}
+
+void CGLRecordingBackend::LineWidth(GLfloat fWidth)
+{
+	Record("LineWidth", to_string(fWidth));
+	RecordFixedState(FIXED_LINE_WIDTH, &fWidth, 1);
+	if (cForward)
+		cForward->LineWidth(fWidth);
+}
+
+void CGLRecordingBackend::Viewport(GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight)
+{
+	Record("Viewport", to_string(iX) + ", " + to_string(iY) + ", " + to_string(iWidth) + ", " + to_string(iHeight));
+	GLfloat afValues[] = { (GLfloat)iX, (GLfloat)iY, (GLfloat)iWidth, (GLfloat)iHeight };
+	RecordFixedState(FIXED_VIEWPORT, afValues, 4);
+	if (cForward)
+		cForward->Viewport(iX, iY, iWidth, iHeight);
+}
+
+void CGLRecordingBackend::ClearColor(GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha)
+{
+	Record("ClearColor");
+	GLfloat afValues[] = { fRed, fGreen, fBlue, fAlpha };
+	RecordFixedState(FIXED_CLEAR_COLOR, afValues, 4);
+	if (cForward)
+		cForward->ClearColor(fRed, fGreen, fBlue, fAlpha);
+}
+
+void CGLRecordingBackend::Clear(GLbitfield uMask)
+{
+	Record("Clear", to_string(uMask));
+	if (cForward)
+		cForward->Clear(uMask);
+}
+
+void CGLRecordingBackend::UseProgram(GLuint uProgram)
+{
+	Record("UseProgram", to_string(uProgram));
+	RecordState(StateKey(STATE_PROGRAM), uProgram);
+	if (cForward)
+		cForward->UseProgram(uProgram);
+}
+
+void CGLRecordingBackend::BindVertexArray(GLuint uArray)
+{
+	Record("BindVertexArray", to_string(uArray));
+	RecordState(StateKey(STATE_VERTEX_ARRAY), uArray);
+	if (cForward)
+		cForward->BindVertexArray(uArray);
+}
+
+void CGLRecordingBackend::BindBuffer(GLenum eTarget, GLuint uBuffer)
+{
+	Record("BindBuffer", to_string(eTarget) + ", " + to_string(uBuffer));
+	RecordState(StateKey(STATE_BUFFER, eTarget), uBuffer);
+	if (cForward)
+		cForward->BindBuffer(eTarget, uBuffer);
+}
+
+void CGLRecordingBackend::ActiveTexture(GLenum eTexture)
+{
+	Record("ActiveTexture", to_string(eTexture));
+	RecordState(StateKey(STATE_ACTIVE_TEXTURE), eTexture);
+	eActiveTexture = eTexture;
+	if (cForward)
+		cForward->ActiveTexture(eTexture);
+}
+
+void CGLRecordingBackend::BindTexture(GLenum eTarget, GLuint uTexture)
+{
+	Record("BindTexture", to_string(eTarget) + ", " + to_string(uTexture));
+	RecordState(StateKey(STATE_TEXTURE, eTarget, eActiveTexture), uTexture);
+	if (cForward)
+		cForward->BindTexture(eTarget, uTexture);
+}
+
+void CGLRecordingBackend::BindFramebuffer(GLenum eTarget, GLuint uFramebuffer)
+{
+	Record("BindFramebuffer", to_string(eTarget) + ", " + to_string(uFramebuffer));
+	RecordState(StateKey(STATE_FRAMEBUFFER, eTarget), uFramebuffer);
+	if (cForward)
+		cForward->BindFramebuffer(eTarget, uFramebuffer);
+}
+
+GLint CGLRecordingBackend::GetUniformLocation(GLuint uProgram, const GLchar* pName)
+{
+	Record("GetUniformLocation", to_string(uProgram) + ", " + pName);
+	if (cForward)
+		return cForward->GetUniformLocation(uProgram, pName);
+
+	// Hand out a location for each name, so that the uniform calls look the same as with a driver
+	std::map<std::pair<GLuint, std::string>, GLint>::iterator it = mapUniformLocations.find(make_pair(uProgram, string(pName)));
+	if (it != mapUniformLocations.end())
+		return it->second;
+	GLint iLocation = (GLint)mapUniformLocations.size();
+	mapUniformLocations[make_pair(uProgram, string(pName))] = iLocation;
+	return iLocation;
+}
+
+void CGLRecordingBackend::Uniform1i(GLint iLocation, GLint iV0)
+{
+	Record("Uniform1i", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform1i(iLocation, iV0);
+}
+
+void CGLRecordingBackend::Uniform1f(GLint iLocation, GLfloat fV0)
+{
+	Record("Uniform1f", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform1f(iLocation, fV0);
+}
+
+void CGLRecordingBackend::Uniform2f(GLint iLocation, GLfloat fV0, GLfloat fV1)
+{
+	Record("Uniform2f", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform2f(iLocation, fV0, fV1);
+}
+
+void CGLRecordingBackend::Uniform3f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2)
+{
+	Record("Uniform3f", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform3f(iLocation, fV0, fV1, fV2);
+}
+
+void CGLRecordingBackend::Uniform4f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2, GLfloat fV3)
+{
+	Record("Uniform4f", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform4f(iLocation, fV0, fV1, fV2, fV3);
+}
+
+void CGLRecordingBackend::Uniform2fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	Record("Uniform2fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform2fv(iLocation, iCount, pValue);
+}
+
+void CGLRecordingBackend::Uniform3fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	Record("Uniform3fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform3fv(iLocation, iCount, pValue);
+}
+
+void CGLRecordingBackend::Uniform4fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue)
+{
+	Record("Uniform4fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->Uniform4fv(iLocation, iCount, pValue);
+}
+
+void CGLRecordingBackend::UniformMatrix2fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	Record("UniformMatrix2fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->UniformMatrix2fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLRecordingBackend::UniformMatrix3fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	Record("UniformMatrix3fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->UniformMatrix3fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLRecordingBackend::UniformMatrix4fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue)
+{
+	Record("UniformMatrix4fv", to_string(iLocation));
+	sFrameStats.uNumOfUniforms++;
+	if (cForward)
+		cForward->UniformMatrix4fv(iLocation, iCount, bTranspose, pValue);
+}
+
+void CGLRecordingBackend::BufferData(GLenum eTarget, GLsizeiptr iSize, const void* pData, GLenum eUsage)
+{
+	Record("BufferData", to_string(eTarget) + ", " + to_string(iSize));
+	// Allocating storage without data does not upload anything
+	if (pData != NULL)
+		sFrameStats.uBytesUploaded += (size_t)iSize;
+	if (cForward)
+		cForward->BufferData(eTarget, iSize, pData, eUsage);
+}
+
+void* CGLRecordingBackend::MapBufferRange(GLenum eTarget, GLintptr iOffset, GLsizeiptr iLength, GLbitfield uAccess)
+{
+	Record("MapBufferRange", to_string(eTarget) + ", " + to_string(iOffset) + ", " + to_string(iLength));
+	if (uAccess & GL_MAP_WRITE_BIT)
+		sFrameStats.uBytesUploaded += (size_t)iLength;
+	if (cForward)
+		return cForward->MapBufferRange(eTarget, iOffset, iLength, uAccess);
+
+	// Give the caller somewhere to write to
+	if (vMappedBuffer.size() < (size_t)iLength)
+		vMappedBuffer.resize((size_t)iLength);
+	return vMappedBuffer.empty() ? NULL : &vMappedBuffer[0];
+}
+
+GLboolean CGLRecordingBackend::UnmapBuffer(GLenum eTarget)
+{
+	Record("UnmapBuffer", to_string(eTarget));
+	if (cForward)
+		return cForward->UnmapBuffer(eTarget);
+	return GL_TRUE;
+}
+
+void CGLRecordingBackend::GenBuffers(GLsizei iCount, GLuint* pBuffers)
+{
+	Record("GenBuffers", to_string(iCount));
+	if (cForward)
+	{
+		cForward->GenBuffers(iCount, pBuffers);
+		return;
+	}
+
+	for (GLsizei i = 0; i < iCount; i++)
+		pBuffers[i] = ++uLastName;
+}
+
+void CGLRecordingBackend::DeleteBuffers(GLsizei iCount, const GLuint* pBuffers)
+{
+	Record("DeleteBuffers", to_string(iCount));
+	if (cForward)
+		cForward->DeleteBuffers(iCount, pBuffers);
+}
+
+void CGLRecordingBackend::GenVertexArrays(GLsizei iCount, GLuint* pArrays)
+{
+	Record("GenVertexArrays", to_string(iCount));
+	if (cForward)
+	{
+		cForward->GenVertexArrays(iCount, pArrays);
+		return;
+	}
+
+	for (GLsizei i = 0; i < iCount; i++)
+		pArrays[i] = ++uLastName;
+}
+
+void CGLRecordingBackend::DeleteVertexArrays(GLsizei iCount, const GLuint* pArrays)
+{
+	Record("DeleteVertexArrays", to_string(iCount));
+	if (cForward)
+		cForward->DeleteVertexArrays(iCount, pArrays);
+}
+
+void CGLRecordingBackend::VertexAttribPointer(GLuint uIndex, GLint iSize, GLenum eType, GLboolean bNormalized, GLsizei iStride, const void* pPointer)
+{
+	Record("VertexAttribPointer", to_string(uIndex) + ", " + to_string(iSize) + ", " + to_string(eType) + ", " + to_string(iStride));
+	if (cForward)
+		cForward->VertexAttribPointer(uIndex, iSize, eType, bNormalized, iStride, pPointer);
+}
+
+void CGLRecordingBackend::EnableVertexAttribArray(GLuint uIndex)
+{
+	Record("EnableVertexAttribArray", to_string(uIndex));
+	if (cForward)
+		cForward->EnableVertexAttribArray(uIndex);
+}
+
+GLsync CGLRecordingBackend::FenceSync(GLenum eCondition, GLbitfield uFlags)
+{
+	Record("FenceSync");
+	if (cForward)
+		return cForward->FenceSync(eCondition, uFlags);
+
+	// The handle is only compared and passed back to this backend, so it does not need to point at anything
+	return (GLsync)(size_t)(++uLastName);
+}
+
+GLenum CGLRecordingBackend::ClientWaitSync(GLsync sSync, GLbitfield uFlags, GLuint64 uTimeout)
+{
+	Record("ClientWaitSync", to_string(uTimeout));
+	if (cForward)
+		return cForward->ClientWaitSync(sSync, uFlags, uTimeout);
+	return GL_ALREADY_SIGNALED;
+}
+
+void CGLRecordingBackend::DeleteSync(GLsync sSync)
+{
+	Record("DeleteSync");
+	if (cForward)
+		cForward->DeleteSync(sSync);
+}
+
+void CGLRecordingBackend::DrawArrays(GLenum eMode, GLint iFirst, GLsizei iCount)
+{
+	Record("DrawArrays", to_string(eMode) + ", " + to_string(iFirst) + ", " + to_string(iCount));
+	sFrameStats.uNumOfDrawCalls++;
+	sFrameStats.uNumOfVertices += (size_t)iCount;
+	if (cForward)
+		cForward->DrawArrays(eMode, iFirst, iCount);
+}
+
+void CGLRecordingBackend::DrawElements(GLenum eMode, GLsizei iCount, GLenum eType, const void* pIndices)
+{
+	Record("DrawElements", to_string(eMode) + ", " + to_string(iCount) + ", " + to_string(eType));
+	sFrameStats.uNumOfDrawCalls++;
+	sFrameStats.uNumOfVertices += (size_t)iCount;
+	if (cForward)
+		cForward->DrawElements(eMode, iCount, eType, pIndices);
+}
+
+/**
+ @brief Make a key for mapState
+ @param eKind A const STATE_KIND variable which contains the kind of state
+ @param eTarget A const GLenum variable which contains the capability or binding target, if there is one
+ @param eUnit A const GLenum variable which contains the texture unit, for texture bindings
+ @return The key
+ */
+unsigned long long CGLRecordingBackend::StateKey(const STATE_KIND eKind, const GLenum eTarget, const GLenum eUnit)
+{
+	return ((unsigned long long)eKind << 48) | ((unsigned long long)(eUnit & 0xFFFF) << 32) | (unsigned long long)eTarget;
+}
+
+/**
+ @brief Count a call, and add it to the log
+ @param cName A const char* variable which contains the name of the call
+ @param strArguments A const std::string& variable which contains the arguments to log
+ */
+void CGLRecordingBackend::Record(const char* cName, const std::string& strArguments)
+{
+	sFrameStats.uNumOfCalls++;
+	if (bCallLogEnabled)
+		vCallLog.push_back(string(cName) + "(" + strArguments + ")");
+}
+
+/**
+ @brief Count a change to a binding or capability, unless it was already set to this value
+ @param uKey A const unsigned long long variable which contains the key from StateKey
+ @param uValue A const GLuint variable which contains the new value
+ */
+void CGLRecordingBackend::RecordState(const unsigned long long uKey, const GLuint uValue)
+{
+	std::map<unsigned long long, GLuint>::iterator it = mapState.find(uKey);
+	if ((it != mapState.end()) && (it->second == uValue))
+	{
+		sFrameStats.uNumOfRedundantStateChanges++;
+		return;
+	}
+	mapState[uKey] = uValue;
+	sFrameStats.uNumOfStateChanges++;
+}
+
+/**
+ @brief Count a change to the fixed function state, unless it was already set to these values
+ @param uOffset A const unsigned int variable which contains the position of the values in vFixedState
+ @param pValues A const GLfloat* variable which contains the new values
+ @param uNumOfValues A const unsigned int variable which contains the number of values
+ */
+void CGLRecordingBackend::RecordFixedState(const unsigned int uOffset, const GLfloat* pValues, const unsigned int uNumOfValues)
+{
+	if (memcmp(&vFixedState[uOffset], pValues, uNumOfValues * sizeof(GLfloat)) == 0)
+	{
+		sFrameStats.uNumOfRedundantStateChanges++;
+		return;
+	}
+	memcpy(&vFixedState[uOffset], pValues, uNumOfValues * sizeof(GLfloat));
+	sFrameStats.uNumOfStateChanges++;
+}
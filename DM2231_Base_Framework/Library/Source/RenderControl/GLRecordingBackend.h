@@ -0,0 +1,162 @@
+#pragma once
+
+// Include GLBackend
+#include "GLBackend.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+// Counts the calls, state changes, draws, vertices and buffer uploads of each frame.
+// The calls are passed on to another backend if one is given, e.g. to measure the game while it runs.
+// Without one, no OpenGL calls are made, so the rendering code can be measured without a GPU. The objects are then
+// given names which are not used by anything, and the fences have always signalled.
+class CGLRecordingBackend : public CGLBackend
+{
+public:
+	// The counters of one frame
+	struct FrameStats
+	{
+		// All the calls made through this backend
+		unsigned int uNumOfCalls;
+		// The draw calls
+		unsigned int uNumOfDrawCalls;
+		// The calls which changed the state, bindings included
+		unsigned int uNumOfStateChanges;
+		// The calls which set the state to what it was already
+		unsigned int uNumOfRedundantStateChanges;
+		// The uniform updates
+		unsigned int uNumOfUniforms;
+		// The vertices or indices which were drawn
+		size_t uNumOfVertices;
+		// The bytes which were written into buffers
+		size_t uBytesUploaded;
+	};
+
+	// Constructor
+	CGLRecordingBackend(CGLBackend* cForward = NULL);
+	// Destructor
+	virtual ~CGLRecordingBackend(void);
+
+	// Mark the start and end of a frame
+	virtual void BeginFrame(void);
+	virtual void EndFrame(void);
+
+	// Keep a text log of every call in the current frame
+	void SetCallLogEnabled(const bool bCallLogEnabled);
+	// Get the text log of the calls in the current frame, or of the last frame after EndFrame
+	const std::vector<std::string>& GetCallLog(void) const;
+
+	// Get the counters of the current frame
+	const FrameStats& GetFrameStats(void) const;
+	// Get the counters of the last frame which was ended
+	const FrameStats& GetLastFrameStats(void) const;
+	// Get the number of frames which were ended
+	unsigned int GetNumOfFrames(void) const;
+
+	// Print the counters of the last frame to the console
+	void PrintStats(void) const;
+
+	// Fixed function state
+	virtual void Enable(GLenum eCap);
+	virtual void Disable(GLenum eCap);
+	virtual void DepthFunc(GLenum eFunc);
+	virtual void BlendFunc(GLenum eSrcFactor, GLenum eDstFactor);
+	virtual void LineWidth(GLfloat fWidth);
+	virtual void Viewport(GLint iX, GLint iY, GLsizei iWidth, GLsizei iHeight);
+	virtual void ClearColor(GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha);
+	virtual void Clear(GLbitfield uMask);
+
+	// Bindings
+	virtual void UseProgram(GLuint uProgram);
+	virtual void BindVertexArray(GLuint uArray);
+	virtual void BindBuffer(GLenum eTarget, GLuint uBuffer);
+	virtual void ActiveTexture(GLenum eTexture);
+	virtual void BindTexture(GLenum eTarget, GLuint uTexture);
+	virtual void BindFramebuffer(GLenum eTarget, GLuint uFramebuffer);
+
+	// Uniforms
+	virtual GLint GetUniformLocation(GLuint uProgram, const GLchar* pName);
+	virtual void Uniform1i(GLint iLocation, GLint iV0);
+	virtual void Uniform1f(GLint iLocation, GLfloat fV0);
+	virtual void Uniform2f(GLint iLocation, GLfloat fV0, GLfloat fV1);
+	virtual void Uniform3f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2);
+	virtual void Uniform4f(GLint iLocation, GLfloat fV0, GLfloat fV1, GLfloat fV2, GLfloat fV3);
+	virtual void Uniform2fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void Uniform3fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void Uniform4fv(GLint iLocation, GLsizei iCount, const GLfloat* pValue);
+	virtual void UniformMatrix2fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+	virtual void UniformMatrix3fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+	virtual void UniformMatrix4fv(GLint iLocation, GLsizei iCount, GLboolean bTranspose, const GLfloat* pValue);
+
+	// Buffer uploads
+	virtual void BufferData(GLenum eTarget, GLsizeiptr iSize, const void* pData, GLenum eUsage);
+	virtual void* MapBufferRange(GLenum eTarget, GLintptr iOffset, GLsizeiptr iLength, GLbitfield uAccess);
+	virtual GLboolean UnmapBuffer(GLenum eTarget);
+
+	// Buffers and vertex arrays
+	virtual void GenBuffers(GLsizei iCount, GLuint* pBuffers);
+	virtual void DeleteBuffers(GLsizei iCount, const GLuint* pBuffers);
+	virtual void GenVertexArrays(GLsizei iCount, GLuint* pArrays);
+	virtual void DeleteVertexArrays(GLsizei iCount, const GLuint* pArrays);
+	virtual void VertexAttribPointer(GLuint uIndex, GLint iSize, GLenum eType, GLboolean bNormalized, GLsizei iStride, const void* pPointer);
+	virtual void EnableVertexAttribArray(GLuint uIndex);
+
+	// Fences
+	virtual GLsync FenceSync(GLenum eCondition, GLbitfield uFlags);
+	virtual GLenum ClientWaitSync(GLsync sSync, GLbitfield uFlags, GLuint64 uTimeout);
+	virtual void DeleteSync(GLsync sSync);
+
+	// Draws
+	virtual void DrawArrays(GLenum eMode, GLint iFirst, GLsizei iCount);
+	virtual void DrawElements(GLenum eMode, GLsizei iCount, GLenum eType, const void* pIndices);
+
+protected:
+	// The backend which the calls are passed on to, or NULL
+	CGLBackend* cForward;
+
+	// The counters of the current frame and of the last frame
+	FrameStats sFrameStats;
+	FrameStats sLastFrameStats;
+	unsigned int uNumOfFrames;
+
+	// Whether the calls are logged as text
+	bool bCallLogEnabled;
+	std::vector<std::string> vCallLog;
+
+	// The capabilities and bindings which were last set, so that redundant calls can be counted.
+	// The keys are made by StateKey.
+	std::map<unsigned long long, GLuint> mapState;
+	// The depth function, blend factors, line width, viewport and clear colour which were last set
+	std::vector<GLfloat> vFixedState;
+	// The texture unit which was last made active
+	GLenum eActiveTexture;
+
+	// The uniform locations which were handed out when there is no backend to pass the calls on to
+	std::map<std::pair<GLuint, std::string>, GLint> mapUniformLocations;
+	// The memory which MapBufferRange returns when there is no backend to pass the calls on to
+	std::vector<unsigned char> vMappedBuffer;
+	// The last buffer, vertex array or fence name which was handed out when there is no backend to pass the calls on to
+	GLuint uLastName;
+
+	// The kinds of state which are tracked in mapState
+	enum STATE_KIND
+	{
+		STATE_CAPABILITY = 1,
+		STATE_PROGRAM,
+		STATE_VERTEX_ARRAY,
+		STATE_BUFFER,
+		STATE_ACTIVE_TEXTURE,
+		STATE_TEXTURE,
+		STATE_FRAMEBUFFER
+	};
+	// Make a key for mapState
+	static unsigned long long StateKey(const STATE_KIND eKind, const GLenum eTarget = 0, const GLenum eUnit = 0);
+
+	// Count a call, and add it to the log
+	void Record(const char* cName, const std::string& strArguments = "");
+	// Count a change to a binding or capability, unless it was already set to this value
+	void RecordState(const unsigned long long uKey, const GLuint uValue);
+	// Count a change to the fixed function state, unless it was already set to these values
+	void RecordFixedState(const unsigned int uOffset, const GLfloat* pValues, const unsigned int uNumOfValues);
+};
@@ -0,0 +1,468 @@
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+// SSE is always available on x64, and VS2019 targets it by default for Win32
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)) || defined(__SSE__)
+	#define OCCLUSION_CULLER_SSE
+	#include <xmmintrin.h>
+#endif
+
+// The 12 triangles of a box, as indices into the corners from TransformBox.
+// Corner i has the maximum x if bit 0 is set, the maximum y if bit 1 is set and the maximum z if bit 2 is set.
+static const int BOX_INDICES[36] = {
+	0, 2, 6,	0, 6, 4,	// -x
+	1, 5, 7,	1, 7, 3,	// +x
+	0, 4, 5,	0, 5, 1,	// -y
+	2, 3, 7,	2, 7, 6,	// +y
+	0, 1, 3,	0, 3, 2,	// -z
+	4, 6, 7,	4, 7, 5		// +z
+};
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+COcclusionCuller::COcclusionCuller(void)
+	: iWidth(0)
+	, iHeight(0)
+	, matViewProjection(1.0f)
+	, bEnabled(true)
+#ifdef OCCLUSION_CULLER_SSE
+	, bSSE(true)
+#else
+	, bSSE(false)
+#endif
+	, uNumOfOccluders(0)
+	, uNumOfTriangles(0)
+	, uNumOfTested(0)
+	, uNumOfCulled(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+COcclusionCuller::~COcclusionCuller(void)
+{
+	vDepthBuffer.clear();
+}
+
+/**
+ @brief Init Initialise this instance
+ @param iWidth A const int variable which contains the width of the depth buffer
+ @param iHeight A const int variable which contains the height of the depth buffer
+ @return true if the initialisation is successful, else false
+ */
+bool COcclusionCuller::Init(const int iWidth, const int iHeight)
+{
+	if ((iWidth <= 0) || (iHeight <= 0))
+	{
+		cout << "COcclusionCuller::Init(): Invalid depth buffer size (" << iWidth << "x" << iHeight << ")." << endl;
+		return false;
+	}
+
+	this->iWidth = (iWidth + 3) & ~3;
+	this->iHeight = iHeight;
+	vDepthBuffer.assign((size_t)this->iWidth * (size_t)this->iHeight, 1.0f);
+
+	return true;
+}
+
+/**
+ @brief Enable or disable the culling. When it is disabled, every box is visible.
+ @param bEnabled A const bool variable which is true to enable the culling
+ */
+void COcclusionCuller::SetEnabled(const bool bEnabled)
+{
+	this->bEnabled = bEnabled;
+}
+
+/**
+ @brief Check if the culling is enabled
+ */
+bool COcclusionCuller::IsEnabled(void) const
+{
+	return bEnabled;
+}
+
+/**
+ @brief Use SSE to draw and test 4 pixels at a time, or else one pixel at a time. SSE is not used if it is not available
+		in this build. Both give the same result, so the pixel at a time path is only used to check the SSE path.
+ @param bSSE A const bool variable which is true to use SSE
+ */
+void COcclusionCuller::SetSSE(const bool bSSE)
+{
+#ifdef OCCLUSION_CULLER_SSE
+	this->bSSE = bSSE;
+#else
+	this->bSSE = false;
+	(void)bSSE;
+#endif
+}
+
+/**
+ @brief Check if SSE is used
+ */
+bool COcclusionCuller::IsSSE(void) const
+{
+	return bSSE;
+}
+
+/**
+ @brief Clear the depth buffer, and set the camera which the occluders and boxes are seen from
+ @param matViewProjection A const glm::mat4& variable which contains the projection matrix times the view matrix
+ */
+void COcclusionCuller::Begin(const glm::mat4& matViewProjection)
+{
+	this->matViewProjection = matViewProjection;
+	std::fill(vDepthBuffer.begin(), vDepthBuffer.end(), 1.0f);
+
+	uNumOfOccluders = 0;
+	uNumOfTriangles = 0;
+	uNumOfTested = 0;
+	uNumOfCulled = 0;
+}
+
+/**
+ @brief Draw an axis-aligned box into the depth buffer. The box should be solid, e.g. a wall or a pillar,
+		since everything behind it will be treated as hidden.
+ @param vec3Min A const glm::vec3& variable which contains the minimum corner of the box in world space
+ @param vec3Max A const glm::vec3& variable which contains the maximum corner of the box in world space
+ */
+void COcclusionCuller::AddOccluder(const glm::vec3& vec3Min, const glm::vec3& vec3Max)
+{
+	if ((!bEnabled) || (vDepthBuffer.empty()))
+		return;
+
+	glm::vec4 vec4Corners[8];
+	TransformBox(vec3Min, vec3Max, vec4Corners);
+
+	// Skip the box if it is entirely behind the near plane
+	bool bInFront = false;
+	for (int i = 0; i < 8; i++)
+	{
+		if (vec4Corners[i].z + vec4Corners[i].w >= 0.0f)
+		{
+			bInFront = true;
+			break;
+		}
+	}
+	if (!bInFront)
+		return;
+
+	for (int i = 0; i < 36; i += 3)
+	{
+		DrawClippedTriangle(vec4Corners[BOX_INDICES[i]],
+							vec4Corners[BOX_INDICES[i + 1]],
+							vec4Corners[BOX_INDICES[i + 2]]);
+	}
+	uNumOfOccluders++;
+}
+
+/**
+ @brief Check if any part of an axis-aligned box may be seen past the occluders.
+		The box is hidden only if every pixel which it covers has an occluder in front of its nearest point.
+		Boxes which cross the near plane are always visible, and boxes which are off the screen are hidden.
+ @param vec3Min A const glm::vec3& variable which contains the minimum corner of the box in world space
+ @param vec3Max A const glm::vec3& variable which contains the maximum corner of the box in world space
+ @return true if the box may be visible, else false
+ */
+bool COcclusionCuller::IsVisible(const glm::vec3& vec3Min, const glm::vec3& vec3Max)
+{
+	if ((!bEnabled) || (vDepthBuffer.empty()))
+		return true;
+
+	uNumOfTested++;
+
+	glm::vec4 vec4Corners[8];
+	TransformBox(vec3Min, vec3Max, vec4Corners);
+
+	// Find the rectangle on the screen which the box covers, and its nearest depth
+	float fMinX = FLT_MAX, fMinY = FLT_MAX, fMinZ = FLT_MAX;
+	float fMaxX = -FLT_MAX, fMaxY = -FLT_MAX;
+	for (int i = 0; i < 8; i++)
+	{
+		if (vec4Corners[i].z + vec4Corners[i].w < 0.0f)
+			return true;
+
+		glm::vec3 vec3Screen = ToScreen(vec4Corners[i]);
+		if (vec3Screen.x < fMinX) fMinX = vec3Screen.x;
+		if (vec3Screen.x > fMaxX) fMaxX = vec3Screen.x;
+		if (vec3Screen.y < fMinY) fMinY = vec3Screen.y;
+		if (vec3Screen.y > fMaxY) fMaxY = vec3Screen.y;
+		if (vec3Screen.z < fMinZ) fMinZ = vec3Screen.z;
+	}
+
+	if ((fMaxX < 0.0f) || (fMinX >= (float)iWidth) || (fMaxY < 0.0f) || (fMinY >= (float)iHeight))
+	{
+		uNumOfCulled++;
+		return false;
+	}
+
+	// Testing a few pixels outside the rectangle can only make the box visible,
+	// so the rows are widened to whole groups of 4 pixels
+	int iMinX = (int)floor(fMinX), iMaxX = (int)floor(fMaxX);
+	int iMinY = (int)floor(fMinY), iMaxY = (int)floor(fMaxY);
+	if (iMinX < 0) iMinX = 0;
+	if (iMaxX > iWidth - 1) iMaxX = iWidth - 1;
+	if (iMinY < 0) iMinY = 0;
+	if (iMaxY > iHeight - 1) iMaxY = iHeight - 1;
+	iMinX &= ~3;
+
+	for (int y = iMinY; y <= iMaxY; y++)
+	{
+		const float* pRow = &vDepthBuffer[(size_t)y * iWidth];
+#ifdef OCCLUSION_CULLER_SSE
+		if (bSSE)
+		{
+			__m128 vMinZ = _mm_set1_ps(fMinZ);
+			for (int x = iMinX; x <= iMaxX; x += 4)
+			{
+				// Visible if any occluder depth is at or behind the nearest point of the box
+				if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(pRow + x), vMinZ)) != 0)
+					return true;
+			}
+			continue;
+		}
+#endif
+		// The groups of 4 pixels are tested whole, as the SSE path does
+		for (int x = iMinX; x <= (iMaxX | 3); x++)
+		{
+			if (pRow[x] >= fMinZ)
+				return true;
+		}
+	}
+
+	uNumOfCulled++;
+	return false;
+}
+
+/**
+ @brief Get the depth buffer, with 0 at the near plane and 1 at the far plane
+ */
+const float* COcclusionCuller::GetDepthBuffer(void) const
+{
+	return vDepthBuffer.empty() ? NULL : &vDepthBuffer[0];
+}
+
+/**
+ @brief Get the width of the depth buffer
+ */
+int COcclusionCuller::GetWidth(void) const
+{
+	return iWidth;
+}
+
+/**
+ @brief Get the height of the depth buffer
+ */
+int COcclusionCuller::GetHeight(void) const
+{
+	return iHeight;
+}
+
+/**
+ @brief Get the number of occluders which were drawn since Begin
+ */
+unsigned int COcclusionCuller::GetNumOfOccluders(void) const
+{
+	return uNumOfOccluders;
+}
+
+/**
+ @brief Get the number of boxes which were tested since Begin
+ */
+unsigned int COcclusionCuller::GetNumOfTested(void) const
+{
+	return uNumOfTested;
+}
+
+/**
+ @brief Get the number of boxes which were found to be hidden since Begin
+ */
+unsigned int COcclusionCuller::GetNumOfCulled(void) const
+{
+	return uNumOfCulled;
+}
+
+/**
+ @brief Print the statistics of the last frame to the console
+ */
+void COcclusionCuller::PrintStats(void) const
+{
+	cout << "COcclusionCuller: " << (bEnabled ? "enabled" : "disabled") << ", " << iWidth << "x" << iHeight << ", "
+		<< uNumOfOccluders << " occluders (" << uNumOfTriangles << " triangles), "
+		<< uNumOfCulled << " of " << uNumOfTested << " boxes culled" << endl;
+}
+
+/**
+ @brief Transform the 8 corners of a box into clip space
+ @param vec3Min A const glm::vec3& variable which contains the minimum corner of the box
+ @param vec3Max A const glm::vec3& variable which contains the maximum corner of the box
+ @param pCorners A glm::vec4* variable which returns the 8 corners, in the order which BOX_INDICES uses
+ */
+void COcclusionCuller::TransformBox(const glm::vec3& vec3Min, const glm::vec3& vec3Max, glm::vec4* pCorners) const
+{
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 vec4Corner(	(i & 1) ? vec3Max.x : vec3Min.x,
+								(i & 2) ? vec3Max.y : vec3Min.y,
+								(i & 4) ? vec3Max.z : vec3Min.z,
+								1.0f);
+		pCorners[i] = matViewProjection * vec4Corner;
+	}
+}
+
+/**
+ @brief Clip a triangle in clip space against the near plane, then draw it.
+		A point is in front of the near plane if z + w >= 0. Clipping one corner off gives a quad.
+ @param vec4A A const glm::vec4& variable which contains the first corner
+ @param vec4B A const glm::vec4& variable which contains the second corner
+ @param vec4C A const glm::vec4& variable which contains the third corner
+ */
+void COcclusionCuller::DrawClippedTriangle(const glm::vec4& vec4A, const glm::vec4& vec4B, const glm::vec4& vec4C)
+{
+	const glm::vec4 vec4In[3] = { vec4A, vec4B, vec4C };
+	glm::vec4 vec4Out[4];
+	int iNumOfOut = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		const glm::vec4& vec4Current = vec4In[i];
+		const glm::vec4& vec4Next = vec4In[(i + 1) % 3];
+		float fCurrent = vec4Current.z + vec4Current.w;
+		float fNext = vec4Next.z + vec4Next.w;
+
+		if (fCurrent >= 0.0f)
+			vec4Out[iNumOfOut++] = vec4Current;
+		if ((fCurrent >= 0.0f) != (fNext >= 0.0f))
+			vec4Out[iNumOfOut++] = vec4Current + (vec4Next - vec4Current) * (fCurrent / (fCurrent - fNext));
+	}
+	if (iNumOfOut < 3)
+		return;
+
+	glm::vec3 vec3Screen[4];
+	for (int i = 0; i < iNumOfOut; i++)
+		vec3Screen[i] = ToScreen(vec4Out[i]);
+
+	RasteriseTriangle(vec3Screen[0], vec3Screen[1], vec3Screen[2]);
+	if (iNumOfOut == 4)
+		RasteriseTriangle(vec3Screen[0], vec3Screen[2], vec3Screen[3]);
+}
+
+/**
+ @brief Draw a triangle in screen space into the depth buffer, keeping the nearest depth.
+		A pixel is covered if its centre is inside all 3 edges. Each row is processed 4 pixels at a time.
+ @param vec3A A glm::vec3 variable which contains the first corner
+ @param vec3B A glm::vec3 variable which contains the second corner
+ @param vec3C A glm::vec3 variable which contains the third corner
+ */
+void COcclusionCuller::RasteriseTriangle(glm::vec3 vec3A, glm::vec3 vec3B, glm::vec3 vec3C)
+{
+	// Make the triangle counter-clockwise, so that the inside of every edge is positive
+	float fArea = (vec3B.x - vec3A.x) * (vec3C.y - vec3A.y) - (vec3B.y - vec3A.y) * (vec3C.x - vec3A.x);
+	if (fabs(fArea) < 1e-6f)
+		return;
+	if (fArea < 0.0f)
+	{
+		std::swap(vec3B, vec3C);
+		fArea = -fArea;
+	}
+
+	// Find the pixels which the triangle may cover
+	float fMinX = vec3A.x, fMaxX = vec3A.x, fMinY = vec3A.y, fMaxY = vec3A.y;
+	if (vec3B.x < fMinX) fMinX = vec3B.x;
+	if (vec3C.x < fMinX) fMinX = vec3C.x;
+	if (vec3B.x > fMaxX) fMaxX = vec3B.x;
+	if (vec3C.x > fMaxX) fMaxX = vec3C.x;
+	if (vec3B.y < fMinY) fMinY = vec3B.y;
+	if (vec3C.y < fMinY) fMinY = vec3C.y;
+	if (vec3B.y > fMaxY) fMaxY = vec3B.y;
+	if (vec3C.y > fMaxY) fMaxY = vec3C.y;
+	if ((fMaxX < 0.0f) || (fMinX >= (float)iWidth) || (fMaxY < 0.0f) || (fMinY >= (float)iHeight))
+		return;
+	int iMinX = (fMinX > 0.0f) ? (int)fMinX : 0;
+	int iMaxX = (fMaxX < (float)(iWidth - 1)) ? (int)fMaxX : iWidth - 1;
+	int iMinY = (fMinY > 0.0f) ? (int)fMinY : 0;
+	int iMaxY = (fMaxY < (float)(iHeight - 1)) ? (int)fMaxY : iHeight - 1;
+	// Start each row on a group of 4 pixels. The width is a multiple of 4, so the last group fits too.
+	iMinX &= ~3;
+
+	uNumOfTriangles++;
+
+	// The edge functions E(x, y) = A * x + B * y + C are 0 on an edge, and equal to the area at the opposite corner
+	const float fA0 = vec3B.y - vec3C.y, fB0 = vec3C.x - vec3B.x, fC0 = vec3B.x * vec3C.y - vec3B.y * vec3C.x;
+	const float fA1 = vec3C.y - vec3A.y, fB1 = vec3A.x - vec3C.x, fC1 = vec3C.x * vec3A.y - vec3C.y * vec3A.x;
+	const float fA2 = vec3A.y - vec3B.y, fB2 = vec3B.x - vec3A.x, fC2 = vec3A.x * vec3B.y - vec3A.y * vec3B.x;
+
+	// The depth is the corners' depths weighted by the edge functions, which is also linear in x and y
+	const float fInvArea = 1.0f / fArea;
+	const float fAz = (fA0 * vec3A.z + fA1 * vec3B.z + fA2 * vec3C.z) * fInvArea;
+	const float fBz = (fB0 * vec3A.z + fB1 * vec3B.z + fB2 * vec3C.z) * fInvArea;
+	const float fCz = (fC0 * vec3A.z + fC1 * vec3B.z + fC2 * vec3C.z) * fInvArea;
+
+	for (int y = iMinY; y <= iMaxY; y++)
+	{
+		const float fY = y + 0.5f;
+		float* pRow = &vDepthBuffer[(size_t)y * iWidth];
+#ifdef OCCLUSION_CULLER_SSE
+		if (bSSE)
+		{
+			const __m128 vZero = _mm_setzero_ps();
+			const __m128 vX = _mm_setr_ps(iMinX + 0.5f, iMinX + 1.5f, iMinX + 2.5f, iMinX + 3.5f);
+			__m128 vE0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fA0), vX), _mm_set1_ps(fB0 * fY + fC0));
+			__m128 vE1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fA1), vX), _mm_set1_ps(fB1 * fY + fC1));
+			__m128 vE2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fA2), vX), _mm_set1_ps(fB2 * fY + fC2));
+			__m128 vZ = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fAz), vX), _mm_set1_ps(fBz * fY + fCz));
+			const __m128 vStepE0 = _mm_set1_ps(fA0 * 4.0f);
+			const __m128 vStepE1 = _mm_set1_ps(fA1 * 4.0f);
+			const __m128 vStepE2 = _mm_set1_ps(fA2 * 4.0f);
+			const __m128 vStepZ = _mm_set1_ps(fAz * 4.0f);
+			for (int x = iMinX; x <= iMaxX; x += 4)
+			{
+				__m128 vInside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(vE0, vZero), _mm_cmpge_ps(vE1, vZero)),
+											_mm_cmpge_ps(vE2, vZero));
+				if (_mm_movemask_ps(vInside) != 0)
+				{
+					__m128 vDepth = _mm_loadu_ps(pRow + x);
+					__m128 vNearest = _mm_min_ps(vDepth, vZ);
+					_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(vInside, vNearest), _mm_andnot_ps(vInside, vDepth)));
+				}
+				vE0 = _mm_add_ps(vE0, vStepE0);
+				vE1 = _mm_add_ps(vE1, vStepE1);
+				vE2 = _mm_add_ps(vE2, vStepE2);
+				vZ = _mm_add_ps(vZ, vStepZ);
+			}
+			continue;
+		}
+#endif
+		for (int x = iMinX; x <= iMaxX; x++)
+		{
+			const float fX = x + 0.5f;
+			if ((fA0 * fX + fB0 * fY + fC0 >= 0.0f) &&
+				(fA1 * fX + fB1 * fY + fC1 >= 0.0f) &&
+				(fA2 * fX + fB2 * fY + fC2 >= 0.0f))
+			{
+				const float fZ = fAz * fX + fBz * fY + fCz;
+				if (fZ < pRow[x])
+					pRow[x] = fZ;
+			}
+		}
+	}
+}
+
+/**
+ @brief Convert a point in clip space, which is in front of the near plane, to screen space
+ @param vec4Clip A const glm::vec4& variable which contains the point in clip space
+ @return The pixel coordinates in x and y, and the depth from 0 to 1 in z
+ */
+glm::vec3 COcclusionCuller::ToScreen(const glm::vec4& vec4Clip) const
+{
+	const float fInvW = 1.0f / vec4Clip.w;
+	return glm::vec3(	(vec4Clip.x * fInvW * 0.5f + 0.5f) * iWidth,
+						(vec4Clip.y * fInvW * 0.5f + 0.5f) * iHeight,
+						vec4Clip.z * fInvW * 0.5f + 0.5f);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+
+class COcclusionCuller : public CSingletonTemplate<COcclusionCuller>
+{
+	friend CSingletonTemplate<COcclusionCuller>;
+public:
+	// Init. The width is rounded up to a multiple of 4, so that each row can be processed 4 pixels at a time.
+	bool Init(const int iWidth = 256, const int iHeight = 128);
+
+	// Enable or disable the culling. When it is disabled, every box is visible.
+	void SetEnabled(const bool bEnabled);
+	// Check if the culling is enabled
+	bool IsEnabled(void) const;
+	// Use SSE to draw and test 4 pixels at a time, where it is available, or else one pixel at a time
+	void SetSSE(const bool bSSE);
+	// Check if SSE is used
+	bool IsSSE(void) const;
+
+	// Clear the depth buffer, and set the camera which the occluders and boxes are seen from
+	void Begin(const glm::mat4& matViewProjection);
+	// Draw an axis-aligned box into the depth buffer
+	void AddOccluder(const glm::vec3& vec3Min, const glm::vec3& vec3Max);
+	// Check if any part of an axis-aligned box may be seen past the occluders
+	bool IsVisible(const glm::vec3& vec3Min, const glm::vec3& vec3Max);
+
+	// Get the depth buffer, with 0 at the near plane and 1 at the far plane
+	const float* GetDepthBuffer(void) const;
+	// Get the width of the depth buffer
+	int GetWidth(void) const;
+	// Get the height of the depth buffer
+	int GetHeight(void) const;
+
+	// Get the number of occluders which were drawn since Begin
+	unsigned int GetNumOfOccluders(void) const;
+	// Get the number of boxes which were tested since Begin
+	unsigned int GetNumOfTested(void) const;
+	// Get the number of boxes which were found to be hidden since Begin
+	unsigned int GetNumOfCulled(void) const;
+
+	// Print the statistics of the last frame to the console
+	void PrintStats(void) const;
+
+protected:
+	// The depth buffer, stored row by row from the bottom of the screen
+	std::vector<float> vDepthBuffer;
+	int iWidth;
+	int iHeight;
+
+	// The camera which the occluders and boxes are seen from
+	glm::mat4 matViewProjection;
+
+	// Whether the culling is enabled
+	bool bEnabled;
+	// Whether SSE is used
+	bool bSSE;
+
+	// Statistics
+	unsigned int uNumOfOccluders;
+	unsigned int uNumOfTriangles;
+	unsigned int uNumOfTested;
+	unsigned int uNumOfCulled;
+
+	// Constructor
+	COcclusionCuller(void);
+
+	// Destructor
+	virtual ~COcclusionCuller(void);
+
+	// Transform the 8 corners of a box into clip space
+	void TransformBox(const glm::vec3& vec3Min, const glm::vec3& vec3Max, glm::vec4* pCorners) const;
+	// Clip a triangle in clip space against the near plane, then draw it
+	void DrawClippedTriangle(const glm::vec4& vec4A, const glm::vec4& vec4B, const glm::vec4& vec4C);
+	// Draw a triangle in screen space into the depth buffer, keeping the nearest depth
+	void RasteriseTriangle(glm::vec3 vec3A, glm::vec3 vec3B, glm::vec3 vec3C);
+	// Convert a point in clip space, which is in front of the near plane, to screen space
+	glm::vec3 ToScreen(const glm::vec4& vec4Clip) const;
+};
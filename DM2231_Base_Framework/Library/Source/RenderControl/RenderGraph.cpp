@@ -0,0 +1,270 @@
+#include "RenderGraph.h"
+
+// Include GLDispatch
+#include "GLDispatch.h"
+// Include Profiler
+#include "../System/Profiler.h"
+
+#include <set>
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+const char* const CRenderGraph::BACKBUFFER = "backbuffer";
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CRenderGraph::CRenderGraph(void)
+	: bIsDirty(true)
+	, iQueryIndex(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CRenderGraph::~CRenderGraph(void)
+{
+	// Delete the timer queries in the graphics card
+	for (unsigned int i = 0; i < vPasses.size(); i++)
+	{
+		glDeleteQueries(NUM_QUERIES, vPasses[i].auiQueries);
+	}
+	vPasses.clear();
+	mapTargets.clear();
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CRenderGraph::Init(void)
+{
+	// The default framebuffer is always available
+	mapTargets[BACKBUFFER] = 0;
+	bIsDirty = true;
+	return true;
+}
+
+/**
+ @brief Declare a render target which passes can write to and read from
+ @param strName A const std::string& variable which contains the name of the target
+ @param uiFBO A const GLuint variable which contains the framebuffer object to render into
+ */
+void CRenderGraph::AddTarget(const std::string& strName, const GLuint uiFBO)
+{
+	mapTargets[strName] = uiFBO;
+}
+
+/**
+ @brief Declare a pass, which renders into a target and reads from a list of targets
+ @param strName A const std::string& variable which contains the name of the pass
+ @param strTarget A const std::string& variable which contains the name of the target to render into
+ @param vInputs A const std::vector<std::string>& variable which contains the names of the targets which are read
+ @param fnExecute A PassFunction variable which renders the pass
+ @return true if the pass is added, else false
+ */
+bool CRenderGraph::AddPass(	const std::string& strName,
+							const std::string& strTarget,
+							const std::vector<std::string>& vInputs,
+							PassFunction fnExecute)
+{
+	if (FindPass(strName) != NULL)
+	{
+		cout << "CRenderGraph::AddPass(): The pass " << strName << " already exists." << endl;
+		return false;
+	}
+	if (mapTargets.find(strTarget) == mapTargets.end())
+	{
+		cout << "CRenderGraph::AddPass(): The target " << strTarget << " of pass " << strName << " is not declared." << endl;
+		return false;
+	}
+	for (unsigned int i = 0; i < vInputs.size(); i++)
+	{
+		if (mapTargets.find(vInputs[i]) == mapTargets.end())
+		{
+			cout << "CRenderGraph::AddPass(): The input " << vInputs[i] << " of pass " << strName << " is not declared." << endl;
+			return false;
+		}
+	}
+
+	Pass sPass;
+	sPass.strName = strName;
+	sPass.strTarget = strTarget;
+	sPass.vInputs = vInputs;
+	sPass.fnExecute = fnExecute;
+	sPass.bEnabled = true;
+	sPass.bActive = false;
+	glGenQueries(NUM_QUERIES, sPass.auiQueries);
+	for (int i = 0; i < NUM_QUERIES; i++)
+	{
+		sPass.abQueryIssued[i] = false;
+		sPass.allQueryStart[i] = 0;
+	}
+	sPass.pProfileName = CProfiler::GetInstance()->InternName(strName);
+	sPass.dGPUTime = 0.0;
+	sPass.dCPUTime = 0.0;
+	vPasses.push_back(sPass);
+
+	bIsDirty = true;
+	return true;
+}
+
+/**
+ @brief Enable or disable a pass
+ @param strName A const std::string& variable which contains the name of the pass
+ @param bEnabled A const bool variable which is true to enable the pass, else false
+ */
+void CRenderGraph::SetPassEnabled(const std::string& strName, const bool bEnabled)
+{
+	Pass* sPass = FindPass(strName);
+	if ((sPass) && (sPass->bEnabled != bEnabled))
+	{
+		sPass->bEnabled = bEnabled;
+		bIsDirty = true;
+	}
+}
+
+/**
+ @brief Check if a pass is enabled
+ @param strName A const std::string& variable which contains the name of the pass
+ @return true if the pass is enabled, else false
+ */
+bool CRenderGraph::IsPassEnabled(const std::string& strName) const
+{
+	const Pass* sPass = FindPass(strName);
+	return ((sPass) && (sPass->bEnabled));
+}
+
+/**
+ @brief Check if a pass was run in the last Execute
+ @param strName A const std::string& variable which contains the name of the pass
+ @return true if the pass is active, else false
+ */
+bool CRenderGraph::IsPassActive(const std::string& strName) const
+{
+	const Pass* sPass = FindPass(strName);
+	return ((sPass) && (sPass->bActive));
+}
+
+/**
+ @brief Run all the enabled passes whose outputs are used, in the order they were declared.
+		Each pass is timed on the CPU, and on the GPU with a timer query. The GPU times are also sent to the profiler
+		when they are read, a frame later, as the timer queries of the passes cannot be nested in other timer queries.
+ */
+void CRenderGraph::Execute(void)
+{
+	if (bIsDirty)
+		Compile();
+
+	for (unsigned int i = 0; i < vPasses.size(); i++)
+	{
+		Pass& sPass = vPasses[i];
+		if (!sPass.bActive)
+			continue;
+
+		// Collect the result of the query which was issued with this index, if the GPU has finished it
+		GLuint uiQuery = sPass.auiQueries[iQueryIndex];
+		if (sPass.abQueryIssued[iQueryIndex])
+		{
+			GLint iAvailable = 0;
+			glGetQueryObjectiv(uiQuery, GL_QUERY_RESULT_AVAILABLE, &iAvailable);
+			if (iAvailable)
+			{
+				GLuint64 ui64Elapsed = 0;
+				glGetQueryObjectui64v(uiQuery, GL_QUERY_RESULT, &ui64Elapsed);
+				sPass.dGPUTime = (double)ui64Elapsed / 1000000.0;
+				CProfiler::GetInstance()->AddGPUSample(sPass.pProfileName, sPass.allQueryStart[iQueryIndex], sPass.dGPUTime);
+			}
+		}
+
+		// Bind the target of this pass
+		GL()->BindFramebuffer(GL_FRAMEBUFFER, mapTargets[sPass.strTarget]);
+
+		chrono::high_resolution_clock::time_point tStart = chrono::high_resolution_clock::now();
+		sPass.allQueryStart[iQueryIndex] = CProfiler::GetInstance()->GetTime();
+		glBeginQuery(GL_TIME_ELAPSED, uiQuery);
+
+		{
+			PROFILE_SCOPE(sPass.pProfileName);
+			sPass.fnExecute();
+		}
+
+		glEndQuery(GL_TIME_ELAPSED);
+		sPass.abQueryIssued[iQueryIndex] = true;
+		sPass.dCPUTime = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - tStart).count();
+	}
+
+	// Leave the default framebuffer bound
+	GL()->BindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	iQueryIndex = (iQueryIndex + 1) % NUM_QUERIES;
+}
+
+/**
+ @brief Print the pass timings to the console
+ */
+void CRenderGraph::PrintTimings(void) const
+{
+	cout << "CRenderGraph: " << vPasses.size() << " passes" << endl;
+	for (unsigned int i = 0; i < vPasses.size(); i++)
+	{
+		const Pass& sPass = vPasses[i];
+		cout << "\t" << sPass.strName << " -> " << sPass.strTarget << ": ";
+		if (sPass.bActive)
+			cout << "CPU " << sPass.dCPUTime << " ms, GPU " << sPass.dGPUTime << " ms" << endl;
+		else
+			cout << "skipped" << endl;
+	}
+}
+
+/**
+ @brief Work out which passes are active. Going from the last pass to the first, a pass is active
+		if it is enabled and it renders into the backbuffer or into a target read by an active pass.
+ */
+void CRenderGraph::Compile(void)
+{
+	set<string> setUsedTargets;
+	setUsedTargets.insert(BACKBUFFER);
+
+	for (int i = (int)vPasses.size() - 1; i >= 0; i--)
+	{
+		Pass& sPass = vPasses[i];
+		sPass.bActive = (sPass.bEnabled) && (setUsedTargets.count(sPass.strTarget) > 0);
+		if (sPass.bActive)
+			setUsedTargets.insert(sPass.vInputs.begin(), sPass.vInputs.end());
+	}
+
+	bIsDirty = false;
+}
+
+/**
+ @brief Find a pass by its name
+ @param strName A const std::string& variable which contains the name of the pass
+ @return The pass, or NULL if it does not exist
+ */
+CRenderGraph::Pass* CRenderGraph::FindPass(const std::string& strName)
+{
+	for (unsigned int i = 0; i < vPasses.size(); i++)
+	{
+		if (vPasses[i].strName == strName)
+			return &vPasses[i];
+	}
+	return NULL;
+}
+
+/**
+ @brief Find a pass by its name
+ @param strName A const std::string& variable which contains the name of the pass
+ @return The pass, or NULL if it does not exist
+ */
+const CRenderGraph::Pass* CRenderGraph::FindPass(const std::string& strName) const
+{
+	for (unsigned int i = 0; i < vPasses.size(); i++)
+	{
+		if (vPasses[i].strName == strName)
+			return &vPasses[i];
+	}
+	return NULL;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+class CRenderGraph : public CSingletonTemplate<CRenderGraph>
+{
+	friend CSingletonTemplate<CRenderGraph>;
+public:
+	// The function which renders a pass
+	typedef std::function<void(void)> PassFunction;
+
+	// The name of the default framebuffer, which is always in use
+	static const char* const BACKBUFFER;
+
+	// Init
+	bool Init(void);
+
+	// Declare a render target which passes can write to and read from
+	void AddTarget(const std::string& strName, const GLuint uiFBO);
+	// Declare a pass, which renders into a target and reads from a list of targets
+	bool AddPass(	const std::string& strName,
+					const std::string& strTarget,
+					const std::vector<std::string>& vInputs,
+					PassFunction fnExecute);
+
+	// Enable or disable a pass
+	void SetPassEnabled(const std::string& strName, const bool bEnabled);
+	// Check if a pass is enabled
+	bool IsPassEnabled(const std::string& strName) const;
+	// Check if a pass was run in the last Execute
+	bool IsPassActive(const std::string& strName) const;
+
+	// Run all the enabled passes whose outputs are used, in the order they were declared
+	void Execute(void);
+
+	// Print the pass timings to the console
+	void PrintTimings(void) const;
+
+protected:
+	// The number of timer queries per pass, so results are read a frame after they are issued
+	static const int NUM_QUERIES = 2;
+
+	// A pass in the graph
+	struct Pass
+	{
+		std::string strName;
+		std::string strTarget;
+		std::vector<std::string> vInputs;
+		PassFunction fnExecute;
+		// Set by the user to switch the pass on or off
+		bool bEnabled;
+		// Set by the graph if the pass is enabled and its output is used
+		bool bActive;
+		// Timer queries, used in turn
+		GLuint auiQueries[NUM_QUERIES];
+		bool abQueryIssued[NUM_QUERIES];
+		// The profiler time at which each query was issued, and the name of the pass in the profiler
+		long long allQueryStart[NUM_QUERIES];
+		const char* pProfileName;
+		// Timings in milliseconds
+		double dGPUTime;
+		double dCPUTime;
+	};
+
+	// The passes in the order they were declared
+	std::vector<Pass> vPasses;
+	// Map of target names to framebuffer objects
+	std::map<std::string, GLuint> mapTargets;
+
+	// Flag to indicate that the active passes must be worked out again
+	bool bIsDirty;
+	// The index of the timer query to use this frame
+	int iQueryIndex;
+
+	// Constructor
+	CRenderGraph(void);
+
+	// Destructor
+	virtual ~CRenderGraph(void);
+
+	// Work out which passes are active
+	void Compile(void);
+	// Find a pass by its name
+	Pass* FindPass(const std::string& strName);
+	const Pass* FindPass(const std::string& strName) const;
+};
@@ -0,0 +1,272 @@
+#include "ShaderCache.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// The tag and version of the cache file
+static const unsigned int CACHE_MAGIC = 0x43504D44;	// "DMPC"
+static const unsigned int CACHE_VERSION = 1;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CShaderCache::CShaderCache(void)
+	: bDirty(false)
+	, bSupported(false)
+	, uNumOfHits(0)
+	, uNumOfMisses(0)
+	, dCompileTime(0.0)
+	, dLoadTime(0.0)
+	, dCachedCompileTime(0.0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CShaderCache::~CShaderCache(void)
+{
+	mapEntries.clear();
+}
+
+/**
+ @brief Init Initialise this instance, and read the program binaries which were saved by an earlier run.
+		The binaries are dropped if they were made by another driver.
+ @param filename A const char* variable which contains the file name of the cache
+ @return true if the initialisation is successful, else false
+ */
+bool CShaderCache::Init(const char* filename)
+{
+	strFilename = filename;
+	mapEntries.clear();
+	bDirty = false;
+
+	GLint iNumOfFormats = 0;
+	if (GLEW_ARB_get_program_binary)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &iNumOfFormats);
+	bSupported = (iNumOfFormats > 0);
+	if (!bSupported)
+	{
+		cout << "CShaderCache::Init(): The driver cannot save program binaries, so the shaders will be compiled from source." << endl;
+		return true;
+	}
+
+	strDriver = string((const char*)glGetString(GL_VENDOR)) + "|"
+		+ (const char*)glGetString(GL_RENDERER) + "|"
+		+ (const char*)glGetString(GL_VERSION);
+
+	ifstream fileStream(strFilename.c_str(), ios::binary);
+	if (!fileStream.is_open())
+		return true;
+
+	unsigned int uMagic = 0, uVersion = 0, uDriverLength = 0, uNumOfEntries = 0;
+	fileStream.read((char*)&uMagic, sizeof(unsigned int));
+	fileStream.read((char*)&uVersion, sizeof(unsigned int));
+	fileStream.read((char*)&uDriverLength, sizeof(unsigned int));
+	if ((!fileStream.good()) || (uMagic != CACHE_MAGIC) || (uVersion != CACHE_VERSION) || (uDriverLength > 1024))
+	{
+		cout << "CShaderCache::Init(): " << strFilename << " is not a program cache, so it will be rebuilt." << endl;
+		bDirty = true;
+		return true;
+	}
+	string strFileDriver(uDriverLength, '\0');
+	if (uDriverLength > 0)
+		fileStream.read(&strFileDriver[0], uDriverLength);
+	if (strFileDriver != strDriver)
+	{
+		cout << "CShaderCache::Init(): The driver has changed, so the program cache will be rebuilt." << endl;
+		bDirty = true;
+		return true;
+	}
+
+	fileStream.read((char*)&uNumOfEntries, sizeof(unsigned int));
+	for (unsigned int i = 0; (i < uNumOfEntries) && (fileStream.good()); i++)
+	{
+		unsigned long long uKey = 0;
+		unsigned int uFormat = 0, uSize = 0;
+		Entry sEntry;
+		fileStream.read((char*)&uKey, sizeof(unsigned long long));
+		fileStream.read((char*)&uFormat, sizeof(unsigned int));
+		fileStream.read((char*)&sEntry.dCompileTime, sizeof(double));
+		fileStream.read((char*)&uSize, sizeof(unsigned int));
+		if ((!fileStream.good()) || (uSize == 0))
+			break;
+		sEntry.eFormat = uFormat;
+		sEntry.vBinary.resize(uSize);
+		fileStream.read(&sEntry.vBinary[0], uSize);
+		if (!fileStream.good())
+			break;
+		mapEntries[uKey] = sEntry;
+	}
+	if (mapEntries.size() != uNumOfEntries)
+	{
+		cout << "CShaderCache::Init(): " << strFilename << " is truncated, so it will be rebuilt." << endl;
+		bDirty = true;
+	}
+
+	return true;
+}
+
+/**
+ @brief Check if the driver can save and load program binaries
+ */
+bool CShaderCache::IsSupported(void) const
+{
+	return bSupported;
+}
+
+/**
+ @brief Get the key of a program, which is a 64-bit FNV-1a hash of its sources and the driver.
+		Editing a shader file or updating the driver gives a new key, so a stale binary is never used.
+ @param strVertexCode A const std::string& variable which contains the vertex shader source
+ @param strFragmentCode A const std::string& variable which contains the fragment shader source
+ @param strGeometryCode A const std::string& variable which contains the geometry shader source, or ""
+ @return The key
+ */
+unsigned long long CShaderCache::GetKey(const std::string& strVertexCode,
+										const std::string& strFragmentCode,
+										const std::string& strGeometryCode) const
+{
+	const string* pStrings[] = { &strVertexCode, &strFragmentCode, &strGeometryCode, &strDriver };
+	unsigned long long uHash = 14695981039346656037ULL;
+	for (int i = 0; i < 4; i++)
+	{
+		for (size_t j = 0; j < pStrings[i]->size(); j++)
+		{
+			uHash ^= (unsigned char)(*pStrings[i])[j];
+			uHash *= 1099511628211ULL;
+		}
+		// Separate the strings, so that moving text from one shader to the next gives a new key
+		uHash ^= 0xFF;
+		uHash *= 1099511628211ULL;
+	}
+	return uHash;
+}
+
+/**
+ @brief Load the binary of a program into a program object. A binary which the driver rejects is removed,
+		and the caller compiles the program from source instead.
+ @param iProgramID A const GLuint variable which contains the program object
+ @param uKey A const unsigned long long variable which contains the key from GetKey
+ @return true if the program is linked from the binary, else false
+ */
+bool CShaderCache::Load(const GLuint iProgramID, const unsigned long long uKey)
+{
+	if (!bSupported)
+		return false;
+
+	std::map<unsigned long long, Entry>::iterator it = mapEntries.find(uKey);
+	if (it == mapEntries.end())
+	{
+		uNumOfMisses++;
+		return false;
+	}
+
+	chrono::high_resolution_clock::time_point tStart = chrono::high_resolution_clock::now();
+
+	glProgramBinary(iProgramID, it->second.eFormat, &it->second.vBinary[0], (GLsizei)it->second.vBinary.size());
+	GLint iSuccess = 0;
+	glGetProgramiv(iProgramID, GL_LINK_STATUS, &iSuccess);
+	if (!iSuccess)
+	{
+		cout << "CShaderCache::Load(): The driver rejected a program binary, so it will be compiled from source." << endl;
+		mapEntries.erase(it);
+		bDirty = true;
+		uNumOfMisses++;
+		return false;
+	}
+
+	dLoadTime += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - tStart).count();
+	dCachedCompileTime += it->second.dCompileTime;
+	uNumOfHits++;
+	return true;
+}
+
+/**
+ @brief Store the binary of a program which was just compiled and linked.
+		The program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+ @param iProgramID A const GLuint variable which contains the program object
+ @param uKey A const unsigned long long variable which contains the key from GetKey
+ @param dCompileTime A const double variable which contains the time, in milliseconds, to compile and link the program
+ */
+void CShaderCache::Store(const GLuint iProgramID, const unsigned long long uKey, const double dCompileTime)
+{
+	this->dCompileTime += dCompileTime;
+	if (!bSupported)
+		return;
+
+	GLint iSuccess = 0, iLength = 0;
+	glGetProgramiv(iProgramID, GL_LINK_STATUS, &iSuccess);
+	glGetProgramiv(iProgramID, GL_PROGRAM_BINARY_LENGTH, &iLength);
+	if ((!iSuccess) || (iLength <= 0))
+		return;
+
+	Entry sEntry;
+	sEntry.dCompileTime = dCompileTime;
+	sEntry.vBinary.resize(iLength);
+	GLsizei iWritten = 0;
+	glGetProgramBinary(iProgramID, iLength, &iWritten, &sEntry.eFormat, &sEntry.vBinary[0]);
+	if (iWritten <= 0)
+		return;
+	sEntry.vBinary.resize(iWritten);
+
+	mapEntries[uKey] = sEntry;
+	bDirty = true;
+}
+
+/**
+ @brief Write the program binaries to the file, if any were added or removed since it was read
+ @return true if the file is up to date, else false
+ */
+bool CShaderCache::Save(void)
+{
+	if ((!bSupported) || (!bDirty))
+		return true;
+
+	ofstream fileStream(strFilename.c_str(), ios::binary);
+	if (!fileStream.is_open())
+	{
+		cout << "CShaderCache::Save(): Unable to write " << strFilename << endl;
+		return false;
+	}
+
+	unsigned int uDriverLength = (unsigned int)strDriver.size();
+	unsigned int uNumOfEntries = (unsigned int)mapEntries.size();
+	fileStream.write((const char*)&CACHE_MAGIC, sizeof(unsigned int));
+	fileStream.write((const char*)&CACHE_VERSION, sizeof(unsigned int));
+	fileStream.write((const char*)&uDriverLength, sizeof(unsigned int));
+	fileStream.write(strDriver.c_str(), uDriverLength);
+	fileStream.write((const char*)&uNumOfEntries, sizeof(unsigned int));
+	for (std::map<unsigned long long, Entry>::const_iterator it = mapEntries.begin(); it != mapEntries.end(); ++it)
+	{
+		unsigned int uFormat = it->second.eFormat;
+		unsigned int uSize = (unsigned int)it->second.vBinary.size();
+		fileStream.write((const char*)&it->first, sizeof(unsigned long long));
+		fileStream.write((const char*)&uFormat, sizeof(unsigned int));
+		fileStream.write((const char*)&it->second.dCompileTime, sizeof(double));
+		fileStream.write((const char*)&uSize, sizeof(unsigned int));
+		fileStream.write(&it->second.vBinary[0], uSize);
+	}
+	if (!fileStream.good())
+	{
+		cout << "CShaderCache::Save(): Unable to write " << strFilename << endl;
+		return false;
+	}
+
+	bDirty = false;
+	return true;
+}
+
+/**
+ @brief Print the cache statistics to the console, including the time saved by not compiling the cached programs
+ */
+void CShaderCache::PrintStats(void) const
+{
+	cout << "CShaderCache: " << uNumOfHits << " hits, " << uNumOfMisses << " misses, "
+		<< dCompileTime << " ms compiling, " << dLoadTime << " ms loading binaries";
+	if (uNumOfHits > 0)
+		cout << ", " << (dCachedCompileTime - dLoadTime) << " ms saved";
+	cout << endl;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+#include <map>
+
+class CShaderCache : public CSingletonTemplate<CShaderCache>
+{
+	friend CSingletonTemplate<CShaderCache>;
+public:
+	// Init, and read the program binaries which were saved by an earlier run
+	bool Init(const char* filename = "Shader//ProgramCache.bin");
+
+	// Check if the driver can save and load program binaries
+	bool IsSupported(void) const;
+
+	// Get the key of a program, which is a hash of its sources and the driver
+	unsigned long long GetKey(	const std::string& strVertexCode,
+								const std::string& strFragmentCode,
+								const std::string& strGeometryCode) const;
+
+	// Load the binary of a program into a program object
+	bool Load(const GLuint iProgramID, const unsigned long long uKey);
+	// Store the binary of a program which was just compiled and linked
+	void Store(const GLuint iProgramID, const unsigned long long uKey, const double dCompileTime);
+
+	// Write the program binaries to the file, if any were added
+	bool Save(void);
+
+	// Print the cache statistics to the console
+	void PrintStats(void) const;
+
+protected:
+	// The binary of a program
+	struct Entry
+	{
+		GLenum eFormat;
+		// The time, in milliseconds, which it took to compile and link the program from source
+		double dCompileTime;
+		std::vector<char> vBinary;
+	};
+
+	// The file which the binaries are saved in
+	std::string strFilename;
+	// The vendor, renderer and version of the driver. The binaries only work with the driver which made them.
+	std::string strDriver;
+	// The program binaries, keyed by GetKey
+	std::map<unsigned long long, Entry> mapEntries;
+	// Whether the binaries have changed since they were read
+	bool bDirty;
+	// Whether the driver supports program binaries
+	bool bSupported;
+
+	// Statistics
+	unsigned int uNumOfHits;
+	unsigned int uNumOfMisses;
+	// The time, in milliseconds, which was spent compiling programs which were not in the cache
+	double dCompileTime;
+	// The time, in milliseconds, which was spent loading programs from the cache
+	double dLoadTime;
+	// The time, in milliseconds, which those programs took to compile when they were stored
+	double dCachedCompileTime;
+
+	// Constructor
+	CShaderCache(void);
+
+	// Destructor
+	virtual ~CShaderCache(void);
+};
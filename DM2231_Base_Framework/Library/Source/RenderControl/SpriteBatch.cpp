@@ -0,0 +1,295 @@
+#include "SpriteBatch.h"
+
+// Include StreamBuffer
+#include "StreamBuffer.h"
+
+#include <iostream>
+using namespace std;
+
+// The number of floats in each vertex: position (2), texture coordinate (2) and colour (4)
+static const int FLOATS_PER_VERTEX = 8;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteBatch::CSpriteBatch(void)
+	: cSpriteShader(NULL)
+	, cTextureAtlas(NULL)
+	, VAO(0)
+	, uNumOfDrawCalls(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteBatch::~CSpriteBatch(void)
+{
+	// Delete the rendering objects in the graphics card
+	if (VAO != 0)
+	{
+		GL()->DeleteVertexArrays(1, &VAO);
+	}
+
+	// We set these to NULL, since they were created elsewhere so we don't delete them here
+	cSpriteShader = NULL;
+	cTextureAtlas = NULL;
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CSpriteBatch::Init(void)
+{
+	if (VAO != 0)
+		return true;
+
+	// The vertices are written into the streaming vertex buffer each frame
+	GLuint uiStreamVBO = CStreamBuffer::GetInstance()->GetVBO();
+	if (uiStreamVBO == 0)
+	{
+		cout << "CSpriteBatch::Init(): Initialise the CStreamBuffer before initialising this class instance." << endl;
+		return false;
+	}
+
+	GL()->GenVertexArrays(1, &VAO);
+
+	GL()->BindVertexArray(VAO);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, uiStreamVBO);
+
+	// position attribute
+	GL()->VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)0);
+	GL()->EnableVertexAttribArray(0);
+	// texture coord attribute
+	GL()->VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(2 * sizeof(float)));
+	GL()->EnableVertexAttribArray(1);
+	// colour attribute
+	GL()->VertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(4 * sizeof(float)));
+	GL()->EnableVertexAttribArray(2);
+
+	GL()->BindVertexArray(0);
+
+	return true;
+}
+
+/**
+ @brief Set a shader to this class instance
+ @param cSpriteShader A Shader* variable which stores a shader which renders sprites
+ */
+void CSpriteBatch::SetShader(Shader* cSpriteShader)
+{
+	this->cSpriteShader = cSpriteShader;
+}
+
+/**
+ @brief Set the atlas which sprites, solid quads and lines are drawn from
+ @param cTextureAtlas A CTextureAtlas* variable which stores a built atlas
+ */
+void CSpriteBatch::SetAtlas(CTextureAtlas* cTextureAtlas)
+{
+	this->cTextureAtlas = cTextureAtlas;
+}
+
+/**
+ @brief Add a region of the atlas to the batch
+ @param strRegion A const std::string& variable which contains the name of the region in the atlas
+ @param vec2BottomLeft A const glm::vec2& variable which contains the bottom left corner in normalised device coordinates
+ @param vec2TopRight A const glm::vec2& variable which contains the top right corner in normalised device coordinates
+ @param vec4Colour A const glm::vec4& variable which contains the colour to multiply the sprite by
+ */
+void CSpriteBatch::AddSprite(	const std::string& strRegion,
+								const glm::vec2& vec2BottomLeft,
+								const glm::vec2& vec2TopRight,
+								const glm::vec4& vec4Colour)
+{
+	if (cTextureAtlas == NULL)
+		return;
+
+	AddTexturedQuad(cTextureAtlas->GetTextureID(), vec2BottomLeft, vec2TopRight,
+					cTextureAtlas->GetRegion(strRegion), vec4Colour);
+}
+
+/**
+ @brief Add a solid coloured quad to the batch
+ @param vec2BottomLeft A const glm::vec2& variable which contains the bottom left corner in normalised device coordinates
+ @param vec2TopRight A const glm::vec2& variable which contains the top right corner in normalised device coordinates
+ @param vec4Colour A const glm::vec4& variable which contains the colour of the quad
+ */
+void CSpriteBatch::AddQuad(const glm::vec2& vec2BottomLeft, const glm::vec2& vec2TopRight, const glm::vec4& vec4Colour)
+{
+	AddSprite(CTextureAtlas::WHITE, vec2BottomLeft, vec2TopRight, vec4Colour);
+}
+
+/**
+ @brief Add a quad with a texture which is not in the atlas to the batch.
+		Quads which follow each other with the same texture share a draw call.
+ @param uiTextureID A const GLuint variable which contains the texture ID
+ @param vec2BottomLeft A const glm::vec2& variable which contains the bottom left corner in normalised device coordinates
+ @param vec2TopRight A const glm::vec2& variable which contains the top right corner in normalised device coordinates
+ @param vec4TexCoords A const glm::vec4& variable which contains the texture coordinates as (left, bottom, right, top)
+ @param vec4Colour A const glm::vec4& variable which contains the colour to multiply the texture by
+ */
+void CSpriteBatch::AddTexturedQuad(	const GLuint uiTextureID,
+									const glm::vec2& vec2BottomLeft,
+									const glm::vec2& vec2TopRight,
+									const glm::vec4& vec4TexCoords,
+									const glm::vec4& vec4Colour)
+{
+	// Start a new run if the texture has changed
+	if ((vBatches.size() == 0) || (vBatches.back().uiTextureID != uiTextureID))
+	{
+		Batch sBatch;
+		sBatch.uiTextureID = uiTextureID;
+		sBatch.iFirst = (GLsizei)(vTriangleVertices.size() / FLOATS_PER_VERTEX);
+		sBatch.iCount = 0;
+		vBatches.push_back(sBatch);
+	}
+
+	const glm::vec2 vec2TopLeft(vec2BottomLeft.x, vec2TopRight.y);
+	const glm::vec2 vec2BottomRight(vec2TopRight.x, vec2BottomLeft.y);
+	const glm::vec2 vec2TexTopLeft(vec4TexCoords.x, vec4TexCoords.w);
+	const glm::vec2 vec2TexBottomLeft(vec4TexCoords.x, vec4TexCoords.y);
+	const glm::vec2 vec2TexBottomRight(vec4TexCoords.z, vec4TexCoords.y);
+	const glm::vec2 vec2TexTopRight(vec4TexCoords.z, vec4TexCoords.w);
+
+	AddVertex(vTriangleVertices, vec2TopLeft, vec2TexTopLeft, vec4Colour);
+	AddVertex(vTriangleVertices, vec2BottomLeft, vec2TexBottomLeft, vec4Colour);
+	AddVertex(vTriangleVertices, vec2BottomRight, vec2TexBottomRight, vec4Colour);
+
+	AddVertex(vTriangleVertices, vec2BottomRight, vec2TexBottomRight, vec4Colour);
+	AddVertex(vTriangleVertices, vec2TopRight, vec2TexTopRight, vec4Colour);
+	AddVertex(vTriangleVertices, vec2TopLeft, vec2TexTopLeft, vec4Colour);
+
+	vBatches.back().iCount += 6;
+}
+
+/**
+ @brief Add a line to the batch
+ @param vec2Start A const glm::vec2& variable which contains the start of the line in normalised device coordinates
+ @param vec2End A const glm::vec2& variable which contains the end of the line in normalised device coordinates
+ @param vec4Colour A const glm::vec4& variable which contains the colour of the line
+ */
+void CSpriteBatch::AddLine(const glm::vec2& vec2Start, const glm::vec2& vec2End, const glm::vec4& vec4Colour)
+{
+	if (cTextureAtlas == NULL)
+		return;
+
+	// Sample the centre of the white region
+	const glm::vec4 vec4White = cTextureAtlas->GetRegion(CTextureAtlas::WHITE);
+	const glm::vec2 vec2TexCoord((vec4White.x + vec4White.z) * 0.5f, (vec4White.y + vec4White.w) * 0.5f);
+
+	AddVertex(vLineVertices, vec2Start, vec2TexCoord, vec4Colour);
+	AddVertex(vLineVertices, vec2End, vec2TexCoord, vec4Colour);
+}
+
+/**
+ @brief Add the outline of a rectangle to the batch
+ @param vec2BottomLeft A const glm::vec2& variable which contains the bottom left corner in normalised device coordinates
+ @param vec2TopRight A const glm::vec2& variable which contains the top right corner in normalised device coordinates
+ @param vec4Colour A const glm::vec4& variable which contains the colour of the outline
+ */
+void CSpriteBatch::AddRectangle(const glm::vec2& vec2BottomLeft, const glm::vec2& vec2TopRight, const glm::vec4& vec4Colour)
+{
+	const glm::vec2 vec2TopLeft(vec2BottomLeft.x, vec2TopRight.y);
+	const glm::vec2 vec2BottomRight(vec2TopRight.x, vec2BottomLeft.y);
+
+	AddLine(vec2TopLeft, vec2BottomLeft, vec4Colour);
+	AddLine(vec2BottomLeft, vec2BottomRight, vec4Colour);
+	AddLine(vec2BottomRight, vec2TopRight, vec4Colour);
+	AddLine(vec2TopRight, vec2TopLeft, vec4Colour);
+}
+
+/**
+ @brief Draw all the quads and lines in the batch, then empty the batch.
+		The quads are drawn first with one draw call per run of texture, then the lines with one draw call.
+ */
+void CSpriteBatch::Flush(void)
+{
+	uNumOfDrawCalls = 0;
+	if ((vTriangleVertices.size() == 0) && (vLineVertices.size() == 0))
+		return;
+
+	if ((VAO == 0) || (cSpriteShader == NULL) || (cTextureAtlas == NULL))
+	{
+		cout << "CSpriteBatch::Flush(): This class instance is not initialised." << endl;
+		vTriangleVertices.clear();
+		vLineVertices.clear();
+		vBatches.clear();
+		return;
+	}
+
+	cSpriteShader->use();
+	cSpriteShader->setInt("texture1", 0);
+	GL()->ActiveTexture(GL_TEXTURE0);
+
+	// Activate blending mode
+	GL()->Enable(GL_BLEND);
+	GL()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// Copy the triangles and then the lines into this frame's part of the streaming vertex buffer
+	const GLsizei iNumOfTriangleVertices = (GLsizei)(vTriangleVertices.size() / FLOATS_PER_VERTEX);
+	const GLsizei iNumOfLineVertices = (GLsizei)(vLineVertices.size() / FLOATS_PER_VERTEX);
+	vTriangleVertices.insert(vTriangleVertices.end(), vLineVertices.begin(), vLineVertices.end());
+	GLint iFirst = CStreamBuffer::GetInstance()->Allocate(	&vTriangleVertices[0],
+															vTriangleVertices.size() * sizeof(float),
+															FLOATS_PER_VERTEX * sizeof(float));
+
+	if (iFirst >= 0)
+	{
+		GL()->BindVertexArray(VAO);
+
+		for (unsigned int i = 0; i < vBatches.size(); i++)
+		{
+			GL()->BindTexture(GL_TEXTURE_2D, vBatches[i].uiTextureID);
+			GL()->DrawArrays(GL_TRIANGLES, iFirst + vBatches[i].iFirst, vBatches[i].iCount);
+			uNumOfDrawCalls++;
+		}
+
+		if (iNumOfLineVertices > 0)
+		{
+			GL()->BindTexture(GL_TEXTURE_2D, cTextureAtlas->GetTextureID());
+			GL()->DrawArrays(GL_LINES, iFirst + iNumOfTriangleVertices, iNumOfLineVertices);
+			uNumOfDrawCalls++;
+		}
+	}
+
+	// Reset to default
+	GL()->BindVertexArray(0);
+	GL()->BindTexture(GL_TEXTURE_2D, 0);
+
+	// Disable blending
+	GL()->Disable(GL_BLEND);
+
+	vTriangleVertices.clear();
+	vLineVertices.clear();
+	vBatches.clear();
+}
+
+/**
+ @brief Get the number of draw calls which were issued by the last Flush
+ */
+unsigned int CSpriteBatch::GetNumOfDrawCalls(void) const
+{
+	return uNumOfDrawCalls;
+}
+
+/**
+ @brief Add a vertex to a list of vertices
+ @param vVertices A std::vector<float>& variable which contains the list of vertices
+ @param vec2Position A const glm::vec2& variable which contains the position
+ @param vec2TexCoord A const glm::vec2& variable which contains the texture coordinate
+ @param vec4Colour A const glm::vec4& variable which contains the colour
+ */
+void CSpriteBatch::AddVertex(	std::vector<float>& vVertices,
+								const glm::vec2& vec2Position,
+								const glm::vec2& vec2TexCoord,
+								const glm::vec4& vec4Colour)
+{
+	const float afVertex[FLOATS_PER_VERTEX] = {
+		vec2Position.x, vec2Position.y,
+		vec2TexCoord.x, vec2TexCoord.y,
+		vec4Colour.x, vec4Colour.y, vec4Colour.z, vec4Colour.w
+	};
+	vVertices.insert(vVertices.end(), afVertex, afVertex + FLOATS_PER_VERTEX);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include shader
+#include "shader.h"
+
+// Include TextureAtlas
+#include "TextureAtlas.h"
+
+#include <string>
+#include <vector>
+
+class CSpriteBatch : public CSingletonTemplate<CSpriteBatch>
+{
+	friend CSingletonTemplate<CSpriteBatch>;
+public:
+	// Init
+	bool Init(void);
+
+	// Set a shader to this class instance
+	void SetShader(Shader* cSpriteShader);
+	// Set the atlas which sprites, solid quads and lines are drawn from
+	void SetAtlas(CTextureAtlas* cTextureAtlas);
+
+	// Add a region of the atlas to the batch
+	void AddSprite(	const std::string& strRegion,
+					const glm::vec2& vec2BottomLeft,
+					const glm::vec2& vec2TopRight,
+					const glm::vec4& vec4Colour = glm::vec4(1.0f));
+	// Add a solid coloured quad to the batch
+	void AddQuad(const glm::vec2& vec2BottomLeft, const glm::vec2& vec2TopRight, const glm::vec4& vec4Colour);
+	// Add a quad with a texture which is not in the atlas to the batch
+	void AddTexturedQuad(	const GLuint uiTextureID,
+							const glm::vec2& vec2BottomLeft,
+							const glm::vec2& vec2TopRight,
+							const glm::vec4& vec4TexCoords = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+							const glm::vec4& vec4Colour = glm::vec4(1.0f));
+	// Add a line to the batch
+	void AddLine(const glm::vec2& vec2Start, const glm::vec2& vec2End, const glm::vec4& vec4Colour);
+	// Add the outline of a rectangle to the batch
+	void AddRectangle(const glm::vec2& vec2BottomLeft, const glm::vec2& vec2TopRight, const glm::vec4& vec4Colour);
+
+	// Draw all the quads and lines in the batch, then empty the batch
+	void Flush(void);
+
+	// Get the number of draw calls which were issued by the last Flush
+	unsigned int GetNumOfDrawCalls(void) const;
+
+protected:
+	// A run of triangles which use the same texture
+	struct Batch
+	{
+		GLuint uiTextureID;
+		GLsizei iFirst;
+		GLsizei iCount;
+	};
+
+	// Handler to the sprite shader
+	Shader* cSpriteShader;
+	// Handler to the atlas
+	CTextureAtlas* cTextureAtlas;
+
+	// The VAO, which reads from the streaming vertex buffer
+	GLuint VAO;
+
+	// The triangle vertices in the batch, each with a position, a texture coordinate and a colour
+	std::vector<float> vTriangleVertices;
+	// The runs of triangles, in the order they were added
+	std::vector<Batch> vBatches;
+	// The line vertices in the batch, which are all drawn from the white region of the atlas
+	std::vector<float> vLineVertices;
+
+	// The number of draw calls which were issued by the last Flush
+	unsigned int uNumOfDrawCalls;
+
+	// Constructor
+	CSpriteBatch(void);
+
+	// Destructor
+	virtual ~CSpriteBatch(void);
+
+	// Add a vertex to a list of vertices
+	void AddVertex(	std::vector<float>& vVertices,
+					const glm::vec2& vec2Position,
+					const glm::vec2& vec2TexCoord,
+					const glm::vec4& vec4Colour);
+};
@@ -0,0 +1,234 @@
+#include "StreamBuffer.h"
+
+// Include GLDispatch
+#include "GLDispatch.h"
+
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CStreamBuffer::CStreamBuffer(void)
+	: VBO(0)
+	, uSegmentSize(0)
+	, iSegment(0)
+	, uHead(0)
+	, uBytesAllocated(0)
+	, uNumOfStalls(0)
+	, uNumOfOrphans(0)
+{
+	for (int i = 0; i < NUM_SEGMENTS; i++)
+		asyncFences[i] = NULL;
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CStreamBuffer::~CStreamBuffer(void)
+{
+	for (int i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if (asyncFences[i] != NULL)
+		{
+			GL()->DeleteSync(asyncFences[i]);
+			asyncFences[i] = NULL;
+		}
+	}
+
+	// Delete the rendering objects in the graphics card
+	if (VBO != 0)
+	{
+		GL()->DeleteBuffers(1, &VBO);
+		VBO = 0;
+	}
+}
+
+/**
+ @brief Init Initialise this instance
+ @param uSegmentSize A const size_t variable which contains the number of bytes which one frame can allocate
+ @return true if the initialisation is successful, else false
+ */
+bool CStreamBuffer::Init(const size_t uSegmentSize)
+{
+	if (VBO != 0)
+		return true;
+
+	this->uSegmentSize = uSegmentSize;
+	iSegment = 0;
+	uHead = 0;
+
+	GL()->GenBuffers(1, &VBO);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, uSegmentSize * NUM_SEGMENTS, NULL, GL_STREAM_DRAW);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (VBO == 0)
+	{
+		cout << "CStreamBuffer::Init(): Unable to create the vertex buffer." << endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ @brief Get the vertex buffer which the allocations are made from. Users point their VAOs at this
+		buffer with an offset of 0, and draw from the first vertex returned by Allocate.
+ */
+GLuint CStreamBuffer::GetVBO(void) const
+{
+	return VBO;
+}
+
+/**
+ @brief Start a frame. The segment which is about to be reused was written NUM_SEGMENTS frames ago,
+		so normally its fence has signalled already. If it has not, wait for the GPU here rather
+		than inside a buffer update in the middle of the frame.
+ */
+void CStreamBuffer::BeginFrame(void)
+{
+	iSegment = (iSegment + 1) % NUM_SEGMENTS;
+	uHead = 0;
+	uBytesAllocated = 0;
+
+	GLsync sFence = asyncFences[iSegment];
+	if (sFence == NULL)
+		return;
+
+	GLenum eResult = GL()->ClientWaitSync(sFence, 0, 0);
+	if ((eResult == GL_TIMEOUT_EXPIRED) || (eResult == GL_WAIT_FAILED))
+	{
+		uNumOfStalls++;
+		// Flush so that the fence is sure to be reached, then wait for up to a second
+		eResult = GL()->ClientWaitSync(sFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		if ((eResult == GL_TIMEOUT_EXPIRED) || (eResult == GL_WAIT_FAILED))
+		{
+			// The GPU is very far behind, so do not risk overwriting what it is reading
+			Orphan();
+			return;
+		}
+	}
+
+	GL()->DeleteSync(sFence);
+	asyncFences[iSegment] = NULL;
+}
+
+/**
+ @brief End a frame. Places a fence after the draws which read from this frame's segment.
+ */
+void CStreamBuffer::EndFrame(void)
+{
+	if (asyncFences[iSegment] != NULL)
+		GL()->DeleteSync(asyncFences[iSegment]);
+	asyncFences[iSegment] = GL()->FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ @brief Copy vertices into the buffer, and get the index of the first vertex to draw.
+		The offset is rounded up to a whole vertex, so that a VAO which points at the start of the
+		buffer can draw from the returned index. The data stays valid until the end of the frame.
+ @param pData A const void* variable which contains the vertices
+ @param uSize A const size_t variable which contains the number of bytes to copy
+ @param uStride A const size_t variable which contains the number of bytes in one vertex
+ @return The index of the first vertex, or -1 if the vertices could not be allocated
+ */
+GLint CStreamBuffer::Allocate(const void* pData, const size_t uSize, const size_t uStride)
+{
+	if ((VBO == 0) || (uStride == 0))
+		return -1;
+	if (uSize > uSegmentSize - uStride)
+	{
+		cout << "CStreamBuffer::Allocate(): " << uSize << " bytes is larger than a segment ("
+			<< uSegmentSize << " bytes)." << endl;
+		return -1;
+	}
+
+	// Find the first whole vertex after the head
+	size_t uSegmentStart = uSegmentSize * iSegment;
+	size_t uOffset = uSegmentStart + uHead;
+	uOffset = ((uOffset + uStride - 1) / uStride) * uStride;
+
+	// If this frame has used up its segment, the GPU may still be reading the next one,
+	// so take new storage from the driver instead of waiting for it
+	if (uOffset + uSize > uSegmentStart + uSegmentSize)
+	{
+		Orphan();
+		uSegmentStart = uSegmentSize * iSegment;
+		uOffset = ((uSegmentStart + uStride - 1) / uStride) * uStride;
+	}
+
+	// The fences make sure that the GPU is not reading this range, so the driver does not need to check
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	void* pDestination = GL()->MapBufferRange(GL_ARRAY_BUFFER, uOffset, uSize,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (pDestination == NULL)
+	{
+		cout << "CStreamBuffer::Allocate(): Unable to map the vertex buffer." << endl;
+		return -1;
+	}
+	memcpy(pDestination, pData, uSize);
+	GL()->UnmapBuffer(GL_ARRAY_BUFFER);
+
+	uHead = uOffset + uSize - uSegmentStart;
+	uBytesAllocated += uSize;
+
+	return (GLint)(uOffset / uStride);
+}
+
+/**
+ @brief Get the number of bytes which were allocated in this frame
+ */
+size_t CStreamBuffer::GetBytesAllocated(void) const
+{
+	return uBytesAllocated;
+}
+
+/**
+ @brief Get the number of times BeginFrame had to wait for the GPU
+ */
+unsigned int CStreamBuffer::GetNumOfStalls(void) const
+{
+	return uNumOfStalls;
+}
+
+/**
+ @brief Get the number of times the buffer was orphaned because a frame did not fit in its segment
+ */
+unsigned int CStreamBuffer::GetNumOfOrphans(void) const
+{
+	return uNumOfOrphans;
+}
+
+/**
+ @brief Print the allocator statistics to the console
+ */
+void CStreamBuffer::PrintStats(void) const
+{
+	cout << "CStreamBuffer: " << NUM_SEGMENTS << " x " << uSegmentSize / 1024 << " KB, "
+		<< uBytesAllocated << " bytes this frame, "
+		<< uNumOfStalls << " stalls, " << uNumOfOrphans << " orphans" << endl;
+}
+
+/**
+ @brief Give the buffer's storage back to the driver and start again with an empty buffer.
+		The driver keeps the old storage until the GPU has finished with it, so all the fences can go.
+ */
+void CStreamBuffer::Orphan(void)
+{
+	GL()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, uSegmentSize * NUM_SEGMENTS, NULL, GL_STREAM_DRAW);
+
+	for (int i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if (asyncFences[i] != NULL)
+		{
+			GL()->DeleteSync(asyncFences[i]);
+			asyncFences[i] = NULL;
+		}
+	}
+
+	uHead = 0;
+	uNumOfOrphans++;
+}
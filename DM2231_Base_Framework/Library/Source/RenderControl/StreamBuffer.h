@@ -0,0 +1,67 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+#include <cstddef>
+
+class CStreamBuffer : public CSingletonTemplate<CStreamBuffer>
+{
+	friend CSingletonTemplate<CStreamBuffer>;
+public:
+	// Init
+	bool Init(const size_t uSegmentSize = 1024 * 1024);
+
+	// Get the vertex buffer which the allocations are made from
+	GLuint GetVBO(void) const;
+
+	// Start a frame. Waits for the GPU if it is still reading the segment which is about to be reused.
+	void BeginFrame(void);
+	// End a frame. Places a fence after the draws which read from this frame's segment.
+	void EndFrame(void);
+
+	// Copy vertices into the buffer, and get the index of the first vertex to draw
+	GLint Allocate(const void* pData, const size_t uSize, const size_t uStride);
+
+	// Get the number of bytes which were allocated in this frame
+	size_t GetBytesAllocated(void) const;
+	// Get the number of times BeginFrame had to wait for the GPU
+	unsigned int GetNumOfStalls(void) const;
+	// Get the number of times the buffer was orphaned because a frame did not fit in its segment
+	unsigned int GetNumOfOrphans(void) const;
+
+	// Print the allocator statistics to the console
+	void PrintStats(void) const;
+
+protected:
+	// The number of segments, which is the number of frames the GPU may be behind the CPU
+	static const int NUM_SEGMENTS = 3;
+
+	// The vertex buffer
+	GLuint VBO;
+	// The size of each segment in bytes
+	size_t uSegmentSize;
+	// The segment which the current frame writes into
+	int iSegment;
+	// The next free byte in the current segment
+	size_t uHead;
+	// A fence for each segment, placed when the frame which wrote into it has been submitted
+	GLsync asyncFences[NUM_SEGMENTS];
+
+	// Statistics
+	size_t uBytesAllocated;
+	unsigned int uNumOfStalls;
+	unsigned int uNumOfOrphans;
+
+	// Constructor
+	CStreamBuffer(void);
+
+	// Destructor
+	virtual ~CStreamBuffer(void);
+
+	// Give the buffer's storage back to the driver and start again with an empty buffer
+	void Orphan(void);
+};
@@ -13,6 +13,9 @@ using namespace std;
 
 #include "../System/filesystem.h"
 
+// Include StreamBuffer
+#include "StreamBuffer.h"
+
 // FreeType
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -22,6 +25,7 @@ using namespace std;
  */
 CTextRenderer::CTextRenderer(void)
 	: cShader(NULL)
+	, VAO(0)
 	, cSettings(NULL)
 {
 }
@@ -37,8 +41,6 @@ CTextRenderer::~CTextRenderer(void)
 	// optional: de-allocate all resources once they've outlived their purpose:
 	// ------------------------------------------------------------------------
 	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
 }
 
 /**
@@ -100,7 +102,7 @@ bool CTextRenderer::Init(void)
 		// Generate texture
 		GLuint texture;
 		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		GL()->BindTexture(GL_TEXTURE_2D, texture);
 		glTexImage2D(
 			GL_TEXTURE_2D,
 			0,
@@ -126,22 +128,26 @@ bool CTextRenderer::Init(void)
 		};
 		Characters.insert(std::pair<GLchar, Character>(c, character));
 	}
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GL()->BindTexture(GL_TEXTURE_2D, 0);
 	// Destroy FreeType once we're finished
 	FT_Done_Face(face);
 	FT_Done_FreeType(ft);
 
 
-	// Configure VAO/VBO for texture quads
+	// Configure VAO for texture quads. The quads are written into the streaming vertex buffer each frame.
+	GLuint uiStreamVBO = CStreamBuffer::GetInstance()->GetVBO();
+	if (uiStreamVBO == 0)
+	{
+		cout << "CTextRenderer::Init: Initialise the CStreamBuffer before initialising this class instance." << endl;
+		return false;
+	}
 	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+	GL()->BindVertexArray(VAO);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, uiStreamVBO);
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GL()->BindBuffer(GL_ARRAY_BUFFER, 0);
+	GL()->BindVertexArray(0);
 
 	return true;
 }
@@ -159,11 +165,11 @@ void CTextRenderer::Update(void)
 void CTextRenderer::PreRender(void)
 {
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	GL()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GL()->Enable(GL_BLEND);
+	GL()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
 	cShader->use();
@@ -176,11 +182,11 @@ void CTextRenderer::Render(std::string text, GLfloat x, GLfloat y, GLfloat scale
 {
 	// Activate corresponding render state	
 	cShader->use();
-	glUniform3f(glGetUniformLocation(cShader->ID, "textColour"), colour.x, colour.y, colour.z);
-	glActiveTexture(GL_TEXTURE0);
-	glBindVertexArray(VAO);
+	GL()->Uniform3f(GL()->GetUniformLocation(cShader->ID, "textColour"), colour.x, colour.y, colour.z);
+	GL()->ActiveTexture(GL_TEXTURE0);
 
-	// Iterate through all characters
+	// Work out the quads of all the characters first, so that they are copied into the buffer at once
+	vVertices.clear();
 	std::string::const_iterator c;
 	for (c = text.begin(); c != text.end(); c++)
 	{
@@ -191,7 +197,7 @@ void CTextRenderer::Render(std::string text, GLfloat x, GLfloat y, GLfloat scale
 
 		GLfloat w = ch.Size.x * scale;
 		GLfloat h = ch.Size.y * scale;
-		// Update VBO for each character
+		// The quad for this character
 		GLfloat vertices[6][4] = {
 			{ xpos, ypos + h, 0.0, 0.0 },
 			{ xpos, ypos, 0.0, 1.0 },
@@ -201,20 +207,30 @@ void CTextRenderer::Render(std::string text, GLfloat x, GLfloat y, GLfloat scale
 			{ xpos + w, ypos, 1.0, 1.0 },
 			{ xpos + w, ypos + h, 1.0, 0.0 }
 		};
-		// Render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-		// Update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // Be sure to use glBufferSubData and not glBufferData
-
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		// Render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
+		vVertices.insert(vVertices.end(), &vertices[0][0], &vertices[0][0] + 6 * 4);
+
 		// Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
 		x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
 	}
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	if (vVertices.size() == 0)
+		return;
+
+	// Copy the quads into this frame's part of the streaming vertex buffer
+	GLint iFirst = CStreamBuffer::GetInstance()->Allocate(&vVertices[0], vVertices.size() * sizeof(GLfloat), 4 * sizeof(GLfloat));
+	if (iFirst < 0)
+		return;
+
+	// Render each glyph texture over its quad
+	GL()->BindVertexArray(VAO);
+	GLint iVertex = iFirst;
+	for (c = text.begin(); c != text.end(); c++)
+	{
+		GL()->BindTexture(GL_TEXTURE_2D, Characters[*c].TextureID);
+		GL()->DrawArrays(GL_TRIANGLES, iVertex, 6);
+		iVertex += 6;
+	}
+	GL()->BindVertexArray(0);
+	GL()->BindTexture(GL_TEXTURE_2D, 0);
 }
 
 /**
@@ -223,5 +239,5 @@ void CTextRenderer::Render(std::string text, GLfloat x, GLfloat y, GLfloat scale
 void CTextRenderer::PostRender(void)
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	GL()->Disable(GL_BLEND);
 }
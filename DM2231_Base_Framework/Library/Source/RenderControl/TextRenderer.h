@@ -16,6 +16,7 @@
 #include "../GameControl/Settings.h"
 
 #include <map>
+#include <vector>
 
 class CTextRenderer : public CSingletonTemplate<CTextRenderer>
 {
@@ -51,7 +52,8 @@ public:
 protected:
 	// Handler to the Shader Program instance
 	Shader* cShader;
-	unsigned int VBO, VAO, EBO;
+	// The VAO, which reads from the streaming vertex buffer
+	unsigned int VAO;
 
 	// Settings
 	CSettings* cSettings;
@@ -59,6 +61,9 @@ protected:
 	// Map of characters
 	std::map<GLchar, Character> Characters;
 
+	// The vertices of the text which is being rendered, kept to avoid allocating every frame
+	std::vector<GLfloat> vVertices;
+
 	// Constructor
 	CTextRenderer(void);
 
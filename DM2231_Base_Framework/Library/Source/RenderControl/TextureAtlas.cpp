@@ -0,0 +1,301 @@
+#include "TextureAtlas.h"
+
+// Include ImageLoader
+#include "../System/ImageLoader.h"
+// Include GLDispatch
+#include "GLDispatch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+using namespace std;
+
+const char* const CTextureAtlas::WHITE = "white";
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CTextureAtlas::CTextureAtlas(void)
+	: iTextureID(0)
+	, iWidth(0)
+	, iHeight(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CTextureAtlas::~CTextureAtlas(void)
+{
+	// Delete the atlas texture in the graphics card
+	if (iTextureID != 0)
+	{
+		glDeleteTextures(1, &iTextureID);
+		iTextureID = 0;
+	}
+	vImages.clear();
+	mapRegions.clear();
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CTextureAtlas::Init(void)
+{
+	vImages.clear();
+
+	// A small white image, so that solid quads and lines can be drawn from the atlas as well
+	Image sWhite;
+	sWhite.strName = WHITE;
+	sWhite.iWidth = 4;
+	sWhite.iHeight = 4;
+	sWhite.vTexels.assign(4 * 4 * 4, 255);
+	vImages.push_back(sWhite);
+
+	return true;
+}
+
+/**
+ @brief Add an image to the atlas. The images are packed when Build is called.
+ @param strName A const std::string& variable which contains the name of the region
+ @param filename A const char* variable which contains the file name of the image
+ @return true if the image is loaded, else false
+ */
+bool CTextureAtlas::AddImage(const std::string& strName, const char* filename)
+{
+	if (iTextureID != 0)
+	{
+		cout << "CTextureAtlas::AddImage(): The atlas is already built, so " << filename << " cannot be added." << endl;
+		return false;
+	}
+
+	int width, height, nrChannels;
+	unsigned char *data = CImageLoader::GetInstance()->Load(filename, width, height, nrChannels, true);
+	if (!data)
+	{
+		cout << "CTextureAtlas::AddImage(): Unable to load " << filename << endl;
+		return false;
+	}
+	if ((nrChannels != 3) && (nrChannels != 4))
+	{
+		cout << "CTextureAtlas::AddImage(): Unsupported number of channels (" << nrChannels << ") in " << filename << endl;
+		free(data);
+		return false;
+	}
+
+	// Store the image as RGBA, so that all the images can be copied into one texture
+	Image sImage;
+	sImage.strName = strName;
+	sImage.iWidth = width;
+	sImage.iHeight = height;
+	sImage.vTexels.resize((size_t)width * (size_t)height * 4);
+	for (size_t i = 0; i < (size_t)width * (size_t)height; i++)
+	{
+		sImage.vTexels[i * 4 + 0] = data[i * nrChannels + 0];
+		sImage.vTexels[i * 4 + 1] = data[i * nrChannels + 1];
+		sImage.vTexels[i * 4 + 2] = data[i * nrChannels + 2];
+		sImage.vTexels[i * 4 + 3] = (nrChannels == 4) ? data[i * nrChannels + 3] : 255;
+	}
+	vImages.push_back(sImage);
+
+	// Free up the memory of the file data read in
+	free(data);
+
+	return true;
+}
+
+/**
+ @brief Add every image in a folder to the atlas, so that a new image only needs to be put in the folder.
+		Each region is named after its file name without the extension, e.g. "CrossHair_Pistol" for CrossHair_Pistol.tga.
+		The images are added in the order of their file names, so that the atlas is packed the same way every time.
+ @param folder A const char* variable which contains the path of the folder
+ @return true if the folder has images and they are all loaded, else false
+ */
+bool CTextureAtlas::AddFolder(const char* folder)
+{
+	std::error_code ec;
+	std::vector<std::filesystem::path> vFiles;
+	for (std::filesystem::directory_iterator it(folder, ec), end; (!ec) && (it != end); it.increment(ec))
+	{
+		std::string strExtension = it->path().extension().string();
+		transform(strExtension.begin(), strExtension.end(), strExtension.begin(), ::tolower);
+		if ((strExtension == ".tga") || (strExtension == ".png") || (strExtension == ".jpg") || (strExtension == ".bmp"))
+			vFiles.push_back(it->path());
+	}
+	if (ec)
+	{
+		cout << "CTextureAtlas::AddFolder(): Unable to read " << folder << " (" << ec.message() << ")" << endl;
+		return false;
+	}
+	if (vFiles.empty())
+	{
+		cout << "CTextureAtlas::AddFolder(): There are no images in " << folder << endl;
+		return false;
+	}
+
+	sort(vFiles.begin(), vFiles.end());
+	for (unsigned int i = 0; i < vFiles.size(); i++)
+	{
+		if (AddImage(vFiles[i].stem().string(), vFiles[i].string().c_str()) == false)
+			return false;
+	}
+	return true;
+}
+
+/**
+ @brief Pack the added images into one texture. The images are placed on shelves, tallest first,
+		and the atlas is made just tall enough to hold all the shelves.
+ @param iMaxWidth A const int variable which contains the width of the atlas
+ @return true if the atlas is built, else false
+ */
+bool CTextureAtlas::Build(const int iMaxWidth)
+{
+	if (iTextureID != 0)
+	{
+		cout << "CTextureAtlas::Build(): The atlas is already built." << endl;
+		return false;
+	}
+
+	GLint iMaxTextureSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &iMaxTextureSize);
+
+	// Sort the images by height, so that each shelf wastes little space
+	vector<int> vOrder(vImages.size());
+	for (unsigned int i = 0; i < vImages.size(); i++)
+		vOrder[i] = i;
+	sort(vOrder.begin(), vOrder.end(), [this](const int a, const int b) {
+		return vImages[a].iHeight > vImages[b].iHeight;
+	});
+
+	// Work out where each image goes
+	vector<glm::ivec2> vPositions(vImages.size());
+	int iShelfX = 0, iShelfY = 0, iShelfHeight = 0;
+	iWidth = 0;
+	for (unsigned int i = 0; i < vOrder.size(); i++)
+	{
+		const Image& sImage = vImages[vOrder[i]];
+		int iCellWidth = sImage.iWidth + PADDING * 2;
+		int iCellHeight = sImage.iHeight + PADDING * 2;
+		if (iCellWidth > iMaxWidth)
+		{
+			cout << "CTextureAtlas::Build(): " << sImage.strName << " is wider than the atlas." << endl;
+			return false;
+		}
+
+		// Start a new shelf if this image does not fit on the current one
+		if (iShelfX + iCellWidth > iMaxWidth)
+		{
+			iShelfY += iShelfHeight;
+			iShelfX = 0;
+			iShelfHeight = 0;
+		}
+
+		vPositions[vOrder[i]] = glm::ivec2(iShelfX + PADDING, iShelfY + PADDING);
+		iShelfX += iCellWidth;
+		if (iCellHeight > iShelfHeight)
+			iShelfHeight = iCellHeight;
+		if (iShelfX > iWidth)
+			iWidth = iShelfX;
+	}
+	iHeight = iShelfY + iShelfHeight;
+
+	if ((iWidth > iMaxTextureSize) || (iHeight > iMaxTextureSize))
+	{
+		cout << "CTextureAtlas::Build(): The atlas (" << iWidth << "x" << iHeight
+			<< ") is larger than the maximum texture size (" << iMaxTextureSize << ")." << endl;
+		return false;
+	}
+
+	// Copy the images into the atlas, and store their texture coordinates.
+	// The coordinates are inset by half a texel so that linear filtering stays inside the region.
+	vector<unsigned char> vTexels((size_t)iWidth * (size_t)iHeight * 4, 0);
+	for (unsigned int i = 0; i < vImages.size(); i++)
+	{
+		const Image& sImage = vImages[i];
+		const glm::ivec2& vec2Position = vPositions[i];
+		for (int y = 0; y < sImage.iHeight; y++)
+		{
+			copy(	sImage.vTexels.begin() + (size_t)y * sImage.iWidth * 4,
+					sImage.vTexels.begin() + (size_t)(y + 1) * sImage.iWidth * 4,
+					vTexels.begin() + ((size_t)(vec2Position.y + y) * iWidth + vec2Position.x) * 4);
+		}
+
+		mapRegions[sImage.strName] = glm::vec4(	(vec2Position.x + 0.5f) / iWidth,
+												(vec2Position.y + 0.5f) / iHeight,
+												(vec2Position.x + sImage.iWidth - 0.5f) / iWidth,
+												(vec2Position.y + sImage.iHeight - 0.5f) / iHeight);
+	}
+
+	glGenTextures(1, &iTextureID);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	// set texture filtering parameters. There are no mipmaps, since they would mix the regions together.
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, iWidth, iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, &vTexels[0]);
+	GL()->BindTexture(GL_TEXTURE_2D, 0);
+
+	// The texels are in the graphics card now
+	vImages.clear();
+
+	return true;
+}
+
+/**
+ @brief Check if the atlas has a region with this name
+ @param strName A const std::string& variable which contains the name of the region
+ @return true if the region exists, else false
+ */
+bool CTextureAtlas::HasRegion(const std::string& strName) const
+{
+	return (mapRegions.find(strName) != mapRegions.end());
+}
+
+/**
+ @brief Get the texture coordinates of a region
+ @param strName A const std::string& variable which contains the name of the region
+ @return The texture coordinates as (left, bottom, right, top), or the white region if the name is not found
+ */
+glm::vec4 CTextureAtlas::GetRegion(const std::string& strName) const
+{
+	std::map<std::string, glm::vec4>::const_iterator it = mapRegions.find(strName);
+	if (it == mapRegions.end())
+		it = mapRegions.find(WHITE);
+	if (it == mapRegions.end())
+		return glm::vec4(0.0f);
+	return it->second;
+}
+
+/**
+ @brief Get the texture ID of the atlas
+ */
+GLuint CTextureAtlas::GetTextureID(void) const
+{
+	return iTextureID;
+}
+
+/**
+ @brief Get the number of bytes of texture memory used by the atlas
+ */
+size_t CTextureAtlas::GetBytesResident(void) const
+{
+	return (iTextureID != 0) ? (size_t)iWidth * (size_t)iHeight * 4 : 0;
+}
+
+/**
+ @brief Print the atlas layout to the console
+ */
+void CTextureAtlas::PrintStats(void) const
+{
+	cout << "CTextureAtlas: " << iWidth << "x" << iHeight << ", " << mapRegions.size() << " regions, "
+		<< GetBytesResident() / 1024 << " KB" << endl;
+	for (std::map<std::string, glm::vec4>::const_iterator it = mapRegions.begin(); it != mapRegions.end(); ++it)
+	{
+		cout << "\t" << it->first << ": (" << it->second.x << ", " << it->second.y << ") - ("
+			<< it->second.z << ", " << it->second.w << ")" << endl;
+	}
+}
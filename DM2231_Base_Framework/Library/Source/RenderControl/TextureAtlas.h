@@ -0,0 +1,74 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+
+class CTextureAtlas : public CSingletonTemplate<CTextureAtlas>
+{
+	friend CSingletonTemplate<CTextureAtlas>;
+public:
+	// The name of the white region, which is used to draw solid colours and lines
+	static const char* const WHITE;
+
+	// Init
+	bool Init(void);
+
+	// Add an image to the atlas. The images are packed when Build is called.
+	bool AddImage(const std::string& strName, const char* filename);
+	// Add every image in a folder to the atlas, named after its file name without the extension
+	bool AddFolder(const char* folder);
+	// Pack the added images into one texture
+	bool Build(const int iMaxWidth = 2048);
+
+	// Check if the atlas has a region with this name
+	bool HasRegion(const std::string& strName) const;
+	// Get the texture coordinates of a region as (left, bottom, right, top)
+	glm::vec4 GetRegion(const std::string& strName) const;
+
+	// Get the texture ID of the atlas
+	GLuint GetTextureID(void) const;
+	// Get the number of bytes of texture memory used by the atlas
+	size_t GetBytesResident(void) const;
+
+	// Print the atlas layout to the console
+	void PrintStats(void) const;
+
+protected:
+	// The number of empty texels around each region, so that linear filtering does not bleed
+	static const int PADDING = 1;
+
+	// An image which is waiting to be packed
+	struct Image
+	{
+		std::string strName;
+		int iWidth;
+		int iHeight;
+		// The RGBA texels, bottom row first
+		std::vector<unsigned char> vTexels;
+	};
+
+	// The images which are waiting to be packed
+	std::vector<Image> vImages;
+	// Map of region names to texture coordinates
+	std::map<std::string, glm::vec4> mapRegions;
+
+	// The atlas texture
+	GLuint iTextureID;
+	int iWidth, iHeight;
+
+	// Constructor
+	CTextureAtlas(void);
+
+	// Destructor
+	virtual ~CTextureAtlas(void);
+};
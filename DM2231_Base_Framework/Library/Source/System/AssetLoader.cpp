@@ -0,0 +1,426 @@
+#include "AssetLoader.h"
+
+// Include ImageLoader
+#include "ImageLoader.h"
+// Include filesystem
+#include "filesystem.h"
+// Include Profiler
+#include "Profiler.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+using namespace std;
+
+// The width of the bars in the printed timeline
+static const int TIMELINE_WIDTH = 50;
+// Two spans of work are taken to follow each other if the gap between them is shorter than this, in milliseconds
+static const double TIMELINE_GAP = 1.0;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CAssetLoader::CAssetLoader(void)
+	: bStopping(false)
+	, uNumOfPending(0)
+	, uNumOfFailures(0)
+	, iCurrentPhase(-1)
+{
+	startTime = std::chrono::high_resolution_clock::now();
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CAssetLoader::~CAssetLoader(void)
+{
+	StopThreads();
+
+	for (unsigned int i = 0; i < vAssets.size(); i++)
+	{
+		delete vAssets[i]->pTexture;
+		delete vAssets[i]->pMesh;
+		delete vAssets[i];
+	}
+	vAssets.clear();
+}
+
+/**
+ @brief Init Initialise this instance, and start the worker threads
+ @param uNumOfThreads A const unsigned int variable which contains the number of worker threads.
+		If it is 0, one thread is started for each core, less the core of the main thread.
+ @return true if the initialisation is successful, else false
+ */
+bool CAssetLoader::Init(const unsigned int uNumOfThreads)
+{
+	StopThreads();
+
+	// The singletons and static paths which the worker threads use are created here,
+	// since creating them is not safe on more than one thread at a time
+	CImageLoader::GetInstance();
+	FileSystem::getPath("");
+
+	unsigned int uThreads = uNumOfThreads;
+	if (uThreads == 0)
+	{
+		uThreads = std::thread::hardware_concurrency();
+		uThreads = (uThreads > 1) ? uThreads - 1 : 1;
+	}
+
+	startTime = std::chrono::high_resolution_clock::now();
+	vEvents.clear();
+	iCurrentPhase = -1;
+	uNumOfFailures = 0;
+
+	bStopping = false;
+	for (unsigned int i = 0; i < uThreads; i++)
+		vThreads.push_back(std::thread(&CAssetLoader::WorkerThread, this, i + 1));
+
+	return true;
+}
+
+/**
+ @brief Queue a texture to be decoded on a worker thread
+ @param filename A const char* variable which contains the file name of the texture
+ */
+void CAssetLoader::RequestTexture(const char* filename)
+{
+	Request(ASSET_TEXTURE, filename);
+}
+
+/**
+ @brief Queue a mesh to be decoded on a worker thread
+ @param filename A const char* variable which contains the file name of the OBJ file
+ */
+void CAssetLoader::RequestMesh(const char* filename)
+{
+	Request(ASSET_MESH, filename);
+}
+
+/**
+ @brief Upload the assets which have been decoded so far, without waiting for the rest.
+		This is called on the main thread, between other work.
+ @return The number of assets which were uploaded
+ */
+unsigned int CAssetLoader::Update(void)
+{
+	unsigned int uNumOfUploads = 0;
+	while (true)
+	{
+		Asset* sAsset = NULL;
+		{
+			std::lock_guard<std::mutex> lock(mtxQueue);
+			if (dqDecoded.empty())
+				break;
+			sAsset = dqDecoded.front();
+			dqDecoded.pop_front();
+		}
+		Upload(sAsset);
+		uNumOfUploads++;
+	}
+	return uNumOfUploads;
+}
+
+/**
+ @brief Wait for all the queued assets, and upload each of them as soon as it is decoded
+ @return true if all the assets were loaded, else false
+ */
+bool CAssetLoader::Finish(void)
+{
+	PROFILE_SCOPE("CAssetLoader::Finish");
+	while (uNumOfPending > 0)
+	{
+		Asset* sAsset = NULL;
+		{
+			std::unique_lock<std::mutex> lock(mtxQueue);
+			cvDecoded.wait(lock, [this] { return !dqDecoded.empty(); });
+			sAsset = dqDecoded.front();
+			dqDecoded.pop_front();
+		}
+		Upload(sAsset);
+	}
+	return (uNumOfFailures == 0);
+}
+
+/**
+ @brief Mark the start of work which the main thread does while the assets are decoded
+ @param cName A const char* variable which contains the name of the work
+ */
+void CAssetLoader::BeginPhase(const char* cName)
+{
+	EndPhase();
+
+	Event sEvent;
+	sEvent.eType = EVENT_PHASE;
+	sEvent.strName = cName;
+	sEvent.uThread = 0;
+	sEvent.dStart = GetTime();
+	sEvent.dEnd = sEvent.dStart;
+
+	std::lock_guard<std::mutex> lock(mtxQueue);
+	iCurrentPhase = (int)vEvents.size();
+	vEvents.push_back(sEvent);
+}
+
+/**
+ @brief Mark the end of the work which was started by BeginPhase
+ */
+void CAssetLoader::EndPhase(void)
+{
+	std::lock_guard<std::mutex> lock(mtxQueue);
+	if (iCurrentPhase < 0)
+		return;
+	vEvents[iCurrentPhase].dEnd = GetTime();
+	iCurrentPhase = -1;
+}
+
+/**
+ @brief Get the number of assets which were requested but are not uploaded yet
+ */
+unsigned int CAssetLoader::GetNumOfPending(void) const
+{
+	return uNumOfPending;
+}
+
+/**
+ @brief Print when each asset was decoded and uploaded, and the chain of work which decided when loading finished.
+		Every step of the chain started as soon as the step before it ended, so shortening the chain is
+		the only way to finish loading sooner.
+ */
+void CAssetLoader::PrintTimeline(void) const
+{
+	std::lock_guard<std::mutex> lock(mtxQueue);
+
+	std::vector<Event> vSorted = vEvents;
+	std::sort(vSorted.begin(), vSorted.end(),
+		[](const Event& a, const Event& b) { return a.dStart < b.dStart; });
+
+	double dWallTime = 0.0, dDecodeTime = 0.0, dUploadTime = 0.0;
+	for (unsigned int i = 0; i < vSorted.size(); i++)
+	{
+		if (vSorted[i].dEnd > dWallTime)
+			dWallTime = vSorted[i].dEnd;
+		if (vSorted[i].eType == EVENT_DECODE)
+			dDecodeTime += vSorted[i].dEnd - vSorted[i].dStart;
+		else if (vSorted[i].eType == EVENT_UPLOAD)
+			dUploadTime += vSorted[i].dEnd - vSorted[i].dStart;
+	}
+
+	static const char* cEventTypes[] = { "phase ", "decode", "upload" };
+
+	cout << fixed << setprecision(1);
+	cout << "CAssetLoader: " << vAssets.size() << " assets on " << vThreads.size() << " worker threads, "
+		<< dWallTime << " ms in all, " << dDecodeTime << " ms of decoding, " << dUploadTime << " ms of uploads, "
+		<< uNumOfFailures << " failures" << endl;
+	for (unsigned int i = 0; i < vSorted.size(); i++)
+	{
+		const Event& sEvent = vSorted[i];
+		int iStart = 0, iEnd = 0;
+		if (dWallTime > 0.0)
+		{
+			iStart = (int)(sEvent.dStart / dWallTime * TIMELINE_WIDTH);
+			iEnd = (int)(sEvent.dEnd / dWallTime * TIMELINE_WIDTH);
+		}
+		if (iEnd <= iStart)
+			iEnd = iStart + 1;
+		if (iEnd > TIMELINE_WIDTH)
+			iEnd = TIMELINE_WIDTH;
+
+		string strThread = (sEvent.uThread == 0) ? "main" : "T" + to_string(sEvent.uThread);
+		string strBar = string(iStart, ' ') + string(iEnd - iStart, (sEvent.eType == EVENT_DECODE) ? '=' : '#')
+			+ string(TIMELINE_WIDTH - iEnd, ' ');
+		cout << "\t" << left << setw(5) << strThread << cEventTypes[sEvent.eType] << " " << setw(28) << sEvent.strName
+			<< right << "|" << strBar << "| " << setw(7) << sEvent.dStart << " - " << setw(7) << sEvent.dEnd << " ms" << endl;
+	}
+
+	// Follow the chain back from the last upload. An upload waits on the decode of its file and on the main thread;
+	// a decode waits on the work before it on its thread; a phase waits on the main thread.
+	int iCurrent = -1;
+	for (unsigned int i = 0; i < vSorted.size(); i++)
+	{
+		if ((vSorted[i].eType == EVENT_UPLOAD) && ((iCurrent < 0) || (vSorted[i].dEnd > vSorted[iCurrent].dEnd)))
+			iCurrent = (int)i;
+	}
+	std::vector<int> vChain;
+	while (iCurrent >= 0)
+	{
+		vChain.push_back(iCurrent);
+		const Event& sCurrent = vSorted[iCurrent];
+
+		// The latest span of work which this one could have waited on, which ended before this one started and
+		// started before this one. Only the earlier events are searched, so the chain cannot loop.
+		int iPrevious = -1;
+		for (int i = 0; i < iCurrent; i++)
+		{
+			const Event& sEvent = vSorted[i];
+			if (sEvent.dEnd > sCurrent.dStart + TIMELINE_GAP)
+				continue;
+			bool bSameThread = (sEvent.uThread == sCurrent.uThread);
+			bool bOwnDecode = (sCurrent.eType == EVENT_UPLOAD) && (sEvent.eType == EVENT_DECODE) && (sEvent.strName == sCurrent.strName);
+			if ((bSameThread || bOwnDecode) && ((iPrevious < 0) || (sEvent.dEnd > vSorted[iPrevious].dEnd)))
+				iPrevious = i;
+		}
+		// A span which started well after the one before it ended was not waiting on it
+		if ((iPrevious >= 0) && (sCurrent.dStart - vSorted[iPrevious].dEnd > TIMELINE_GAP))
+			iPrevious = -1;
+		iCurrent = iPrevious;
+	}
+
+	cout << "CAssetLoader: critical path" << endl;
+	for (int i = (int)vChain.size() - 1; i >= 0; i--)
+	{
+		const Event& sEvent = vSorted[vChain[i]];
+		string strThread = (sEvent.uThread == 0) ? "main" : "T" + to_string(sEvent.uThread);
+		cout << "\t" << left << setw(5) << strThread << cEventTypes[sEvent.eType] << " " << setw(28) << sEvent.strName
+			<< right << setw(7) << sEvent.dEnd - sEvent.dStart << " ms" << endl;
+	}
+	cout << defaultfloat << setprecision(6);
+}
+
+/**
+ @brief Stop and join the worker threads. The assets which are still queued are not decoded.
+ */
+void CAssetLoader::StopThreads(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxQueue);
+		bStopping = true;
+	}
+	cvQueued.notify_all();
+
+	for (unsigned int i = 0; i < vThreads.size(); i++)
+		vThreads[i].join();
+	vThreads.clear();
+}
+
+/**
+ @brief Queue an asset for the worker threads, unless the same file was requested before
+ @param eType A const ASSET_TYPE variable which contains the kind of asset
+ @param filename A const char* variable which contains the file name of the asset
+ */
+void CAssetLoader::Request(const ASSET_TYPE eType, const char* filename)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+	if (vThreads.empty())
+	{
+		cout << "CAssetLoader::Request(): Not initialised, so " << filename << " is not loaded" << endl;
+		return;
+	}
+
+	Asset* sAsset = new Asset();
+	sAsset->eType = eType;
+	sAsset->strFilename = filename;
+	sAsset->pTexture = NULL;
+	sAsset->pMesh = NULL;
+	sAsset->bDecoded = false;
+
+	{
+		std::lock_guard<std::mutex> lock(mtxQueue);
+		if (setRequested.insert(strPath).second == false)
+		{
+			delete sAsset;
+			return;
+		}
+		vAssets.push_back(sAsset);
+		dqQueued.push_back(sAsset);
+		uNumOfPending++;
+	}
+	cvQueued.notify_one();
+}
+
+/**
+ @brief Take assets off the queue and decode them, until the threads are stopped
+ @param uThread A const unsigned int variable which contains the number of this thread, from 1
+ */
+void CAssetLoader::WorkerThread(const unsigned int uThread)
+{
+	CProfiler::GetInstance()->SetThreadName(("Asset Loader " + to_string(uThread)).c_str());
+
+	while (true)
+	{
+		Asset* sAsset = NULL;
+		{
+			std::unique_lock<std::mutex> lock(mtxQueue);
+			cvQueued.wait(lock, [this] { return bStopping || !dqQueued.empty(); });
+			if (bStopping)
+				return;
+			sAsset = dqQueued.front();
+			dqQueued.pop_front();
+		}
+
+		Event sEvent;
+		sEvent.eType = EVENT_DECODE;
+		sEvent.strName = sAsset->strFilename;
+		sEvent.uThread = uThread;
+		sEvent.dStart = GetTime();
+
+		if (sAsset->eType == ASSET_TEXTURE)
+		{
+			PROFILE_SCOPE("Decode Texture");
+			sAsset->pTexture = new DecodedTexture();
+			sAsset->bDecoded = CTextureManager::DecodeTexture(sAsset->strFilename.c_str(), *sAsset->pTexture);
+		}
+		else
+		{
+			PROFILE_SCOPE("Decode Mesh");
+			sAsset->pMesh = new DecodedMesh();
+			sAsset->bDecoded = CMeshManager::DecodeMesh(sAsset->strFilename.c_str(), *sAsset->pMesh);
+		}
+
+		sEvent.dEnd = GetTime();
+
+		{
+			std::lock_guard<std::mutex> lock(mtxQueue);
+			vEvents.push_back(sEvent);
+			dqDecoded.push_back(sAsset);
+		}
+		cvDecoded.notify_one();
+	}
+}
+
+/**
+ @brief Upload a decoded asset on the main thread, and free its decoded file
+ @param sAsset An Asset* variable which contains the asset
+ */
+void CAssetLoader::Upload(Asset* sAsset)
+{
+	PROFILE_SCOPE("CAssetLoader::Upload");
+	Event sEvent;
+	sEvent.eType = EVENT_UPLOAD;
+	sEvent.strName = sAsset->strFilename;
+	sEvent.uThread = 0;
+	sEvent.dStart = GetTime();
+
+	bool bLoaded = false;
+	if (sAsset->bDecoded)
+	{
+		if (sAsset->eType == ASSET_TEXTURE)
+			bLoaded = CTextureManager::GetInstance()->PreloadDecoded(sAsset->strFilename.c_str(), *sAsset->pTexture);
+		else
+			bLoaded = CMeshManager::GetInstance()->PreloadDecoded(sAsset->strFilename.c_str(), *sAsset->pMesh);
+	}
+	if (bLoaded == false)
+	{
+		cout << "CAssetLoader::Upload(): Unable to load " << sAsset->strFilename << endl;
+		uNumOfFailures++;
+	}
+
+	delete sAsset->pTexture;
+	sAsset->pTexture = NULL;
+	delete sAsset->pMesh;
+	sAsset->pMesh = NULL;
+
+	sEvent.dEnd = GetTime();
+
+	std::lock_guard<std::mutex> lock(mtxQueue);
+	vEvents.push_back(sEvent);
+	uNumOfPending--;
+}
+
+/**
+ @brief Get the time since Init, in milliseconds
+ */
+double CAssetLoader::GetTime(void) const
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include TextureManager
+#include "TextureManager.h"
+// Include MeshManager
+#include "MeshManager.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// Loads textures and meshes at startup. The files are read and decoded on worker threads,
+// while the main thread carries on with other work; only the OpenGL uploads are done on the main thread.
+// The loaded assets are kept in the CTextureManager and CMeshManager, like their Preload methods do.
+class CAssetLoader : public CSingletonTemplate<CAssetLoader>
+{
+	friend CSingletonTemplate<CAssetLoader>;
+public:
+	// Init
+	bool Init(const unsigned int uNumOfThreads = 0);
+
+	// Queue a texture or a mesh to be decoded on a worker thread
+	void RequestTexture(const char* filename);
+	void RequestMesh(const char* filename);
+
+	// Upload the assets which have been decoded so far, without waiting for the rest
+	unsigned int Update(void);
+	// Wait for all the queued assets, and upload them
+	bool Finish(void);
+
+	// Mark the start and end of work which the main thread does while the assets are decoded
+	void BeginPhase(const char* cName);
+	void EndPhase(void);
+
+	// Get the number of assets which were requested but are not uploaded yet
+	unsigned int GetNumOfPending(void) const;
+
+	// Print when each asset was decoded and uploaded, and the chain of work which decided when loading finished
+	void PrintTimeline(void) const;
+
+protected:
+	// The kinds of assets
+	enum ASSET_TYPE
+	{
+		ASSET_TEXTURE = 0,
+		ASSET_MESH
+	};
+
+	// An asset which was requested
+	struct Asset
+	{
+		ASSET_TYPE eType;
+		std::string strFilename;
+		// The decoded file, which is deleted once it is uploaded
+		DecodedTexture* pTexture;
+		DecodedMesh* pMesh;
+		// true if the file was decoded
+		bool bDecoded;
+	};
+
+	// The kinds of events in the timeline
+	enum EVENT_TYPE
+	{
+		EVENT_PHASE = 0,
+		EVENT_DECODE,
+		EVENT_UPLOAD
+	};
+
+	// A span of work in the timeline
+	struct Event
+	{
+		EVENT_TYPE eType;
+		std::string strName;
+		// 0 for the main thread, else the worker thread number
+		unsigned int uThread;
+		// The start and end, in milliseconds since Init
+		double dStart, dEnd;
+	};
+
+	// The worker threads
+	std::vector<std::thread> vThreads;
+	bool bStopping;
+
+	// The requested assets, the ones waiting for a worker thread and the ones waiting to be uploaded
+	std::vector<Asset*> vAssets;
+	std::deque<Asset*> dqQueued;
+	std::deque<Asset*> dqDecoded;
+	// The canonical paths which were requested, so that each file is only loaded once
+	std::set<std::string> setRequested;
+	// The number of assets which are not uploaded yet
+	unsigned int uNumOfPending;
+	// The number of assets which could not be loaded
+	unsigned int uNumOfFailures;
+
+	// The timeline, and the phase which is running on the main thread
+	std::vector<Event> vEvents;
+	int iCurrentPhase;
+	std::chrono::high_resolution_clock::time_point startTime;
+
+	// Guards the queues and the timeline
+	mutable std::mutex mtxQueue;
+	std::condition_variable cvQueued;
+	std::condition_variable cvDecoded;
+
+	// Constructor
+	CAssetLoader(void);
+
+	// Destructor
+	virtual ~CAssetLoader(void);
+
+	// Stop and join the worker threads
+	void StopThreads(void);
+
+	// Queue an asset for the worker threads
+	void Request(const ASSET_TYPE eType, const char* filename);
+	// Take assets off the queue and decode them, until the threads are stopped
+	void WorkerThread(const unsigned int uThread);
+	// Upload a decoded asset on the main thread
+	void Upload(Asset* sAsset);
+
+	// Get the time since Init, in milliseconds
+	double GetTime(void) const;
+};
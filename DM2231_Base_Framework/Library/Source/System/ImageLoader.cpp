@@ -5,7 +5,12 @@
  */
 #include "ImageLoader.h"
 
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <vector>
+#include <sys/stat.h>
 using namespace std;
 
 // Include GLEW
@@ -18,6 +23,20 @@ using namespace std;
 #include <includes/stb_image.h>
 #include "filesystem.h"
 
+// SOIL's DXT compressor and mipmap builder
+extern "C" {
+#include <includes/image_DXT.h>
+#include <includes/image_helper.h>
+}
+
+// The tags of the DDS files and their pixel formats
+static const unsigned int DDS_MAGIC = 0x20534444;	// "DDS "
+static const unsigned int FOURCC_DXT1 = 0x31545844;	// "DXT1"
+static const unsigned int FOURCC_DXT5 = 0x35545844;	// "DXT5"
+// Stored in the reserved fields of the DDS files which this class writes, together with bInvert,
+// so that a file which was compressed the other way up is not used
+static const unsigned int DDS_MARKER = 0x32324D44;	// "DM22"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -45,13 +64,283 @@ bool CImageLoader::Init(void)
 */
 unsigned char * CImageLoader::Load(const char* filename, int& width, int& height, int& nrChannels, const bool bInvert)
 {
-	// tell stb_image.h to flip loaded texture's on the y-axis.
-	stbi_set_flip_vertically_on_load(bInvert);
-
 	// load image, create texture and generate mipmaps
 	unsigned char *data = stbi_load(FileSystem::getPath(filename).c_str(),
 									&width, &height, &nrChannels, 0);
 
+	// Flip the image on the y-axis here, instead of with stbi_set_flip_vertically_on_load,
+	// whose flag is shared by all threads and so cannot be used while images are loaded in parallel
+	if (data && bInvert)
+	{
+		const size_t uRowSize = (size_t)width * (size_t)nrChannels;
+		vector<unsigned char> vRow(uRowSize);
+		for (int iTop = 0, iBottom = height - 1; iTop < iBottom; iTop++, iBottom--)
+		{
+			memcpy(&vRow[0], data + iTop * uRowSize, uRowSize);
+			memcpy(data + iTop * uRowSize, data + iBottom * uRowSize, uRowSize);
+			memcpy(data + iBottom * uRowSize, &vRow[0], uRowSize);
+		}
+	}
+
 	// Return the data but you must remember to free up the memory of the file data read in
 	return data;
 }
+
+/**
+@brief Check if the graphics card can read DXT compressed textures
+*/
+bool CImageLoader::IsCompressionSupported(void) const
+{
+	return (GLEW_EXT_texture_compression_s3tc == GL_TRUE);
+}
+
+/**
+@brief Get the file name of the compressed copy of an image, which is the image's file name with a .dds extension
+*/
+std::string CImageLoader::GetCompressedFilename(const char* filename) const
+{
+	std::string strFilename = filename;
+	size_t uDot = strFilename.find_last_of('.');
+	size_t uSlash = strFilename.find_last_of("/\\");
+	if ((uDot != std::string::npos) && ((uSlash == std::string::npos) || (uDot > uSlash)))
+		strFilename.erase(uDot);
+	return strFilename + ".dds";
+}
+
+/**
+@brief Compress an image to a DXT file next to it. Images which are fully opaque are stored as DXT1 (4 bits per texel),
+		the others as DXT5 (8 bits per texel). The mipmap chain is built here, so that it does not need to be
+		generated by the driver every time the image is loaded.
+@param filename A const char* variable which contains the file name of the image
+@param bInvert A const bool variable which is true if the image is flipped vertically
+@param bMipmaps A const bool variable which is true if the mipmap chain is stored as well
+@return true if the compressed file is written, else false
+*/
+bool CImageLoader::Compress(const char* filename, const bool bInvert, const bool bMipmaps)
+{
+	int width, height, nrChannels;
+	unsigned char *data = Load(filename, width, height, nrChannels, bInvert);
+	if (!data)
+	{
+		cout << "CImageLoader::Compress(): Unable to load " << filename << endl;
+		return false;
+	}
+	if ((nrChannels != 3) && (nrChannels != 4))
+	{
+		cout << "CImageLoader::Compress(): Unsupported number of channels (" << nrChannels << ") in " << filename << endl;
+		free(data);
+		return false;
+	}
+
+	// Only keep the alpha channel if it is used
+	bool bAlpha = false;
+	if (nrChannels == 4)
+	{
+		for (size_t i = 0; i < (size_t)width * (size_t)height; i++)
+		{
+			if (data[i * 4 + 3] != 255)
+			{
+				bAlpha = true;
+				break;
+			}
+		}
+	}
+
+	// Compress each level of the mipmap chain, halving the image until it is 1x1
+	vector<unsigned char> vCompressed;
+	vector<unsigned char> vLevel;
+	const unsigned char* pLevel = data;
+	int iLevelWidth = width, iLevelHeight = height;
+	unsigned int uNumOfLevels = 0;
+	while (true)
+	{
+		int iSize = 0;
+		unsigned char* pBlocks = NULL;
+		if (bAlpha)
+			pBlocks = convert_image_to_DXT5(pLevel, iLevelWidth, iLevelHeight, nrChannels, &iSize);
+		else
+			pBlocks = convert_image_to_DXT1(pLevel, iLevelWidth, iLevelHeight, nrChannels, &iSize);
+		if (pBlocks == NULL)
+		{
+			cout << "CImageLoader::Compress(): Unable to compress " << filename << endl;
+			free(data);
+			return false;
+		}
+		vCompressed.insert(vCompressed.end(), pBlocks, pBlocks + iSize);
+		free(pBlocks);
+		uNumOfLevels++;
+
+		if ((bMipmaps == false) || ((iLevelWidth == 1) && (iLevelHeight == 1)))
+			break;
+
+		// Average each 2x2 block of texels into the next level
+		int iBlockWidth = (iLevelWidth > 1) ? 2 : 1;
+		int iBlockHeight = (iLevelHeight > 1) ? 2 : 1;
+		vector<unsigned char> vNextLevel((size_t)(iLevelWidth / iBlockWidth) * (size_t)(iLevelHeight / iBlockHeight) * nrChannels);
+		mipmap_image(pLevel, iLevelWidth, iLevelHeight, nrChannels, &vNextLevel[0], iBlockWidth, iBlockHeight);
+		vLevel.swap(vNextLevel);
+		pLevel = &vLevel[0];
+		iLevelWidth /= iBlockWidth;
+		iLevelHeight /= iBlockHeight;
+	}
+
+	// Free up the memory of the file data read in
+	free(data);
+
+	DDS_header sHeader;
+	memset(&sHeader, 0, sizeof(DDS_header));
+	sHeader.dwMagic = DDS_MAGIC;
+	sHeader.dwSize = 124;
+	sHeader.dwFlags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE | DDSD_MIPMAPCOUNT;
+	sHeader.dwHeight = height;
+	sHeader.dwWidth = width;
+	sHeader.dwPitchOrLinearSize = ((width + 3) / 4) * ((height + 3) / 4) * (bAlpha ? 16 : 8);
+	sHeader.dwMipMapCount = uNumOfLevels;
+	sHeader.dwReserved1[0] = DDS_MARKER;
+	sHeader.dwReserved1[1] = bInvert ? 1 : 0;
+	sHeader.sPixelFormat.dwSize = 32;
+	sHeader.sPixelFormat.dwFlags = DDPF_FOURCC;
+	sHeader.sPixelFormat.dwFourCC = bAlpha ? FOURCC_DXT5 : FOURCC_DXT1;
+	sHeader.sCaps.dwCaps1 = DDSCAPS_TEXTURE;
+	if (uNumOfLevels > 1)
+		sHeader.sCaps.dwCaps1 |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+
+	std::string strCompressed = GetCompressedFilename(filename);
+	ofstream fileStream(FileSystem::getPath(strCompressed).c_str(), ios::binary);
+	if (!fileStream.is_open())
+	{
+		cout << "CImageLoader::Compress(): Unable to write " << strCompressed << endl;
+		return false;
+	}
+	fileStream.write((const char*)&sHeader, sizeof(DDS_header));
+	fileStream.write((const char*)&vCompressed[0], vCompressed.size());
+	if (!fileStream.good())
+	{
+		cout << "CImageLoader::Compress(): Unable to write " << strCompressed << endl;
+		return false;
+	}
+
+	cout << "CImageLoader::Compress(): " << filename << " -> " << strCompressed
+		<< " (" << (bAlpha ? "DXT5" : "DXT1") << ", " << uNumOfLevels << " levels, "
+		<< vCompressed.size() / 1024 << " KB)" << endl;
+	return true;
+}
+
+/**
+@brief Upload the compressed copy of an image to the texture which is bound to a target.
+		The compressed copy is not used if it is missing, older than the image, or flipped the other way.
+@param filename A const char* variable which contains the file name of the image
+@param eTarget A const GLenum variable which contains the target, e.g. GL_TEXTURE_2D or a face of a cube map
+@param bInvert A const bool variable which is true if the image is flipped vertically
+@param iNumOfLevels An int& variable which returns the number of mipmap levels which were uploaded
+@param uBytes A size_t& variable which returns the number of bytes which were uploaded
+@return true if the compressed copy is uploaded, else false
+*/
+bool CImageLoader::LoadCompressed(	const char* filename,
+									const GLenum eTarget,
+									const bool bInvert,
+									int& iNumOfLevels,
+									size_t& uBytes)
+{
+	iNumOfLevels = 0;
+	uBytes = 0;
+
+	CompressedImage sImage;
+	if (!ReadCompressed(filename, bInvert, sImage))
+		return false;
+	return UploadCompressed(sImage, eTarget, iNumOfLevels, uBytes);
+}
+
+/**
+@brief Read the compressed copy of an image into memory.
+		The compressed copy is not used if it is missing, older than the image, or flipped the other way.
+@param filename A const char* variable which contains the file name of the image
+@param bInvert A const bool variable which is true if the image is flipped vertically
+@param sImage A CompressedImage& variable which returns the format and the blocks of every level
+@return true if the compressed copy is read, else false
+*/
+bool CImageLoader::ReadCompressed(const char* filename, const bool bInvert, CompressedImage& sImage) const
+{
+	if (!IsCompressionSupported())
+		return false;
+
+	// Do not use a compressed copy which is older than the image
+	std::string strSource = FileSystem::getPath(filename);
+	std::string strCompressed = FileSystem::getPath(GetCompressedFilename(filename));
+	struct stat sSourceStat, sCompressedStat;
+	if (stat(strCompressed.c_str(), &sCompressedStat) != 0)
+		return false;
+	if ((stat(strSource.c_str(), &sSourceStat) == 0) && (sSourceStat.st_mtime > sCompressedStat.st_mtime))
+		return false;
+
+	ifstream fileStream(strCompressed.c_str(), ios::binary);
+	if (!fileStream.is_open())
+		return false;
+
+	DDS_header sHeader;
+	fileStream.read((char*)&sHeader, sizeof(DDS_header));
+	if ((!fileStream.good()) || (sHeader.dwMagic != DDS_MAGIC)
+		|| (sHeader.dwReserved1[0] != DDS_MARKER) || (sHeader.dwReserved1[1] != (bInvert ? 1u : 0u)))
+		return false;
+
+	if (sHeader.sPixelFormat.dwFourCC == FOURCC_DXT1)
+	{
+		sImage.eFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		sImage.iBlockSize = 8;
+	}
+	else if (sHeader.sPixelFormat.dwFourCC == FOURCC_DXT5)
+	{
+		sImage.eFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		sImage.iBlockSize = 16;
+	}
+	else
+		return false;
+
+	sImage.iWidth = sHeader.dwWidth;
+	sImage.iHeight = sHeader.dwHeight;
+	sImage.uNumOfLevels = sHeader.dwMipMapCount;
+
+	// Read all the levels in one go
+	sImage.vBlocks.assign((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+	return true;
+}
+
+/**
+@brief Upload a compressed image which was read by ReadCompressed to the texture which is bound to a target
+@param sImage A const CompressedImage& variable which contains the compressed image
+@param eTarget A const GLenum variable which contains the target, e.g. GL_TEXTURE_2D or a face of a cube map
+@param iNumOfLevels An int& variable which returns the number of mipmap levels which were uploaded
+@param uBytes A size_t& variable which returns the number of bytes which were uploaded
+@return true if at least one level is uploaded, else false
+*/
+bool CImageLoader::UploadCompressed(const CompressedImage& sImage,
+									const GLenum eTarget,
+									int& iNumOfLevels,
+									size_t& uBytes) const
+{
+	iNumOfLevels = 0;
+	uBytes = 0;
+
+	int iLevelWidth = sImage.iWidth, iLevelHeight = sImage.iHeight;
+	size_t uOffset = 0;
+	for (unsigned int i = 0; i < sImage.uNumOfLevels; i++)
+	{
+		size_t uSize = (size_t)((iLevelWidth + 3) / 4) * (size_t)((iLevelHeight + 3) / 4) * sImage.iBlockSize;
+		if (uOffset + uSize > sImage.vBlocks.size())
+		{
+			cout << "CImageLoader::UploadCompressed(): The compressed image is truncated." << endl;
+			break;
+		}
+		glCompressedTexImage2D(eTarget, i, sImage.eFormat, iLevelWidth, iLevelHeight, 0, (GLsizei)uSize, &sImage.vBlocks[uOffset]);
+		uOffset += uSize;
+		iNumOfLevels++;
+
+		if (iLevelWidth > 1)
+			iLevelWidth /= 2;
+		if (iLevelHeight > 1)
+			iLevelHeight /= 2;
+	}
+	uBytes = uOffset;
+
+	return (iNumOfLevels > 0);
+}
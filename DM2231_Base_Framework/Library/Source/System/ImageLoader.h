@@ -8,6 +8,22 @@
 // Include SingletonTemplate
 #include "../DesignPatterns/SingletonTemplate.h"
 
+// Include GLEW
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+// The DXT blocks of every mipmap level of an image, read from its compressed copy, which are ready to be uploaded
+struct CompressedImage
+{
+	GLenum eFormat;
+	int iWidth, iHeight;
+	int iBlockSize;
+	unsigned int uNumOfLevels;
+	std::vector<char> vBlocks;
+};
+
 class CImageLoader : public CSingletonTemplate<CImageLoader>
 {
 	friend CSingletonTemplate<CImageLoader>;
@@ -18,6 +34,26 @@ public:
 	// Load an image and return as unsigned char*
 	unsigned char * Load(const char* filename, int& width, int& height, int& nrChannels, const bool bInvert = false);
 
+	// Check if the graphics card can read DXT compressed textures
+	bool IsCompressionSupported(void) const;
+	// Get the file name of the compressed copy of an image
+	std::string GetCompressedFilename(const char* filename) const;
+	// Compress an image to a DXT file next to it, with or without a mipmap chain
+	bool Compress(const char* filename, const bool bInvert = false, const bool bMipmaps = true);
+	// Upload the compressed copy of an image to the texture which is bound to a target
+	bool LoadCompressed(const char* filename,
+						const GLenum eTarget,
+						const bool bInvert,
+						int& iNumOfLevels,
+						size_t& uBytes);
+	// Read the compressed copy of an image into memory. This makes no OpenGL calls, so it can be run on any thread.
+	bool ReadCompressed(const char* filename, const bool bInvert, CompressedImage& sImage) const;
+	// Upload a compressed image which was read by ReadCompressed to the texture which is bound to a target
+	bool UploadCompressed(	const CompressedImage& sImage,
+							const GLenum eTarget,
+							int& iNumOfLevels,
+							size_t& uBytes) const;
+
 protected:
 	// Constructor
 	CImageLoader(void);
@@ -1,8 +1,62 @@
 #include <iostream>
-#include <fstream>
-#include <map>
+#include <cstring>
+#include <charconv>
 
 #include "LoadOBJ.h"
+// Include MappedFile
+#include "MappedFile.h"
+
+// Skip the spaces and tabs before the next value on a line
+static inline const char* SkipSpaces(const char* p, const char* end)
+{
+	while ((p < end) && ((*p == ' ') || (*p == '\t')))
+		++p;
+	return p;
+}
+
+// Move to the start of the next line
+static inline const char* NextLine(const char* p, const char* end)
+{
+	const char* eol = (const char*)memchr(p, '\n', end - p);
+	return (eol == NULL) ? end : eol + 1;
+}
+
+// Read a float, e.g. from a "v", "vt" or "vn" line
+static inline bool ParseFloat(const char*& p, const char* end, float& fValue)
+{
+	p = SkipSpaces(p, end);
+	// from_chars does not accept a leading '+'
+	if ((p < end) && (*p == '+'))
+		++p;
+	std::from_chars_result sResult = std::from_chars(p, end, fValue);
+	if (sResult.ec != std::errc())
+		return false;
+	p = sResult.ptr;
+	return true;
+}
+
+// Read an index of a face corner, and turn it into a 0-based index.
+// Negative indices count back from the last element which was read so far.
+static inline bool ParseIndex(const char*& p, const char* end, const size_t uNumOfElements, int& iIndex)
+{
+	std::from_chars_result sResult = std::from_chars(p, end, iIndex);
+	if (sResult.ec != std::errc())
+		return false;
+	p = sResult.ptr;
+	if (iIndex > 0)
+		iIndex -= 1;
+	else if (iIndex < 0)
+		iIndex += (int)uNumOfElements;
+	else
+		return false;
+	return (iIndex >= 0) && (iIndex < (int)uNumOfElements);
+}
+
+// The indices of the position, uv and normal of one corner of a face. The uv and normal are -1 if they are missing.
+struct FaceCorner
+{
+	int iVertex, iUV, iNormal;
+};
 
 bool LoadOBJ(
 	const char *file_path, 
@@ -11,140 +65,144 @@ bool LoadOBJ(
 	std::vector<glm::vec3> & out_normals
 )
 {
-	std::ifstream fileStream(file_path, std::ios::binary);
-	if(!fileStream.is_open())
+	CMappedFile cFile;
+	if (!cFile.Open(file_path))
 	{
 		std::cout << "Impossible to open " << file_path << ". Are you in the right directory ?\n";
 		return false;
 	}
 
-	std::vector<unsigned> vertexIndices, uvIndices, normalIndices;
 	std::vector<glm::vec3> temp_vertices;
 	std::vector<glm::vec2> temp_uvs;
 	std::vector<glm::vec3> temp_normals;
+	// Reserve from the file size, as the "v", "vt", "vn" and "f" lines are each about 30 to 40 bytes long
+	temp_vertices.reserve(cFile.GetSize() / 128);
+	temp_uvs.reserve(cFile.GetSize() / 128);
+	temp_normals.reserve(cFile.GetSize() / 128);
+	out_vertices.reserve(out_vertices.size() + cFile.GetSize() / 32);
+	out_uvs.reserve(out_uvs.size() + cFile.GetSize() / 32);
+	out_normals.reserve(out_normals.size() + cFile.GetSize() / 32);
 
-	while(!fileStream.eof())
+	std::vector<FaceCorner> corners;
+	const char* p = cFile.GetData();
+	const char* end = cFile.GetData() + cFile.GetSize();
+	// Read the file in one pass. The faces are written out as they are read, since they can only
+	// refer to the positions, uvs and normals which came before them.
+	while (p < end)
 	{
-		char buf[256];
-		fileStream.getline(buf, 256);
-		if(strncmp("v ", buf, 2) == 0)
+		const char* line = SkipSpaces(p, end);
+		p = line;
+		bool bValid = true;
+		if ((end - p >= 2) && (p[0] == 'v') && ((p[1] == ' ') || (p[1] == '\t')))
 		{
+			p += 2;
 			glm::vec3 vertex;
-			sscanf_s((buf + 2), "%f%f%f", &vertex.x, &vertex.y, &vertex.z);
+			bValid = ParseFloat(p, end, vertex.x) && ParseFloat(p, end, vertex.y) && ParseFloat(p, end, vertex.z);
 			temp_vertices.push_back(vertex);
 		}
-		else if(strncmp("vt ", buf, 3) == 0)
+		else if ((end - p >= 3) && (p[0] == 'v') && (p[1] == 't') && ((p[2] == ' ') || (p[2] == '\t')))
 		{
+			p += 3;
 			glm::vec2 tc;
-			sscanf_s((buf + 2), "%f%f", &tc.x, &tc.y);
+			bValid = ParseFloat(p, end, tc.x) && ParseFloat(p, end, tc.y);
 			temp_uvs.push_back(tc);
 		}
-		else if(strncmp("vn ", buf, 3) == 0)
+		else if ((end - p >= 3) && (p[0] == 'v') && (p[1] == 'n') && ((p[2] == ' ') || (p[2] == '\t')))
 		{
+			p += 3;
 			glm::vec3 normal;
-			sscanf_s((buf + 2), "%f%f%f", &normal.x, &normal.y, &normal.z);
+			bValid = ParseFloat(p, end, normal.x) && ParseFloat(p, end, normal.y) && ParseFloat(p, end, normal.z);
 			temp_normals.push_back(normal);
 		}
-		else if(strncmp("f ", buf, 2) == 0)
+		else if ((end - p >= 2) && (p[0] == 'f') && ((p[1] == ' ') || (p[1] == '\t')))
 		{
-			unsigned int vertexIndex[4], uvIndex[4], normalIndex[4];
-			int matches = sscanf_s((buf + 2), "%d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", 
-				&vertexIndex[0], &uvIndex[0], &normalIndex[0], 
-				&vertexIndex[1], &uvIndex[1], &normalIndex[1], 
-				&vertexIndex[2], &uvIndex[2], &normalIndex[2], 
-				&vertexIndex[3], &uvIndex[3], &normalIndex[3]);
-			
-			if(matches == 9) //triangle
+			p += 2;
+			// Read the corners, which can be "v", "v/vt", "v//vn" or "v/vt/vn"
+			corners.clear();
+			while (bValid)
 			{
-				vertexIndices.push_back(vertexIndex[0]);
-				vertexIndices.push_back(vertexIndex[1]);
-				vertexIndices.push_back(vertexIndex[2]);
-				uvIndices    .push_back(uvIndex[0]);
-				uvIndices    .push_back(uvIndex[1]);
-				uvIndices    .push_back(uvIndex[2]);
-				normalIndices.push_back(normalIndex[0]);
-				normalIndices.push_back(normalIndex[1]);
-				normalIndices.push_back(normalIndex[2]);
+				p = SkipSpaces(p, end);
+				if ((p >= end) || (*p == '\r') || (*p == '\n') || (*p == '#'))
+					break;
+				FaceCorner corner = { -1, -1, -1 };
+				bValid = ParseIndex(p, end, temp_vertices.size(), corner.iVertex);
+				if (bValid && (p < end) && (*p == '/'))
+				{
+					++p;
+					if ((p < end) && (*p != '/'))
+						bValid = ParseIndex(p, end, temp_uvs.size(), corner.iUV);
+					if (bValid && (p < end) && (*p == '/'))
+					{
+						++p;
+						bValid = ParseIndex(p, end, temp_normals.size(), corner.iNormal);
+					}
+				}
+				corners.push_back(corner);
 			}
-			else if(matches == 12) //quad
-			{
-				vertexIndices.push_back(vertexIndex[0]);
-				vertexIndices.push_back(vertexIndex[1]);
-				vertexIndices.push_back(vertexIndex[2]);
-				uvIndices    .push_back(uvIndex[0]);
-				uvIndices    .push_back(uvIndex[1]);
-				uvIndices    .push_back(uvIndex[2]);
-				normalIndices.push_back(normalIndex[0]);
-				normalIndices.push_back(normalIndex[1]);
-				normalIndices.push_back(normalIndex[2]);
-				
-				vertexIndices.push_back(vertexIndex[2]);
-				vertexIndices.push_back(vertexIndex[3]);
-				vertexIndices.push_back(vertexIndex[0]);
-				uvIndices    .push_back(uvIndex[2]);
-				uvIndices    .push_back(uvIndex[3]);
-				uvIndices    .push_back(uvIndex[0]);
-				normalIndices.push_back(normalIndex[2]);
-				normalIndices.push_back(normalIndex[3]);
-				normalIndices.push_back(normalIndex[0]);
-			}
-			else
+			if (corners.size() < 3)
+				bValid = false;
+
+			// Split the face into a fan of triangles, so that quads and other polygons can be drawn
+			for (size_t i = 1; bValid && (i + 1 < corners.size()); ++i)
 			{
-				std::cout << "Error line: " << buf << std::endl;
-				std::cout << "File can't be read by parser\n";
-				return false;
+				const FaceCorner* triangle[3] = { &corners[0], &corners[i], &corners[i + 1] };
+				// A corner without a normal uses the normal of its triangle
+				glm::vec3 faceNormal = glm::cross(	temp_vertices[triangle[1]->iVertex] - temp_vertices[triangle[0]->iVertex],
+													temp_vertices[triangle[2]->iVertex] - temp_vertices[triangle[0]->iVertex]);
+				float fLength = glm::length(faceNormal);
+				faceNormal = (fLength > 0.0f) ? faceNormal / fLength : glm::vec3(0.0f, 1.0f, 0.0f);
+				for (int j = 0; j < 3; ++j)
+				{
+					out_vertices.push_back(temp_vertices[triangle[j]->iVertex]);
+					out_uvs.push_back((triangle[j]->iUV >= 0) ? temp_uvs[triangle[j]->iUV] : glm::vec2(0.0f, 0.0f));
+					out_normals.push_back((triangle[j]->iNormal >= 0) ? temp_normals[triangle[j]->iNormal] : faceNormal);
+				}
 			}
 		}
-	}
-	fileStream.close();
+		// Skip the rest of the line, which includes comments, groups, materials and smoothing groups
+		p = NextLine(p, end);
 
-	// For each vertex of each triangle
-	for(unsigned i = 0; i < vertexIndices.size(); ++i)
-	{
-		// Get the indices of its attributes
-		unsigned int vertexIndex = vertexIndices[i];
-		unsigned int uvIndex = uvIndices[i];
-		unsigned int normalIndex = normalIndices[i];
-		
-		// Get the attributes thanks to the index
-		glm::vec3 vertex = temp_vertices[vertexIndex - 1];
-		glm::vec2 uv = temp_uvs[uvIndex - 1];
-		glm::vec3 normal = temp_normals[normalIndex - 1];
-		
-		// Put the attributes in buffers
-		out_vertices.push_back(vertex);
-		out_uvs.push_back(uv);
-		out_normals.push_back(normal);
+		if (!bValid)
+		{
+			const char* eol = NextLine(line, end);
+			while ((eol > line) && ((eol[-1] == '\n') || (eol[-1] == '\r')))
+				--eol;
+			std::cout << "Error line: " << std::string(line, eol) << std::endl;
+			std::cout << "File can't be read by parser\n";
+			return false;
+		}
 	}
 
 	return true;
 }
 
-struct PackedVertex{
-	glm::vec3 position;
-	glm::vec2 uv;
-	glm::vec3 normal;
-	bool operator<(const PackedVertex that) const{
-		return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
-	};
-};
+// A vertex as the bits of its 8 floats, so that it can be hashed and compared without any padding bytes
+struct PackedVertex
+{
+	unsigned int bits[8];
 
-bool getSimilarVertexIndex_fast( 
-	PackedVertex & packed, 
-	std::map<PackedVertex, unsigned short> & VertexToOutIndex,
-	unsigned short & result
-){
-	std::map<PackedVertex, unsigned short>::iterator it = VertexToOutIndex.find(packed);
-	if(it == VertexToOutIndex.end())
+	PackedVertex(const glm::vec3& position, const glm::vec2& uv, const glm::vec3& normal)
 	{
-		return false;
+		memcpy(&bits[0], &position, sizeof(glm::vec3));
+		memcpy(&bits[3], &uv, sizeof(glm::vec2));
+		memcpy(&bits[5], &normal, sizeof(glm::vec3));
 	}
-	else
+	bool operator==(const PackedVertex& that) const
 	{
-		result = it->second;
-		return true;
+		return memcmp(bits, that.bits, sizeof(bits)) == 0;
 	}
-}
+	// FNV-1a over the 8 words, with a final mix so that the low bits can be used as the slot
+	unsigned int Hash(void) const
+	{
+		unsigned int hash = 2166136261u;
+		for (int i = 0; i < 8; ++i)
+			hash = (hash ^ bits[i]) * 16777619u;
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6bu;
+		hash ^= hash >> 13;
+		return hash;
+	}
+};
 
 void IndexVBO(
 	std::vector<glm::vec3> & in_vertices,
@@ -155,35 +213,50 @@ void IndexVBO(
 	std::vector<Vertex> & out_vertices
 )
 {
-	std::map<PackedVertex,unsigned short> VertexToOutIndex;
+	const unsigned int EMPTY_SLOT = 0xFFFFFFFF;
+
+	// An open-addressing hash table from a vertex to its index in out_vertices, with linear probing.
+	// It has at least twice as many slots as input vertices, so that it is never more than half full.
+	size_t uNumOfSlots = 16;
+	while (uNumOfSlots < in_vertices.size() * 2)
+		uNumOfSlots *= 2;
+	const size_t uSlotMask = uNumOfSlots - 1;
+	std::vector<unsigned int> slots(uNumOfSlots, EMPTY_SLOT);
+	// The packed form of each vertex in out_vertices, so that a slot can be compared without repacking
+	std::vector<PackedVertex> packedVertices;
+	packedVertices.reserve(in_vertices.size());
+
+	out_indices.reserve(out_indices.size() + in_vertices.size());
+	out_vertices.reserve(out_vertices.size() + in_vertices.size());
+	const unsigned int uFirstVertex = (unsigned int)out_vertices.size();
 
 	// For each input vertex
 	for(unsigned int i = 0; i < in_vertices.size(); ++i) 
 	{
-
-		PackedVertex packed = {in_vertices[i], in_uvs[i], in_normals[i]};
+		PackedVertex packed(in_vertices[i], in_uvs[i], in_normals[i]);
 
 		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex_fast( packed, VertexToOutIndex, index);
+		size_t uSlot = packed.Hash() & uSlotMask;
+		while ((slots[uSlot] != EMPTY_SLOT) && !(packedVertices[slots[uSlot]] == packed))
+			uSlot = (uSlot + 1) & uSlotMask;
 
-		if ( found )
+		if (slots[uSlot] != EMPTY_SLOT)
 		{ 
 			// A similar vertex is already in the VBO, use it instead !
-			out_indices.push_back( index );
+			out_indices.push_back(uFirstVertex + slots[uSlot]);
 		}
 		else
 		{ 
 			// If not, it needs to be added in the output data.
 			Vertex v;
-			v.pos = glm::vec3(in_vertices[i].x, in_vertices[i].y, in_vertices[i].z);
-			v.texCoord = glm::vec2(in_uvs[i].x, in_uvs[i].y);
-			v.normal = glm::vec3(in_normals[i].x, in_normals[i].y, in_normals[i].z);
+			v.pos = in_vertices[i];
+			v.texCoord = in_uvs[i];
+			v.normal = in_normals[i];
 
 			out_vertices.push_back(v);
-			unsigned newindex = (unsigned)out_vertices.size() - 1;
-			out_indices.push_back( newindex );
-			VertexToOutIndex[ packed ] = newindex;
+			slots[uSlot] = (unsigned int)packedVertices.size();
+			packedVertices.push_back(packed);
+			out_indices.push_back((unsigned int)out_vertices.size() - 1);
 		}
 	}
-}
\ No newline at end of file
+}
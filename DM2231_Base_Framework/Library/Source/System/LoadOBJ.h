@@ -19,6 +19,17 @@ bool LoadOBJ(
 	std::vector<glm::vec3> & out_normals
 );
 
+// The line-by-line parser which LoadOBJ replaced. It is only kept so that the two can be compared.
+bool LoadOBJ_Getline(
+	const char *file_path, 
+	std::vector<glm::vec3> & out_vertices, 
+	std::vector<glm::vec2> & out_uvs, 
+	std::vector<glm::vec3> & out_normals
+);
+
+// Time LoadOBJ against the line-by-line parser which it replaced, and print the results to the console
+void BenchmarkLoadOBJ(const char* file_path, const int iNumOfRuns);
+
 void IndexVBO(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
@@ -0,0 +1,174 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+
+#include "LoadOBJ.h"
+
+/**
+ @brief Load an OBJ file line by line. This is the parser which LoadOBJ replaced; it is only kept so that the two can be compared.
+ @param file_path A const char* variable which contains the file name of the OBJ file
+ @param out_vertices The positions of the corners of the triangles
+ @param out_uvs The texture coordinates of the corners of the triangles
+ @param out_normals The normals of the corners of the triangles
+ @return true if the file was read, else false
+ */
+bool LoadOBJ_Getline(
+	const char *file_path, 
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals
+)
+{
+	std::ifstream fileStream(file_path, std::ios::binary);
+	if(!fileStream.is_open())
+	{
+		std::cout << "Impossible to open " << file_path << ". Are you in the right directory ?\n";
+		return false;
+	}
+
+	std::vector<unsigned> vertexIndices, uvIndices, normalIndices;
+	std::vector<glm::vec3> temp_vertices;
+	std::vector<glm::vec2> temp_uvs;
+	std::vector<glm::vec3> temp_normals;
+
+	while(!fileStream.eof())
+	{
+		char buf[256];
+		fileStream.getline(buf, 256);
+		if(strncmp("v ", buf, 2) == 0)
+		{
+			glm::vec3 vertex;
+			sscanf_s((buf + 2), "%f%f%f", &vertex.x, &vertex.y, &vertex.z);
+			temp_vertices.push_back(vertex);
+		}
+		else if(strncmp("vt ", buf, 3) == 0)
+		{
+			glm::vec2 tc;
+			sscanf_s((buf + 2), "%f%f", &tc.x, &tc.y);
+			temp_uvs.push_back(tc);
+		}
+		else if(strncmp("vn ", buf, 3) == 0)
+		{
+			glm::vec3 normal;
+			sscanf_s((buf + 2), "%f%f%f", &normal.x, &normal.y, &normal.z);
+			temp_normals.push_back(normal);
+		}
+		else if(strncmp("f ", buf, 2) == 0)
+		{
+			unsigned int vertexIndex[4], uvIndex[4], normalIndex[4];
+			int matches = sscanf_s((buf + 2), "%d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", 
+				&vertexIndex[0], &uvIndex[0], &normalIndex[0], 
+				&vertexIndex[1], &uvIndex[1], &normalIndex[1], 
+				&vertexIndex[2], &uvIndex[2], &normalIndex[2], 
+				&vertexIndex[3], &uvIndex[3], &normalIndex[3]);
+			
+			if(matches == 9) //triangle
+			{
+				vertexIndices.push_back(vertexIndex[0]);
+				vertexIndices.push_back(vertexIndex[1]);
+				vertexIndices.push_back(vertexIndex[2]);
+				uvIndices    .push_back(uvIndex[0]);
+				uvIndices    .push_back(uvIndex[1]);
+				uvIndices    .push_back(uvIndex[2]);
+				normalIndices.push_back(normalIndex[0]);
+				normalIndices.push_back(normalIndex[1]);
+				normalIndices.push_back(normalIndex[2]);
+			}
+			else if(matches == 12) //quad
+			{
+				vertexIndices.push_back(vertexIndex[0]);
+				vertexIndices.push_back(vertexIndex[1]);
+				vertexIndices.push_back(vertexIndex[2]);
+				uvIndices    .push_back(uvIndex[0]);
+				uvIndices    .push_back(uvIndex[1]);
+				uvIndices    .push_back(uvIndex[2]);
+				normalIndices.push_back(normalIndex[0]);
+				normalIndices.push_back(normalIndex[1]);
+				normalIndices.push_back(normalIndex[2]);
+				
+				vertexIndices.push_back(vertexIndex[2]);
+				vertexIndices.push_back(vertexIndex[3]);
+				vertexIndices.push_back(vertexIndex[0]);
+				uvIndices    .push_back(uvIndex[2]);
+				uvIndices    .push_back(uvIndex[3]);
+				uvIndices    .push_back(uvIndex[0]);
+				normalIndices.push_back(normalIndex[2]);
+				normalIndices.push_back(normalIndex[3]);
+				normalIndices.push_back(normalIndex[0]);
+			}
+			else
+			{
+				std::cout << "Error line: " << buf << std::endl;
+				std::cout << "File can't be read by parser\n";
+				return false;
+			}
+		}
+	}
+	fileStream.close();
+
+	// For each vertex of each triangle
+	for(unsigned i = 0; i < vertexIndices.size(); ++i)
+	{
+		// Get the indices of its attributes
+		unsigned int vertexIndex = vertexIndices[i];
+		unsigned int uvIndex = uvIndices[i];
+		unsigned int normalIndex = normalIndices[i];
+		
+		// Get the attributes thanks to the index
+		glm::vec3 vertex = temp_vertices[vertexIndex - 1];
+		glm::vec2 uv = temp_uvs[uvIndex - 1];
+		glm::vec3 normal = temp_normals[normalIndex - 1];
+		
+		// Put the attributes in buffers
+		out_vertices.push_back(vertex);
+		out_uvs.push_back(uv);
+		out_normals.push_back(normal);
+	}
+
+	return true;
+}
+
+/**
+ @brief Time LoadOBJ against the line-by-line parser which it replaced, and print the results to the console
+ @param file_path A const char* variable which contains the file name of the OBJ file
+ @param iNumOfRuns A const int variable which contains the number of times to load the file with each parser
+ */
+void BenchmarkLoadOBJ(const char* file_path, const int iNumOfRuns)
+{
+	double dGetlineTime = 0.0, dMappedTime = 0.0;
+	size_t uGetlineVertices = 0, uMappedVertices = 0;
+	for (int i = 0; i < iNumOfRuns; ++i)
+	{
+		std::vector<glm::vec3> vertices, normals;
+		std::vector<glm::vec2> uvs;
+		std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+		if (LoadOBJ_Getline(file_path, vertices, uvs, normals) == false)
+		{
+			std::cout << "BenchmarkLoadOBJ(): The line-by-line parser could not read " << file_path << std::endl;
+			return;
+		}
+		dGetlineTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+		uGetlineVertices = vertices.size();
+
+		vertices.clear();
+		uvs.clear();
+		normals.clear();
+		startTime = std::chrono::high_resolution_clock::now();
+		if (LoadOBJ(file_path, vertices, uvs, normals) == false)
+		{
+			std::cout << "BenchmarkLoadOBJ(): LoadOBJ could not read " << file_path << std::endl;
+			return;
+		}
+		dMappedTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+		uMappedVertices = vertices.size();
+	}
+
+	std::cout << "BenchmarkLoadOBJ(): " << file_path << ", " << iNumOfRuns << " runs" << std::endl;
+	std::cout << "\tline-by-line: " << dGetlineTime / iNumOfRuns << " ms, " << uGetlineVertices << " vertices" << std::endl;
+	std::cout << "\tLoadOBJ: " << dMappedTime / iNumOfRuns << " ms, " << uMappedVertices << " vertices" << std::endl;
+	if (dMappedTime > 0.0)
+		std::cout << "\tspeedup: " << dGetlineTime / dMappedTime << "x" << std::endl;
+	if (uGetlineVertices != uMappedVertices)
+		std::cout << "\tThe parsers returned a different number of vertices" << std::endl;
+}
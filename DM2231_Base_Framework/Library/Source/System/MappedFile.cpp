@@ -0,0 +1,125 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ @brief Constructor
+ */
+CMappedFile::CMappedFile(void)
+	: pData(NULL)
+	, uSize(0)
+#ifdef _WIN32
+	, hFile(INVALID_HANDLE_VALUE)
+	, hMapping(NULL)
+#endif
+{
+}
+
+/**
+ @brief Destructor
+ */
+CMappedFile::~CMappedFile(void)
+{
+	Close();
+}
+
+/**
+ @brief Map a file into memory. The pages are only read from the disk when they are used.
+ @param filename A const char* variable which contains the name of the file
+ @return true if the file was mapped, or is empty, else false
+ */
+bool CMappedFile::Open(const char* filename)
+{
+	Close();
+#ifdef _WIN32
+	hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER iFileSize;
+	if (GetFileSizeEx(hFile, &iFileSize) == FALSE)
+	{
+		Close();
+		return false;
+	}
+	uSize = (size_t)iFileSize.QuadPart;
+	// An empty file cannot be mapped, but it is still a valid file
+	if (uSize == 0)
+		return true;
+	hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping != NULL)
+		pData = (const char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	int iFile = open(filename, O_RDONLY);
+	if (iFile < 0)
+		return false;
+	struct stat sFileStat;
+	if (fstat(iFile, &sFileStat) == 0)
+	{
+		uSize = (size_t)sFileStat.st_size;
+		if (uSize == 0)
+		{
+			close(iFile);
+			return true;
+		}
+		void* pMapping = mmap(NULL, uSize, PROT_READ, MAP_PRIVATE, iFile, 0);
+		if (pMapping != MAP_FAILED)
+			pData = (const char*)pMapping;
+	}
+	close(iFile);
+#endif
+	if (pData == NULL)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Unmap the file
+ */
+void CMappedFile::Close(void)
+{
+#ifdef _WIN32
+	if (pData)
+		UnmapViewOfFile(pData);
+	if (hMapping)
+		CloseHandle(hMapping);
+	if (hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(hFile);
+	hMapping = NULL;
+	hFile = INVALID_HANDLE_VALUE;
+#else
+	if (pData)
+		munmap((void*)pData, uSize);
+#endif
+	pData = NULL;
+	uSize = 0;
+}
+
+/**
+ @brief Get the contents of the file
+ @return The contents of the file, or NULL if it is empty or not open
+ */
+const char* CMappedFile::GetData(void) const
+{
+	return pData;
+}
+
+/**
+ @brief Get the number of bytes in the file
+ @return The number of bytes in the file
+ */
+size_t CMappedFile::GetSize(void) const
+{
+	return uSize;
+}
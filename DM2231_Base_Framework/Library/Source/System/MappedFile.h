@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+// A read-only view of a whole file, which is mapped into memory instead of being copied
+class CMappedFile
+{
+public:
+	// Constructor
+	CMappedFile(void);
+	// Destructor
+	~CMappedFile(void);
+
+	// Map a file into memory
+	bool Open(const char* filename);
+	// Unmap the file
+	void Close(void);
+
+	// Get the contents of the file, or NULL if it is empty or not open
+	const char* GetData(void) const;
+	// Get the number of bytes in the file
+	size_t GetSize(void) const;
+
+protected:
+	// The contents of the file
+	const char* pData;
+	// The number of bytes in the file
+	size_t uSize;
+
+#ifdef _WIN32
+	// The HANDLEs of the file and its mapping, kept as void* so that this header does not need Windows.h
+	void* hFile;
+	void* hMapping;
+#endif
+
+	// A mapping cannot be copied, since it would be unmapped twice
+	CMappedFile(const CMappedFile&);
+	CMappedFile& operator=(const CMappedFile&);
+};
@@ -0,0 +1,217 @@
+#include "MeshFile.h"
+
+// Include LoadOBJ
+#include "LoadOBJ.h"
+// Include MeshOptimizer
+#include "MeshOptimizer.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+using namespace std;
+
+/**
+ @brief Round an offset up to a multiple of an alignment
+ */
+static unsigned int AlignOffset(const unsigned int uOffset, const unsigned int uAlignment)
+{
+	return (uOffset + uAlignment - 1) / uAlignment * uAlignment;
+}
+
+/**
+ @brief Get the name of the .mesh file for an OBJ file, which is the OBJ file's name with its extension replaced
+ @param obj_path A const char* variable which contains the file name of the OBJ file
+ @return The file name of the .mesh file
+ */
+std::string GetMeshFilename(const char* obj_path)
+{
+	std::string strFilename = obj_path;
+	size_t uDot = strFilename.find_last_of('.');
+	size_t uSlash = strFilename.find_last_of("/\\");
+	if ((uDot != std::string::npos) && ((uSlash == std::string::npos) || (uDot > uSlash)))
+		strFilename.erase(uDot);
+	return strFilename + ".mesh";
+}
+
+/**
+ @brief Check if the .mesh file is missing, or older than its OBJ file.
+		A .mesh file without its OBJ file is not stale, so the OBJ files do not have to be shipped.
+ @param obj_path A const char* variable which contains the file name of the OBJ file
+ @param mesh_path A const char* variable which contains the file name of the .mesh file
+ @return true if the OBJ file has to be imported again, else false
+ */
+bool IsMeshFileStale(const char* obj_path, const char* mesh_path)
+{
+	struct stat sSourceStat, sMeshStat;
+	if (stat(mesh_path, &sMeshStat) != 0)
+		return true;
+	if ((stat(obj_path, &sSourceStat) == 0) && (sSourceStat.st_mtime > sMeshStat.st_mtime))
+		return true;
+	return false;
+}
+
+/**
+ @brief Read, index and optimise an OBJ file into the contents of a .mesh file
+ @param obj_path A const char* variable which contains the file name of the OBJ file
+ @param out_file A std::vector<char>& variable which returns the contents of the .mesh file
+ @return true if the OBJ file was imported, else false
+ */
+bool ImportMeshFile(const char* obj_path, std::vector<char>& out_file)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+	if (LoadOBJ(obj_path, vertices, uvs, normals) == false)
+		return false;
+
+	std::vector<Vertex> vertex_buffer_data;
+	std::vector<unsigned> index_buffer_data;
+	IndexVBO(vertices, uvs, normals, index_buffer_data, vertex_buffer_data);
+	if ((vertex_buffer_data.size() == 0) || (index_buffer_data.size() == 0))
+		return false;
+
+	MeshFileHeader sHeader;
+	memset(&sHeader, 0, sizeof(MeshFileHeader));
+	sHeader.uMagic = MESH_FILE_MAGIC;
+	sHeader.uVersion = MESH_FILE_VERSION;
+
+	// Reorder the triangles for the post-transform cache and overdraw, and the vertices for fetching
+	sHeader.fACMRBefore = ComputeACMR(index_buffer_data, (unsigned int)vertex_buffer_data.size());
+	OptimizeMesh(index_buffer_data, vertex_buffer_data);
+	sHeader.fACMRAfter = ComputeACMR(index_buffer_data, (unsigned int)vertex_buffer_data.size());
+
+	// position, normal and texture coord attributes
+	sHeader.uVertexStride = sizeof(Vertex);
+	sHeader.uNumOfAttributes = 3;
+	MeshFileAttribute sPosition = { 0, 3, (unsigned int)offsetof(Vertex, pos) };
+	MeshFileAttribute sNormal = { 1, 3, (unsigned int)offsetof(Vertex, normal) };
+	MeshFileAttribute sTexCoord = { 2, 2, (unsigned int)offsetof(Vertex, texCoord) };
+	sHeader.sAttributes[0] = sPosition;
+	sHeader.sAttributes[1] = sNormal;
+	sHeader.sAttributes[2] = sTexCoord;
+
+	sHeader.uNumOfVertices = (unsigned int)vertex_buffer_data.size();
+	sHeader.uNumOfIndices = (unsigned int)index_buffer_data.size();
+	// Use 16-bit indices when every vertex can be reached with them, which halves the size of the IBO
+	if (vertex_buffer_data.size() <= 65536)
+	{
+		sHeader.eIndexType = GL_UNSIGNED_SHORT;
+		sHeader.uIndexSize = sizeof(GLushort);
+	}
+	else
+	{
+		sHeader.eIndexType = GL_UNSIGNED_INT;
+		sHeader.uIndexSize = sizeof(GLuint);
+	}
+
+	for (int j = 0; j < 3; j++)
+		sHeader.afMin[j] = sHeader.afMax[j] = vertex_buffer_data[0].pos[j];
+	for (size_t i = 1; i < vertex_buffer_data.size(); i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			if (vertex_buffer_data[i].pos[j] < sHeader.afMin[j])
+				sHeader.afMin[j] = vertex_buffer_data[i].pos[j];
+			if (vertex_buffer_data[i].pos[j] > sHeader.afMax[j])
+				sHeader.afMax[j] = vertex_buffer_data[i].pos[j];
+		}
+	}
+
+	sHeader.uVertexOffset = AlignOffset(sizeof(MeshFileHeader), 16);
+	sHeader.uIndexOffset = AlignOffset(sHeader.uVertexOffset + sHeader.uNumOfVertices * sHeader.uVertexStride, 16);
+
+	out_file.assign(sHeader.uIndexOffset + sHeader.uNumOfIndices * sHeader.uIndexSize, 0);
+	memcpy(&out_file[0], &sHeader, sizeof(MeshFileHeader));
+	memcpy(&out_file[sHeader.uVertexOffset], &vertex_buffer_data[0], sHeader.uNumOfVertices * sHeader.uVertexStride);
+	if (sHeader.eIndexType == GL_UNSIGNED_SHORT)
+	{
+		GLushort* pIndices = (GLushort*)&out_file[sHeader.uIndexOffset];
+		for (size_t i = 0; i < index_buffer_data.size(); i++)
+			pIndices[i] = (GLushort)index_buffer_data[i];
+	}
+	else
+		memcpy(&out_file[sHeader.uIndexOffset], &index_buffer_data[0], sHeader.uNumOfIndices * sizeof(GLuint));
+
+	return true;
+}
+
+/**
+ @brief Write the contents of a .mesh file to the disk
+ @param mesh_path A const char* variable which contains the file name of the .mesh file
+ @param file A const std::vector<char>& variable which contains the contents of the .mesh file
+ @return true if the file was written, else false
+ */
+bool WriteMeshFile(const char* mesh_path, const std::vector<char>& file)
+{
+	ofstream fileStream(mesh_path, ios::binary);
+	if (!fileStream.is_open())
+	{
+		cout << "WriteMeshFile(): Unable to write " << mesh_path << endl;
+		return false;
+	}
+	fileStream.write(&file[0], file.size());
+	return fileStream.good();
+}
+
+/**
+ @brief Check the header of a .mesh file, that the vertices and indices are all in it, and that every index points at a vertex
+ @param pData A const char* variable which contains the contents of the .mesh file
+ @param uSize A const size_t variable which contains the number of bytes in the .mesh file
+ @return The header of the .mesh file, or NULL if it is not a valid .mesh file for this version
+ */
+const MeshFileHeader* ValidateMeshFile(const char* pData, const size_t uSize)
+{
+	if ((pData == NULL) || (uSize < sizeof(MeshFileHeader)))
+		return NULL;
+
+	const MeshFileHeader* pHeader = (const MeshFileHeader*)pData;
+	if ((pHeader->uMagic != MESH_FILE_MAGIC) || (pHeader->uVersion != MESH_FILE_VERSION))
+		return NULL;
+	if ((pHeader->uNumOfAttributes == 0) || (pHeader->uNumOfAttributes > MESH_FILE_MAX_ATTRIBUTES))
+		return NULL;
+	if ((pHeader->uNumOfVertices == 0) || (pHeader->uNumOfIndices == 0))
+		return NULL;
+	if (!((pHeader->eIndexType == GL_UNSIGNED_SHORT) && (pHeader->uIndexSize == sizeof(GLushort))) &&
+		!((pHeader->eIndexType == GL_UNSIGNED_INT) && (pHeader->uIndexSize == sizeof(GLuint))))
+		return NULL;
+
+	for (unsigned int i = 0; i < pHeader->uNumOfAttributes; i++)
+	{
+		if (pHeader->sAttributes[i].uOffset + pHeader->sAttributes[i].uNumOfComponents * sizeof(float) > pHeader->uVertexStride)
+			return NULL;
+	}
+
+	// Use 64-bit sizes, so that a damaged header cannot overflow the checks
+	unsigned long long uVertexEnd = (unsigned long long)pHeader->uVertexOffset + (unsigned long long)pHeader->uNumOfVertices * pHeader->uVertexStride;
+	unsigned long long uIndexEnd = (unsigned long long)pHeader->uIndexOffset + (unsigned long long)pHeader->uNumOfIndices * pHeader->uIndexSize;
+	if ((pHeader->uVertexOffset < sizeof(MeshFileHeader)) || (uVertexEnd > uSize) ||
+		(pHeader->uIndexOffset < uVertexEnd) || (uIndexEnd > uSize) || (pHeader->uIndexOffset % pHeader->uIndexSize != 0))
+		return NULL;
+
+	// Every index must point at a vertex, else the draw would read past the end of the VBO
+	if (pHeader->eIndexType == GL_UNSIGNED_SHORT)
+	{
+		const GLushort* pIndices = (const GLushort*)(pData + pHeader->uIndexOffset);
+		for (unsigned int i = 0; i < pHeader->uNumOfIndices; i++)
+		{
+			if (pIndices[i] >= pHeader->uNumOfVertices)
+				return NULL;
+		}
+	}
+	else
+	{
+		const GLuint* pIndices = (const GLuint*)(pData + pHeader->uIndexOffset);
+		for (unsigned int i = 0; i < pHeader->uNumOfIndices; i++)
+		{
+			if (pIndices[i] >= pHeader->uNumOfVertices)
+				return NULL;
+		}
+	}
+
+	return pHeader;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// The tag and version of .mesh files. Increase the version when the layout of the file or of Vertex changes,
+// so that the files which were written before are imported again.
+const unsigned int MESH_FILE_MAGIC = 0x48534D44;	// "DMSH"
+const unsigned int MESH_FILE_VERSION = 1;
+// The largest number of vertex attributes in a .mesh file
+const unsigned int MESH_FILE_MAX_ATTRIBUTES = 4;
+
+// A vertex attribute in a .mesh file. The attributes are floats.
+struct MeshFileAttribute
+{
+	// The shader location
+	unsigned int uLocation;
+	// The number of floats
+	unsigned int uNumOfComponents;
+	// The offset from the start of the vertex, in bytes
+	unsigned int uOffset;
+};
+
+// The header at the start of a .mesh file. The interleaved vertices and the indices follow it, at the offsets which it gives.
+struct MeshFileHeader
+{
+	unsigned int uMagic;
+	unsigned int uVersion;
+
+	// The vertex layout
+	unsigned int uVertexStride;
+	unsigned int uNumOfAttributes;
+	MeshFileAttribute sAttributes[MESH_FILE_MAX_ATTRIBUTES];
+
+	unsigned int uNumOfVertices;
+	unsigned int uNumOfIndices;
+	// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	unsigned int eIndexType;
+	unsigned int uIndexSize;
+
+	// The bounding box of the vertices in model space
+	float afMin[3];
+	float afMax[3];
+	// The average cache miss ratio of the indices as they were read, and after they were optimised
+	float fACMRBefore;
+	float fACMRAfter;
+
+	// The offsets of the vertices and indices from the start of the file, in bytes
+	unsigned int uVertexOffset;
+	unsigned int uIndexOffset;
+};
+
+// Get the name of the .mesh file for an OBJ file
+std::string GetMeshFilename(const char* obj_path);
+
+// Check if the .mesh file is missing, or older than its OBJ file
+bool IsMeshFileStale(const char* obj_path, const char* mesh_path);
+
+// Read, index and optimise an OBJ file into the contents of a .mesh file
+bool ImportMeshFile(const char* obj_path, std::vector<char>& out_file);
+
+// Write the contents of a .mesh file to the disk
+bool WriteMeshFile(const char* mesh_path, const std::vector<char>& file);
+
+// Check the header of a .mesh file, that the vertices and indices are all in it, and that every index points at a vertex
+const MeshFileHeader* ValidateMeshFile(const char* pData, const size_t uSize);
@@ -0,0 +1,320 @@
+#include "MeshManager.h"
+
+// Include filesystem
+#include "filesystem.h"
+// Include GLDispatch
+#include "../RenderControl/GLDispatch.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+DecodedMesh::DecodedMesh(void)
+	: pHeader(NULL)
+	, pData(NULL)
+	, bImported(false)
+{
+}
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CMeshManager::CMeshManager(void)
+	: uNumOfHits(0)
+	, uNumOfMisses(0)
+	, uNumOfImports(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CMeshManager::~CMeshManager(void)
+{
+	// Delete the preloaded meshes and any meshes which were not released by their users
+	for (std::map<std::string, Mesh*>::iterator it = mapMeshes.begin(); it != mapMeshes.end(); ++it)
+	{
+		DeleteMesh(it->second);
+	}
+	mapMeshes.clear();
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CMeshManager::Init(void)
+{
+	uNumOfHits = 0;
+	uNumOfMisses = 0;
+	uNumOfImports = 0;
+	return true;
+}
+
+/**
+ @brief Get a shared mesh for an OBJ file, loading it if it is not in the registry yet.
+		Every successful call must be matched by a call to Release.
+ @param filename A const char* variable which contains the file name of the OBJ file
+ @return The shared mesh, or NULL if the OBJ file could not be loaded
+ */
+const Mesh* CMeshManager::Acquire(const char* filename)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+
+	// Return the cached mesh if this file was loaded before
+	std::map<std::string, Mesh*>::iterator it = mapMeshes.find(strPath);
+	if (it != mapMeshes.end())
+	{
+		it->second->iRefCount++;
+		uNumOfHits++;
+		return it->second;
+	}
+
+	uNumOfMisses++;
+
+	Mesh* cMesh = LoadMesh(filename);
+	if (cMesh == NULL)
+	{
+		cout << "CMeshManager::Acquire(): Unable to load " << filename << endl;
+		return NULL;
+	}
+
+	AddMesh(strPath, cMesh);
+
+	return cMesh;
+}
+
+/**
+ @brief Release a mesh which was returned by Acquire. The mesh is deleted when it has no more users.
+ @param cMesh A const Mesh* variable which contains the mesh to release
+ */
+void CMeshManager::Release(const Mesh* cMesh)
+{
+	if (cMesh == NULL)
+		return;
+
+	std::map<std::string, Mesh*>::iterator it = mapMeshes.find(cMesh->strPath);
+	if ((it == mapMeshes.end()) || (it->second != cMesh))
+		return;
+
+	it->second->iRefCount--;
+	if (it->second->iRefCount > 0)
+		return;
+
+	DeleteMesh(it->second);
+	mapMeshes.erase(it);
+}
+
+/**
+ @brief Load a mesh ahead of time and keep it until this class instance is destroyed,
+		so that entities which are spawned during the game do not parse the OBJ file
+ @param filename A const char* variable which contains the file name of the OBJ file
+ @return true if the mesh is loaded, else false
+ */
+bool CMeshManager::Preload(const char* filename)
+{
+	// The reference taken here is held by the registry itself
+	return (Acquire(filename) != NULL);
+}
+
+/**
+ @brief Read the .mesh file of an OBJ file. The OBJ file is imported into a .mesh file the first time,
+		and again whenever it changes. The .mesh file is mapped into memory, and its pages are touched so that
+		the disk is read on this thread rather than during the upload. A .mesh file which fails ValidateMeshFile,
+		e.g. as it was damaged or has an index past its vertices, is imported from the OBJ file again.
+		This makes no OpenGL calls and does not touch the registry, so it can be run on any thread.
+ @param filename A const char* variable which contains the file name of the OBJ file
+ @param sMesh A DecodedMesh& variable which returns the contents of the .mesh file
+ @return true if the mesh was read, else false
+ */
+bool CMeshManager::DecodeMesh(const char* filename, DecodedMesh& sMesh)
+{
+	std::string strMeshFile = GetMeshFilename(filename);
+	if ((IsMeshFileStale(filename, strMeshFile.c_str()) == false) && sMesh.cMappedFile.Open(strMeshFile.c_str()))
+	{
+		sMesh.pData = sMesh.cMappedFile.GetData();
+		sMesh.pHeader = ValidateMeshFile(sMesh.pData, sMesh.cMappedFile.GetSize());
+	}
+	if (sMesh.pHeader == NULL)
+	{
+		// Import the OBJ file, and save the .mesh file for the next run. The imported mesh is used even if it cannot be saved.
+		sMesh.cMappedFile.Close();
+		if (ImportMeshFile(filename, sMesh.vImportedFile) == false)
+			return false;
+		WriteMeshFile(strMeshFile.c_str(), sMesh.vImportedFile);
+		sMesh.pData = &sMesh.vImportedFile[0];
+		sMesh.pHeader = ValidateMeshFile(sMesh.pData, sMesh.vImportedFile.size());
+		sMesh.bImported = true;
+		return (sMesh.pHeader != NULL);
+	}
+
+	// Touch every page of the mapping
+	volatile char cTouched = 0;
+	for (size_t i = 0; i < sMesh.cMappedFile.GetSize(); i += 4096)
+		cTouched += sMesh.pData[i];
+
+	return true;
+}
+
+/**
+ @brief Upload a mesh which was read by DecodeMesh, and keep it until this class instance is destroyed like Preload.
+		Nothing is uploaded if the mesh is in the registry already.
+ @param filename A const char* variable which contains the file name of the OBJ file
+ @param sMesh A const DecodedMesh& variable which contains the contents of the .mesh file
+ @return true if the mesh is loaded, else false
+ */
+bool CMeshManager::PreloadDecoded(const char* filename, const DecodedMesh& sMesh)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+	if (mapMeshes.find(strPath) != mapMeshes.end())
+		return true;
+
+	Mesh* cMesh = UploadMesh(sMesh);
+	if (cMesh == NULL)
+	{
+		cout << "CMeshManager::PreloadDecoded(): Unable to load " << filename << endl;
+		return false;
+	}
+
+	// The reference taken here is held by the registry itself
+	AddMesh(strPath, cMesh);
+	return true;
+}
+
+/**
+ @brief Draw a mesh with the currently active shader
+ @param cMesh A const Mesh* variable which contains the mesh to draw
+ */
+void CMeshManager::Draw(const Mesh* cMesh) const
+{
+	if (cMesh == NULL)
+		return;
+
+	GL()->BindVertexArray(cMesh->VAO);
+	GL()->DrawElements(GL_TRIANGLES, cMesh->iIndexCount, cMesh->eIndexType, 0);
+	GL()->BindVertexArray(0);
+}
+
+/**
+ @brief Get the number of meshes in the registry
+ */
+unsigned int CMeshManager::GetNumOfMeshes(void) const
+{
+	return (unsigned int)mapMeshes.size();
+}
+
+/**
+ @brief Get the number of Acquire calls which were served from the registry
+ */
+unsigned int CMeshManager::GetNumOfHits(void) const
+{
+	return uNumOfHits;
+}
+
+/**
+ @brief Get the number of Acquire calls which had to load from file
+ */
+unsigned int CMeshManager::GetNumOfMisses(void) const
+{
+	return uNumOfMisses;
+}
+
+/**
+ @brief Print the registry statistics to the console
+ */
+void CMeshManager::PrintStats(void) const
+{
+	cout << "CMeshManager: " << mapMeshes.size() << " meshes, "
+		<< uNumOfHits << " hits, " << uNumOfMisses << " misses, "
+		<< uNumOfImports << " imported from OBJ" << endl;
+	for (std::map<std::string, Mesh*>::const_iterator it = mapMeshes.begin(); it != mapMeshes.end(); ++it)
+	{
+		cout << "\t" << it->first << ": " << it->second->uVertexCount << " vertices, "
+			<< it->second->iIndexCount << " indices, ACMR " << it->second->fACMRBefore << " -> "
+			<< it->second->fACMRAfter << ", " << it->second->iRefCount << " users" << endl;
+	}
+}
+
+/**
+ @brief Load an OBJ file into the graphics card, through its .mesh file
+ @param filename A const char* variable which contains the file name of the OBJ file
+ @return The new mesh, or NULL if the OBJ file could not be loaded
+ */
+Mesh* CMeshManager::LoadMesh(const char* filename)
+{
+	DecodedMesh sMesh;
+	if (DecodeMesh(filename, sMesh) == false)
+		return NULL;
+	return UploadMesh(sMesh);
+}
+
+/**
+ @brief Upload a mesh which was read by DecodeMesh into the graphics card,
+		straight from the mapped .mesh file or the imported contents
+ @param sMesh A const DecodedMesh& variable which contains the contents of the .mesh file
+ @return The new mesh
+ */
+Mesh* CMeshManager::UploadMesh(const DecodedMesh& sMesh)
+{
+	const MeshFileHeader* pHeader = sMesh.pHeader;
+	const char* pData = sMesh.pData;
+	if (sMesh.bImported)
+		uNumOfImports++;
+
+	Mesh* cMesh = new Mesh();
+	cMesh->fACMRBefore = pHeader->fACMRBefore;
+	cMesh->fACMRAfter = pHeader->fACMRAfter;
+	cMesh->iIndexCount = (GLsizei)pHeader->uNumOfIndices;
+	cMesh->eIndexType = pHeader->eIndexType;
+	cMesh->uVertexCount = pHeader->uNumOfVertices;
+	cMesh->vec3Min = glm::vec3(pHeader->afMin[0], pHeader->afMin[1], pHeader->afMin[2]);
+	cMesh->vec3Max = glm::vec3(pHeader->afMax[0], pHeader->afMax[1], pHeader->afMax[2]);
+
+	glGenVertexArrays(1, &cMesh->VAO);
+	GL()->BindVertexArray(cMesh->VAO);
+	glGenBuffers(1, &cMesh->VBO);
+	glGenBuffers(1, &cMesh->IBO);
+
+	GL()->BindBuffer(GL_ARRAY_BUFFER, cMesh->VBO);
+	GL()->BufferData(GL_ARRAY_BUFFER, (GLsizeiptr)pHeader->uNumOfVertices * pHeader->uVertexStride, pData + pHeader->uVertexOffset, GL_STATIC_DRAW);
+	GL()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, cMesh->IBO);
+	GL()->BufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)pHeader->uNumOfIndices * pHeader->uIndexSize, pData + pHeader->uIndexOffset, GL_STATIC_DRAW);
+
+	// The vertex attributes, as they are laid out in the .mesh file
+	for (unsigned int i = 0; i < pHeader->uNumOfAttributes; i++)
+	{
+		const MeshFileAttribute& sAttribute = pHeader->sAttributes[i];
+		glVertexAttribPointer(sAttribute.uLocation, sAttribute.uNumOfComponents, GL_FLOAT, GL_FALSE, pHeader->uVertexStride, (void*)(size_t)sAttribute.uOffset);
+		glEnableVertexAttribArray(sAttribute.uLocation);
+	}
+
+	GL()->BindVertexArray(0);
+
+	return cMesh;
+}
+
+/**
+ @brief Add a mesh to the registry, with one user
+ @param strPath A const std::string& variable which contains the canonical path of the OBJ file
+ @param cMesh A Mesh* variable which contains the mesh
+ */
+void CMeshManager::AddMesh(const std::string& strPath, Mesh* cMesh)
+{
+	cMesh->strPath = strPath;
+	cMesh->iRefCount = 1;
+	mapMeshes[strPath] = cMesh;
+}
+
+/**
+ @brief Delete a mesh from the graphics card
+ @param cMesh A Mesh* variable which contains the mesh to delete
+ */
+void CMeshManager::DeleteMesh(Mesh* cMesh)
+{
+	glDeleteVertexArrays(1, &cMesh->VAO);
+	glDeleteBuffers(1, &cMesh->VBO);
+	glDeleteBuffers(1, &cMesh->IBO);
+	delete cMesh;
+}
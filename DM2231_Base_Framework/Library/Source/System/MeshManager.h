@@ -0,0 +1,115 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include MeshFile
+#include "MeshFile.h"
+// Include MappedFile
+#include "MappedFile.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+// A mesh in the graphics card which is shared by all the entities which use the same OBJ file
+struct Mesh
+{
+	// The canonical path which this mesh was loaded from
+	std::string strPath;
+	// OpenGL objects
+	GLuint VAO, VBO, IBO;
+	// The number of indices in the IBO
+	GLsizei iIndexCount;
+	// The type of the indices in the IBO
+	GLenum eIndexType;
+	// The number of vertices in the VBO
+	unsigned int uVertexCount;
+	// The bounding box of the vertices in model space
+	glm::vec3 vec3Min, vec3Max;
+	// The average cache miss ratio of the indices as they were read, and after they were optimised
+	float fACMRBefore, fACMRAfter;
+	// The number of users of this mesh
+	int iRefCount;
+};
+
+// A .mesh file which was read, or imported from its OBJ file, and is ready to be uploaded into the graphics card
+struct DecodedMesh
+{
+	// The mapped .mesh file, or the imported contents if the .mesh file was missing or stale
+	CMappedFile cMappedFile;
+	std::vector<char> vImportedFile;
+	// The header and the contents, in whichever of the two above holds the file
+	const MeshFileHeader* pHeader;
+	const char* pData;
+	// true if the OBJ file had to be imported
+	bool bImported;
+
+	DecodedMesh(void);
+};
+
+class CMeshManager : public CSingletonTemplate<CMeshManager>
+{
+	friend CSingletonTemplate<CMeshManager>;
+public:
+	// Init
+	bool Init(void);
+
+	// Get a shared mesh for an OBJ file, loading it if it is not in the registry yet
+	const Mesh* Acquire(const char* filename);
+	// Release a mesh which was returned by Acquire
+	void Release(const Mesh* cMesh);
+
+	// Load a mesh ahead of time and keep it until this class instance is destroyed
+	bool Preload(const char* filename);
+
+	// Read the .mesh file of an OBJ file, importing it first if needed.
+	// This makes no OpenGL calls and does not touch the registry, so it can be run on any thread.
+	static bool DecodeMesh(const char* filename, DecodedMesh& sMesh);
+	// Upload a mesh which was read by DecodeMesh, and keep it until this class instance is destroyed like Preload
+	bool PreloadDecoded(const char* filename, const DecodedMesh& sMesh);
+
+	// Draw a mesh with the currently active shader
+	void Draw(const Mesh* cMesh) const;
+
+	// Get the number of meshes in the registry
+	unsigned int GetNumOfMeshes(void) const;
+	// Get the number of Acquire calls which were served from the registry
+	unsigned int GetNumOfHits(void) const;
+	// Get the number of Acquire calls which had to load from file
+	unsigned int GetNumOfMisses(void) const;
+
+	// Print the registry statistics to the console
+	void PrintStats(void) const;
+
+protected:
+	// Map of canonical paths to meshes
+	std::map<std::string, Mesh*> mapMeshes;
+
+	// Statistics
+	unsigned int uNumOfHits;
+	unsigned int uNumOfMisses;
+	// The number of meshes which had to be imported from their OBJ file, instead of loaded from their .mesh file
+	unsigned int uNumOfImports;
+
+	// Constructor
+	CMeshManager(void);
+
+	// Destructor
+	virtual ~CMeshManager(void);
+
+	// Load an OBJ file into the graphics card, through its .mesh file
+	Mesh* LoadMesh(const char* filename);
+	// Upload a mesh which was read by DecodeMesh into the graphics card
+	Mesh* UploadMesh(const DecodedMesh& sMesh);
+	// Add a mesh to the registry, with one user
+	void AddMesh(const std::string& strPath, Mesh* cMesh);
+	// Delete a mesh from the graphics card
+	void DeleteMesh(Mesh* cMesh);
+};
@@ -0,0 +1,375 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+// The size of the LRU cache which Forsyth's algorithm scores the vertices with
+static const int FORSYTH_CACHE_SIZE = 32;
+// The tuning values from Forsyth's "Linear-Speed Vertex Cache Optimisation"
+static const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+static const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+static const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+static const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+/**
+ @brief Get the score of a vertex, which is higher if it is near the front of the cache or has few triangles left to draw
+ @param iCachePosition A const int variable which contains the position of the vertex in the cache, or -1 if it is not in the cache
+ @param iNumOfTriangles A const int variable which contains the number of triangles left which use the vertex
+ @return The score of the vertex
+ */
+static float ForsythVertexScore(const int iCachePosition, const int iNumOfTriangles)
+{
+	// The vertex is not used by any more triangles
+	if (iNumOfTriangles == 0)
+		return -1.0f;
+
+	float fScore = 0.0f;
+	if (iCachePosition >= 0)
+	{
+		// The vertices of the last triangle get a fixed score, so that it does not matter which of them is used next
+		if (iCachePosition < 3)
+			fScore = FORSYTH_LAST_TRIANGLE_SCORE;
+		else
+		{
+			const float fScaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+			fScore = powf(1.0f - (iCachePosition - 3) * fScaler, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+
+	// Boost the vertices with few triangles left, so that they are finished off and not left behind
+	fScore += FORSYTH_VALENCE_BOOST_SCALE * powf((float)iNumOfTriangles, -FORSYTH_VALENCE_BOOST_POWER);
+	return fScore;
+}
+
+/**
+ @brief Check if a corner of a triangle uses the same vertex as an earlier corner of that triangle. A degenerate triangle,
+		such as (a, a, b), only counts once in the list of triangles of each of its vertices.
+ @param indices A const std::vector<unsigned>& variable which contains the triangle list
+ @param uCorner A const size_t variable which contains the index of the corner in the triangle list
+ @return true if the vertex was used by an earlier corner of the same triangle, else false
+ */
+static bool IsRepeatedCorner(const std::vector<unsigned>& indices, const size_t uCorner)
+{
+	const size_t uFirstCorner = uCorner - uCorner % 3;
+	for (size_t i = uFirstCorner; i < uCorner; ++i)
+	{
+		if (indices[i] == indices[uCorner])
+			return true;
+	}
+	return false;
+}
+
+/**
+ @brief Get the average cache miss ratio of a mesh with a FIFO post-transform cache
+ @param indices A const std::vector<unsigned>& variable which contains the triangle list
+ @param uNumOfVertices A const unsigned int variable which contains the number of vertices
+ @param uCacheSize A const unsigned int variable which contains the number of entries in the cache
+ @return The number of vertices which are transformed per triangle
+ */
+float ComputeACMR(const std::vector<unsigned>& indices, const unsigned int uNumOfVertices, const unsigned int uCacheSize)
+{
+	if (indices.size() < 3)
+		return 0.0f;
+
+	// The time at which each vertex entered the cache. A vertex is in the cache if it entered it
+	// less than uCacheSize misses ago, which is how a FIFO cache behaves.
+	std::vector<unsigned int> timestamps(uNumOfVertices, 0);
+	unsigned int uNumOfMisses = 0;
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		unsigned int& uTimestamp = timestamps[indices[i]];
+		if ((uTimestamp == 0) || (uNumOfMisses + 1 - uTimestamp > uCacheSize))
+		{
+			uNumOfMisses++;
+			uTimestamp = uNumOfMisses;
+		}
+	}
+	return (float)uNumOfMisses / (float)(indices.size() / 3);
+}
+
+/**
+ @brief Reorder the triangles so that their vertices are reused while they are still in the post-transform cache
+ @param indices A std::vector<unsigned>& variable which contains the triangle list to reorder
+ @param uNumOfVertices A const unsigned int variable which contains the number of vertices
+ */
+void OptimizeVertexCache(std::vector<unsigned>& indices, const unsigned int uNumOfVertices)
+{
+	const size_t uNumOfTriangles = indices.size() / 3;
+	if (uNumOfTriangles == 0)
+		return;
+
+	// The triangles which use each vertex, stored as one list with an offset for each vertex.
+	// A triangle which uses a vertex more than once is only in its list once.
+	std::vector<int> vertexNumOfTriangles(uNumOfVertices, 0);
+	for (size_t i = 0; i < uNumOfTriangles * 3; ++i)
+	{
+		if (!IsRepeatedCorner(indices, i))
+			vertexNumOfTriangles[indices[i]]++;
+	}
+	std::vector<int> vertexTriangleOffset(uNumOfVertices + 1, 0);
+	for (unsigned int i = 0; i < uNumOfVertices; ++i)
+		vertexTriangleOffset[i + 1] = vertexTriangleOffset[i] + vertexNumOfTriangles[i];
+	std::vector<int> vertexTriangles(uNumOfTriangles * 3);
+	std::vector<int> vertexFill(vertexTriangleOffset.begin(), vertexTriangleOffset.end() - 1);
+	for (size_t i = 0; i < uNumOfTriangles * 3; ++i)
+	{
+		if (!IsRepeatedCorner(indices, i))
+			vertexTriangles[vertexFill[indices[i]]++] = (int)(i / 3);
+	}
+
+	// The score of each vertex and triangle
+	std::vector<float> vertexScore(uNumOfVertices);
+	for (unsigned int i = 0; i < uNumOfVertices; ++i)
+		vertexScore[i] = ForsythVertexScore(-1, vertexNumOfTriangles[i]);
+	std::vector<float> triangleScore(uNumOfTriangles);
+	std::vector<bool> triangleAdded(uNumOfTriangles, false);
+	for (size_t i = 0; i < uNumOfTriangles; ++i)
+		triangleScore[i] = vertexScore[indices[i * 3]] + vertexScore[indices[i * 3 + 1]] + vertexScore[indices[i * 3 + 2]];
+
+	// The simulated LRU cache. It has room for the 3 vertices of the new triangle on top of the cache size.
+	std::vector<int> cache, newCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	std::vector<unsigned> newIndices;
+	newIndices.reserve(uNumOfTriangles * 3);
+
+	int iBestTriangle = -1;
+	// Triangles before this one were all added, so the search for a new starting triangle can begin here
+	size_t uNextUnadded = 0;
+	for (size_t uNumOfAdded = 0; uNumOfAdded < uNumOfTriangles; ++uNumOfAdded)
+	{
+		// If no triangle was found in the cache, start from the best triangle which is left
+		if (iBestTriangle < 0)
+		{
+			float fBestScore = -1.0f;
+			while (triangleAdded[uNextUnadded])
+				uNextUnadded++;
+			for (size_t i = uNextUnadded; i < uNumOfTriangles; ++i)
+			{
+				if (!triangleAdded[i] && (triangleScore[i] > fBestScore))
+				{
+					fBestScore = triangleScore[i];
+					iBestTriangle = (int)i;
+				}
+			}
+		}
+
+		// Add the triangle, and move its vertices to the front of the cache
+		triangleAdded[iBestTriangle] = true;
+		newCache.clear();
+		for (int j = 0; j < 3; ++j)
+		{
+			const unsigned int uVertex = indices[iBestTriangle * 3 + j];
+			newIndices.push_back(uVertex);
+			if (IsRepeatedCorner(indices, iBestTriangle * 3 + j))
+				continue;
+			newCache.push_back(uVertex);
+
+			// Remove the triangle from the vertex's list of triangles which are left
+			int* pBegin = &vertexTriangles[vertexTriangleOffset[uVertex]];
+			int* pEnd = pBegin + vertexNumOfTriangles[uVertex];
+			int* pFound = std::find(pBegin, pEnd, iBestTriangle);
+			*pFound = *(pEnd - 1);
+			vertexNumOfTriangles[uVertex]--;
+		}
+		const size_t uNumOfNew = newCache.size();
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			if (std::find(newCache.begin(), newCache.begin() + uNumOfNew, cache[i]) == newCache.begin() + uNumOfNew)
+				newCache.push_back(cache[i]);
+		}
+		cache.swap(newCache);
+
+		// Update the scores of the vertices in the cache, including the ones which just fell out of it
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			const int iCachePosition = (i < FORSYTH_CACHE_SIZE) ? (int)i : -1;
+			vertexScore[cache[i]] = ForsythVertexScore(iCachePosition, vertexNumOfTriangles[cache[i]]);
+		}
+
+		// Update the scores of the triangles which use these vertices, and find the best one to add next
+		iBestTriangle = -1;
+		float fBestScore = -1.0f;
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			const int iVertex = cache[i];
+			for (int k = 0; k < vertexNumOfTriangles[iVertex]; ++k)
+			{
+				const int iTriangle = vertexTriangles[vertexTriangleOffset[iVertex] + k];
+				triangleScore[iTriangle] =	vertexScore[indices[iTriangle * 3]] +
+											vertexScore[indices[iTriangle * 3 + 1]] +
+											vertexScore[indices[iTriangle * 3 + 2]];
+				if (triangleScore[iTriangle] > fBestScore)
+				{
+					fBestScore = triangleScore[iTriangle];
+					iBestTriangle = iTriangle;
+				}
+			}
+		}
+
+		// Drop the vertices which fell out of the cache
+		if (cache.size() > FORSYTH_CACHE_SIZE)
+			cache.resize(FORSYTH_CACHE_SIZE);
+	}
+
+	indices.swap(newIndices);
+}
+
+/**
+ @brief Reorder clusters of triangles so that the ones facing outwards are drawn first.
+		The clusters are split where the cache has to load all 3 vertices of a triangle,
+		so that reordering them does not lose much of the cache reuse (Tipsify's hard boundaries).
+ @param indices A std::vector<unsigned>& variable which contains the triangle list to reorder, which should be optimised for the vertex cache first
+ @param vertices A const std::vector<Vertex>& variable which contains the vertices
+ @param fThreshold A const float variable which contains the largest increase in ACMR which is accepted
+ */
+void OptimizeOverdraw(std::vector<unsigned>& indices, const std::vector<Vertex>& vertices, const float fThreshold)
+{
+	const size_t uNumOfTriangles = indices.size() / 3;
+	if (uNumOfTriangles < 2)
+		return;
+
+	// Find the triangles which start a cluster, with the same FIFO cache as ComputeACMR
+	std::vector<size_t> clusterStart;
+	std::vector<unsigned int> timestamps(vertices.size(), 0);
+	unsigned int uNumOfMisses = 0;
+	for (size_t i = 0; i < uNumOfTriangles; ++i)
+	{
+		int iNumOfTriangleMisses = 0;
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned int& uTimestamp = timestamps[indices[i * 3 + j]];
+			if ((uTimestamp == 0) || (uNumOfMisses + 1 - uTimestamp > VERTEX_CACHE_SIZE))
+			{
+				uNumOfMisses++;
+				uTimestamp = uNumOfMisses;
+				iNumOfTriangleMisses++;
+			}
+		}
+		if ((i == 0) || (iNumOfTriangleMisses == 3))
+			clusterStart.push_back(i);
+	}
+	if (clusterStart.size() < 2)
+		return;
+	clusterStart.push_back(uNumOfTriangles);
+
+	// The area weighted centre of the mesh, and the area weighted centre and normal of each cluster
+	const size_t uNumOfClusters = clusterStart.size() - 1;
+	std::vector<glm::vec3> clusterCentre(uNumOfClusters, glm::vec3(0.0f));
+	std::vector<glm::vec3> clusterNormal(uNumOfClusters, glm::vec3(0.0f));
+	glm::vec3 meshCentre(0.0f);
+	float fMeshArea = 0.0f;
+	for (size_t c = 0; c < uNumOfClusters; ++c)
+	{
+		float fClusterArea = 0.0f;
+		for (size_t i = clusterStart[c]; i < clusterStart[c + 1]; ++i)
+		{
+			const glm::vec3& p0 = vertices[indices[i * 3]].pos;
+			const glm::vec3& p1 = vertices[indices[i * 3 + 1]].pos;
+			const glm::vec3& p2 = vertices[indices[i * 3 + 2]].pos;
+			// The cross product's length is twice the area, which does not matter for weighting
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float fArea = glm::length(normal);
+			clusterCentre[c] += (p0 + p1 + p2) * (fArea / 3.0f);
+			clusterNormal[c] += normal;
+			fClusterArea += fArea;
+		}
+		meshCentre += clusterCentre[c];
+		fMeshArea += fClusterArea;
+		if (fClusterArea > 0.0f)
+			clusterCentre[c] /= fClusterArea;
+		float fNormalLength = glm::length(clusterNormal[c]);
+		if (fNormalLength > 0.0f)
+			clusterNormal[c] /= fNormalLength;
+	}
+	if (fMeshArea > 0.0f)
+		meshCentre /= fMeshArea;
+
+	// Sort the clusters so that the ones which face most directly away from the centre are drawn first.
+	// They are the ones most likely to be in front of the other clusters.
+	std::vector<float> clusterSortKey(uNumOfClusters);
+	std::vector<size_t> clusterOrder(uNumOfClusters);
+	for (size_t c = 0; c < uNumOfClusters; ++c)
+	{
+		clusterSortKey[c] = glm::dot(clusterCentre[c] - meshCentre, clusterNormal[c]);
+		clusterOrder[c] = c;
+	}
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+		[&clusterSortKey](size_t a, size_t b) { return clusterSortKey[a] > clusterSortKey[b]; });
+
+	std::vector<unsigned> newIndices;
+	newIndices.reserve(indices.size());
+	for (size_t c = 0; c < uNumOfClusters; ++c)
+	{
+		newIndices.insert(newIndices.end(),
+			indices.begin() + clusterStart[clusterOrder[c]] * 3,
+			indices.begin() + clusterStart[clusterOrder[c] + 1] * 3);
+	}
+
+	// Keep the new order only if it does not cost too much of the cache reuse
+	if (ComputeACMR(newIndices, (unsigned int)vertices.size()) <= ComputeACMR(indices, (unsigned int)vertices.size()) * fThreshold)
+		indices.swap(newIndices);
+}
+
+/**
+ @brief Reorder the vertices into the order which the triangles first use them in
+ @param indices A std::vector<unsigned>& variable which contains the triangle list, which is remapped to the new vertex order
+ @param vertices A std::vector<Vertex>& variable which contains the vertices to reorder. Vertices which are not used are removed.
+ */
+void OptimizeVertexFetch(std::vector<unsigned>& indices, std::vector<Vertex>& vertices)
+{
+	const unsigned int UNUSED_VERTEX = 0xFFFFFFFF;
+	std::vector<unsigned int> remap(vertices.size(), UNUSED_VERTEX);
+	std::vector<Vertex> newVertices;
+	newVertices.reserve(vertices.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		unsigned int& uNewIndex = remap[indices[i]];
+		if (uNewIndex == UNUSED_VERTEX)
+		{
+			uNewIndex = (unsigned int)newVertices.size();
+			newVertices.push_back(vertices[indices[i]]);
+		}
+		indices[i] = uNewIndex;
+	}
+	vertices.swap(newVertices);
+}
+
+/**
+ @brief Run the vertex cache, overdraw and vertex fetch optimisations on an indexed mesh
+ @param indices A std::vector<unsigned>& variable which contains the triangle list
+ @param vertices A std::vector<Vertex>& variable which contains the vertices
+ */
+void OptimizeMesh(std::vector<unsigned>& indices, std::vector<Vertex>& vertices)
+{
+	OptimizeVertexCache(indices, (unsigned int)vertices.size());
+	OptimizeOverdraw(indices, vertices);
+	OptimizeVertexFetch(indices, vertices);
+}
+
+/**
+ @brief Load, index and optimise an OBJ file, and print its ACMR before and after each step to the console
+ @param file_path A const char* variable which contains the file name of the OBJ file
+ */
+void ReportMeshOptimisation(const char* file_path)
+{
+	std::vector<glm::vec3> in_vertices, in_normals;
+	std::vector<glm::vec2> in_uvs;
+	if (LoadOBJ(file_path, in_vertices, in_uvs, in_normals) == false)
+		return;
+	std::vector<unsigned> indices;
+	std::vector<Vertex> vertices;
+	IndexVBO(in_vertices, in_uvs, in_normals, indices, vertices);
+
+	const unsigned int uNumOfVertices = (unsigned int)vertices.size();
+	cout << "ReportMeshOptimisation(): " << file_path << ", " << indices.size() / 3 << " triangles, "
+		<< uNumOfVertices << " vertices" << endl;
+	cout << "\tACMR as indexed: " << ComputeACMR(indices, uNumOfVertices) << endl;
+	OptimizeVertexCache(indices, uNumOfVertices);
+	cout << "\tACMR after vertex cache: " << ComputeACMR(indices, uNumOfVertices) << endl;
+	OptimizeOverdraw(indices, vertices);
+	cout << "\tACMR after overdraw: " << ComputeACMR(indices, uNumOfVertices) << endl;
+}
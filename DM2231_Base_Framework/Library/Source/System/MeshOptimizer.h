@@ -0,0 +1,29 @@
+#pragma once
+
+// Include LoadOBJ
+#include "LoadOBJ.h"
+
+#include <vector>
+
+// The number of entries in the FIFO post-transform cache which ComputeACMR simulates
+const unsigned int VERTEX_CACHE_SIZE = 16;
+
+// Get the average cache miss ratio, i.e. the number of vertices which are transformed per triangle.
+// It is 3.0 when no vertex is reused, and about 0.5 to 0.7 for a well ordered mesh.
+float ComputeACMR(const std::vector<unsigned>& indices, const unsigned int uNumOfVertices, const unsigned int uCacheSize = VERTEX_CACHE_SIZE);
+
+// Reorder the triangles so that their vertices are reused while they are still in the post-transform cache (Forsyth's algorithm)
+void OptimizeVertexCache(std::vector<unsigned>& indices, const unsigned int uNumOfVertices);
+
+// Reorder clusters of triangles so that the ones facing outwards are drawn first, which lets the depth test reject more pixels.
+// The new order is kept only if the ACMR does not rise above fThreshold times the ACMR of the current order.
+void OptimizeOverdraw(std::vector<unsigned>& indices, const std::vector<Vertex>& vertices, const float fThreshold = 1.05f);
+
+// Reorder the vertices into the order which the triangles first use them in, so that the vertex fetches are sequential
+void OptimizeVertexFetch(std::vector<unsigned>& indices, std::vector<Vertex>& vertices);
+
+// Run the three optimisations above on an indexed mesh
+void OptimizeMesh(std::vector<unsigned>& indices, std::vector<Vertex>& vertices);
+
+// Load, index and optimise an OBJ file, and print its ACMR before and after each step to the console
+void ReportMeshOptimisation(const char* file_path);
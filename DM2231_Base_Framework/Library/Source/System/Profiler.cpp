@@ -0,0 +1,390 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// The zones are not timed until the profiler is enabled
+std::atomic<bool> CProfiler::bIsEnabled(false);
+// No instance is numbered 0, so that it stands for none
+std::atomic<unsigned int> CProfiler::uNumOfInstances(0);
+
+// The weight of the last frame in the averages of the summary
+static const double SUMMARY_SMOOTHING = 0.05;
+
+/**
+ @brief Constructor
+ */
+CProfiler::CProfiler(void)
+	: uInstance(++uNumOfInstances)
+	, tEpoch(std::chrono::steady_clock::now())
+	, llFrameStart(0)
+	, dFrameTime(0.0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CProfiler::~CProfiler(void)
+{
+	bIsEnabled = false;
+
+	// The threads which recorded zones must have ended by now
+	lock_guard<mutex> lock(mtxThreadBuffers);
+	for (unsigned int i = 0; i < vThreadBuffers.size(); i++)
+		delete vThreadBuffers[i];
+	vThreadBuffers.clear();
+}
+
+/**
+ @brief Init
+ @return A bool value. true is this class instance was initialised, else false
+ */
+bool CProfiler::Init(void)
+{
+	tEpoch = std::chrono::steady_clock::now();
+	llFrameStart = 0;
+	dFrameTime = 0.0;
+	dqHistory.clear();
+	vFrameSamples.clear();
+	vSummary.clear();
+	SetThreadName("Main");
+	return true;
+}
+
+/**
+ @brief Enable or disable the profiler. The zones which started while it was enabled are still recorded.
+ @param bEnabled A const bool variable which is true if the zones are to be timed
+ */
+void CProfiler::SetEnabled(const bool bEnabled)
+{
+	bIsEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+/**
+ @brief Name the calling thread in the trace
+ @param pName A const char* variable which contains the name of the thread
+ */
+void CProfiler::SetThreadName(const char* pName)
+{
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+	lock_guard<mutex> lock(mtxThreadBuffers);
+	pBuffer->strName = pName;
+}
+
+/**
+ @brief Get a name which stays valid until the profiler is destroyed, for the names of zones which are not string literals
+ @param strName A const std::string& variable which contains the name
+ @return A const char* which points to the interned name
+ */
+const char* CProfiler::InternName(const std::string& strName)
+{
+	lock_guard<mutex> lock(mtxNames);
+	return setNames.insert(strName).first->c_str();
+}
+
+/**
+ @brief Get the time since Init
+ @return The time since Init, in nanoseconds
+ */
+long long CProfiler::GetTime(void) const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tEpoch).count();
+}
+
+/**
+ @brief Get the number of zones which enclose the current one on the calling thread
+ @return A reference to the depth of the calling thread
+ */
+int& CProfiler::GetDepth(void)
+{
+	static thread_local int iDepth = 0;
+	return iDepth;
+}
+
+/**
+ @brief Get the ring buffer of the calling thread. It is added the first time that the thread asks for it, which is the only time that a lock is taken.
+		The thread caches its buffer with the number of the instance which owns it, as the buffer is deleted with the instance,
+		so a new buffer is added if the profiler was destroyed and created again.
+ @return A ThreadBuffer* of the calling thread
+ */
+CProfiler::ThreadBuffer* CProfiler::GetThreadBuffer(void)
+{
+	static thread_local ThreadBuffer* pBuffer = NULL;
+	static thread_local unsigned int uBufferInstance = 0;
+	if ((pBuffer == NULL) || (uBufferInstance != uInstance))
+	{
+		uBufferInstance = uInstance;
+		pBuffer = new ThreadBuffer();
+		pBuffer->uWrite = 0;
+		pBuffer->uRead = 0;
+		pBuffer->uNumOfDropped = 0;
+
+		lock_guard<mutex> lock(mtxThreadBuffers);
+		pBuffer->uThread = (unsigned int)vThreadBuffers.size();
+		pBuffer->strName = "Thread " + to_string(pBuffer->uThread);
+		vThreadBuffers.push_back(pBuffer);
+	}
+	return pBuffer;
+}
+
+/**
+ @brief Record a zone which ended on the calling thread. If the ring buffer is full, the zone is dropped and counted.
+ @param pName A const char* variable which contains the name of the zone
+ @param llStart A const long long variable which contains the start of the zone, in nanoseconds since Init
+ @param llEnd A const long long variable which contains the end of the zone, in nanoseconds since Init
+ @param iDepth A const int variable which contains the number of zones which enclose this one
+ */
+void CProfiler::AddSample(const char* pName, const long long llStart, const long long llEnd, const int iDepth)
+{
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+
+	// Only this thread writes uWrite, so it is read relaxed. uRead is acquired so that the slot is not reused before it was read.
+	unsigned int uWrite = pBuffer->uWrite.load(std::memory_order_relaxed);
+	if (uWrite - pBuffer->uRead.load(std::memory_order_acquire) >= RING_SIZE)
+	{
+		pBuffer->uNumOfDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Sample& sSample = pBuffer->asSamples[uWrite & (RING_SIZE - 1)];
+	sSample.pName = pName;
+	sSample.llStart = llStart;
+	sSample.llEnd = llEnd;
+	sSample.iDepth = iDepth;
+	// Publish the zone to the main thread
+	pBuffer->uWrite.store(uWrite + 1, std::memory_order_release);
+}
+
+/**
+ @brief Record a zone which was timed on the GPU. It is shown on its own thread in the trace.
+ @param pName A const char* variable which contains the name of the zone
+ @param llStart A const long long variable which contains the time, in nanoseconds since Init, at which the zone was issued on the CPU
+ @param dTime A const double variable which contains the time which the GPU took, in milliseconds
+ */
+void CProfiler::AddGPUSample(const char* pName, const long long llStart, const double dTime)
+{
+	if (!IsEnabled())
+		return;
+
+	Sample sSample;
+	sSample.pName = pName;
+	sSample.llStart = llStart;
+	sSample.llEnd = llStart + (long long)(dTime * 1000000.0);
+	sSample.iDepth = 0;
+	Collect(sSample, GPU_THREAD);
+}
+
+/**
+ @brief Mark the start of a frame on the main thread
+ */
+void CProfiler::BeginFrame(void)
+{
+	llFrameStart = GetTime();
+}
+
+/**
+ @brief Mark the end of a frame on the main thread. The zones in the ring buffers of all the threads are collected into the history,
+		and the summary is updated.
+ */
+void CProfiler::EndFrame(void)
+{
+	if (!IsEnabled())
+	{
+		vFrameSamples.clear();
+		return;
+	}
+
+	// The frame encloses all the zones of the main thread
+	long long llFrameEnd = GetTime();
+	Sample sFrame;
+	sFrame.pName = "Frame";
+	sFrame.llStart = llFrameStart;
+	sFrame.llEnd = llFrameEnd;
+	sFrame.iDepth = -1;
+
+	{
+		lock_guard<mutex> lock(mtxThreadBuffers);
+		for (unsigned int i = 0; i < vThreadBuffers.size(); i++)
+		{
+			ThreadBuffer* pBuffer = vThreadBuffers[i];
+			unsigned int uRead = pBuffer->uRead.load(std::memory_order_relaxed);
+			unsigned int uWrite = pBuffer->uWrite.load(std::memory_order_acquire);
+			for (; uRead != uWrite; uRead++)
+				Collect(pBuffer->asSamples[uRead & (RING_SIZE - 1)], pBuffer->uThread);
+			// Free the slots for the writer
+			pBuffer->uRead.store(uRead, std::memory_order_release);
+
+			unsigned int uNumOfDropped = pBuffer->uNumOfDropped.exchange(0, std::memory_order_relaxed);
+			if (uNumOfDropped > 0)
+				cout << "CProfiler::EndFrame(): " << uNumOfDropped << " zones were dropped on " << pBuffer->strName << endl;
+		}
+	}
+	Collect(sFrame, 0);
+
+	dFrameTime += ((llFrameEnd - llFrameStart) / 1000000.0 - dFrameTime) * SUMMARY_SMOOTHING;
+	UpdateSummary();
+	vFrameSamples.clear();
+}
+
+/**
+ @brief Add a zone to the history, dropping the oldest zones when it is full. The zones of the main thread and the GPU are also kept for the summary.
+ @param sSample A const Sample& variable which contains the zone
+ @param uThread A const unsigned int variable which contains the thread which the zone ran on
+ */
+void CProfiler::Collect(const Sample& sSample, const unsigned int uThread)
+{
+	TraceEvent sEvent;
+	sEvent.sSample = sSample;
+	sEvent.uThread = uThread;
+
+	dqHistory.push_back(sEvent);
+	if (dqHistory.size() > MAX_HISTORY)
+		dqHistory.pop_front();
+
+	if (((uThread == 0) || (uThread == GPU_THREAD)) && (sSample.iDepth >= 0))
+		vFrameSamples.push_back(sEvent);
+}
+
+/**
+ @brief Update the summary with the zones of this frame. A zone is a line for each name and depth, which are kept in the order
+		that they first ran in, and the times are averaged over the last frames. A zone which did not run in this frame decays towards 0.
+ */
+void CProfiler::UpdateSummary(void)
+{
+	// The zones are recorded as they end, so sort them by their start to get the order which they ran in
+	stable_sort(vFrameSamples.begin(), vFrameSamples.end(),
+		[](const TraceEvent& a, const TraceEvent& b)
+		{
+			if (a.uThread != b.uThread)
+				return a.uThread < b.uThread;
+			return a.sSample.llStart < b.sSample.llStart;
+		});
+
+	// Sum the time of each line in this frame
+	vector<double> vTimes(vSummary.size(), 0.0);
+	for (unsigned int i = 0; i < vFrameSamples.size(); i++)
+	{
+		const Sample& sSample = vFrameSamples[i].sSample;
+		bool bGPU = (vFrameSamples[i].uThread == GPU_THREAD);
+		double dTime = (sSample.llEnd - sSample.llStart) / 1000000.0;
+
+		unsigned int uLine = 0;
+		while ((uLine < vSummary.size()) &&
+			((vSummary[uLine].pName != sSample.pName) || (vSummary[uLine].iDepth != sSample.iDepth) || (vSummary[uLine].bGPU != bGPU)))
+			uLine++;
+		if (uLine == vSummary.size())
+		{
+			SummaryLine sLine;
+			sLine.pName = sSample.pName;
+			sLine.iDepth = sSample.iDepth;
+			sLine.dTime = dTime;
+			sLine.dLastTime = 0.0;
+			sLine.bGPU = bGPU;
+			vSummary.push_back(sLine);
+			vTimes.push_back(0.0);
+		}
+		vTimes[uLine] += dTime;
+	}
+
+	for (unsigned int i = 0; i < vSummary.size(); i++)
+	{
+		vSummary[i].dLastTime = vTimes[i];
+		vSummary[i].dTime += (vTimes[i] - vSummary[i].dTime) * SUMMARY_SMOOTHING;
+	}
+}
+
+/**
+ @brief Get the summary of the main thread and the GPU
+ @return A const std::vector<SummaryLine>& of the lines, in the order that the zones first ran in
+ */
+const std::vector<CProfiler::SummaryLine>& CProfiler::GetSummary(void) const
+{
+	return vSummary;
+}
+
+/**
+ @brief Get the frame time, averaged over the last frames
+ @return The frame time, in milliseconds
+ */
+double CProfiler::GetFrameTime(void) const
+{
+	return dFrameTime;
+}
+
+/**
+ @brief Write a string as a JSON string, escaping the characters which JSON needs escaped
+ @param os A std::ostream& variable to write to
+ @param pString A const char* variable which contains the string
+ */
+static void WriteJSONString(std::ostream& os, const char* pString)
+{
+	os << '"';
+	for (const char* p = pString; *p; p++)
+	{
+		switch (*p)
+		{
+		case '"':	os << "\\\"";	break;
+		case '\\':	os << "\\\\";	break;
+		case '\n':	os << "\\n";	break;
+		case '\t':	os << "\\t";	break;
+		default:
+			if ((unsigned char)*p < 0x20)
+				os << ' ';
+			else
+				os << *p;
+			break;
+		}
+	}
+	os << '"';
+}
+
+/**
+ @brief Save the zones which are kept in the history as a Chrome trace JSON file, which can be opened in chrome://tracing or Perfetto
+ @param filename A const char* variable which contains the name of the file
+ @return A bool value. true if the file was saved, else false
+ */
+bool CProfiler::ExportChromeTrace(const char* filename) const
+{
+	ofstream ofs(filename);
+	if (!ofs.is_open())
+	{
+		cout << "CProfiler::ExportChromeTrace(): Unable to open " << filename << endl;
+		return false;
+	}
+
+	ofs << "{\"traceEvents\":[\n";
+	ofs.setf(ios::fixed);
+	ofs.precision(3);
+
+	// Name the threads
+	bool bFirst = true;
+	{
+		lock_guard<mutex> lock(const_cast<mutex&>(mtxThreadBuffers));
+		for (unsigned int i = 0; i < vThreadBuffers.size(); i++)
+		{
+			ofs << (bFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << vThreadBuffers[i]->uThread
+				<< ",\"args\":{\"name\":";
+			WriteJSONString(ofs, vThreadBuffers[i]->strName.c_str());
+			ofs << "}}";
+			bFirst = false;
+		}
+	}
+	ofs << (bFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPU_THREAD << ",\"args\":{\"name\":\"GPU\"}}";
+
+	// The zones are complete events, with their times in microseconds
+	for (deque<TraceEvent>::const_iterator it = dqHistory.begin(); it != dqHistory.end(); ++it)
+	{
+		ofs << ",\n{\"name\":";
+		WriteJSONString(ofs, it->sSample.pName);
+		ofs << ",\"ph\":\"X\",\"ts\":" << it->sSample.llStart / 1000.0
+			<< ",\"dur\":" << (it->sSample.llEnd - it->sSample.llStart) / 1000.0
+			<< ",\"pid\":1,\"tid\":" << it->uThread << "}";
+	}
+	ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	cout << "CProfiler::ExportChromeTrace(): Saved " << dqHistory.size() << " zones to " << filename << endl;
+	return true;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// Time the rest of the enclosing scope as a zone of the profiler. The name must be a string literal,
+// or a name from CProfiler::InternName. When the profiler is disabled, this only checks a flag.
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) CProfileScope PROFILE_CONCAT(cProfileScope, __LINE__)(name)
+
+// Records how long the zones of each frame take on every thread, and how long the render passes take on the GPU.
+// Each thread writes its zones into its own ring buffer without locking, and the main thread collects them at the end of each frame,
+// into a summary which can be drawn on the screen and into a history which can be saved as a Chrome trace (chrome://tracing).
+class CProfiler : public CSingletonTemplate<CProfiler>
+{
+	friend CSingletonTemplate<CProfiler>;
+public:
+	// A zone which was timed
+	struct Sample
+	{
+		const char* pName;
+		// The start and end of the zone, in nanoseconds since Init
+		long long llStart;
+		long long llEnd;
+		// The number of zones which enclose this one on its thread
+		int iDepth;
+	};
+
+	// A line of the summary of the main thread
+	struct SummaryLine
+	{
+		const char* pName;
+		int iDepth;
+		// The time spent in the zone per frame, averaged over the last frames, in milliseconds
+		double dTime;
+		// The time spent in the zone in the last frame, in milliseconds
+		double dLastTime;
+		// true if it was timed on the GPU
+		bool bGPU;
+	};
+
+	// Init
+	bool Init(void);
+
+	// Enable or disable the profiler
+	void SetEnabled(const bool bEnabled);
+	// Check if the profiler is enabled. This is checked by every zone, so it is inline.
+	static bool IsEnabled(void) { return bIsEnabled.load(std::memory_order_relaxed); }
+
+	// Name the calling thread in the trace
+	void SetThreadName(const char* pName);
+	// Get a name which stays valid until the profiler is destroyed, for names which are not string literals
+	const char* InternName(const std::string& strName);
+
+	// Mark the start and the end of a frame on the main thread. The zones of all the threads are collected at the end.
+	void BeginFrame(void);
+	void EndFrame(void);
+
+	// Record a zone which was timed on the GPU, which started on the CPU at llStart
+	void AddGPUSample(const char* pName, const long long llStart, const double dTime);
+
+	// Get the summary of the main thread and the GPU, averaged over the last frames
+	const std::vector<SummaryLine>& GetSummary(void) const;
+	// Get the frame time, averaged over the last frames, in milliseconds
+	double GetFrameTime(void) const;
+	// Save the zones which are kept in the history as a Chrome trace JSON file
+	bool ExportChromeTrace(const char* filename) const;
+
+	// Get the time since Init, in nanoseconds
+	long long GetTime(void) const;
+	// Record a zone which ended on the calling thread. This is called by CProfileScope.
+	void AddSample(const char* pName, const long long llStart, const long long llEnd, const int iDepth);
+	// Get the number of zones which enclose the current one on the calling thread
+	static int& GetDepth(void);
+
+protected:
+	// The number of zones in each ring buffer. It is a power of 2, so the indices wrap with a mask.
+	static const unsigned int RING_SIZE = 4096;
+	// The most zones which are kept in the history for the trace
+	static const unsigned int MAX_HISTORY = 200000;
+	// The thread number of the GPU in the trace
+	static const unsigned int GPU_THREAD = 1000;
+
+	// The ring buffer of a thread. Only that thread writes to it, and only the main thread reads from it.
+	struct ThreadBuffer
+	{
+		Sample asSamples[RING_SIZE];
+		std::atomic<unsigned int> uWrite;
+		std::atomic<unsigned int> uRead;
+		// The zones which were dropped as the buffer was full
+		std::atomic<unsigned int> uNumOfDropped;
+		unsigned int uThread;
+		std::string strName;
+	};
+
+	// A zone in the history, with the thread it ran on
+	struct TraceEvent
+	{
+		Sample sSample;
+		unsigned int uThread;
+	};
+
+	// Flag to indicate if the zones are timed
+	static std::atomic<bool> bIsEnabled;
+	// The number of instances which were created. Each instance is numbered, so that a thread can tell if
+	// the ring buffer which it cached belongs to an instance which was destroyed.
+	static std::atomic<unsigned int> uNumOfInstances;
+	unsigned int uInstance;
+
+	// The time at which Init was called
+	std::chrono::steady_clock::time_point tEpoch;
+
+	// The ring buffers of the threads, which are added the first time each thread records a zone
+	std::vector<ThreadBuffer*> vThreadBuffers;
+	std::mutex mtxThreadBuffers;
+	// The names from InternName
+	std::set<std::string> setNames;
+	std::mutex mtxNames;
+
+	// The zones which were collected, for the trace
+	std::deque<TraceEvent> dqHistory;
+	// The zones of the main thread and the GPU in the last frame
+	std::vector<TraceEvent> vFrameSamples;
+	// The summary of the main thread and the GPU
+	std::vector<SummaryLine> vSummary;
+	// The start of the frame, and the frame time which is averaged over the last frames
+	long long llFrameStart;
+	double dFrameTime;
+
+	// Constructor
+	CProfiler(void);
+
+	// Destructor
+	virtual ~CProfiler(void);
+
+	// Get the ring buffer of the calling thread, adding it if needed
+	ThreadBuffer* GetThreadBuffer(void);
+	// Add a zone to the history and to the zones of this frame
+	void Collect(const Sample& sSample, const unsigned int uThread);
+	// Update the summary with the zones of this frame
+	void UpdateSummary(void);
+};
+
+// Times the scope which it is declared in, from its constructor to its destructor
+class CProfileScope
+{
+public:
+	// Constructor
+	CProfileScope(const char* pName)
+		: pName(NULL)
+	{
+		if (CProfiler::IsEnabled())
+		{
+			this->pName = pName;
+			llStart = CProfiler::GetInstance()->GetTime();
+			CProfiler::GetDepth()++;
+		}
+	}
+
+	// Destructor
+	~CProfileScope(void)
+	{
+		if (pName)
+		{
+			int& iDepth = CProfiler::GetDepth();
+			iDepth--;
+			CProfiler::GetInstance()->AddSample(pName, llStart, CProfiler::GetInstance()->GetTime(), iDepth);
+		}
+	}
+
+protected:
+	// The name of the zone, or NULL if the profiler was disabled when the zone started
+	const char* pName;
+	// The start of the zone, in nanoseconds since CProfiler::Init
+	long long llStart;
+};
@@ -0,0 +1,326 @@
+#include "TextureManager.h"
+
+// Include filesystem
+#include "filesystem.h"
+// Include GLDispatch
+#include "../RenderControl/GLDispatch.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+DecodedTexture::DecodedTexture(void)
+	: bCompressed(false)
+	, iWidth(0)
+	, iHeight(0)
+	, iNumOfChannels(0)
+	, pTexels(NULL)
+{
+}
+
+/**
+ @brief Destructor
+ */
+DecodedTexture::~DecodedTexture(void)
+{
+	// Free up the memory of the file data read in
+	if (pTexels)
+		free(pTexels);
+}
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CTextureManager::CTextureManager(void)
+	: uBytesResident(0)
+	, uNumOfHits(0)
+	, uNumOfMisses(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CTextureManager::~CTextureManager(void)
+{
+	// Delete any textures which were not released by their users
+	for (std::map<GLuint, TextureInfo>::iterator it = mapTextureInfo.begin(); it != mapTextureInfo.end(); ++it)
+	{
+		glDeleteTextures(1, &(it->first));
+	}
+	mapTextureInfo.clear();
+	mapPathToTextureID.clear();
+	uBytesResident = 0;
+}
+
+/**
+ @brief Init Initialise this instance
+ @return true if the initialisation is successful, else false
+ */
+bool CTextureManager::Init(void)
+{
+	uNumOfHits = 0;
+	uNumOfMisses = 0;
+	return true;
+}
+
+/**
+ @brief Get a shared texture for a file, loading it if it is not in the cache yet.
+		Every successful call must be matched by a call to Release.
+ @param filename A const char* variable which contains the file name of the texture
+ @return The OpenGL texture ID, or 0 if the texture could not be loaded
+ */
+GLuint CTextureManager::Acquire(const char* filename)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+
+	// Return the cached texture if this file was loaded before
+	std::map<std::string, GLuint>::iterator it = mapPathToTextureID.find(strPath);
+	if (it != mapPathToTextureID.end())
+	{
+		mapTextureInfo[it->second].iRefCount++;
+		uNumOfHits++;
+		return it->second;
+	}
+
+	uNumOfMisses++;
+
+	size_t uBytes = 0;
+	GLuint iTextureID = LoadTexture(filename, uBytes);
+	if (iTextureID == 0)
+	{
+		cout << "CTextureManager::Acquire(): Unable to load " << filename << endl;
+		return 0;
+	}
+
+	AddTexture(strPath, iTextureID, uBytes);
+
+	return iTextureID;
+}
+
+/**
+ @brief Release a texture which was returned by Acquire. The texture is deleted when it has no more users.
+		Texture IDs which were not created by this class are ignored.
+ @param iTextureID A const GLuint variable which contains the OpenGL texture ID
+ */
+void CTextureManager::Release(const GLuint iTextureID)
+{
+	std::map<GLuint, TextureInfo>::iterator it = mapTextureInfo.find(iTextureID);
+	if (it == mapTextureInfo.end())
+		return;
+
+	it->second.iRefCount--;
+	if (it->second.iRefCount > 0)
+		return;
+
+	glDeleteTextures(1, &iTextureID);
+	uBytesResident -= it->second.uBytes;
+	mapPathToTextureID.erase(it->second.strPath);
+	mapTextureInfo.erase(it);
+}
+
+/**
+ @brief Load a texture ahead of time and keep it until this class instance is destroyed,
+		so that entities which are spawned during the game do not decode the image
+ @param filename A const char* variable which contains the file name of the texture
+ @return true if the texture is loaded, else false
+ */
+bool CTextureManager::Preload(const char* filename)
+{
+	// The reference taken here is held by the cache itself
+	return (Acquire(filename) != 0);
+}
+
+/**
+ @brief Read an image from file. The DXT compressed copy of the file is read if there is an up-to-date one;
+		if not, it is made from the file first. The file itself is decoded if the graphics card cannot read DXT textures.
+		This makes no OpenGL calls and does not touch the cache, so it can be run on any thread.
+ @param filename A const char* variable which contains the file name of the texture
+ @param sTexture A DecodedTexture& variable which returns the compressed image or the decoded texels
+ @return true if the image was read, else false
+ */
+bool CTextureManager::DecodeTexture(const char* filename, DecodedTexture& sTexture)
+{
+	CImageLoader* cImageLoader = CImageLoader::GetInstance();
+
+	if (cImageLoader->IsCompressionSupported())
+	{
+		if ((cImageLoader->ReadCompressed(filename, true, sTexture.sCompressedImage))
+			|| ((cImageLoader->Compress(filename, true, true))
+				&& (cImageLoader->ReadCompressed(filename, true, sTexture.sCompressedImage))))
+		{
+			sTexture.bCompressed = true;
+			return true;
+		}
+	}
+
+	sTexture.bCompressed = false;
+	sTexture.pTexels = cImageLoader->Load(filename, sTexture.iWidth, sTexture.iHeight, sTexture.iNumOfChannels, true);
+	if (!sTexture.pTexels)
+		return false;
+
+	if ((sTexture.iNumOfChannels != 3) && (sTexture.iNumOfChannels != 4))
+	{
+		cout << "CTextureManager::DecodeTexture(): Unsupported number of channels (" << sTexture.iNumOfChannels << ") in " << filename << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Upload an image which was read by DecodeTexture, and keep it until this class instance is destroyed like Preload.
+		Nothing is uploaded if the texture is in the cache already.
+ @param filename A const char* variable which contains the file name of the texture
+ @param sTexture A DecodedTexture& variable which contains the image
+ @return true if the texture is loaded, else false
+ */
+bool CTextureManager::PreloadDecoded(const char* filename, DecodedTexture& sTexture)
+{
+	string strPath = FileSystem::getCanonicalPath(filename);
+	if (mapPathToTextureID.find(strPath) != mapPathToTextureID.end())
+		return true;
+
+	size_t uBytes = 0;
+	GLuint iTextureID = UploadTexture(filename, sTexture, uBytes);
+	if (iTextureID == 0)
+	{
+		cout << "CTextureManager::PreloadDecoded(): Unable to load " << filename << endl;
+		return false;
+	}
+
+	// The reference taken here is held by the cache itself
+	AddTexture(strPath, iTextureID, uBytes);
+	return true;
+}
+
+/**
+ @brief Get the number of textures in the cache
+ */
+unsigned int CTextureManager::GetNumOfTextures(void) const
+{
+	return (unsigned int)mapTextureInfo.size();
+}
+
+/**
+ @brief Get the number of bytes of texture memory held by the cache
+ */
+size_t CTextureManager::GetBytesResident(void) const
+{
+	return uBytesResident;
+}
+
+/**
+ @brief Get the number of Acquire calls which were served from the cache
+ */
+unsigned int CTextureManager::GetNumOfHits(void) const
+{
+	return uNumOfHits;
+}
+
+/**
+ @brief Get the number of Acquire calls which had to load from file
+ */
+unsigned int CTextureManager::GetNumOfMisses(void) const
+{
+	return uNumOfMisses;
+}
+
+/**
+ @brief Print the cache statistics to the console
+ */
+void CTextureManager::PrintStats(void) const
+{
+	cout << "CTextureManager: " << mapTextureInfo.size() << " textures, "
+		<< (uBytesResident / 1024) << " KB resident, "
+		<< uNumOfHits << " hits, " << uNumOfMisses << " misses" << endl;
+	for (std::map<GLuint, TextureInfo>::const_iterator it = mapTextureInfo.begin(); it != mapTextureInfo.end(); ++it)
+	{
+		cout << "\t" << it->second.strPath << " (ID " << it->first << "): "
+			<< it->second.iRefCount << " users, " << (it->second.uBytes / 1024) << " KB" << endl;
+	}
+}
+
+/**
+ @brief Load a texture from file into OpenGL
+ @param filename A const char* variable which contains the file name of the texture
+ @param uBytes A size_t& variable which returns the estimated GPU memory used by the texture
+ @return The OpenGL texture ID, or 0 if the texture could not be loaded
+ */
+GLuint CTextureManager::LoadTexture(const char* filename, size_t& uBytes)
+{
+	DecodedTexture sTexture;
+	if (DecodeTexture(filename, sTexture) == false)
+		return 0;
+	return UploadTexture(filename, sTexture, uBytes);
+}
+
+/**
+ @brief Upload an image which was read by DecodeTexture into a new texture.
+		The DXT compressed copy brings its own mipmap chain; the decoded texels have theirs generated by the driver.
+ @param filename A const char* variable which contains the file name of the texture
+ @param sTexture A DecodedTexture& variable which contains the image
+ @param uBytes A size_t& variable which returns the estimated GPU memory used by the texture
+ @return The OpenGL texture ID, or 0 if the texture could not be uploaded
+ */
+GLuint CTextureManager::UploadTexture(const char* filename, DecodedTexture& sTexture, size_t& uBytes)
+{
+	CImageLoader* cImageLoader = CImageLoader::GetInstance();
+
+	// Texture ID
+	GLuint iTextureID = 0;
+	glGenTextures(1, &iTextureID);
+	GL()->BindTexture(GL_TEXTURE_2D, iTextureID);
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	if (sTexture.bCompressed)
+	{
+		int iNumOfLevels = 0;
+		if (cImageLoader->UploadCompressed(sTexture.sCompressedImage, GL_TEXTURE_2D, iNumOfLevels, uBytes) == false)
+		{
+			cout << "CTextureManager::UploadTexture(): Unable to upload " << filename << endl;
+			glDeleteTextures(1, &iTextureID);
+			return 0;
+		}
+		// The mipmap chain came from the file, so tell OpenGL where it ends
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, iNumOfLevels - 1);
+		return iTextureID;
+	}
+
+	if (sTexture.iNumOfChannels == 3)
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, sTexture.iWidth, sTexture.iHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, sTexture.pTexels);
+	else
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, sTexture.iWidth, sTexture.iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, sTexture.pTexels);
+
+	// Generate mipmaps
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	// The drivers pad RGB to 4 bytes per texel; the mipmap chain adds about a third
+	uBytes = (size_t)sTexture.iWidth * (size_t)sTexture.iHeight * 4;
+	uBytes += uBytes / 3;
+
+	return iTextureID;
+}
+
+/**
+ @brief Add a texture to the cache, with one user
+ @param strPath A const std::string& variable which contains the canonical path of the texture
+ @param iTextureID A const GLuint variable which contains the OpenGL texture ID
+ @param uBytes A const size_t variable which contains the estimated GPU memory used by the texture
+ */
+void CTextureManager::AddTexture(const std::string& strPath, const GLuint iTextureID, const size_t uBytes)
+{
+	TextureInfo sTextureInfo;
+	sTextureInfo.strPath = strPath;
+	sTextureInfo.iRefCount = 1;
+	sTextureInfo.uBytes = uBytes;
+	mapTextureInfo[iTextureID] = sTextureInfo;
+	mapPathToTextureID[strPath] = iTextureID;
+	uBytesResident += uBytes;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#include <GL/glew.h>
+
+// Include ImageLoader
+#include "ImageLoader.h"
+
+#include <string>
+#include <map>
+
+// An image which was read from file, and is ready to be uploaded into a texture
+struct DecodedTexture
+{
+	// true if the DXT compressed copy was read, else the texels were decoded
+	bool bCompressed;
+	CompressedImage sCompressedImage;
+	// The decoded texels, which are freed by the destructor
+	int iWidth, iHeight, iNumOfChannels;
+	unsigned char* pTexels;
+
+	DecodedTexture(void);
+	~DecodedTexture(void);
+
+private:
+	// The texels would be freed twice if this was copied
+	DecodedTexture(const DecodedTexture&);
+	DecodedTexture& operator=(const DecodedTexture&);
+};
+
+class CTextureManager : public CSingletonTemplate<CTextureManager>
+{
+	friend CSingletonTemplate<CTextureManager>;
+public:
+	// Init
+	bool Init(void);
+
+	// Get a shared texture for a file, loading it if it is not in the cache yet
+	GLuint Acquire(const char* filename);
+	// Release a texture which was returned by Acquire
+	void Release(const GLuint iTextureID);
+
+	// Load a texture ahead of time and keep it until this class instance is destroyed
+	bool Preload(const char* filename);
+
+	// Read an image from file, through its compressed copy if the graphics card can read it.
+	// This makes no OpenGL calls and does not touch the cache, so it can be run on any thread.
+	static bool DecodeTexture(const char* filename, DecodedTexture& sTexture);
+	// Upload an image which was read by DecodeTexture, and keep it until this class instance is destroyed like Preload
+	bool PreloadDecoded(const char* filename, DecodedTexture& sTexture);
+
+	// Get the number of textures in the cache
+	unsigned int GetNumOfTextures(void) const;
+	// Get the number of bytes of texture memory held by the cache
+	size_t GetBytesResident(void) const;
+	// Get the number of Acquire calls which were served from the cache
+	unsigned int GetNumOfHits(void) const;
+	// Get the number of Acquire calls which had to load from file
+	unsigned int GetNumOfMisses(void) const;
+
+	// Print the cache statistics to the console
+	void PrintStats(void) const;
+
+protected:
+	// A texture which is shared by one or more users
+	struct TextureInfo
+	{
+		// The canonical path which this texture was loaded from
+		std::string strPath;
+		// The number of users of this texture
+		int iRefCount;
+		// The estimated GPU memory used by this texture, including mipmaps
+		size_t uBytes;
+	};
+
+	// Map of canonical paths to texture IDs
+	std::map<std::string, GLuint> mapPathToTextureID;
+	// Map of texture IDs to their information
+	std::map<GLuint, TextureInfo> mapTextureInfo;
+
+	// Statistics
+	size_t uBytesResident;
+	unsigned int uNumOfHits;
+	unsigned int uNumOfMisses;
+
+	// Constructor
+	CTextureManager(void);
+
+	// Destructor
+	virtual ~CTextureManager(void);
+
+	// Load a texture from file into OpenGL
+	GLuint LoadTexture(const char* filename, size_t& uBytes);
+	// Upload an image which was read by DecodeTexture into a new texture
+	GLuint UploadTexture(const char* filename, DecodedTexture& sTexture, size_t& uBytes);
+	// Add a texture to the cache, with one user
+	void AddTexture(const std::string& strPath, const GLuint iTextureID, const size_t uBytes);
+};
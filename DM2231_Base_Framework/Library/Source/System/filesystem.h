@@ -5,6 +5,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cctype>
 #include <cstdlib>
 #include "../GameControl/Settings.h"
 
@@ -28,12 +30,46 @@ public:
 		return (*pathBuilder)(path);
 	}
 
+	// Get a canonical form of a relative path, for use as a cache key.
+	// Separators are unified, "." and ".." segments are resolved and the path is
+	// lower-cased, so "Image//enemy2.tga" and "Image\\Enemy2.tga" give the same key.
+	static std::string getCanonicalPath(const std::string& path)
+	{
+		std::vector<std::string> vSegments;
+		std::string strSegment;
+		for (size_t i = 0; i <= path.size(); ++i)
+		{
+			char c = (i < path.size()) ? path[i] : '\0';
+			if ((c == '/') || (c == '\\') || (c == '\0'))
+			{
+				if ((strSegment == "..") && (vSegments.size() > 0) && (vSegments.back() != ".."))
+					vSegments.pop_back();
+				else if ((strSegment.size() > 0) && (strSegment != "."))
+					vSegments.push_back(strSegment);
+				strSegment.clear();
+			}
+			else
+			{
+				strSegment += (char)tolower((unsigned char)c);
+			}
+		}
+
+		std::string strPath;
+		for (size_t i = 0; i < vSegments.size(); ++i)
+		{
+			if (i > 0)
+				strPath += '/';
+			strPath += vSegments[i];
+		}
+		return strPath;
+	}
+
 private:
 	static std::string const & getRoot()
 	{
 		char buff[FILENAME_MAX]; //create string buffer to hold path
 		GetCurrentDir(buff, FILENAME_MAX);
-		string current_working_dir(buff);
+		std::string current_working_dir(buff);
 
 		static char const * envRoot = current_working_dir.c_str();	// getenv("LOGL_ROOT_PATH");
 		static char const * givenRoot = (envRoot != nullptr ? envRoot : CSettings::GetInstance()->logl_root);
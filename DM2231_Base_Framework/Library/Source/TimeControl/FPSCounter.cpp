@@ -1,5 +1,9 @@
 #include "FPSCounter.h"
+// Include Profiler
+#include "../System/Profiler.h"
+
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 CFPSCounter::CFPSCounter()
@@ -7,6 +11,14 @@ CFPSCounter::CFPSCounter()
 	, nFrames(0)
 	, iFrameRate(0)
 	, dFrameTime(0.0)
+	, uNumOfFrames(0)
+	, dPercentile50(0.0)
+	, dPercentile95(0.0)
+	, dPercentile99(0.0)
+	, dMaxFrameTime(0.0)
+	, dHitchFactor(2.0)
+	, dMinHitchTime(20.0)
+	, uNumOfHitches(0)
 {
 	Init();
 }
@@ -24,6 +36,17 @@ void CFPSCounter::Init(void)
 	nFrames = 0;
 	iFrameRate = 0;
 	dFrameTime = 60;
+
+	vFrameTimes.assign(WINDOW_SIZE, 0.0);
+	vIsHitch.assign(WINDOW_SIZE, false);
+	uNumOfFrames = 0;
+	vHistogram.assign(NUM_HISTOGRAM_BINS, 0);
+	dPercentile50 = 0.0;
+	dPercentile95 = 0.0;
+	dPercentile99 = 0.0;
+	dMaxFrameTime = 0.0;
+	dqHitches.clear();
+	uNumOfHitches = 0;
 }
 
 // Update the class instance
@@ -35,6 +58,21 @@ void CFPSCounter::Update(const double deltaTime)
 	// Update the frame count
 	nFrames++;
 
+	// Put the frame time into the ring and the histogram, in place of the oldest one
+	double dTime = deltaTime * 1000.0;
+	unsigned int uIndex = uNumOfFrames % WINDOW_SIZE;
+	if (uNumOfFrames >= WINDOW_SIZE)
+		vHistogram[GetHistogramBin(vFrameTimes[uIndex])]--;
+	vFrameTimes[uIndex] = dTime;
+	vHistogram[GetHistogramBin(dTime)]++;
+
+	// A hitch takes much longer than the median frame, which was worked out before this frame
+	double dHitchTime = dHitchFactor * dPercentile50;
+	vIsHitch[uIndex] = (dTime > ((dHitchTime > dMinHitchTime) ? dHitchTime : dMinHitchTime));
+	if (vIsHitch[uIndex])
+		RecordHitch(dTime);
+	uNumOfFrames++;
+
 	if (dElapsedTime >= 1.0){ // If last update was more than 1 sec ago...
 		// Calculate the current frame rate
 		dFrameTime = 1000.0 / double(nFrames);
@@ -45,6 +83,8 @@ void CFPSCounter::Update(const double deltaTime)
 		// Reset timer and update the lastTime
 		nFrames = 0;
 		dElapsedTime = 0.0;
+
+		UpdatePercentiles();
 	}
 }
 
@@ -65,3 +105,133 @@ double CFPSCounter::GetFrameTime(void) const
 {
 	return dFrameTime;
 }
+
+// Set when a frame is a hitch: when it takes longer than dFactor times the median frame time, and longer than dMinTime milliseconds
+void CFPSCounter::SetHitchThreshold(const double dFactor, const double dMinTime)
+{
+	dHitchFactor = dFactor;
+	dMinHitchTime = dMinTime;
+}
+
+// Get the median frame time of the last frames, in milliseconds
+double CFPSCounter::GetPercentile50(void) const
+{
+	return dPercentile50;
+}
+
+// Get the frame time which 95% of the last frames were shorter than, in milliseconds
+double CFPSCounter::GetPercentile95(void) const
+{
+	return dPercentile95;
+}
+
+// Get the frame time which 99% of the last frames were shorter than, in milliseconds
+double CFPSCounter::GetPercentile99(void) const
+{
+	return dPercentile99;
+}
+
+// Get the longest frame time of the last frames, in milliseconds
+double CFPSCounter::GetMaxFrameTime(void) const
+{
+	return dMaxFrameTime;
+}
+
+// Get the number of frames in each bin of the histogram of the last frames
+const std::vector<int>& CFPSCounter::GetHistogram(void) const
+{
+	return vHistogram;
+}
+
+// Get the frame times of the last frames from the oldest, in milliseconds, and if each of them was a hitch
+void CFPSCounter::GetFrameTimes(std::vector<double>& vFrameTimes, std::vector<bool>& vHitches) const
+{
+	vFrameTimes.clear();
+	vHitches.clear();
+	unsigned int uFirst = (uNumOfFrames > WINDOW_SIZE) ? uNumOfFrames - WINDOW_SIZE : 0;
+	for (unsigned int i = uFirst; i < uNumOfFrames; i++)
+	{
+		vFrameTimes.push_back(this->vFrameTimes[i % WINDOW_SIZE]);
+		vHitches.push_back(vIsHitch[i % WINDOW_SIZE]);
+	}
+}
+
+// Get the number of the last frame since Init
+unsigned int CFPSCounter::GetNumOfFrames(void) const
+{
+	return uNumOfFrames;
+}
+
+// Get the hitches which were recorded, from the oldest
+const std::deque<CFPSCounter::Hitch>& CFPSCounter::GetHitches(void) const
+{
+	return dqHitches;
+}
+
+// Get the number of hitches since Init
+unsigned int CFPSCounter::GetNumOfHitches(void) const
+{
+	return uNumOfHitches;
+}
+
+// Get the bin of the histogram for a frame time, in milliseconds
+unsigned int CFPSCounter::GetHistogramBin(const double dTime) const
+{
+	unsigned int uBin = (unsigned int)(dTime / HISTOGRAM_BIN_WIDTH);
+	return (uBin < NUM_HISTOGRAM_BINS) ? uBin : NUM_HISTOGRAM_BINS - 1;
+}
+
+// Work out the percentiles of the last frames. A copy of the frame times is partly sorted for each percentile.
+void CFPSCounter::UpdatePercentiles(void)
+{
+	unsigned int uCount = (uNumOfFrames < WINDOW_SIZE) ? uNumOfFrames : WINDOW_SIZE;
+	if (uCount == 0)
+		return;
+
+	vector<double> vSorted(vFrameTimes.begin(), vFrameTimes.begin() + uCount);
+	double* adPercentiles[] = { &dPercentile50, &dPercentile95, &dPercentile99 };
+	const double adFractions[] = { 0.50, 0.95, 0.99 };
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		vector<double>::iterator it = vSorted.begin() + (unsigned int)(adFractions[i] * (uCount - 1));
+		nth_element(vSorted.begin(), it, vSorted.end());
+		*adPercentiles[i] = *it;
+	}
+	dMaxFrameTime = *max_element(vSorted.begin(), vSorted.end());
+}
+
+// Record a hitch, with the profiler zones which took longer than usual in the frame which the profiler collected last.
+// A zone took longer than usual if it took dHitchFactor times its average, and at least 1 ms more.
+void CFPSCounter::RecordHitch(const double dTime)
+{
+	Hitch sHitch;
+	sHitch.uFrame = uNumOfFrames;
+	sHitch.dFrameTime = dTime;
+	sHitch.dMedian = dPercentile50;
+
+	if (CProfiler::IsEnabled())
+	{
+		const std::vector<CProfiler::SummaryLine>& vSummary = CProfiler::GetInstance()->GetSummary();
+		for (unsigned int i = 0; i < vSummary.size(); i++)
+		{
+			const CProfiler::SummaryLine& sLine = vSummary[i];
+			if ((sLine.dLastTime > sLine.dTime * dHitchFactor) && (sLine.dLastTime - sLine.dTime >= 1.0))
+			{
+				if (!sHitch.strZones.empty())
+					sHitch.strZones += ", ";
+				sHitch.strZones += (sLine.bGPU ? "GPU " : "") + string(sLine.pName) + " " + to_string(sLine.dLastTime) + " ms";
+			}
+		}
+	}
+
+	cout << "CFPSCounter::Update(): Hitch of " << dTime << " ms at frame " << uNumOfFrames
+		<< " (median " << dPercentile50 << " ms)";
+	if (!sHitch.strZones.empty())
+		cout << ": " << sHitch.strZones;
+	cout << endl;
+
+	dqHitches.push_back(sHitch);
+	if (dqHitches.size() > MAX_HITCHES)
+		dqHitches.pop_front();
+	uNumOfHitches++;
+}
@@ -9,7 +9,12 @@ Date: Mar 2020
 #include "../DesignPatterns/SingletonTemplate.h"
 
 #include <string>
+#include <vector>
+#include <deque>
 
+// Counts the frame rate over each second, and keeps the frame times of the last frames, so that the stalls
+// which an average hides can be seen in a histogram and in the percentiles, and each hitch is recorded
+// with the profiler zones which took longer than usual in that frame.
 class CFPSCounter : public CSingletonTemplate<CFPSCounter>
 {
 	friend CSingletonTemplate<CFPSCounter>;
@@ -33,6 +38,47 @@ public:
 	// Get the current frame time
 	double GetFrameTime(void) const;
 
+	// A frame which took much longer than the frames around it
+	struct Hitch
+	{
+		// The number of the frame since Init
+		unsigned int uFrame;
+		// The frame time and the median frame time at that point, in milliseconds
+		double dFrameTime;
+		double dMedian;
+		// The profiler zones which took longer than usual in that frame, or empty if the profiler was disabled
+		std::string strZones;
+	};
+
+	// The number of frames which the statistics are kept for
+	static const unsigned int WINDOW_SIZE = 1024;
+	// The number of bins in the histogram, and the width of each bin in milliseconds. The last bin also counts the longer frames.
+	static const unsigned int NUM_HISTOGRAM_BINS = 100;
+	static const unsigned int HISTOGRAM_BIN_WIDTH = 1;
+	// The number of hitches which are kept
+	static const unsigned int MAX_HITCHES = 64;
+
+	// Set when a frame is a hitch: when it takes longer than dFactor times the median frame time, and longer than dMinTime
+	void SetHitchThreshold(const double dFactor, const double dMinTime);
+
+	// Get a percentile of the frame times of the last frames, in milliseconds. They are worked out once per second.
+	double GetPercentile50(void) const;
+	double GetPercentile95(void) const;
+	double GetPercentile99(void) const;
+	// Get the longest frame time of the last frames, in milliseconds
+	double GetMaxFrameTime(void) const;
+
+	// Get the number of frames in each bin of the histogram of the last frames
+	const std::vector<int>& GetHistogram(void) const;
+	// Get the frame times of the last frames from the oldest, in milliseconds, and if each of them was a hitch
+	void GetFrameTimes(std::vector<double>& vFrameTimes, std::vector<bool>& vHitches) const;
+	// Get the number of the last frame since Init
+	unsigned int GetNumOfFrames(void) const;
+	// Get the hitches which were recorded, from the oldest
+	const std::deque<Hitch>& GetHitches(void) const;
+	// Get the number of hitches since Init
+	unsigned int GetNumOfHitches(void) const;
+
 protected:
 	// Count the elapsed time since the last reset
 	double dElapsedTime;
@@ -43,6 +89,34 @@ protected:
 	// Count the elapsed time since the last reset
 	double dFrameTime;
 
+	// The frame times of the last frames in milliseconds, used as a ring, and if each of them was a hitch
+	std::vector<double> vFrameTimes;
+	std::vector<bool> vIsHitch;
+	// The number of frames since Init. The next frame time goes into vFrameTimes at uNumOfFrames % WINDOW_SIZE.
+	unsigned int uNumOfFrames;
+	// The number of the last frames in each bin of the histogram
+	std::vector<int> vHistogram;
+
+	// The percentiles of the last frames, in milliseconds
+	double dPercentile50;
+	double dPercentile95;
+	double dPercentile99;
+	double dMaxFrameTime;
+
+	// The hitch threshold
+	double dHitchFactor;
+	double dMinHitchTime;
+	// The hitches which were recorded, and the number of hitches since Init
+	std::deque<Hitch> dqHitches;
+	unsigned int uNumOfHitches;
+
+	// Get the bin of the histogram for a frame time, in milliseconds
+	unsigned int GetHistogramBin(const double dTime) const;
+	// Work out the percentiles of the last frames
+	void UpdatePercentiles(void);
+	// Record a hitch, with the profiler zones which took longer than usual
+	void RecordHitch(const double dTime);
+
 	// Constructor
 	CFPSCounter(void);
 };
@@ -0,0 +1,261 @@
+#include "FramePacer.h"
+
+#include <thread>
+#include <iostream>
+using namespace std;
+
+#ifdef _WIN32
+#include <windows.h>
+// Timer flag from the Windows 10 1803 SDK, defined here for the older SDKs
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <time.h>
+#include <errno.h>
+#endif
+
+/**
+ @brief Constructor
+ */
+CFramePacer::CFramePacer(void)
+	: dTargetFrameTime(1.0 / 60.0)
+	, dSpinWindow(0.002)
+	, bVSync(false)
+	, dRefreshPeriod(1.0 / 60.0)
+	, uNumOfFrames(0)
+	, uNumOfMissed(0)
+	, dTotalLateness(0.0)
+#ifdef _WIN32
+	, hTimer(NULL)
+	, uTimerResolution(0)
+#endif
+{
+}
+
+/**
+ @brief Destructor
+ */
+CFramePacer::~CFramePacer(void)
+{
+#ifdef _WIN32
+	if (hTimer)
+	{
+		CloseHandle(hTimer);
+		hTimer = NULL;
+	}
+	if (uTimerResolution > 0)
+	{
+		timeEndPeriod(uTimerResolution);
+		uTimerResolution = 0;
+	}
+#endif
+}
+
+/**
+ @brief Initialise this class instance
+ @param dTargetFrameTime A const double variable which contains the time for each frame, in seconds
+ @param dSpinWindow A const double variable which contains the last part of each wait, in seconds, which is spun on
+ @return A bool value. true is this class instance was initialised, else false
+ */
+bool CFramePacer::Init(const double dTargetFrameTime, const double dSpinWindow)
+{
+	if (dTargetFrameTime < 0.0)
+	{
+		cout << "CFramePacer::Init(): The time for each frame cannot be negative" << endl;
+		return false;
+	}
+	SetTargetFrameTime(dTargetFrameTime);
+	SetSpinWindow(dSpinWindow);
+
+#ifdef _WIN32
+	if (hTimer == NULL)
+	{
+		// A high resolution timer wakes the thread within a fraction of a millisecond, without changing the system timer
+		hTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (hTimer == NULL)
+		{
+			// Else, the system timer is set to 1 ms, so that a sleep is not rounded up to the default 15.6 ms
+			hTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+			if (timeBeginPeriod(1) == TIMERR_NOERROR)
+				uTimerResolution = 1;
+		}
+	}
+#endif
+
+	uNumOfFrames = 0;
+	uNumOfMissed = 0;
+	dTotalLateness = 0.0;
+	Start();
+	return true;
+}
+
+/**
+ @brief Set the time for each frame
+ @param dTargetFrameTime A const double variable which contains the time for each frame, in seconds. 0 does not wait at all.
+ */
+void CFramePacer::SetTargetFrameTime(const double dTargetFrameTime)
+{
+	this->dTargetFrameTime = dTargetFrameTime;
+}
+
+/**
+ @brief Get the time for each frame
+ @return The time for each frame, in seconds
+ */
+double CFramePacer::GetTargetFrameTime(void) const
+{
+	return dTargetFrameTime;
+}
+
+/**
+ @brief Set the last part of each wait which is spun on instead of slept through. A larger window is more precise, but uses more CPU.
+ @param dSpinWindow A const double variable which contains the spin window, in seconds
+ */
+void CFramePacer::SetSpinWindow(const double dSpinWindow)
+{
+	this->dSpinWindow = (dSpinWindow > 0.0) ? dSpinWindow : 0.0;
+}
+
+/**
+ @brief Get the spin window
+ @return The spin window, in seconds
+ */
+double CFramePacer::GetSpinWindow(void) const
+{
+	return dSpinWindow;
+}
+
+/**
+ @brief Let the buffer swap wait for the vertical blank. The frames are then only paced on the CPU when the time for each frame
+		is longer than a refresh, and the waits end half a refresh early, so that the swap catches the vertical blank which is due.
+ @param bVSync A const bool variable which is true if the buffer swap waits for the vertical blank
+ @param dRefreshPeriod A const double variable which contains the time between the vertical blanks, in seconds
+ */
+void CFramePacer::SetVSync(const bool bVSync, const double dRefreshPeriod)
+{
+	this->bVSync = bVSync;
+	if (dRefreshPeriod > 0.0)
+		this->dRefreshPeriod = dRefreshPeriod;
+}
+
+/**
+ @brief Check if the buffer swap waits for the vertical blank
+ @return bVSync value
+ */
+bool CFramePacer::IsVSync(void) const
+{
+	return bVSync;
+}
+
+/**
+ @brief Start the schedule from now, so that the next frame is due one frame time from now
+ */
+void CFramePacer::Start(void)
+{
+	tDeadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double>(dTargetFrameTime));
+}
+
+/**
+ @brief Wait until the next frame is due, then move the deadline on by one frame time. If the frame is more than
+		a frame time late, the schedule is restarted from now, instead of rushing the next frames to catch up.
+ @return The time which was waited, in seconds
+ */
+double CFramePacer::Wait(void)
+{
+	uNumOfFrames++;
+	const Clock::duration tPeriod = chrono::duration_cast<Clock::duration>(chrono::duration<double>(dTargetFrameTime));
+
+	Clock::time_point tTarget = tDeadline;
+	if (bVSync)
+	{
+		// The buffer swap already waits for the vertical blank
+		if (dTargetFrameTime <= dRefreshPeriod * 1.05)
+		{
+			tDeadline = Clock::now() + tPeriod;
+			return 0.0;
+		}
+		tTarget -= chrono::duration_cast<Clock::duration>(chrono::duration<double>(dRefreshPeriod * 0.5));
+	}
+
+	Clock::time_point tStart = Clock::now();
+	if (tStart >= tTarget)
+	{
+		uNumOfMissed++;
+		if (tStart - tTarget > tPeriod)
+			tDeadline = tStart + tPeriod;
+		else
+			tDeadline += tPeriod;
+		return 0.0;
+	}
+
+	// Sleep through most of the wait, then spin on the rest
+	SleepUntil(tTarget - chrono::duration_cast<Clock::duration>(chrono::duration<double>(dSpinWindow)));
+	Clock::time_point tNow = Clock::now();
+	while (tNow < tTarget)
+	{
+		this_thread::yield();
+		tNow = Clock::now();
+	}
+
+	dTotalLateness += chrono::duration<double>(tNow - tTarget).count();
+	tDeadline += tPeriod;
+	return chrono::duration<double>(tNow - tStart).count();
+}
+
+/**
+ @brief Get the number of frames which were started after their deadline
+ @return uNumOfMissed value
+ */
+unsigned int CFramePacer::GetNumOfMissed(void) const
+{
+	return uNumOfMissed;
+}
+
+/**
+ @brief Get the average time by which the waits ended after their deadlines. It shows how precise the spin window is.
+ @return The average lateness, in seconds
+ */
+double CFramePacer::GetAverageLateness(void) const
+{
+	unsigned int uNumOfWaits = uNumOfFrames - uNumOfMissed;
+	return (uNumOfWaits > 0) ? dTotalLateness / uNumOfWaits : 0.0;
+}
+
+/**
+ @brief Sleep until a time point. The thread may wake a little late, which the spin window makes up for.
+ @param tTime A const Clock::time_point& variable which contains the time to wake at
+ */
+void CFramePacer::SleepUntil(const Clock::time_point& tTime)
+{
+	Clock::time_point tNow = Clock::now();
+	if (tTime <= tNow)
+		return;
+
+#if defined(_WIN32)
+	long long llNanoseconds = chrono::duration_cast<chrono::nanoseconds>(tTime - tNow).count();
+	if (hTimer)
+	{
+		// A negative due time is relative, in 100 ns units
+		LARGE_INTEGER liDueTime;
+		liDueTime.QuadPart = -(llNanoseconds / 100);
+		if (SetWaitableTimer(hTimer, &liDueTime, 0, NULL, NULL, FALSE))
+		{
+			WaitForSingleObject(hTimer, INFINITE);
+			return;
+		}
+	}
+	Sleep((DWORD)(llNanoseconds / 1000000));
+#elif defined(__linux__)
+	// The steady clock counts from the same point as CLOCK_MONOTONIC, so the time point can be slept until directly
+	long long llNanoseconds = chrono::duration_cast<chrono::nanoseconds>(tTime.time_since_epoch()).count();
+	struct timespec tsTime;
+	tsTime.tv_sec = (time_t)(llNanoseconds / 1000000000);
+	tsTime.tv_nsec = (long)(llNanoseconds % 1000000000);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tsTime, NULL) == EINTR)
+	{
+	}
+#else
+	this_thread::sleep_until(tTime);
+#endif
+}
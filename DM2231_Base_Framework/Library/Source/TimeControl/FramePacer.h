@@ -0,0 +1,75 @@
+#pragma once
+
+// Include chrono for the steady clock
+#include <chrono>
+
+// Waits out the rest of each frame so that the frames are started at a steady rate.
+// The deadlines are kept on an absolute schedule, so that the rounding of one frame does not add up over the next ones.
+// Most of the wait is slept through, which frees the CPU, and the last part of it, the spin window, is spun on,
+// as the operating system can wake a sleeping thread late.
+class CFramePacer
+{
+public:
+	// Constructor
+	CFramePacer(void);
+
+	// Destructor
+	~CFramePacer(void);
+
+	// Initialise this class instance
+	bool Init(const double dTargetFrameTime, const double dSpinWindow = 0.002);
+
+	// Set the time for each frame, in seconds
+	void SetTargetFrameTime(const double dTargetFrameTime);
+	// Get the time for each frame, in seconds
+	double GetTargetFrameTime(void) const;
+	// Set the last part of each wait, in seconds, which is spun on instead of slept through
+	void SetSpinWindow(const double dSpinWindow);
+	// Get the spin window, in seconds
+	double GetSpinWindow(void) const;
+	// Let the buffer swap wait for the vertical blank, which refreshes every dRefreshPeriod seconds
+	void SetVSync(const bool bVSync, const double dRefreshPeriod);
+	// Check if the buffer swap waits for the vertical blank
+	bool IsVSync(void) const;
+
+	// Start the schedule from now
+	void Start(void);
+	// Wait until the next frame is due
+	double Wait(void);
+
+	// Get the number of frames which were started after their deadline
+	unsigned int GetNumOfMissed(void) const;
+	// Get the average time, in seconds, by which the waits ended after their deadlines
+	double GetAverageLateness(void) const;
+
+protected:
+	typedef std::chrono::steady_clock Clock;
+
+	// The time for each frame, in seconds
+	double dTargetFrameTime;
+	// The last part of each wait, in seconds, which is spun on
+	double dSpinWindow;
+	// true if the buffer swap waits for the vertical blank
+	bool bVSync;
+	// The time between the vertical blanks, in seconds
+	double dRefreshPeriod;
+
+	// The time at which the next frame is due
+	Clock::time_point tDeadline;
+
+	// Statistics
+	unsigned int uNumOfFrames;
+	unsigned int uNumOfMissed;
+	double dTotalLateness;
+
+#ifdef _WIN32
+	// The HANDLE of the timer which the thread sleeps on, kept as void* so that this header does not need windows.h.
+	// It is a high resolution timer where Windows supports one.
+	void* hTimer;
+	// The resolution of the system timer which was requested, if the high resolution timer is not supported
+	unsigned int uTimerResolution;
+#endif
+
+	// Sleep until a time point, which may end a little late
+	void SleepUntil(const Clock::time_point& tTime);
+};
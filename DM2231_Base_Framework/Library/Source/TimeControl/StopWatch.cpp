@@ -65,24 +65,6 @@ double CStopWatch::GetElapsedTime(void)
 	return LIToSecs(time);
 }
 
-/**
- @brief Wait until this time in milliseconds has passed
- */
-void CStopWatch::WaitUntil(const long long llTime)
-{
-	LARGE_INTEGER nowTime;
-	LONGLONG timeElapsed;
-	while (true)
-	{
-		QueryPerformanceCounter(&nowTime);
-		timeElapsed = ((nowTime.QuadPart - prevTime.QuadPart) * 1000 / frequency.QuadPart);
-		if (timeElapsed > llTime)
-			return;
-		else if (llTime - timeElapsed > 1)
-			Sleep(1);
-	}
-}
-
 /**
  @brief Convert from Large Integer to seconds in double
  @param L A LARGE_INTEGER & containing the time value
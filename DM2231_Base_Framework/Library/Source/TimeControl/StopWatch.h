@@ -28,9 +28,6 @@ public:
 	// Get elapsed time in seconds since the last call to this function
 	double GetElapsedTime(void);
 
-	// Wait until this time in milliseconds has passed
-	void WaitUntil(const long long llTime);
-
 protected:
 	LARGE_INTEGER frequency;
 	LARGE_INTEGER prevTime, currTime;
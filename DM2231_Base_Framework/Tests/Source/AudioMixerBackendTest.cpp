@@ -0,0 +1,192 @@
+#include "UnitTest.h"
+
+// Include AudioMixerBackend
+#include "SoundController\AudioMixerBackend.h"
+// Include VoiceManager
+#include "SoundController\VoiceManager.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ @brief Write a 16-bit PCM mono WAV file
+ */
+static bool WriteWav(const char* filename, const std::vector<short>& vSamples, const int iSampleRate)
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	const unsigned int uDataSize = (unsigned int)(vSamples.size() * sizeof(short));
+	const unsigned int uRIFFSize = 36 + uDataSize;
+	const unsigned int uFormatSize = 16;
+	const unsigned short uPCM = 1, uNumOfChannels = 1, uBytesPerFrame = 2, uBitsPerSample = 16;
+	const unsigned int uSampleRate = iSampleRate, uBytesPerSecond = iSampleRate * 2;
+	file.write("RIFF", 4);
+	file.write((const char*)&uRIFFSize, 4);
+	file.write("WAVEfmt ", 8);
+	file.write((const char*)&uFormatSize, 4);
+	file.write((const char*)&uPCM, 2);
+	file.write((const char*)&uNumOfChannels, 2);
+	file.write((const char*)&uSampleRate, 4);
+	file.write((const char*)&uBytesPerSecond, 4);
+	file.write((const char*)&uBytesPerFrame, 2);
+	file.write((const char*)&uBitsPerSample, 2);
+	file.write("data", 4);
+	file.write((const char*)&uDataSize, 4);
+	file.write((const char*)&vSamples[0], uDataSize);
+	return (bool)file;
+}
+
+/**
+ @brief Write a WAV file with the same sample in every frame, and load it as a source
+ @return The handle of the source
+ */
+static int LoadConstantSource(CAudioMixerBackend& cMixer, const char* filename, const short iSample, const int iNumOfFrames)
+{
+	std::vector<short> vSamples(iNumOfFrames, iSample);
+	if (WriteWav(filename, vSamples, 44100) == false)
+		return -1;
+	int iSource = cMixer.LoadSource(filename, false, false);
+	remove(filename);
+	return iSource;
+}
+
+/**
+ @brief Check if two samples are the same, within the rounding of the mixing
+ */
+static bool IsNear(const float fA, const float fB)
+{
+	return fabs(fA - fB) < 1e-5f;
+}
+
+// The samples of a 2D voice are scaled by the source and master volumes and copied to both channels,
+// and the frames which are not mixed in an Update are carried over to the next one
+TEST(AudioMixerBackend_MixesKnownBuffer)
+{
+	std::vector<short> vSamples;
+	for (int i = 0; i < 441; i++)
+		vSamples.push_back((short)(i * 10 - 2000));
+	CHECK(WriteWav("unittest_ramp.wav", vSamples, 44100));
+
+	CAudioMixerBackend cMixer(44100);
+	CHECK(cMixer.Init());
+	int iSource = cMixer.LoadSource("unittest_ramp.wav", false, false);
+	remove("unittest_ramp.wav");
+	CHECK(iSource >= 0);
+	cMixer.SetSourceVolume(iSource, 0.5f);
+	cMixer.SetMasterVolume(0.5f);
+
+	int iVoice = cMixer.Play(iSource, false, false, vec3df(0.0f, 0.0f, 0.0f));
+	CHECK(iVoice >= 0);
+
+	// 5 ms is 220.5 frames, so 220 frames are mixed and half a frame is carried over
+	cMixer.Update(0.005);
+	const std::vector<float>& vMix = cMixer.GetMixBuffer();
+	CHECK(vMix.size() == 220 * 2);
+	bool bMatches = (vMix.size() == 220 * 2);
+	for (unsigned int i = 0; bMatches && (i < 220); i++)
+	{
+		const float fExpected = vSamples[i] * 0.25f / 32768.0f;
+		bMatches = IsNear(vMix[i * 2], fExpected) && IsNear(vMix[i * 2 + 1], fExpected);
+	}
+	CHECK(bMatches);
+
+	// The next 221 frames finish the source
+	cMixer.Update(0.005);
+	CHECK(cMixer.GetMixBuffer().size() == 221 * 2);
+	CHECK(IsNear(cMixer.GetMixBuffer()[220 * 2], vSamples[440] * 0.25f / 32768.0f));
+	CHECK(cMixer.IsFinished(iVoice) == false);
+	cMixer.Update(0.001);
+	CHECK(cMixer.IsFinished(iVoice));
+	CHECK(cMixer.GetStats().uNumOfVoiceFrames == 441);
+	CHECK(cMixer.GetStats().uNumOfPlays == 1);
+}
+
+// Two voices are summed, and a 3D voice fades beyond its minimum distance and is panned to the side it is on
+TEST(AudioMixerBackend_MixesVoicesIn3D)
+{
+	CAudioMixerBackend cMixer(44100);
+	int iSource = LoadConstantSource(cMixer, "unittest_constant.wav", 8192, 4410);
+	CHECK(iSource >= 0);
+	cMixer.SetListener(vec3df(0.0f, 0.0f, 0.0f), vec3df(0.0f, 0.0f, 1.0f));
+
+	// A 2D voice, and a 3D voice which is 2 units to the right of the listener
+	cMixer.Play(iSource, true, false, vec3df(0.0f, 0.0f, 0.0f));
+	cMixer.Play(iSource, true, true, vec3df(2.0f, 0.0f, 0.0f));
+	cMixer.Update(0.001);
+
+	const std::vector<float>& vMix = cMixer.GetMixBuffer();
+	CHECK(vMix.size() == 44 * 2);
+	CHECK(IsNear(vMix[0], 0.25f));
+	CHECK(IsNear(vMix[1], 0.25f + 0.125f));
+	CHECK(cMixer.GetStats().iPeakVoices == 2);
+}
+
+// Get the sum of the samples of the voices which are playing, which tells which of them are playing
+// as each source has its own power of 2 as its sample
+static int GetPlayingSum(CAudioMixerBackend& cMixer)
+{
+	cMixer.Update(0.001);
+	const std::vector<float>& vMix = cMixer.GetMixBuffer();
+	if (vMix.empty())
+		return -1;
+	return (int)floor(vMix[0] * 32768.0f + 0.5f);
+}
+
+// When the voices are all in use, the voice with the lowest priority is stolen, then the quietest, then the oldest,
+// and a sound is not played if every voice has a higher priority than it
+TEST(VoiceManager_StealsByPriorityLoudnessAndAge)
+{
+	CAudioMixerBackend cMixer(44100);
+	const short aSamples[] = { 64, 128, 256, 512, 1024, 2048 };
+	int aSources[6];
+	for (int i = 0; i < 6; i++)
+	{
+		std::string strName = "unittest_voice_" + std::to_string(i) + ".wav";
+		aSources[i] = LoadConstantSource(cMixer, strName.c_str(), aSamples[i], 44100);
+		CHECK(aSources[i] >= 0);
+	}
+
+	CVoiceManager cVoiceManager;
+	CHECK(cVoiceManager.Init(&cMixer, 3));
+	const vec3df vec3dfListener(0.0f, 0.0f, 0.0f);
+	const int aPriorities[] = { 1, 5, 3, 3, 3, 1 };
+	// Play a sound, with its ID the same as its source
+	auto Play = [&](const int i) -> bool
+	{
+		if (cVoiceManager.Acquire(i, aPriorities[i], 0, vec3dfListener) == false)
+			return false;
+		cVoiceManager.Add(cMixer.Play(aSources[i], true, false, vec3dfListener), i, aPriorities[i], false);
+		return true;
+	};
+
+	CHECK(Play(0));
+	CHECK(Play(1));
+	CHECK(Play(2));
+	CHECK(GetPlayingSum(cMixer) == 64 + 128 + 256);
+
+	// The voice with the lowest priority, 0, is stolen
+	CHECK(Play(3));
+	CHECK(GetPlayingSum(cMixer) == 128 + 256 + 512);
+	CHECK(cVoiceManager.GetNumOfStolen() == 1);
+
+	// Voices 2 and 3 have the same priority and volume, so the older one, 2, is stolen. Sound 4 plays at 3/4 of the volume.
+	cMixer.SetSourceVolume(aSources[4], 0.75f);
+	CHECK(Play(4));
+	CHECK(GetPlayingSum(cMixer) == 128 + 512 + 768);
+
+	// Voices 3 and 4 have the same priority, and 4 is the quieter one though it is newer
+	CHECK(Play(2));
+	CHECK(GetPlayingSum(cMixer) == 128 + 512 + 256);
+	CHECK(cVoiceManager.GetNumOfStolen() == 3);
+
+	// No voice has a priority as low as 1, so the sound is not played
+	CHECK(Play(5) == false);
+	CHECK(cVoiceManager.GetNumOfRejected() == 1);
+	CHECK(GetPlayingSum(cMixer) == 128 + 512 + 256);
+	CHECK(cVoiceManager.GetNumOfVoices() == 3);
+}
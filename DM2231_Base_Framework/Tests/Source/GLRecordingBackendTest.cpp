@@ -0,0 +1,125 @@
+#include "UnitTest.h"
+
+// Include GLRecordingBackend
+#include "RenderControl\GLRecordingBackend.h"
+// Include GLDispatch
+#include "RenderControl\GLDispatch.h"
+// Include StreamBuffer
+#include "RenderControl\StreamBuffer.h"
+// Include DebugDraw
+#include "RenderControl\DebugDraw.h"
+
+#include <string>
+#include <vector>
+
+// The program of the line shader. There is no driver to link one, so any name will do.
+static const unsigned int LINE_PROGRAM = 1;
+
+/**
+ @brief Draw a frame of debug lines through the recording backend. Each flush draws a box and a line.
+ */
+static void DrawFrame(CGLRecordingBackend& cRecorder, const int iNumOfFlushes)
+{
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+
+	cRecorder.BeginFrame();
+	CStreamBuffer::GetInstance()->BeginFrame();
+	for (int i = 0; i < iNumOfFlushes; i++)
+	{
+		CDebugDraw::GetInstance()->AddBox(glm::translate(glm::mat4(1.0f), glm::vec3((float)i, 0.0f, 0.0f)),
+										  glm::vec3(-0.5f), glm::vec3(0.5f), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+		CDebugDraw::GetInstance()->AddLine(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+		CDebugDraw::GetInstance()->Flush(view, projection);
+	}
+	CStreamBuffer::GetInstance()->EndFrame();
+	cRecorder.EndFrame();
+}
+
+/**
+ @brief Get the uniform calls in a call log
+ */
+static std::vector<std::string> GetUniformCalls(const std::vector<std::string>& vCallLog)
+{
+	std::vector<std::string> vUniformCalls;
+	for (unsigned int i = 0; i < vCallLog.size(); i++)
+	{
+		if (vCallLog[i].compare(0, 7, "Uniform") == 0)
+			vUniformCalls.push_back(vCallLog[i]);
+	}
+	return vUniformCalls;
+}
+
+// The debug lines are drawn through GL() with only the recording backend, and each frame's counters
+// are what the batch should cost: one draw call per flush, and the state which is set again is redundant
+TEST(GLRecordingBackend_CountsTheDebugLinesWithoutADriver)
+{
+	CGLRecordingBackend cRecorder;
+	CGLDispatch::GetInstance()->SetBackend(&cRecorder);
+
+	// The buffers and vertex arrays are given names, although there is no driver to create them
+	CHECK(CStreamBuffer::GetInstance()->Init(64 * 1024));
+	CHECK(CStreamBuffer::GetInstance()->GetVBO() != 0);
+	CHECK(CDebugDraw::GetInstance()->Init());
+	Shader cLineShader(LINE_PROGRAM);
+	CDebugDraw::GetInstance()->SetShader(&cLineShader);
+
+	// Each box is 12 lines, so a flush draws 13 lines, which is 26 vertices of 6 floats
+	const size_t uVerticesPerFlush = 26;
+	const size_t uBytesPerFlush = uVerticesPerFlush * 6 * sizeof(float);
+
+	// The first flush sets the program and line width for the first time. Init left the streaming vertex buffer bound,
+	// so binding it again to upload the lines is redundant.
+	DrawFrame(cRecorder, 1);
+	CHECK(cRecorder.GetNumOfFrames() == 1);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfDrawCalls == 1);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfVertices == uVerticesPerFlush);
+	CHECK(cRecorder.GetLastFrameStats().uBytesUploaded == uBytesPerFlush);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfUniforms == 3);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfRedundantStateChanges == 1);
+	CHECK(CDebugDraw::GetInstance()->GetNumOfLinesDrawn() == 13);
+	CHECK(CStreamBuffer::GetInstance()->GetBytesAllocated() == uBytesPerFlush);
+
+	// Every flush after that sets the same program, line width and vertex buffer again
+	cRecorder.SetCallLogEnabled(true);
+	DrawFrame(cRecorder, 2);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfDrawCalls == 2);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfVertices == 2 * uVerticesPerFlush);
+	CHECK(cRecorder.GetLastFrameStats().uBytesUploaded == 2 * uBytesPerFlush);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfUniforms == 6);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfRedundantStateChanges == 6);
+	CHECK(CStreamBuffer::GetInstance()->GetBytesAllocated() == 2 * uBytesPerFlush);
+
+	// The uniform locations which were handed out for the shader are the same in both flushes,
+	// and different for each uniform
+	std::vector<std::string> vUniformCalls = GetUniformCalls(cRecorder.GetCallLog());
+	CHECK(vUniformCalls.size() == 6);
+	if (vUniformCalls.size() == 6)
+	{
+		CHECK(std::vector<std::string>(vUniformCalls.begin(), vUniformCalls.begin() + 3)
+			  == std::vector<std::string>(vUniformCalls.begin() + 3, vUniformCalls.end()));
+		CHECK((vUniformCalls[0] != vUniformCalls[1]) && (vUniformCalls[1] != vUniformCalls[2]) && (vUniformCalls[0] != vUniformCalls[2]));
+	}
+	cRecorder.SetCallLogEnabled(false);
+
+	// The stream buffer goes round all its segments and waits on their fences, which have always signalled
+	for (int i = 0; i < 4; i++)
+		DrawFrame(cRecorder, 1);
+	CHECK(cRecorder.GetNumOfFrames() == 6);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfDrawCalls == 1);
+	CHECK(cRecorder.GetLastFrameStats().uBytesUploaded == uBytesPerFlush);
+	CHECK(CStreamBuffer::GetInstance()->GetNumOfStalls() == 0);
+	CHECK(CStreamBuffer::GetInstance()->GetNumOfOrphans() == 0);
+
+	// A frame with nothing to draw makes no draw calls and uploads nothing
+	DrawFrame(cRecorder, 0);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfDrawCalls == 0);
+	CHECK(cRecorder.GetLastFrameStats().uNumOfVertices == 0);
+	CHECK(cRecorder.GetLastFrameStats().uBytesUploaded == 0);
+
+	// The buffers and vertex arrays are deleted through the recording backend too
+	CDebugDraw::Destroy();
+	CStreamBuffer::Destroy();
+	CGLDispatch::GetInstance()->SetBackend(NULL);
+	CGLDispatch::Destroy();
+}
@@ -0,0 +1,145 @@
+#include "UnitTest.h"
+
+// Include LoadOBJ
+#include "System\LoadOBJ.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A corner of a triangle by its position, uv and normal
+typedef std::array<float, 8> Corner;
+// A triangle by its corners, rotated so that the smallest corner is first, so that the winding is compared too
+typedef std::array<Corner, 3> Triangle;
+
+/**
+ @brief Get a corner as an array, so that it can be sorted and compared
+ */
+static Corner GetCorner(const glm::vec3& pos, const glm::vec2& uv, const glm::vec3& normal)
+{
+	Corner aCorner = { pos.x, pos.y, pos.z, uv.x, uv.y, normal.x, normal.y, normal.z };
+	return aCorner;
+}
+
+/**
+ @brief Get the triangles which were loaded, sorted, so that the parsers can be compared whatever order
+		they write the triangles of a face in
+ */
+static std::vector<Triangle> GetSortedTriangles(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec2>& uvs, const std::vector<glm::vec3>& normals)
+{
+	std::vector<Triangle> vTriangles;
+	for (size_t i = 0; i + 2 < vertices.size(); i += 3)
+	{
+		Triangle aTriangle;
+		for (int j = 0; j < 3; j++)
+			aTriangle[j] = GetCorner(vertices[i + j], uvs[i + j], normals[i + j]);
+		std::rotate(aTriangle.begin(), std::min_element(aTriangle.begin(), aTriangle.end()), aTriangle.end());
+		vTriangles.push_back(aTriangle);
+	}
+	std::sort(vTriangles.begin(), vTriangles.end());
+	return vTriangles;
+}
+
+/**
+ @brief Count the triangles which the line-by-line parser dropped from a file. It reads only the first 4 corners
+		of a face, so it keeps 2 triangles of a face with more corners.
+ */
+static size_t CountDroppedTriangles(const std::string& strFile)
+{
+	std::ifstream file(strFile);
+	std::string strLine;
+	size_t uNumOfDropped = 0;
+	while (std::getline(file, strLine))
+	{
+		if (strLine.compare(0, 2, "f ") != 0)
+			continue;
+		std::istringstream line(strLine.substr(2));
+		std::string strCorner;
+		size_t uNumOfCorners = 0;
+		while (line >> strCorner)
+			uNumOfCorners++;
+		if (uNumOfCorners > 4)
+			uNumOfDropped += uNumOfCorners - 4;
+	}
+	return uNumOfDropped;
+}
+
+/**
+ @brief Check that IndexVBO merged the corners which are the same into one vertex, and that every index points at a vertex
+		the same as its corner
+ */
+static bool IsIndexedCorrectly(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec2>& uvs, const std::vector<glm::vec3>& normals,
+							   const std::vector<unsigned>& indices, const std::vector<Vertex>& indexedVertices)
+{
+	if (indices.size() != vertices.size())
+		return false;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if ((indices[i] >= indexedVertices.size())
+			|| (GetCorner(indexedVertices[indices[i]].pos, indexedVertices[indices[i]].texCoord, indexedVertices[indices[i]].normal)
+				!= GetCorner(vertices[i], uvs[i], normals[i])))
+			return false;
+	}
+
+	// No two vertices are the same
+	std::vector<Corner> vCorners;
+	for (size_t i = 0; i < indexedVertices.size(); i++)
+		vCorners.push_back(GetCorner(indexedVertices[i].pos, indexedVertices[i].texCoord, indexedVertices[i].normal));
+	std::sort(vCorners.begin(), vCorners.end());
+	return std::adjacent_find(vCorners.begin(), vCorners.end()) == vCorners.end();
+}
+
+// Every shipped OBJ file is read by LoadOBJ into the same triangles as the line-by-line parser which it replaced,
+// except for the triangles which the old parser dropped, and IndexVBO merges them into as many vertices
+TEST(LoadOBJ_MatchesLineByLineParser)
+{
+	int iNumOfFiles = 0, iNumOfCompared = 0;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("OBJ"))
+	{
+		if (entry.path().extension() != ".obj")
+			continue;
+		iNumOfFiles++;
+		const std::string strFile = entry.path().string();
+
+		std::vector<glm::vec3> vertices, normals;
+		std::vector<glm::vec2> uvs;
+		std::vector<unsigned> indices;
+		std::vector<Vertex> indexedVertices;
+		CHECK(LoadOBJ(strFile.c_str(), vertices, uvs, normals));
+		CHECK(vertices.size() > 0);
+		CHECK((vertices.size() % 3 == 0) && (uvs.size() == vertices.size()) && (normals.size() == vertices.size()));
+		IndexVBO(vertices, uvs, normals, indices, indexedVertices);
+		CHECK(IsIndexedCorrectly(vertices, uvs, normals, indices, indexedVertices));
+
+		// The old parser only reads the faces whose corners are all "v/vt/vn", so files with other faces are not compared
+		std::vector<glm::vec3> oldVertices, oldNormals;
+		std::vector<glm::vec2> oldUVs;
+		if (LoadOBJ_Getline(strFile.c_str(), oldVertices, oldUVs, oldNormals) == false)
+		{
+			std::cout << strFile << " cannot be read by the line-by-line parser, so it is not compared" << std::endl;
+			continue;
+		}
+		iNumOfCompared++;
+		std::vector<unsigned> oldIndices;
+		std::vector<Vertex> oldIndexedVertices;
+		IndexVBO(oldVertices, oldUVs, oldNormals, oldIndices, oldIndexedVertices);
+
+		std::vector<Triangle> vTriangles = GetSortedTriangles(vertices, uvs, normals);
+		std::vector<Triangle> vOldTriangles = GetSortedTriangles(oldVertices, oldUVs, oldNormals);
+		const size_t uNumOfDropped = CountDroppedTriangles(strFile);
+		CHECK(vTriangles.size() == vOldTriangles.size() + uNumOfDropped);
+		CHECK(std::includes(vTriangles.begin(), vTriangles.end(), vOldTriangles.begin(), vOldTriangles.end()));
+		CHECK(indices.size() == oldIndices.size() + uNumOfDropped * 3);
+		if (uNumOfDropped == 0)
+			CHECK(indexedVertices.size() == oldIndexedVertices.size());
+		else
+			CHECK(indexedVertices.size() >= oldIndexedVertices.size());
+	}
+	CHECK(iNumOfFiles > 0);
+	CHECK(iNumOfCompared > 0);
+}
@@ -0,0 +1,50 @@
+#include "UnitTest.h"
+
+// Include MeshFile
+#include "System\MeshFile.h"
+
+#include <cstring>
+#include <vector>
+
+/**
+ @brief Set an index in the contents of a .mesh file, whatever the size of its indices
+ */
+static void SetIndex(std::vector<char>& file, const unsigned int uIndex, const unsigned int uValue)
+{
+	const MeshFileHeader* pHeader = (const MeshFileHeader*)&file[0];
+	char* pIndex = &file[pHeader->uIndexOffset + uIndex * pHeader->uIndexSize];
+	if (pHeader->uIndexSize == sizeof(unsigned short))
+	{
+		unsigned short uShort = (unsigned short)uValue;
+		memcpy(pIndex, &uShort, sizeof(unsigned short));
+	}
+	else
+		memcpy(pIndex, &uValue, sizeof(unsigned int));
+}
+
+// An imported .mesh file is valid, and it is not once one of its indices points past its vertices
+TEST(ValidateMeshFile_ChecksIndexRange)
+{
+	std::vector<char> file;
+	CHECK(ImportMeshFile("OBJ/box2.obj", file));
+	CHECK(file.size() >= sizeof(MeshFileHeader));
+	if (file.size() < sizeof(MeshFileHeader))
+		return;
+	const MeshFileHeader* pHeader = ValidateMeshFile(&file[0], file.size());
+	CHECK(pHeader != NULL);
+	if (pHeader == NULL)
+		return;
+	const unsigned int uNumOfVertices = pHeader->uNumOfVertices;
+	const unsigned int uLastIndex = pHeader->uNumOfIndices - 1;
+
+	// The last vertex is in range
+	SetIndex(file, uLastIndex, uNumOfVertices - 1);
+	CHECK(ValidateMeshFile(&file[0], file.size()) != NULL);
+
+	// One past the last vertex is not
+	SetIndex(file, uLastIndex, uNumOfVertices);
+	CHECK(ValidateMeshFile(&file[0], file.size()) == NULL);
+	SetIndex(file, 0, 0xFFFF);
+	SetIndex(file, uLastIndex, 0);
+	CHECK(ValidateMeshFile(&file[0], file.size()) == NULL);
+}
@@ -0,0 +1,133 @@
+#include "UnitTest.h"
+
+// Include MeshOptimizer
+#include "System\MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// A triangle by the positions of its corners, in the order they are drawn, so that the winding is compared too
+typedef std::array<float, 9> TrianglePositions;
+
+/**
+ @brief Get the triangles of a mesh by the positions of their corners, sorted, so that two meshes can be compared
+		whatever order their triangles and vertices are in
+ */
+static std::vector<TrianglePositions> GetSortedTriangles(const std::vector<unsigned>& indices, const std::vector<Vertex>& vertices)
+{
+	std::vector<TrianglePositions> vTriangles;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		TrianglePositions aTriangle;
+		for (int j = 0; j < 3; j++)
+		{
+			const glm::vec3& pos = vertices[indices[i + j]].pos;
+			aTriangle[j * 3] = pos.x;
+			aTriangle[j * 3 + 1] = pos.y;
+			aTriangle[j * 3 + 2] = pos.z;
+		}
+		vTriangles.push_back(aTriangle);
+	}
+	std::sort(vTriangles.begin(), vTriangles.end());
+	return vTriangles;
+}
+
+/**
+ @brief Make a grid of quads, each of which is 2 triangles, with the triangles in a scattered order
+ */
+static void MakeGrid(const int iSize, std::vector<unsigned>& indices, std::vector<Vertex>& vertices)
+{
+	vertices.clear();
+	for (int z = 0; z <= iSize; z++)
+	{
+		for (int x = 0; x <= iSize; x++)
+		{
+			Vertex sVertex;
+			sVertex.pos = glm::vec3((float)x, 0.0f, (float)z);
+			sVertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+			sVertex.texCoord = glm::vec2((float)x / iSize, (float)z / iSize);
+			vertices.push_back(sVertex);
+		}
+	}
+
+	std::vector<unsigned> vQuads;
+	for (int z = 0; z < iSize; z++)
+	{
+		for (int x = 0; x < iSize; x++)
+		{
+			unsigned int a = z * (iSize + 1) + x;
+			unsigned int b = a + 1;
+			unsigned int c = a + iSize + 1;
+			unsigned int d = c + 1;
+			unsigned int aTriangles[6] = { a, c, b, b, c, d };
+			vQuads.insert(vQuads.end(), aTriangles, aTriangles + 6);
+		}
+	}
+
+	// Scatter the triangles, so that the optimiser has something to do
+	indices.clear();
+	const size_t uNumOfTriangles = vQuads.size() / 3;
+	for (size_t i = 0; i < uNumOfTriangles; i++)
+	{
+		size_t uTriangle = (i * 7919) % uNumOfTriangles;
+		indices.insert(indices.end(), vQuads.begin() + uTriangle * 3, vQuads.begin() + uTriangle * 3 + 3);
+	}
+}
+
+// The cache optimisation only reorders the triangles, so every triangle is kept with its winding
+TEST(OptimizeVertexCache_KeepsTriangles)
+{
+	std::vector<unsigned> indices;
+	std::vector<Vertex> vertices;
+	MakeGrid(16, indices, vertices);
+	std::vector<TrianglePositions> vBefore = GetSortedTriangles(indices, vertices);
+	const float fACMRBefore = ComputeACMR(indices, (unsigned int)vertices.size());
+
+	OptimizeVertexCache(indices, (unsigned int)vertices.size());
+
+	CHECK(GetSortedTriangles(indices, vertices) == vBefore);
+	CHECK(ComputeACMR(indices, (unsigned int)vertices.size()) < fACMRBefore);
+}
+
+// A triangle which uses a vertex more than once must not break the lists of triangles of its vertices
+TEST(OptimizeVertexCache_DegenerateTriangles)
+{
+	std::vector<unsigned> indices;
+	std::vector<Vertex> vertices;
+	MakeGrid(4, indices, vertices);
+	const unsigned int aDegenerate[] = { 0, 0, 1,  2, 3, 2,  5, 6, 6,  7, 7, 7,  1, 0, 0 };
+	indices.insert(indices.begin() + 6, aDegenerate, aDegenerate + 15);
+	std::vector<TrianglePositions> vBefore = GetSortedTriangles(indices, vertices);
+
+	OptimizeVertexCache(indices, (unsigned int)vertices.size());
+
+	CHECK(indices.size() == vBefore.size() * 3);
+	CHECK(GetSortedTriangles(indices, vertices) == vBefore);
+}
+
+// The whole optimisation reorders the triangles and the vertices, but keeps the same triangles
+TEST(OptimizeMesh_KeepsTriangles)
+{
+	std::vector<unsigned> indices;
+	std::vector<Vertex> vertices;
+	MakeGrid(16, indices, vertices);
+	const unsigned int aDegenerate[] = { 3, 3, 4,  9, 9, 9 };
+	indices.insert(indices.end(), aDegenerate, aDegenerate + 6);
+	std::vector<TrianglePositions> vBefore = GetSortedTriangles(indices, vertices);
+
+	OptimizeMesh(indices, vertices);
+
+	CHECK(GetSortedTriangles(indices, vertices) == vBefore);
+	// The vertices are in the order which the triangles first use them in
+	unsigned int uNextNew = 0;
+	bool bSequential = true;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (indices[i] > uNextNew)
+			bSequential = false;
+		else if (indices[i] == uNextNew)
+			uNextNew++;
+	}
+	CHECK(bSequential);
+}
@@ -0,0 +1,141 @@
+#include "UnitTest.h"
+
+// Include OcclusionCuller
+#include "RenderControl\OcclusionCuller.h"
+
+#include <includes/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <vector>
+
+// The camera of the tests is at head height, looking down the -z axis, with a 2:1 screen like the depth buffer
+static glm::mat4 GetViewProjection(void)
+{
+	glm::mat4 matProjection = glm::perspective(glm::radians(45.0f), 2.0f, 0.1f, 100.0f);
+	glm::mat4 matView = glm::lookAt(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return matProjection * matView;
+}
+
+// A box, as its minimum and maximum corners
+struct Box
+{
+	glm::vec3 vec3Min;
+	glm::vec3 vec3Max;
+};
+
+// A wall 10 units in front of the camera, which covers the middle of the screen
+static const Box WALL = { glm::vec3(-4.0f, 0.0f, -10.5f), glm::vec3(4.0f, 5.0f, -10.0f) };
+// A wall along the right of the camera, which runs from behind it into the distance, so that it crosses the near plane
+static const Box SIDE_WALL = { glm::vec3(2.0f, 0.0f, -30.0f), glm::vec3(3.0f, 5.0f, 5.0f) };
+
+/**
+ @brief Draw the occluders of a test into the depth buffer
+ */
+static void DrawOccluders(COcclusionCuller* cOcclusionCuller, const std::vector<Box>& vOccluders)
+{
+	cOcclusionCuller->Begin(GetViewProjection());
+	for (unsigned int i = 0; i < vOccluders.size(); i++)
+		cOcclusionCuller->AddOccluder(vOccluders[i].vec3Min, vOccluders[i].vec3Max);
+}
+
+// A box behind the wall is hidden, and the boxes in front of it, beside it or across the near plane are not
+TEST(OcclusionCuller_HidesOnlyTheBoxesBehindAWall)
+{
+	COcclusionCuller* cOcclusionCuller = COcclusionCuller::GetInstance();
+	CHECK(cOcclusionCuller->Init(256, 128));
+	DrawOccluders(cOcclusionCuller, std::vector<Box>(1, WALL));
+	CHECK(cOcclusionCuller->GetNumOfOccluders() == 1);
+
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-1.0f, 0.0f, -20.0f), glm::vec3(1.0f, 2.0f, -18.0f)) == false);
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-1.0f, 0.0f, -6.0f), glm::vec3(1.0f, 2.0f, -4.0f)));
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(10.0f, 0.0f, -20.0f), glm::vec3(12.0f, 2.0f, -18.0f)));
+	// A box which runs from behind the camera to behind the wall crosses the near plane. Its corners which are in front
+	// of the near plane are all behind the wall, but the part of it in front of the wall is seen.
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-1.0f, 0.0f, -20.0f), glm::vec3(1.0f, 2.0f, 1.0f)));
+	// A box which sticks out above the wall is seen over it
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-1.0f, 0.0f, -20.0f), glm::vec3(1.0f, 12.0f, -18.0f)));
+	CHECK(cOcclusionCuller->GetNumOfCulled() == 1);
+	CHECK(cOcclusionCuller->GetNumOfTested() == 5);
+
+	// When the culling is disabled, every box is visible
+	cOcclusionCuller->SetEnabled(false);
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-1.0f, 0.0f, -20.0f), glm::vec3(1.0f, 2.0f, -18.0f)));
+	cOcclusionCuller->SetEnabled(true);
+
+	COcclusionCuller::Destroy();
+}
+
+// An occluder which crosses the near plane is clipped and still hides the boxes behind it
+TEST(OcclusionCuller_ClipsOccludersAtTheNearPlane)
+{
+	COcclusionCuller* cOcclusionCuller = COcclusionCuller::GetInstance();
+	CHECK(cOcclusionCuller->Init(256, 128));
+	DrawOccluders(cOcclusionCuller, std::vector<Box>(1, SIDE_WALL));
+	CHECK(cOcclusionCuller->GetNumOfOccluders() == 1);
+
+	// The depth buffer has no NaNs or depths in front of the near plane from the corners behind the camera
+	bool bValidDepths = true;
+	const float* pDepthBuffer = cOcclusionCuller->GetDepthBuffer();
+	for (int i = 0; i < cOcclusionCuller->GetWidth() * cOcclusionCuller->GetHeight(); i++)
+	{
+		if (!(pDepthBuffer[i] >= 0.0f) || !(pDepthBuffer[i] <= 1.0f))
+			bValidDepths = false;
+	}
+	CHECK(bValidDepths);
+
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(6.0f, 0.0f, -12.0f), glm::vec3(8.0f, 2.0f, -10.0f)) == false);
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(-8.0f, 0.0f, -12.0f), glm::vec3(-6.0f, 2.0f, -10.0f)));
+	CHECK(cOcclusionCuller->IsVisible(glm::vec3(0.0f, 0.0f, -12.0f), glm::vec3(1.0f, 2.0f, -10.0f)));
+
+	COcclusionCuller::Destroy();
+}
+
+// The SSE path draws the same depth buffer as the pixel at a time path, and hides the same boxes
+TEST(OcclusionCuller_SSEMatchesScalar)
+{
+	std::vector<Box> vOccluders;
+	vOccluders.push_back(WALL);
+	vOccluders.push_back(SIDE_WALL);
+	// A pillar at an angle to the screen
+	Box sPillar = { glm::vec3(-7.3f, 0.0f, -15.2f), glm::vec3(-5.9f, 7.0f, -13.7f) };
+	vOccluders.push_back(sPillar);
+
+	// A grid of boxes over the floor, in front of and behind the occluders
+	std::vector<Box> vBoxes;
+	for (int z = 0; z < 12; z++)
+	{
+		for (int x = 0; x < 12; x++)
+		{
+			Box sBox;
+			sBox.vec3Min = glm::vec3(-15.0f + x * 2.5f, 0.0f, -2.0f - z * 3.0f);
+			sBox.vec3Max = sBox.vec3Min + glm::vec3(1.0f, 1.5f + (x % 3), 1.0f);
+			vBoxes.push_back(sBox);
+		}
+	}
+
+	std::vector<float> avDepthBuffers[2];
+	std::vector<bool> avVisible[2];
+	int aiNumOfCulled[2] = { 0, 0 };
+	for (int i = 0; i < 2; i++)
+	{
+		COcclusionCuller* cOcclusionCuller = COcclusionCuller::GetInstance();
+		CHECK(cOcclusionCuller->Init(256, 128));
+		cOcclusionCuller->SetSSE(i == 0);
+		DrawOccluders(cOcclusionCuller, vOccluders);
+		avDepthBuffers[i].assign(cOcclusionCuller->GetDepthBuffer(),
+								 cOcclusionCuller->GetDepthBuffer() + cOcclusionCuller->GetWidth() * cOcclusionCuller->GetHeight());
+		for (unsigned int j = 0; j < vBoxes.size(); j++)
+			avVisible[i].push_back(cOcclusionCuller->IsVisible(vBoxes[j].vec3Min, vBoxes[j].vec3Max));
+		aiNumOfCulled[i] = (int)cOcclusionCuller->GetNumOfCulled();
+		COcclusionCuller::Destroy();
+	}
+
+	// The SSE path steps its edge functions across the row, so the depths may differ by rounding
+	bool bSameDepths = (avDepthBuffers[0].size() == avDepthBuffers[1].size());
+	for (unsigned int i = 0; bSameDepths && (i < avDepthBuffers[0].size()); i++)
+		bSameDepths = (fabs(avDepthBuffers[0][i] - avDepthBuffers[1][i]) < 1e-5f);
+	CHECK(bSameDepths);
+	CHECK(avVisible[0] == avVisible[1]);
+	// Some boxes are hidden, and some are not, so the comparison means something
+	CHECK((aiNumOfCulled[0] > 0) && (aiNumOfCulled[0] < (int)vBoxes.size()));
+}
@@ -0,0 +1,42 @@
+#include "UnitTest.h"
+
+// Include Profiler
+#include "System\Profiler.h"
+
+#include <cstring>
+
+/**
+ @brief Time a zone and end the frame, then check if the zone is in the summary
+ */
+static bool RecordsZone(const char* pName)
+{
+	CProfiler* cProfiler = CProfiler::GetInstance();
+	cProfiler->BeginFrame();
+	{
+		PROFILE_SCOPE(pName);
+	}
+	cProfiler->EndFrame();
+
+	const std::vector<CProfiler::SummaryLine>& vSummary = cProfiler->GetSummary();
+	for (unsigned int i = 0; i < vSummary.size(); i++)
+	{
+		if (strcmp(vSummary[i].pName, pName) == 0)
+			return true;
+	}
+	return false;
+}
+
+// The ring buffer which a thread cached is deleted with the profiler, so a profiler which is created again
+// gives the thread a new one
+TEST(Profiler_RecordsAfterBeingCreatedAgain)
+{
+	CProfiler::GetInstance()->Init();
+	CProfiler::GetInstance()->SetEnabled(true);
+	CHECK(RecordsZone("First"));
+	CProfiler::Destroy();
+
+	CProfiler::GetInstance()->Init();
+	CProfiler::GetInstance()->SetEnabled(true);
+	CHECK(RecordsZone("Second"));
+	CProfiler::Destroy();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+// The unit tests of the Tests project. Each test is a function which is declared with TEST,
+// and registers itself before main runs. CHECK records a failure and carries on with the rest of the test.
+class CUnitTest
+{
+public:
+	// The signature of a test
+	typedef void (*TestFunction)(void);
+
+	// Register a test, which is called by TEST
+	static void Register(const char* pName, TestFunction fnTest);
+	// Run all the tests and print a line for each of them
+	static int RunAll(void);
+
+	// Record the result of a check
+	static void Check(const bool bPassed, const char* pCondition, const char* pFile, const int iLine);
+
+protected:
+	// A registered test
+	struct Test
+	{
+		const char* pName;
+		TestFunction fnTest;
+	};
+
+	// Get the registered tests. They are kept in a function, so that they are created before the first test registers itself.
+	static std::vector<Test>& GetTests(void);
+	// The number of checks which failed in the test which is running
+	static int iNumOfFailures;
+};
+
+// Registers a test when it is constructed
+class CUnitTestRegistrar
+{
+public:
+	CUnitTestRegistrar(const char* pName, CUnitTest::TestFunction fnTest)
+	{
+		CUnitTest::Register(pName, fnTest);
+	}
+};
+
+// Declare a test. The body of the test follows the macro.
+#define TEST(name) \
+	static void name(void); \
+	static CUnitTestRegistrar cUnitTestRegistrar_##name(#name, name); \
+	static void name(void)
+
+// Check a condition in a test
+#define CHECK(condition) CUnitTest::Check((condition), #condition, __FILE__, __LINE__)
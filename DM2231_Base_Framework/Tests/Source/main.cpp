@@ -0,0 +1,74 @@
+#include "UnitTest.h"
+
+#include <iostream>
+using namespace std;
+
+int CUnitTest::iNumOfFailures = 0;
+
+/**
+ @brief Register a test, which is called by TEST
+ @param pName A const char* variable which contains the name of the test
+ @param fnTest A TestFunction variable which contains the test
+ */
+void CUnitTest::Register(const char* pName, TestFunction fnTest)
+{
+	Test sTest;
+	sTest.pName = pName;
+	sTest.fnTest = fnTest;
+	GetTests().push_back(sTest);
+}
+
+/**
+ @brief Run all the tests and print a line for each of them
+ @return The number of tests which failed
+ */
+int CUnitTest::RunAll(void)
+{
+	std::vector<Test>& vTests = GetTests();
+	int iNumOfFailedTests = 0;
+	for (unsigned int i = 0; i < vTests.size(); i++)
+	{
+		iNumOfFailures = 0;
+		vTests[i].fnTest();
+		if (iNumOfFailures > 0)
+			iNumOfFailedTests++;
+		cout << (iNumOfFailures > 0 ? "FAIL " : "ok   ") << vTests[i].pName << endl;
+	}
+	cout << vTests.size() - iNumOfFailedTests << " of " << vTests.size() << " tests passed" << endl;
+	return iNumOfFailedTests;
+}
+
+/**
+ @brief Record the result of a check, and print it if it failed
+ @param bPassed A const bool variable which is true if the check passed
+ @param pCondition A const char* variable which contains the condition which was checked
+ @param pFile A const char* variable which contains the file of the check
+ @param iLine A const int variable which contains the line of the check
+ */
+void CUnitTest::Check(const bool bPassed, const char* pCondition, const char* pFile, const int iLine)
+{
+	if (bPassed)
+		return;
+
+	iNumOfFailures++;
+	cout << pFile << "(" << iLine << "): CHECK(" << pCondition << ") failed" << endl;
+}
+
+/**
+ @brief Get the registered tests
+ @return A std::vector<Test>& which contains the tests
+ */
+std::vector<CUnitTest::Test>& CUnitTest::GetTests(void)
+{
+	static std::vector<Test> vTests;
+	return vTests;
+}
+
+/**
+ @brief The entry point of the Tests project. The working directory must be the App folder, so that the assets are found.
+ @return 0 if all the tests passed, else 1
+ */
+int main(void)
+{
+	return (CUnitTest::RunAll() == 0) ? 0 : 1;
+}